@@ -41,12 +41,14 @@
 
 // azure/core/http
 #include "azure/core/http/http.hpp"
+#include "azure/core/http/http_headers.hpp"
 #include "azure/core/http/http_status_code.hpp"
 #include "azure/core/http/raw_response.hpp"
 #include "azure/core/http/transport.hpp"
 
 // azure/core/http/policies
 #include "azure/core/http/policies/policy.hpp"
+#include "azure/core/http/policies/policy_latency_recorder.hpp"
 
 // azure/core/io
 #include "azure/core/io/body_stream.hpp"
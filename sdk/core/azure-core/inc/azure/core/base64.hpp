@@ -10,6 +10,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint> // defines std::uint8_t
 #include <stdexcept>
 #include <stdint.h> // deprecated, defines uint8_t in global namespace. TODO: Remove when uint8_t in the global namespace is removed.
@@ -50,6 +51,58 @@ namespace Azure { namespace Core {
      * @return The decoded binary data.
      */
     static std::vector<uint8_t> Base64Decode(const std::string& text);
+
+    /**
+     * @brief Gets the size of the Base64 encoding of binary data.
+     *
+     * @param dataSize The size of the binary data, in bytes.
+     * @return The number of characters the Base64 encoding of \p dataSize bytes has.
+     */
+    static size_t GetBase64EncodedSize(size_t dataSize);
+
+    /**
+     * @brief Gets the size of the binary data encoded with Base64.
+     *
+     * @param text Base64 encoded data.
+     * @param textSize The number of characters of \p text.
+     * @return The number of bytes \p text decodes to.
+     * @throw std::runtime_error if \p textSize is not a multiple of 4.
+     */
+    static size_t GetBase64DecodedSize(char const* text, size_t textSize);
+
+    /**
+     * @brief Encodes binary data using Base64 into a caller provided buffer.
+     *
+     * @param data The binary data to be encoded.
+     * @param dataSize The size of \p data, in bytes.
+     * @param buffer The buffer to write the Base64 encoded data to. The data is not followed by a
+     * null character.
+     * @param bufferSize The size of \p buffer, at least `GetBase64EncodedSize(dataSize)`.
+     * @return The number of characters written to \p buffer.
+     * @throw std::invalid_argument if \p buffer is too small.
+     */
+    static size_t Base64Encode(
+        uint8_t const* data,
+        size_t dataSize,
+        char* buffer,
+        size_t bufferSize);
+
+    /**
+     * @brief Decodes Base64 encoded data into a caller provided buffer.
+     *
+     * @param text Base64 encoded data to be decoded.
+     * @param textSize The number of characters of \p text.
+     * @param buffer The buffer to write the decoded binary data to.
+     * @param bufferSize The size of \p buffer, at least `GetBase64DecodedSize(text, textSize)`.
+     * @return The number of bytes written to \p buffer.
+     * @throw std::invalid_argument if \p buffer is too small.
+     * @throw std::runtime_error if \p text is not valid Base64 encoded data.
+     */
+    static size_t Base64Decode(
+        char const* text,
+        size_t textSize,
+        uint8_t* buffer,
+        size_t bufferSize);
   };
 
   namespace _internal {
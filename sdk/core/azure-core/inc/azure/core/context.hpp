@@ -14,7 +14,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -25,6 +27,11 @@ namespace Azure { namespace Core { namespace Tracing {
 }}} // namespace Azure::Core::Tracing
 
 namespace Azure { namespace Core {
+  class Context;
+
+  namespace _internal {
+    class ContextCancellationSignal;
+  }
 
   /**
    * @brief An exception thrown when an operation is cancelled.
@@ -103,16 +110,37 @@ namespace Azure { namespace Core {
     };
 
   private:
-    struct ContextSharedState final
+    friend class _internal::ContextCancellationSignal;
+
+    struct ContextSharedState
     {
+      // The cancellation signals of the contexts of a tree, defined with the signals.
+      struct SignalList;
+
       std::shared_ptr<ContextSharedState> Parent;
+      // The context without parent of the tree of the context, kept alive by the parents.
+      ContextSharedState* const Root;
+      // The earliest deadline of the context and its parents, `DateTime::min()` once the context
+      // or one of its parents is cancelled.
       std::atomic<DateTime::rep> Deadline;
+      // The #CancellationGeneration of the root when the parents were last checked for
+      // cancellation.
+      std::atomic<uint64_t> CheckedGeneration;
+      // Of the root only: counts the cancellations of the contexts of the tree. The children
+      // don't register with their parent, so that creating contexts from a shared context takes
+      // no lock. Instead, a context checks its parents again when a context of its tree was
+      // cancelled since it last checked them.
+      std::atomic<uint64_t> CancellationGeneration;
+      // Of the root only: the cancellation signals of the contexts of the tree, created with the
+      // first one.
+      std::atomic<SignalList*> Signals;
       std::shared_ptr<Azure::Core::Tracing::TracerProvider> TraceProvider;
       Context::Key Key;
-      std::shared_ptr<void> Value;
+      void const* Value;
 #if defined(AZ_CORE_RTTI)
       const std::type_info& ValueType;
 #endif
+
       static constexpr DateTime::rep ToDateTimeRepresentation(DateTime const& dateTime)
       {
         return dateTime.time_since_epoch().count();
@@ -129,10 +157,13 @@ namespace Azure { namespace Core {
       ContextSharedState&& operator=(ContextSharedState&&) = delete;
 
       /**
-       * @brief Creates a new ContextSharedState object with no deadline and no value.
+       * @brief Creates a new ContextSharedState object with a deadline and no parent.
+       *
+       * @param deadline The deadline for the new context.
        */
-      explicit ContextSharedState()
-          : Deadline(ToDateTimeRepresentation((DateTime::max)())), Value(nullptr)
+      explicit ContextSharedState(DateTime const& deadline = (DateTime::max)())
+          : Root(this), Deadline(ToDateTimeRepresentation(deadline)), CheckedGeneration(0),
+            CancellationGeneration(0), Signals(nullptr), Value(nullptr)
 #if defined(AZ_CORE_RTTI)
             ,
             ValueType(typeid(std::nullptr_t))
@@ -140,47 +171,100 @@ namespace Azure { namespace Core {
       {
       }
 
+      ~ContextSharedState();
+
       /**
        * @brief Create a new ContextSharedState from another ContextSharedState with a deadline.
        *
+       * @remark The new context is cancelled with its parent, and its deadline is the earliest
+       * of \p deadline and the deadline of its parent.
+       *
        * @param parent The parent context to create a child context from.
        * @param deadline The deadline for the new context.
        *
        */
       explicit ContextSharedState(
           const std::shared_ptr<ContextSharedState>& parent,
-          DateTime const& deadline = (DateTime::max)())
-          : Parent(parent), Deadline(ToDateTimeRepresentation(deadline)), Value(nullptr)
+          DateTime const& deadline)
+          : ContextSharedState(parent, deadline, nullptr, nullptr
 #if defined(AZ_CORE_RTTI)
-            ,
-            ValueType(typeid(std::nullptr_t))
+                               ,
+                               typeid(std::nullptr_t)
 #endif
+            )
       {
       }
 
       /**
-       * @brief Create a new ContextSharedState from another ContextSharedState with a deadline and
-       * a key value pair.
+       * @brief Gets the deadline of the context, after checking the parents for cancellation if
+       * a context of the tree was cancelled since they were last checked.
+       *
+       * @return The earliest deadline of the context and its parents, `DateTime::min()` if the
+       * context or one of its parents is cancelled.
+       */
+      DateTime::rep GetDeadline()
+      {
+        uint64_t const generation = Root->CancellationGeneration.load(std::memory_order_acquire);
+        if (CheckedGeneration.load(std::memory_order_acquire) != generation)
+        {
+          CheckParents(generation);
+        }
+        return Deadline.load(std::memory_order_acquire);
+      }
+
+      /**
+       * @brief Cancels the context, and notifies the cancellation signals of the context and of
+       * its children, found in the signals of its tree.
+       */
+      void Cancel();
+
+    private:
+      void CheckParents(uint64_t generation);
+
+    protected:
+      explicit ContextSharedState(
+          const std::shared_ptr<ContextSharedState>& parent,
+          DateTime const& deadline,
+          Context::Key const* key,
+          void const* value
+#if defined(AZ_CORE_RTTI)
+          ,
+          const std::type_info& valueType
+#endif
+      );
+    };
+
+    /**
+     * @brief The state of a context with a key value pair, stored with the state to create the
+     * context with one allocation.
+     *
+     * @tparam T The type of the value stored with the key.
+     */
+    template <class T> struct ContextSharedStateWithValue final : public ContextSharedState
+    {
+      T StoredValue;
+
+      /**
+       * @brief Create a new ContextSharedState from another ContextSharedState with a key value
+       * pair.
        *
-       * @tparam T The type of the value to be stored with the key.
        * @param parent The parent context to create a child context from.
-       * @param deadline The deadline for the new context.
        * @param key The key to associate with the value.
        * @param value The value to associate with the key.
        *
        */
-      template <class T>
-      explicit ContextSharedState(
+      template <class U>
+      explicit ContextSharedStateWithValue(
           const std::shared_ptr<ContextSharedState>& parent,
-          DateTime const& deadline,
           Context::Key const& key,
-          T value) // NOTE, should this be T&&
-          : Parent(parent), Deadline(ToDateTimeRepresentation(deadline)), Key(key),
-            Value(std::make_shared<T>(std::move(value)))
+          U&& value)
+          : ContextSharedState(parent, (DateTime::max)(), &key, &StoredValue
 #if defined(AZ_CORE_RTTI)
-            ,
-            ValueType(typeid(T))
+                               ,
+                               typeid(T)
 #endif
+                               ),
+            StoredValue(std::forward<U>(value))
       {
       }
     };
@@ -207,7 +291,7 @@ namespace Azure { namespace Core {
      *
      */
     explicit Context(DateTime const& deadline)
-        : m_contextSharedState(std::make_shared<ContextSharedState>(nullptr, deadline))
+        : m_contextSharedState(std::make_shared<ContextSharedState>(deadline))
     {
     }
 
@@ -288,8 +372,8 @@ namespace Azure { namespace Core {
      */
     template <class T> Context WithValue(Key const& key, T&& value) const
     {
-      return Context{std::make_shared<ContextSharedState>(
-          m_contextSharedState, (DateTime::max)(), key, std::forward<T>(value))};
+      return Context{std::make_shared<ContextSharedStateWithValue<typename std::decay<T>::type>>(
+          m_contextSharedState, key, std::forward<T>(value))};
     }
 
     /**
@@ -300,7 +384,10 @@ namespace Azure { namespace Core {
      * specified.
      *
      */
-    DateTime GetDeadline() const;
+    DateTime GetDeadline() const
+    {
+      return ContextSharedState::FromDateTimeRepresentation(m_contextSharedState->GetDeadline());
+    }
 
     /**
      * @brief Gets the value associated with a \p key parameter within this context or the
@@ -318,7 +405,8 @@ namespace Azure { namespace Core {
      */
     template <class T> bool TryGetValue(Key const& key, T& outputValue) const
     {
-      for (std::shared_ptr<ContextSharedState> ptr = m_contextSharedState; ptr; ptr = ptr->Parent)
+      for (ContextSharedState const* ptr = m_contextSharedState.get(); ptr;
+           ptr = ptr->Parent.get())
       {
         if (ptr->Key == key)
         {
@@ -327,7 +415,7 @@ namespace Azure { namespace Core {
               typeid(T) == ptr->ValueType, "Type mismatch for Context::TryGetValue().");
 #endif
 
-          outputValue = *reinterpret_cast<const T*>(ptr->Value.get());
+          outputValue = *static_cast<const T*>(ptr->Value);
           return true;
         }
       }
@@ -345,17 +433,29 @@ namespace Azure { namespace Core {
      * @note Once a context has been cancelled, the cancellation cannot be undone.
      *
      */
-    void Cancel()
-    {
-      m_contextSharedState->Deadline
-          = ContextSharedState::ToDateTimeRepresentation((DateTime::min)());
-    }
+    void Cancel() { m_contextSharedState->Cancel(); }
 
     /**
      * @brief Checks if the context is cancelled.
+     *
+     * @remark The check reads the deadline of the context, which includes the deadlines and the
+     * cancellation of its parents, so it takes the same time for any number of parents. The
+     * parents are only walked once after a context of the same tree is cancelled, and the clock
+     * is only read when the context has a deadline.
+     *
      * @return `true` if this context is cancelled; otherwise, `false`.
      */
-    bool IsCancelled() const { return GetDeadline() < std::chrono::system_clock::now(); }
+    bool IsCancelled() const
+    {
+      DateTime::rep const deadline = m_contextSharedState->GetDeadline();
+      if (deadline == ContextSharedState::ToDateTimeRepresentation((DateTime::max)()))
+      {
+        return false;
+      }
+      return deadline == ContextSharedState::ToDateTimeRepresentation((DateTime::min)())
+          || ContextSharedState::FromDateTimeRepresentation(deadline)
+          < std::chrono::system_clock::now();
+    }
 
     /** @brief Throws if the context is cancelled.
      *
@@ -380,4 +480,77 @@ namespace Azure { namespace Core {
         "ApplicationContext is no longer supported. Instead customers should create their "
         "own root context objects.")]] static const AZ_CORE_DLLEXPORT Context ApplicationContext;
   };
+
+  namespace _internal {
+    /**
+     * @brief Wakes up the threads waiting on a condition variable when a context is cancelled.
+     *
+     * @details While the signal exists, cancelling the context or one of its parents notifies the
+     * condition variable, so that the threads waiting for an event or for the cancellation don't
+     * have to wake up regularly to check the context.
+     *
+     * @remark The condition variable is notified with its mutex locked. Create and destroy the
+     * signal without the mutex locked, and don't cancel the context or create a child context
+     * from it with the mutex locked.
+     */
+    class ContextCancellationSignal final {
+      friend class Azure::Core::Context;
+
+      Context m_context;
+      std::mutex& m_mutex;
+      std::condition_variable& m_signal;
+      // The signals are kept in a list per tree of contexts, which cancelling a context walks to
+      // notify the signals of the context and of its children.
+      ContextCancellationSignal* m_previous = nullptr;
+      ContextCancellationSignal* m_next = nullptr;
+
+      void Notify();
+
+      static void NotifyCancelled(Context::ContextSharedState& root);
+
+    public:
+      /**
+       * @brief Notifies \p signal when \p context is cancelled.
+       *
+       * @param context The context.
+       * @param mutex The mutex of the condition variable.
+       * @param signal The condition variable to notify.
+       */
+      explicit ContextCancellationSignal(
+          Context const& context,
+          std::mutex& mutex,
+          std::condition_variable& signal);
+
+      ContextCancellationSignal(ContextCancellationSignal const&) = delete;
+      ContextCancellationSignal& operator=(ContextCancellationSignal const&) = delete;
+
+      /**
+       * @brief Stops notifying the condition variable.
+       */
+      ~ContextCancellationSignal();
+
+      /**
+       * @brief Waits until the condition variable is notified, the context is cancelled, the
+       * deadline of the context passes or \p timeout elapses.
+       *
+       * @remark Like `std::condition_variable::wait_for()`, the wait may end spuriously.
+       *
+       * @param lock The lock of the mutex of the condition variable, locked.
+       * @param timeout The maximum time to wait.
+       */
+      void WaitFor(
+          std::unique_lock<std::mutex>& lock,
+          std::chrono::steady_clock::duration timeout) const;
+
+      /**
+       * @brief Waits for \p duration, or until \p context is cancelled.
+       *
+       * @param context The context.
+       * @param duration The time to wait.
+       *
+       * @throw #Azure::Core::OperationCancelledException if the context is cancelled.
+       */
+      static void Sleep(Context const& context, std::chrono::milliseconds duration);
+    };
+  } // namespace _internal
 }} // namespace Azure::Core
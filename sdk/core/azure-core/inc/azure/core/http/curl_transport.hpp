@@ -13,21 +13,122 @@
 #include "azure/core/nullable.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+
+#if defined(_azure_TESTING_BUILD)
+// Define the classes used from tests to validate the event loops
+namespace Azure { namespace Core { namespace Test {
+  class CurlMultiTransport_http2Multiplexing_Test;
+  class CurlMultiTransport_connectionReuse_Test;
+}}} // namespace Azure::Core::Test
+#endif
 
 namespace Azure { namespace Core { namespace Http {
   class CurlNetworkConnection;
 
+  class CurlMultiTransport;
+
   namespace _detail {
+    class CurlMultiEventLoop;
+
     /**
      * @brief Default maximum time in milliseconds that you allow the connection phase to the server
      * to take.
      *
      */
     constexpr std::chrono::milliseconds DefaultConnectionTimeout = std::chrono::minutes(5);
+
+    /**
+     * @brief Default maximum number of idle connections kept in the connection pool for a single
+     * host.
+     *
+     */
+    constexpr size_t DefaultMaxPooledConnectionsPerHost = 1024;
+
+    /**
+     * @brief Default time an idle connection is kept in the connection pool.
+     *
+     */
+    constexpr std::chrono::milliseconds DefaultConnectionIdleTimeout = std::chrono::seconds(60);
+
+    /**
+     * @brief Default size in bytes of the buffer used to read the status line and headers of a
+     * response.
+     *
+     */
+    constexpr size_t DefaultHeaderBufferSize = 4 * 1024;
+
+    /**
+     * @brief Default time the host names resolved by libcurl are kept in the DNS cache.
+     *
+     */
+    constexpr std::chrono::seconds DefaultDnsCacheTimeout = std::chrono::seconds(60);
   } // namespace _detail
 
+  /**
+   * @brief Counters collected by the libcurl connection pool.
+   *
+   * @remark The connection pool is shared by all the #Azure::Core::Http::CurlTransport instances
+   * in the application, so the counters are process wide.
+   *
+   */
+  struct CurlConnectionPoolStatistics final
+  {
+    /**
+     * @brief Number of times a request re-used a connection from the pool.
+     *
+     */
+    uint64_t Hits = 0;
+
+    /**
+     * @brief Number of times a request found no connection in the pool and a new connection had to
+     * be created.
+     *
+     */
+    uint64_t Misses = 0;
+
+    /**
+     * @brief Number of idle connections closed by the pool, either because a pool limit was reached
+     * or because they expired.
+     *
+     */
+    uint64_t Evictions = 0;
+
+    /**
+     * @brief Accumulated time spent by all threads waiting for a connection pool lock.
+     *
+     */
+    std::chrono::nanoseconds LockWaitTime{0};
+
+    /**
+     * @brief Number of idle connections currently in the pool.
+     *
+     */
+    size_t PooledConnections = 0;
+
+    /**
+     * @brief Number of new connections which did a full TLS handshake.
+     *
+     * @remark TLS handshakes are only counted when libcurl uses OpenSSL.
+     *
+     */
+    uint64_t FullTlsHandshakes = 0;
+
+    /**
+     * @brief Number of new connections which resumed a TLS session cached by an earlier
+     * connection to the same host.
+     *
+     * @details See #Azure::Core::Http::CurlTransportOptions::EnableCurlSslCaching.
+     *
+     * @remark TLS handshakes are only counted when libcurl uses OpenSSL.
+     *
+     */
+    uint64_t ResumedTlsHandshakes = 0;
+  };
+
   /**
    * @brief The available options to set libcurl SSL options.
    *
@@ -197,8 +298,99 @@ namespace Azure { namespace Core { namespace Http {
 
     /**
      * @brief If set, enables libcurl's internal SSL session caching.
+     *
+     * @details The TLS sessions are cached for each host and shared by all the connections in the
+     * application, so a new connection to a host resumes the session of an earlier one instead of
+     * doing a full TLS handshake.
      */
     bool EnableCurlSslCaching = true;
+
+    /**
+     * @brief If set, requests are sent with HTTP/2 when the server supports it, and concurrent
+     * requests to the same host are multiplexed over a single connection.
+     *
+     * @details HTTP/2 is negotiated during the TLS handshake, so it is only used for `https` URLs.
+     * Any other request and any server without HTTP/2 support uses HTTP/1.1. The requests are sent
+     * by a #Azure::Core::Http::CurlMultiTransport, even when this option is given to a
+     * #Azure::Core::Http::CurlTransport.
+     *
+     * @remark The default value is `false`. Certificate revocation list checks can't be enabled
+     * together with this option on Linux.
+     */
+    bool EnableHttp2 = false;
+
+    /**
+     * @brief The maximum number of idle connections kept in the connection pool for a single host.
+     *
+     * @details When a connection is returned to the pool and its host already has this many idle
+     * connections, the oldest idle connection for the host is closed. Setting `0` disables
+     * connection re-use.
+     *
+     * @remark The default value is 1024.
+     *
+     */
+    size_t MaxPooledConnectionsPerHost = _detail::DefaultMaxPooledConnectionsPerHost;
+
+    /**
+     * @brief The maximum number of idle connections kept in the connection pool across all hosts.
+     *
+     * @details When the limit is reached, a connection returned to the pool is closed instead of
+     * being kept for re-use. `0` means there is no global limit.
+     *
+     * @remark The connection pool is shared by all the transports in the application. Both limits
+     * are taken from the options of the transport returning the connection. The default value is
+     * `0`.
+     *
+     */
+    size_t MaxPooledConnections = 0;
+
+    /**
+     * @brief The time an idle connection is kept in the connection pool before it is closed.
+     *
+     * @remark The timeout is taken from the options of the transport which opened the connection.
+     * The default value is 60 seconds. `0` uses the default value.
+     *
+     */
+    std::chrono::milliseconds ConnectionIdleTimeout = _detail::DefaultConnectionIdleTimeout;
+
+    /**
+     * @brief The maximum time a connection is re-used for, counted from when it was opened.
+     *
+     * @details A connection reaching this age is closed instead of being re-used, so the requests
+     * move to new connections from time to time, e.g. to follow a change in the DNS records of a
+     * host.
+     *
+     * @remark The default value is `0`, which keeps re-using a connection for as long as it works.
+     *
+     */
+    std::chrono::milliseconds ConnectionMaxLifetime{0};
+
+    /**
+     * @brief The size in bytes of the buffer each request uses to read the status line and headers
+     * of the response.
+     *
+     * @details Bytes of the body received together with the headers are kept in this buffer until
+     * the body stream is read. Reading the body with a buffer larger than this size copies the
+     * data straight from the socket to the caller's buffer. A larger value lets responses with big
+     * headers be read with fewer socket reads.
+     *
+     * @remark The default value is 4 KiB. `0` uses the default value.
+     *
+     */
+    size_t HeaderBufferSize = _detail::DefaultHeaderBufferSize;
+
+    /**
+     * @brief The time a resolved host name is kept in the DNS cache.
+     *
+     * @details The DNS cache of a host is shared by all the connections to that host in the
+     * application, so only the first connection waits for the name to be resolved. `0` disables
+     * the cache and a negative value keeps the entries forever.
+     *
+     * @remark The default value is 60 seconds. More about this option:
+     * https://curl.se/libcurl/c/CURLOPT_DNS_CACHE_TIMEOUT.html
+     *
+     */
+    std::chrono::seconds DnsCacheTimeout = _detail::DefaultDnsCacheTimeout;
   };
 
   /**
@@ -207,6 +399,8 @@ namespace Azure { namespace Core { namespace Http {
   class CurlTransport : public HttpTransport {
   private:
     CurlTransportOptions m_options;
+    // Sends the requests when HTTP/2 is enabled, libcurl handles the HTTP/2 framing.
+    std::shared_ptr<CurlMultiTransport> m_http2Transport;
 
     /**
      * @brief Called when an HTTP response indicates the connection should be upgraded to
@@ -220,9 +414,7 @@ namespace Azure { namespace Core { namespace Http {
      *
      * @param options Optional parameter to override the default options.
      */
-    CurlTransport(CurlTransportOptions const& options = CurlTransportOptions()) : m_options(options)
-    {
-    }
+    CurlTransport(CurlTransportOptions const& options = CurlTransportOptions());
 
     /**
      * @brief Construct a new CurlTransport object based on common Azure HTTP Transport Options
@@ -250,6 +442,94 @@ namespace Azure { namespace Core { namespace Http {
      * @return unique ptr to an HTTP RawResponse.
      */
     std::unique_ptr<RawResponse> Send(Request& request, Context const& context) override;
+
+    /**
+     * @brief Opens connections to a host ahead of time and adds them to the connection pool.
+     *
+     * @details Up to 8 connections are opened concurrently, including the DNS resolution and the
+     * TLS handshake, so the first requests to \p url don't pay for them. They are only kept while
+     * the pool limits in the transport options allow it, and they expire like any other idle
+     * connection in the pool.
+     *
+     * @remark Nothing is done when #Azure::Core::Http::CurlTransportOptions::EnableHttp2 is set.
+     *
+     * @param url The URL of the host to connect to. Only the scheme, host and port are used.
+     * @param connectionCount The number of connections to open.
+     * @param context A context to control the request lifetime.
+     *
+     * @throw TransportException if a connection can't be opened. The connections opened
+     * successfully are still added to the pool.
+     */
+    void Prewarm(Url const& url, size_t connectionCount, Context const& context = Context());
+
+    /**
+     * @brief Gets the counters collected by the libcurl connection pool.
+     *
+     * @return A snapshot of the connection pool counters.
+     */
+    static CurlConnectionPoolStatistics GetConnectionPoolStatistics();
+  };
+
+  /**
+   * @brief Concrete implementation of an HTTP Transport that uses the libcurl multi interface.
+   *
+   * @details Requests are driven by a small number of event loop threads instead of one thread per
+   * request, so a single thread can keep thousands of requests in flight. Each event loop keeps its
+   * own connection cache, and all the requests to a host go through the same event loop, so that
+   * they share its connections. The response body is buffered up to a fixed size while the caller
+   * is not reading it, after that the transfer is paused until the caller reads more data.
+   *
+   * @remark Certificate revocation list checks are not supported by this transport on Linux.
+   */
+  class CurlMultiTransport : public HttpTransport {
+#if defined(_azure_TESTING_BUILD)
+    // make tests classes friends to validate the connections opened by the event loops
+    friend class Azure::Core::Test::CurlMultiTransport_http2Multiplexing_Test;
+    friend class Azure::Core::Test::CurlMultiTransport_connectionReuse_Test;
+#endif
+  private:
+    CurlTransportOptions m_options;
+    std::vector<std::shared_ptr<_detail::CurlMultiEventLoop>> m_eventLoops;
+
+  public:
+    /**
+     * @brief Construct a new CurlMultiTransport object.
+     *
+     * @param options Optional parameter to override the default options.
+     * @param eventLoopCount Number of event loop threads the hosts are spread across.
+     *
+     * @throw std::invalid_argument if \p eventLoopCount is zero or \p options asks for a feature
+     * this transport does not support.
+     */
+    explicit CurlMultiTransport(
+        CurlTransportOptions const& options = CurlTransportOptions(),
+        size_t eventLoopCount = 1);
+
+    /**
+     * @brief Construct a new CurlMultiTransport object based on common Azure HTTP Transport
+     * Options.
+     *
+     * @param options Common Azure Core Transport Options.
+     */
+    CurlMultiTransport(Azure::Core::Http::Policies::TransportOptions const& options);
+
+    /**
+     * @brief Destroys a CurlMultiTransport object.
+     *
+     * @remark Event loops stay alive until every response body stream created by them has been
+     * destroyed.
+     */
+    virtual ~CurlMultiTransport();
+
+    /**
+     * @brief Implements interface to send an HTTP Request and produce an HTTP RawResponse
+     *
+     * @param request an HTTP Request to be send.
+     * @param context A context to control the request lifetime.
+     *
+     * @return unique ptr to an HTTP RawResponse.
+     */
+    std::unique_ptr<RawResponse> Send(Request& request, Context const& context) override;
   };
 
 }}} // namespace Azure::Core::Http
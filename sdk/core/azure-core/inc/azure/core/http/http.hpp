@@ -11,6 +11,7 @@
 #include "azure/core/case_insensitive_containers.hpp"
 #include "azure/core/dll_import_export.hpp"
 #include "azure/core/exception.hpp"
+#include "azure/core/http/http_headers.hpp"
 #include "azure/core/http/http_status_code.hpp"
 #include "azure/core/http/raw_response.hpp"
 #include "azure/core/internal/contract.hpp"
@@ -35,6 +36,7 @@ namespace Azure { namespace Core { namespace Test {
   class TestHttp_getters_Test;
   class TestHttp_query_parameter_Test;
   class TestHttp_RequestStartTry_Test;
+  class TestHttp_RequestStartTryHeaders_Test;
   class TestURL_getters_Test;
   class TestURL_query_parameter_Test;
   class TransportAdapter_headWithStream_Test;
@@ -187,6 +189,7 @@ namespace Azure { namespace Core { namespace Http {
     friend class Azure::Core::Test::TestHttp_getters_Test;
     friend class Azure::Core::Test::TestHttp_query_parameter_Test;
     friend class Azure::Core::Test::TestHttp_RequestStartTry_Test;
+    friend class Azure::Core::Test::TestHttp_RequestStartTryHeaders_Test;
     friend class Azure::Core::Test::TestURL_getters_Test;
     friend class Azure::Core::Test::TestURL_query_parameter_Test;
     // make tests classes friends to validate private Request ctor that takes both stream and bool
@@ -203,14 +206,17 @@ namespace Azure { namespace Core { namespace Http {
   private:
     HttpMethod m_method;
     Url m_url;
-    CaseInsensitiveMap m_headers;
-    CaseInsensitiveMap m_retryHeaders;
+    HttpHeaders m_headers;
+    // The headers set during the current try, with their values before the try, which the next
+    // try restores.
+    std::vector<std::pair<std::string, Azure::Nullable<std::string>>> m_headersBeforeTry;
 
     Azure::Core::IO::BodyStream* m_bodyStream;
 
     // flag to know where to insert header
     bool m_retryModeEnabled{false};
     bool m_shouldBufferResponse{true};
+    size_t m_uploadChunkSize{0};
 
     // Expected to be called by a Retry policy to reset all headers set after this function was
     // previously called
@@ -307,10 +313,10 @@ namespace Azure { namespace Core { namespace Http {
     /**
      * @brief Get HTTP headers.
      *
-     * @remark Note that this function return a COPY of the headers for this request.
+     * @remark The reference is valid until the headers change. Copy the headers to keep them.
      *
      */
-    CaseInsensitiveMap GetHeaders() const;
+    HttpHeaders const& GetHeaders() const { return this->m_headers; }
 
     /**
      * @brief Get HTTP body as #Azure::Core::IO::BodyStream.
@@ -330,6 +336,23 @@ namespace Azure { namespace Core { namespace Http {
      */
     bool ShouldBufferResponse() const { return this->m_shouldBufferResponse; }
 
+    /**
+     * @brief Set the maximum number of bytes the transport sends to the network at a time when
+     * uploading the request body.
+     *
+     * @remark Larger values mean fewer send calls for big uploads. `0` uses the transport default,
+     * which is 64 KiB for the libcurl transport.
+     *
+     * @param chunkSize The upload chunk size in bytes.
+     */
+    void SetUploadChunkSize(size_t chunkSize) { this->m_uploadChunkSize = chunkSize; }
+
+    /**
+     * @brief Get the upload chunk size set with
+     * #Azure::Core::Http::Request::SetUploadChunkSize, or `0` if it was not set.
+     */
+    size_t GetUploadChunkSize() const { return this->m_uploadChunkSize; }
+
     /**
      * @brief Get URL.
      *
@@ -357,7 +380,7 @@ namespace Azure { namespace Core { namespace Http {
        * @throw if \p headerName is invalid.
        */
       static void InsertHeaderWithValidation(
-          CaseInsensitiveMap& headers,
+          HttpHeaders& headers,
           std::string const& headerName,
           std::string const& headerValue);
 
@@ -375,9 +398,8 @@ namespace Azure { namespace Core { namespace Http {
           throw std::invalid_argument("Invalid header. No delimiter ':' found.");
         }
 
-        // Always toLower() headers
-        auto const headerName
-            = Azure::Core::_internal::StringExtensions::ToLower(std::string(start, end));
+        // The headers lowercase the name
+        auto const headerName = std::string(start, end);
         start = end + 1; // start value
         while (start < last && (*start == ' ' || *start == '\t'))
         {
@@ -403,7 +425,7 @@ namespace Azure { namespace Core { namespace Http {
       AZ_CORE_DLLEXPORT static char const MsClientRequestId[];
 
       static inline std::string GetHeaderOrEmptyString(
-          Azure::Core::CaseInsensitiveMap const& headers,
+          HttpHeaders const& headers,
           std::string const& headerName)
       {
         auto header = headers.find(headerName);
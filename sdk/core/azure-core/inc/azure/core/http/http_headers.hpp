@@ -0,0 +1,243 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief The headers of an HTTP request or response.
+ */
+
+#pragma once
+
+#include "azure/core/case_insensitive_containers.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace Azure { namespace Core { namespace Http {
+
+  /**
+   * @brief The headers of an HTTP request or response, sorted by name.
+   *
+   * @details The header names are lowercase and looked up case-insensitively. The headers are
+   * stored in one array, inside the object itself for up to 16 headers, so that the headers of
+   * typical requests and responses don't allocate beyond their names and values.
+   *
+   * @remark The read methods have the names and behavior of the `std::map` ones, and the headers
+   * convert to a #Azure::Core::CaseInsensitiveMap.
+   */
+  class HttpHeaders final {
+  public:
+    /**
+     * @brief A header name and value.
+     *
+     */
+    using value_type = std::pair<std::string, std::string>;
+
+    /**
+     * @brief An iterator over the headers, in name order.
+     *
+     */
+    using const_iterator = value_type const*;
+
+    /**
+     * @brief The headers can't be changed through their iterators.
+     *
+     */
+    using iterator = const_iterator;
+
+    /**
+     * @brief The type of the number of headers.
+     *
+     */
+    using size_type = size_t;
+
+    /**
+     * @brief Constructs empty headers.
+     *
+     */
+    HttpHeaders() noexcept : m_data(GetInlineData()) {}
+
+    /**
+     * @brief Constructs a copy of \p other.
+     *
+     */
+    HttpHeaders(HttpHeaders const& other);
+
+    /**
+     * @brief Constructs the headers by moving the headers of \p other.
+     *
+     */
+    HttpHeaders(HttpHeaders&& other) noexcept;
+
+    /**
+     * @brief Replaces the headers with a copy of \p other.
+     *
+     */
+    HttpHeaders& operator=(HttpHeaders const& other);
+
+    /**
+     * @brief Replaces the headers with the headers of \p other.
+     *
+     */
+    HttpHeaders& operator=(HttpHeaders&& other) noexcept;
+
+    /**
+     * @brief Destructs the headers.
+     *
+     */
+    ~HttpHeaders();
+
+    /**
+     * @brief Get an iterator to the first header.
+     *
+     */
+    const_iterator begin() const noexcept { return m_data; }
+
+    /**
+     * @brief Get an iterator past the last header.
+     *
+     */
+    const_iterator end() const noexcept { return m_data + m_size; }
+
+    /**
+     * @brief Get an iterator to the first header.
+     *
+     */
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    /**
+     * @brief Get an iterator past the last header.
+     *
+     */
+    const_iterator cend() const noexcept { return end(); }
+
+    /**
+     * @brief Get the number of headers.
+     *
+     */
+    size_type size() const noexcept { return m_size; }
+
+    /**
+     * @brief Check if there are no headers.
+     *
+     */
+    bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief Find a header by name, ignoring case.
+     *
+     * @param name The header name.
+     * @return An iterator to the header, or #end if there is no header named \p name.
+     */
+    const_iterator find(std::string const& name) const { return Find(name.data(), name.size()); }
+
+    /**
+     * @brief Find a header by name, ignoring case.
+     *
+     * @param name The header name.
+     * @return An iterator to the header, or #end if there is no header named \p name.
+     */
+    const_iterator find(char const* name) const { return Find(name, std::strlen(name)); }
+
+    /**
+     * @brief Count the headers named \p name, ignoring case.
+     *
+     * @return `1` if there is a header named \p name, `0` otherwise.
+     */
+    size_type count(std::string const& name) const { return find(name) != end() ? 1 : 0; }
+
+    /**
+     * @brief Count the headers named \p name, ignoring case.
+     *
+     * @return `1` if there is a header named \p name, `0` otherwise.
+     */
+    size_type count(char const* name) const { return find(name) != end() ? 1 : 0; }
+
+    /**
+     * @brief Get the value of a header, ignoring the case of its name.
+     *
+     * @param name The header name.
+     * @return The header value.
+     * @throw std::out_of_range if there is no header named \p name.
+     */
+    std::string const& at(std::string const& name) const { return At(name.data(), name.size()); }
+
+    /**
+     * @brief Get the value of a header, ignoring the case of its name.
+     *
+     * @param name The header name.
+     * @return The header value.
+     * @throw std::out_of_range if there is no header named \p name.
+     */
+    std::string const& at(char const* name) const { return At(name, std::strlen(name)); }
+
+    /**
+     * @brief Get an iterator to the first header which is not ordered before \p name, ignoring
+     * case.
+     *
+     */
+    const_iterator lower_bound(std::string const& name) const
+    {
+      return LowerBound(name.data(), name.size());
+    }
+
+    /**
+     * @brief Get an iterator to the first header which is ordered after \p name, ignoring case.
+     *
+     */
+    const_iterator upper_bound(std::string const& name) const;
+
+    /**
+     * @brief Set the value of a header, adding the header if there is none named \p name.
+     *
+     * @remark The name of an added header is lowercased.
+     *
+     * @param name The header name.
+     * @param value The header value.
+     */
+    void insert_or_assign(std::string const& name, std::string const& value);
+
+    /**
+     * @brief Remove a header, ignoring the case of its name.
+     *
+     * @return The number of headers removed.
+     */
+    size_type erase(std::string const& name);
+
+    /**
+     * @brief Remove all the headers.
+     *
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Copy the headers to a #Azure::Core::CaseInsensitiveMap.
+     *
+     */
+    operator CaseInsensitiveMap() const { return CaseInsensitiveMap(begin(), end()); }
+
+  private:
+    static constexpr size_type InlineCapacity = 16;
+
+    value_type* m_data;
+    size_type m_size = 0;
+    size_type m_capacity = InlineCapacity;
+    alignas(value_type) unsigned char m_inlineData[InlineCapacity * sizeof(value_type)];
+
+    value_type* GetInlineData() noexcept { return reinterpret_cast<value_type*>(m_inlineData); }
+    bool IsInline() const noexcept
+    {
+      return m_data == reinterpret_cast<value_type const*>(m_inlineData);
+    }
+
+    const_iterator LowerBound(char const* name, size_t length) const;
+    const_iterator Find(char const* name, size_t length) const;
+    std::string const& At(char const* name, size_t length) const;
+    void Reserve(size_type capacity);
+    void Release() noexcept;
+    void MoveFrom(HttpHeaders& other) noexcept;
+  };
+
+}}} // namespace Azure::Core::Http
@@ -20,6 +20,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -38,10 +39,17 @@
  */
 extern std::shared_ptr<Azure::Core::Http::HttpTransport> AzureSdkGetCustomHttpTransport();
 
+namespace Azure { namespace Core { namespace Test {
+  class BearerTokenAuthenticationPolicy_IdlePolicyDestructionDoesNotCancel_Test;
+}}} // namespace Azure::Core::Test
+
 namespace Azure { namespace Core { namespace Http { namespace Policies {
 
   struct TransportOptions;
+  class PolicyLatencyRecorder;
   namespace _detail {
+    class PolicyLatencyTimings;
+
     std::shared_ptr<HttpTransport> GetTransportAdapter(TransportOptions const& transportOptions);
 
     AZ_CORE_DLLEXPORT extern std::set<std::string> const g_defaultAllowedHttpQueryParameters;
@@ -73,6 +81,14 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
      */
     std::shared_ptr<Azure::Core::Tracing::TracerProvider> TracingProvider;
 
+    /**
+     * @brief Records how long the requests of the client spend in each HTTP policy. By default,
+     * the policies are not timed.
+     *
+     * @remark See #Azure::Core::Http::Policies::PolicyLatencyRecorder.
+     */
+    std::shared_ptr<PolicyLatencyRecorder> LatencyRecorder;
+
   private:
     // The friend declaration is needed so that TelemetryPolicy could access CppStandardVersion,
     // and it is not a struct's public field like the ones above to be set non-programmatically.
@@ -331,6 +347,18 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
   class NextHttpPolicy final {
     const size_t m_index;
     const std::vector<std::unique_ptr<HttpPolicy>>& m_policies;
+    // Times the policies when the pipeline measures their latencies.
+    _detail::PolicyLatencyTimings* const m_timings = nullptr;
+
+    friend class _detail::PolicyLatencyTimings;
+
+    explicit NextHttpPolicy(
+        size_t index,
+        const std::vector<std::unique_ptr<HttpPolicy>>& policies,
+        _detail::PolicyLatencyTimings* timings)
+        : m_index(index), m_policies(policies), m_timings(timings)
+    {
+    }
 
   public:
     /**
@@ -589,6 +617,10 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
      *
      */
     class BearerTokenAuthenticationPolicy : public HttpPolicy {
+      // Checks that the background refresh context is left alone when no refresh runs.
+      friend class Azure::Core::Test::
+          BearerTokenAuthenticationPolicy_IdlePolicyDestructionDoesNotCancel_Test;
+
     private:
       std::shared_ptr<const Credentials::TokenCredential> m_credential;
       Credentials::TokenRequestContext m_tokenRequestContext;
@@ -598,21 +630,46 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
       mutable Credentials::TokenRequestContext m_accessTokenContext;
       mutable std::atomic<bool> m_invalidateToken = {false};
 
+      DateTime::duration m_tokenRefreshWindow;
+      mutable std::mutex m_backgroundRefreshMutex;
+      // No new background refresh starts before this time after one failed, so a failing
+      // credential is not called by every request.
+      mutable DateTime m_backgroundRefreshRetryTime;
+      // Passed to the credential by the background refresh and cancelled when the policy is
+      // destroyed during a refresh, so a hung credential doesn't block the destructor.
+      Context m_backgroundRefreshContext;
+      // Declared last: destroying the policy waits for the background refresh, which uses the
+      // members above.
+      mutable std::shared_future<void> m_backgroundRefresh;
+
+      void RefreshTokenInBackground(
+          Credentials::TokenRequestContext const& tokenRequestContext,
+          DateTime const& currentTime) const;
+
     public:
       /**
        * @brief Construct a Bearer Token authentication policy.
        *
        * @param credential An #Azure::Core::TokenCredential to use with this policy.
        * @param tokenRequestContext A context to get the token in.
+       * @param tokenRefreshWindow When longer than the `MinimumExpiration` of
+       * \p tokenRequestContext, a token expiring within this window is refreshed in the
+       * background while requests keep using it. Only requests which find a token expiring within
+       * `MinimumExpiration` wait for a new one. By default, the token is refreshed by the request
+       * which finds it expiring.
        */
       explicit BearerTokenAuthenticationPolicy(
           std::shared_ptr<const Credentials::TokenCredential> credential,
-          Credentials::TokenRequestContext tokenRequestContext)
+          Credentials::TokenRequestContext tokenRequestContext,
+          DateTime::duration tokenRefreshWindow = DateTime::duration::zero())
           : m_credential(std::move(credential)),
-            m_tokenRequestContext(std::move(tokenRequestContext))
+            m_tokenRequestContext(std::move(tokenRequestContext)),
+            m_tokenRefreshWindow(tokenRefreshWindow)
       {
       }
 
+      ~BearerTokenAuthenticationPolicy() override;
+
       std::unique_ptr<HttpPolicy> Clone() const override
       {
         // Can't use std::make_shared here because copy constructor is not public.
@@ -626,7 +683,10 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
 
     protected:
       BearerTokenAuthenticationPolicy(BearerTokenAuthenticationPolicy const& other)
-          : BearerTokenAuthenticationPolicy(other.m_credential, other.m_tokenRequestContext)
+          : BearerTokenAuthenticationPolicy(
+              other.m_credential,
+              other.m_tokenRequestContext,
+              other.m_tokenRefreshWindow)
       {
         std::shared_lock<std::shared_timed_mutex> readLock(other.m_accessTokenMutex);
         m_accessToken = other.m_accessToken;
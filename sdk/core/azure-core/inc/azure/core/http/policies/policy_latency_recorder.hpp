@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Latency histograms of the policies of HTTP pipelines.
+ */
+
+#pragma once
+
+#include "azure/core/context.hpp"
+#include "azure/core/http/http.hpp"
+#include "azure/core/http/policies/policy.hpp"
+#include "azure/core/http/raw_response.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Http { namespace Policies {
+
+  /**
+   * @brief The options of a #Azure::Core::Http::Policies::PolicyLatencyRecorder.
+   *
+   */
+  struct PolicyLatencyRecorderOptions final
+  {
+    /**
+     * @brief Record the latencies of one request out of this many.
+     *
+     * @remark The default, `1`, records every request. Sampling makes the cost of recording
+     * negligible for services sending thousands of requests per second.
+     */
+    uint32_t SamplingInterval = 1;
+  };
+
+  /**
+   * @brief The latencies of the policies of one type.
+   *
+   * @details The latency of a policy for a request is the time spent in the policy itself, not in
+   * the policies after it: the retry delays for the retry policy, or the token acquisition for
+   * the bearer token authentication policy. When a policy sends the request several times, like
+   * the retry policy, its latency covers all the tries.
+   */
+  struct PolicyLatencyHistogram final
+  {
+    /**
+     * @brief The number of buckets of the histogram.
+     *
+     */
+    static constexpr size_t BucketCount = 32;
+
+    /**
+     * @brief The type name of the policies, like
+     * `Azure::Core::Http::Policies::_internal::RetryPolicy`.
+     *
+     * @remark When the SDK is built without RTTI, the policies are named by their position in the
+     * pipeline instead, like `Policy 3`.
+     */
+    std::string PolicyName;
+
+    /**
+     * @brief The number of latencies recorded.
+     *
+     */
+    uint64_t Count = 0;
+
+    /**
+     * @brief The sum of the latencies recorded.
+     *
+     */
+    std::chrono::nanoseconds TotalLatency{0};
+
+    /**
+     * @brief The number of latencies in each bucket.
+     *
+     * @details Bucket `0` counts the latencies shorter than 1 microsecond, and bucket `i` the
+     * latencies from 2^(i-1) up to 2^i microseconds. The last bucket also counts all the longer
+     * latencies.
+     */
+    std::vector<uint64_t> BucketCounts;
+  };
+
+  namespace _detail {
+    class PipelineLatencyRecorder;
+  } // namespace _detail
+
+  /**
+   * @brief Records how long the requests spend in each policy of the HTTP pipelines of the
+   * clients using it.
+   *
+   * @details Set #Azure::Core::Http::Policies::TelemetryOptions::LatencyRecorder to the same
+   * recorder for all the clients to measure, and read the histograms with #GetHistograms. The
+   * clients built with a recorder time the policies of the sampled requests and add the
+   * histograms of all the policies of the same type together.
+   *
+   * @remark When distributed tracing is on, the latencies of each sampled request are also added
+   * to the span of its operation as events named after the policies, with a
+   * `az.policy.latency_us` attribute.
+   *
+   * @remark The recorder can be used and read from any thread.
+   */
+  class PolicyLatencyRecorder final {
+  public:
+    /**
+     * @brief Constructs a recorder with no latencies.
+     *
+     * @param options The options of the recorder.
+     */
+    explicit PolicyLatencyRecorder(
+        PolicyLatencyRecorderOptions const& options = PolicyLatencyRecorderOptions());
+
+    /**
+     * @brief Destructs the recorder.
+     *
+     */
+    ~PolicyLatencyRecorder();
+
+    /**
+     * @brief Get the histograms of the policies, in the order the policies were first seen.
+     *
+     */
+    std::vector<PolicyLatencyHistogram> GetHistograms() const;
+
+    /**
+     * @brief Clear the latencies recorded so far.
+     *
+     */
+    void Reset();
+
+  private:
+    struct Histogram;
+
+    friend class _detail::PipelineLatencyRecorder;
+
+    PolicyLatencyRecorderOptions const m_options;
+    std::atomic<uint64_t> m_requestCount{0};
+    mutable std::mutex m_histogramsMutex;
+    // The histograms never move, so that the pipelines can keep pointers to them.
+    std::vector<std::unique_ptr<Histogram>> m_histograms;
+
+    PolicyLatencyRecorder(PolicyLatencyRecorder const&) = delete;
+    PolicyLatencyRecorder& operator=(PolicyLatencyRecorder const&) = delete;
+
+    Histogram* GetHistogram(std::string const& policyName);
+    bool IsSampled();
+  };
+
+  namespace _detail {
+    /**
+     * @brief The time a request spends in each policy of a pipeline and the policies after it.
+     *
+     */
+    class PolicyLatencyTimings final {
+      struct PolicyTiming
+      {
+        std::chrono::steady_clock::duration Duration{0};
+        bool IsCalled = false;
+      };
+
+      std::vector<std::unique_ptr<HttpPolicy>> const& m_policies;
+      std::vector<PolicyTiming> m_timings;
+
+      friend class PipelineLatencyRecorder;
+
+    public:
+      /**
+       * @brief Constructs the timings of a request going through \p policies.
+       *
+       */
+      explicit PolicyLatencyTimings(std::vector<std::unique_ptr<HttpPolicy>> const& policies)
+          : m_policies(policies), m_timings(policies.size())
+      {
+      }
+
+      /**
+       * @brief Send \p request through the policies from \p index on, timing them.
+       *
+       */
+      std::unique_ptr<RawResponse> Send(size_t index, Request& request, Context const& context);
+    };
+
+    /**
+     * @brief Times the policies of one HTTP pipeline with a
+     * #Azure::Core::Http::Policies::PolicyLatencyRecorder.
+     *
+     */
+    class PipelineLatencyRecorder final {
+      std::shared_ptr<PolicyLatencyRecorder> m_recorder;
+      std::vector<PolicyLatencyRecorder::Histogram*> m_histograms;
+
+      void Record(PolicyLatencyTimings const& timings, Context const& context) const;
+
+    public:
+      /**
+       * @brief Constructs a recorder for the \p policies of a pipeline.
+       *
+       */
+      explicit PipelineLatencyRecorder(
+          std::shared_ptr<PolicyLatencyRecorder> recorder,
+          std::vector<std::unique_ptr<HttpPolicy>> const& policies);
+
+      /**
+       * @brief Send \p request through the \p policies, timing them if the request is sampled.
+       *
+       */
+      std::unique_ptr<RawResponse> Send(
+          std::vector<std::unique_ptr<HttpPolicy>> const& policies,
+          Request& request,
+          Context const& context) const;
+    };
+  } // namespace _detail
+
+}}}} // namespace Azure::Core::Http::Policies
@@ -8,15 +8,93 @@
 
 #pragma once
 
-#include "azure/core/case_insensitive_containers.hpp"
+#include "azure/core/http/http_headers.hpp"
 #include "azure/core/http/http_status_code.hpp"
 #include "azure/core/io/body_stream.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace Azure { namespace Core { namespace Http {
+  /**
+   * @brief Where the time of an HTTP request went inside the HTTP transport, and how the
+   * transport used the network socket for it.
+   *
+   * @remark The transport keeps updating the body fields while the response body stream is read.
+   */
+  struct TransportMetrics final
+  {
+    /**
+     * @brief `true` when the request was sent over a connection taken from the connection pool.
+     * The connection setup times are 0 in that case.
+     *
+     */
+    bool ConnectionReused = false;
+
+    /**
+     * @brief Time to resolve the host name of a new connection.
+     *
+     */
+    std::chrono::microseconds NameLookupTime{0};
+
+    /**
+     * @brief Time to connect the socket of a new connection, after the host name was resolved.
+     *
+     */
+    std::chrono::microseconds ConnectTime{0};
+
+    /**
+     * @brief Time of the TLS handshake of a new connection.
+     *
+     */
+    std::chrono::microseconds TlsHandshakeTime{0};
+
+    /**
+     * @brief Time to send the request headers and body.
+     *
+     */
+    std::chrono::microseconds SendTime{0};
+
+    /**
+     * @brief Time from the end of the request upload to the first byte of the response.
+     *
+     */
+    std::chrono::microseconds TimeToFirstByte{0};
+
+    /**
+     * @brief Time spent reading the response body.
+     *
+     */
+    std::chrono::microseconds BodyReadTime{0};
+
+    /**
+     * @brief Number of bytes written to the socket.
+     *
+     */
+    int64_t BytesSent = 0;
+
+    /**
+     * @brief Number of bytes read from the socket, including the response headers.
+     *
+     */
+    int64_t BytesReceived = 0;
+
+    /**
+     * @brief Number of reads from the socket.
+     *
+     */
+    int64_t SocketReads = 0;
+
+    /**
+     * @brief Number of times the transport waited for the socket to be ready to read or write.
+     *
+     */
+    int64_t SocketWaits = 0;
+  };
+
   /**
    * @brief After receiving and interpreting a request message, a server responds with an HTTP
    * response message.
@@ -28,10 +106,11 @@ namespace Azure { namespace Core { namespace Http {
     int32_t m_minorVersion;
     HttpStatusCode m_statusCode;
     std::string m_reasonPhrase;
-    CaseInsensitiveMap m_headers;
+    HttpHeaders m_headers;
 
     std::unique_ptr<Azure::Core::IO::BodyStream> m_bodyStream;
     std::vector<uint8_t> m_body;
+    std::shared_ptr<TransportMetrics const> m_transportMetrics;
 
     explicit RawResponse(
         int32_t majorVersion,
@@ -79,6 +158,7 @@ namespace Azure { namespace Core { namespace Http {
       AZURE_ASSERT(m_bodyStream == nullptr);
       // Copy body
       m_body = response.GetBody();
+      m_transportMetrics = response.m_transportMetrics;
     }
 
     /**
@@ -135,6 +215,17 @@ namespace Azure { namespace Core { namespace Http {
      */
     void SetBody(std::vector<uint8_t> body) { this->m_body = std::move(body); }
 
+    /**
+     * @brief Set the metrics measured by the HTTP transport for this HTTP response.
+     *
+     * @param metrics The metrics, which the transport can keep updating while the body stream is
+     * read.
+     */
+    void SetTransportMetrics(std::shared_ptr<TransportMetrics const> metrics)
+    {
+      this->m_transportMetrics = std::move(metrics);
+    }
+
     // adding getters for version and stream body. Clang will complain on macOS if we have unused
     // fields in a class
 
@@ -166,7 +257,7 @@ namespace Azure { namespace Core { namespace Http {
      * @brief Get HTTP response headers.
      *
      */
-    CaseInsensitiveMap const& GetHeaders() const;
+    HttpHeaders const& GetHeaders() const;
 
     /**
      * @brief Get HTTP response body as #Azure::Core::IO::BodyStream.
@@ -189,5 +280,15 @@ namespace Azure { namespace Core { namespace Http {
      *
      */
     std::vector<uint8_t> const& GetBody() const { return this->m_body; }
+
+    /**
+     * @brief Get the metrics measured by the HTTP transport for this HTTP response.
+     *
+     * @return The metrics, or `nullptr` if the HTTP transport does not measure them.
+     */
+    std::shared_ptr<TransportMetrics const> const& GetTransportMetrics() const
+    {
+      return this->m_transportMetrics;
+    }
   };
 }}} // namespace Azure::Core::Http
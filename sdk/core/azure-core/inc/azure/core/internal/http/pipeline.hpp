@@ -12,6 +12,7 @@
 #include "azure/core/context.hpp"
 #include "azure/core/http/http.hpp"
 #include "azure/core/http/policies/policy.hpp"
+#include "azure/core/http/policies/policy_latency_recorder.hpp"
 #include "azure/core/http/transport.hpp"
 #include "azure/core/internal/client_options.hpp"
 #include "azure/core/internal/http/http_sanitizer.hpp"
@@ -28,11 +29,19 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
    * individual HTTP policies. Policies shape the behavior of how a HTTP request is being handled,
    * ranging from retrying and logging, up to sending a HTTP request over the wire.
    *
+   * @remark The policies of a pipeline don't change after its construction, and the copies of a
+   * pipeline share its policies, so that the clients derived from a client, like the blob clients
+   * of a container client, can copy its pipeline for the cost of a reference count.
+   *
    * @remark See #policy.hpp
    */
   class HttpPipeline final {
-  protected:
-    std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> m_policies;
+    using Policies = std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>>;
+
+    std::shared_ptr<Policies const> m_policies;
+    // Set when the policies are timed, see Azure::Core::Http::Policies::PolicyLatencyRecorder.
+    std::shared_ptr<Azure::Core::Http::Policies::_detail::PipelineLatencyRecorder const>
+        m_latencyRecorder;
 
   public:
     /**
@@ -40,22 +49,36 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
      *
      * @param policies A sequence of #Azure::Core::Http::Policies::HttpPolicy
      * representing a stack, first element corresponding to the top of the stack.
+     * @param latencyRecorder The recorder timing the policies, usually
+     * #Azure::Core::Http::Policies::TelemetryOptions::LatencyRecorder of the client options.
+     * `nullptr` to not time them.
      *
      * @throw `std::invalid_argument` when policies is empty.
      */
     explicit HttpPipeline(
-        const std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>>& policies)
+        const std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>>& policies,
+        std::shared_ptr<Azure::Core::Http::Policies::PolicyLatencyRecorder> const&
+            latencyRecorder
+        = nullptr)
     {
       if (policies.empty())
       {
         throw std::invalid_argument("policies cannot be empty");
       }
 
-      m_policies.reserve(policies.size());
+      auto clonedPolicies = std::make_shared<Policies>();
+      clonedPolicies->reserve(policies.size());
       for (auto& policy : policies)
       {
-        m_policies.emplace_back(policy->Clone());
+        clonedPolicies->emplace_back(policy->Clone());
       }
+      if (latencyRecorder)
+      {
+        m_latencyRecorder
+            = std::make_shared<Azure::Core::Http::Policies::_detail::PipelineLatencyRecorder>(
+                latencyRecorder, *clonedPolicies);
+      }
+      m_policies = std::move(clonedPolicies);
     }
 
     /**
@@ -97,57 +120,66 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
       auto pipelineSize = perCallClientPolicies.size() + perRetryClientPolicies.size()
           + perRetryPolicies.size() + perCallPolicies.size() + 6;
 
-      m_policies.reserve(pipelineSize);
+      auto policies = std::make_shared<Policies>();
+      policies->reserve(pipelineSize);
 
       // service-specific per call policies
       for (auto& policy : perCallPolicies)
       {
-        m_policies.emplace_back(policy->Clone());
+        policies->emplace_back(policy->Clone());
       }
 
       // Request Id
-      m_policies.emplace_back(
+      policies->emplace_back(
           std::make_unique<Azure::Core::Http::Policies::_internal::RequestIdPolicy>());
 
       // Telemetry (user-agent header)
-      m_policies.emplace_back(
+      policies->emplace_back(
           std::make_unique<Azure::Core::Http::Policies::_internal::TelemetryPolicy>(
               telemetryPackageName, telemetryPackageVersion, clientOptions.Telemetry));
 
       // client-options per call policies.
       for (auto& policy : perCallClientPolicies)
       {
-        m_policies.emplace_back(policy->Clone());
+        policies->emplace_back(policy->Clone());
       }
 
       // Retry policy
-      m_policies.emplace_back(std::make_unique<Azure::Core::Http::Policies::_internal::RetryPolicy>(
+      policies->emplace_back(std::make_unique<Azure::Core::Http::Policies::_internal::RetryPolicy>(
           clientOptions.Retry));
 
       // service-specific per retry policies.
       for (auto& policy : perRetryPolicies)
       {
-        m_policies.emplace_back(policy->Clone());
+        policies->emplace_back(policy->Clone());
       }
       // client options per retry policies.
       for (auto& policy : perRetryClientPolicies)
       {
-        m_policies.emplace_back(policy->Clone());
+        policies->emplace_back(policy->Clone());
       }
 
       // Add a request activity policy which will generate distributed traces for the pipeline.
-      m_policies.emplace_back(
+      policies->emplace_back(
           std::make_unique<Azure::Core::Http::Policies::_internal::RequestActivityPolicy>(
               httpSanitizer));
 
       // logging - won't update request
-      m_policies.emplace_back(
+      policies->emplace_back(
           std::make_unique<Azure::Core::Http::Policies::_internal::LogPolicy>(clientOptions.Log));
 
       // transport
-      m_policies.emplace_back(
+      policies->emplace_back(
           std::make_unique<Azure::Core::Http::Policies::_internal::TransportPolicy>(
               clientOptions.Transport));
+
+      if (clientOptions.Telemetry.LatencyRecorder)
+      {
+        m_latencyRecorder
+            = std::make_shared<Azure::Core::Http::Policies::_detail::PipelineLatencyRecorder>(
+                clientOptions.Telemetry.LatencyRecorder, *policies);
+      }
+      m_policies = std::move(policies);
     }
 
     /**
@@ -183,35 +215,40 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
      *
      * @param policies A sequence of #Azure::Core::Http::Policies::HttpPolicy
      * representing a stack, first element corresponding to the top of the stack.
+     * @param latencyRecorder The recorder timing the policies, usually
+     * #Azure::Core::Http::Policies::TelemetryOptions::LatencyRecorder of the client options.
+     * `nullptr` to not time them.
      *
      * @throw `std::invalid_argument` when policies is empty.
      */
     explicit HttpPipeline(
-        std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>>&& policies)
-        : m_policies(std::move(policies))
+        std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>>&& policies,
+        std::shared_ptr<Azure::Core::Http::Policies::PolicyLatencyRecorder> const&
+            latencyRecorder
+        = nullptr)
     {
-      if (m_policies.empty())
+      if (policies.empty())
       {
         throw std::invalid_argument("policies cannot be empty");
       }
+      m_policies = std::make_shared<Policies>(std::move(policies));
+      if (latencyRecorder)
+      {
+        m_latencyRecorder
+            = std::make_shared<Azure::Core::Http::Policies::_detail::PipelineLatencyRecorder>(
+                latencyRecorder, *m_policies);
+      }
     }
 
     /**
      * @brief Copy constructor.
      *
-     * @remark \p other is expected to have at least one policy.
+     * @remark The copy shares the policies of \p other.
      *
      * @param other Another instance of #Azure::Core::Http::_internal::HttpPipeline to create a copy
      * of.
      */
-    HttpPipeline(const HttpPipeline& other)
-    {
-      m_policies.reserve(other.m_policies.size());
-      for (auto& policy : other.m_policies)
-      {
-        m_policies.emplace_back(policy->Clone());
-      }
-    }
+    HttpPipeline(const HttpPipeline& other) = default;
 
     /**
      * @brief Start the HTTP pipeline.
@@ -225,10 +262,15 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
         Azure::Core::Http::Request& request,
         Context const& context) const
     {
+      if (m_latencyRecorder)
+      {
+        return m_latencyRecorder->Send(*m_policies, request, context);
+      }
+
       // Accessing position zero is fine because pipeline must be constructed with at least one
       // policy.
-      return m_policies[0]->Send(
-          request, Azure::Core::Http::Policies::NextHttpPolicy(0, m_policies), context);
+      return (*m_policies)[0]->Send(
+          request, Azure::Core::Http::Policies::NextHttpPolicy(0, *m_policies), context);
     }
   };
 }}}} // namespace Azure::Core::Http::_internal
@@ -10,6 +10,10 @@
 
 #pragma once
 
+namespace Azure { namespace Core { namespace Http { namespace Policies { namespace _detail {
+  class PipelineLatencyRecorder;
+}}}}} // namespace Azure::Core::Http::Policies::_detail
+
 /**
  *
  * @brief Helper classes to enable service client distributed tracing implementations.
@@ -187,6 +191,9 @@ namespace Azure { namespace Core { namespace Tracing { namespace _internal {
     static Azure::Core::Context::Key ContextSpanKey;
     static Azure::Core::Context::Key TracingFactoryContextKey;
 
+    // Adds the latencies of the policies to the span of the request operation.
+    friend class Azure::Core::Http::Policies::_detail::PipelineLatencyRecorder;
+
   public:
     /**
      * @brief Construct a new Tracing Context Factory object
@@ -332,6 +339,20 @@ namespace Azure { namespace Core { namespace Tracing { namespace _internal {
      */
     AZ_CORE_DLLEXPORT const static TracingAttributes ServiceRequestId;
 
+    /** @brief Time in milliseconds the HTTP transport took to open a new connection for the
+     * request, including the name lookup and the TLS handshake. 0 for a reused connection.
+     *
+     * @remarks Azure Specific attribute.
+     */
+    AZ_CORE_DLLEXPORT const static TracingAttributes TransportConnectTime;
+
+    /** @brief Time in milliseconds from the end of the request upload to the first byte of the
+     * response.
+     *
+     * @remarks Azure Specific attribute.
+     */
+    AZ_CORE_DLLEXPORT const static TracingAttributes TransportTimeToFirstByte;
+
     /**
      * @brief HTTP request method.
      *
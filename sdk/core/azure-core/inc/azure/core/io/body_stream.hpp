@@ -44,6 +44,30 @@ namespace Azure { namespace Core { namespace IO {
      */
     virtual size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const& context) = 0;
 
+    /**
+     * @brief Read portion of data without copying it.
+     *
+     * @remark Derived classes keeping their data in memory can override this to give access to
+     * it. The default implementation sets \p data to `nullptr` and reads nothing.
+     *
+     * @param data Set to the first byte read, or to `nullptr` if the stream can't be read in
+     * place.
+     * @param count Maximum number of bytes to read.
+     * @param context A context to control the request lifetime.
+     *
+     * @return Number of bytes read.
+     */
+    virtual size_t OnReadInPlace(
+        uint8_t const*& data,
+        size_t count,
+        Azure::Core::Context const& context)
+    {
+      (void)count;
+      (void)context;
+      data = nullptr;
+      return 0;
+    }
+
   public:
     /**
      * @brief Destructs `%BodyStream`.
@@ -91,6 +115,27 @@ namespace Azure { namespace Core { namespace IO {
       return OnRead(buffer, count, context);
     }
 
+    /**
+     * @brief Read portion of data without copying it, when the stream keeps its data in memory.
+     * @remark Throws if error/cancelled.
+     *
+     * @param data Set to the first byte read, or to `nullptr` if the stream can't be read in
+     * place. In that case nothing is read and #Azure::Core::IO::BodyStream::Read must be used.
+     * @param count Maximum number of bytes to read.
+     * @param context A context to control the request lifetime.
+     *
+     * @return Number of bytes read. The bytes remain valid as long as the memory the stream reads
+     * from.
+     */
+    size_t ReadInPlace(
+        uint8_t const*& data,
+        size_t count,
+        Azure::Core::Context const& context = Azure::Core::Context())
+    {
+      context.ThrowIfCancelled();
+      return OnReadInPlace(data, count, context);
+    }
+
     /**
      * @brief Read #Azure::Core::IO::BodyStream into a buffer until the buffer is filled, or until
      * the stream is read to end.
@@ -127,6 +172,10 @@ namespace Azure { namespace Core { namespace IO {
     size_t m_offset = 0;
 
     size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const& context) override;
+    size_t OnReadInPlace(
+        uint8_t const*& data,
+        size_t count,
+        Azure::Core::Context const& context) override;
 
   public:
     // Forbid constructor for rval so we don't end up storing dangling ptr
@@ -296,6 +345,10 @@ namespace Azure { namespace Core { namespace IO {
 
   private:
     size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const& context) override;
+    size_t OnReadInPlace(
+        uint8_t const*& data,
+        size_t count,
+        Azure::Core::Context const& context) override;
 
   public:
     /**
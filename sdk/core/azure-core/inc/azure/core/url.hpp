@@ -37,6 +37,10 @@ namespace Azure { namespace Core {
     }
   } // namespace _detail
 
+  namespace _internal {
+    struct UrlHelpers;
+  } // namespace _internal
+
   /**
    * @brief Represents the location where a request will be performed.
    *
@@ -44,6 +48,8 @@ namespace Azure { namespace Core {
    * (scheme, host, path, etc.). Authority is not currently supported.
    */
   class Url final {
+    friend struct _internal::UrlHelpers;
+
   private:
     std::string m_scheme;
     std::string m_host;
@@ -240,4 +246,26 @@ namespace Azure { namespace Core {
      */
     std::string GetAbsoluteUrl() const;
   };
+
+  namespace _internal {
+    /**
+     * @brief Gives access to the query parameters of a URL without the copy made by
+     * #Azure::Core::Url::GetQueryParameters.
+     */
+    struct UrlHelpers final
+    {
+      /**
+       * @brief Get the URL-encoded query parameters of \p url.
+       *
+       */
+      static std::map<std::string, std::string> const& GetEncodedQueryParameters(Url const& url)
+      {
+        return url.m_encodedQueryParameters;
+      }
+
+    private:
+      UrlHelpers() = delete;
+      ~UrlHelpers() = delete;
+    };
+  } // namespace _internal
 }} // namespace Azure::Core
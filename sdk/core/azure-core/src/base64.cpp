@@ -3,9 +3,25 @@
 
 #include "azure/core/base64.hpp"
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#if defined(__x86_64__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+#define _azure_BASE64_X64_KERNELS
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// The kernels are compiled for the instruction sets they use and only called when the CPU
+// supports them.
+#if defined(__GNUC__) || defined(__clang__)
+#define _azure_BASE64_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#else
+#define _azure_BASE64_TARGET(instructionSet)
+#endif
+#endif
+
 namespace {
 
 char const Base64EncodeArray[65]
@@ -312,15 +328,373 @@ void Base64WriteIntAsFourBytes(char* destination, int32_t value)
   destination[0] = static_cast<uint8_t>(value & 0xFF);
 }
 
-std::string Base64Encode(uint8_t const* const data, size_t length)
+#if defined(_azure_BASE64_X64_KERNELS)
+// The x64 kernels implement "Faster Base64 Encoding and Decoding Using AVX2 Instructions" by
+// Wojciech Muła and Daniel Lemire, which encode 12 bytes (or decode 16 characters) per SSSE3
+// instruction sequence and twice as many with AVX2.
+enum class Base64Kernels
+{
+  Scalar,
+  Ssse3,
+  Avx2,
+};
+
+#if defined(_MSC_VER)
+_azure_BASE64_TARGET("xsave") Base64Kernels DetectBase64Kernels()
+{
+  int info[4];
+  __cpuid(info, 0);
+  auto const maxLeaf = info[0];
+  __cpuid(info, 1);
+  if ((info[2] & (1 << 9)) == 0)
+  {
+    return Base64Kernels::Scalar;
+  }
+  // AVX2 also needs the OS to save the YMM registers.
+  bool const osSavesYmm
+      = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+  if (osSavesYmm && maxLeaf >= 7)
+  {
+    __cpuidex(info, 7, 0);
+    if ((info[1] & (1 << 5)) != 0)
+    {
+      return Base64Kernels::Avx2;
+    }
+  }
+  return Base64Kernels::Ssse3;
+}
+#else
+Base64Kernels DetectBase64Kernels()
+{
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return Base64Kernels::Avx2;
+  }
+  if (__builtin_cpu_supports("ssse3"))
+  {
+    return Base64Kernels::Ssse3;
+  }
+  return Base64Kernels::Scalar;
+}
+#endif
+
+Base64Kernels GetBase64Kernels()
+{
+  static Base64Kernels const kernels = DetectBase64Kernels();
+  return kernels;
+}
+
+// Gets the 6 bit groups of 12 bytes, spread over the 16 bytes of the result.
+_azure_BASE64_TARGET("ssse3") inline __m128i Base64EncodeSplitSsse3(__m128i const input)
+{
+  __m128i const in = _mm_shuffle_epi8(
+      input, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  __m128i const t0 = _mm_mulhi_epu16(
+      _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+  __m128i const t1 = _mm_mullo_epi16(
+      _mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t0, t1);
+}
+
+// Maps each 6 bit group to its character by adding the offset of the range it belongs to.
+_azure_BASE64_TARGET("ssse3") inline __m128i Base64EncodeLookupSsse3(__m128i const indices)
+{
+  // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12.
+  __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  ranges = _mm_or_si128(
+      ranges,
+      _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+  __m128i const offsets = _mm_setr_epi8(
+      'a' - 26,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '+' - 62,
+      '/' - 63,
+      'A',
+      0,
+      0);
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), indices);
+}
+
+// Encodes blocks of 12 bytes while 16 bytes can be loaded, returns the number of bytes encoded.
+_azure_BASE64_TARGET("ssse3")
+size_t Base64EncodeSsse3(uint8_t const* data, size_t length, char* destination)
+{
+  size_t sourceIndex = 0;
+  for (; sourceIndex + 16 <= length; sourceIndex += 12, destination += 16)
+  {
+    __m128i const input = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + sourceIndex));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(destination),
+        Base64EncodeLookupSsse3(Base64EncodeSplitSsse3(input)));
+  }
+  return sourceIndex;
+}
+
+_azure_BASE64_TARGET("avx2")
+size_t Base64EncodeAvx2(uint8_t const* data, size_t length, char* destination)
+{
+  __m256i const split = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  __m256i const offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      'a' - 26,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '0' - 52,
+      '+' - 62,
+      '/' - 63,
+      'A',
+      0,
+      0));
+
+  size_t sourceIndex = 0;
+  // Each half of the register encodes 12 bytes, the upper half reads up to 12 bytes further.
+  for (; sourceIndex + 28 <= length; sourceIndex += 24, destination += 32)
+  {
+    __m256i const input = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + sourceIndex))),
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + sourceIndex + 12)),
+        1);
+    __m256i const in = _mm256_shuffle_epi8(input, split);
+    __m256i const indices = _mm256_or_si256(
+        _mm256_mulhi_epu16(
+            _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040)),
+        _mm256_mullo_epi16(
+            _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+            _mm256_set1_epi32(0x01000010)));
+    __m256i ranges = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    ranges = _mm256_or_si256(
+        ranges,
+        _mm256_and_si256(
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(destination),
+        _mm256_add_epi8(_mm256_shuffle_epi8(offsets, ranges), indices));
+  }
+  return sourceIndex + Base64EncodeSsse3(data + sourceIndex, length - sourceIndex, destination);
+}
+
+// Checks 16 characters are in the Base64 alphabet and converts them to their 6 bit values.
+_azure_BASE64_TARGET("ssse3")
+inline bool Base64DecodeLookupSsse3(__m128i const input, __m128i& values)
+{
+  __m128i const higherNibbles = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0f));
+  __m128i const lowerNibbles = _mm_and_si128(input, _mm_set1_epi8(0x0f));
+  // A character is valid when the bit of its higher nibble is set in the mask of its lower nibble.
+  __m128i const masks = _mm_shuffle_epi8(
+      _mm_setr_epi8(
+          static_cast<char>(0xa8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf8),
+          static_cast<char>(0xf0),
+          0x54,
+          0x50,
+          0x50,
+          0x50,
+          0x54),
+      lowerNibbles);
+  __m128i const bits = _mm_shuffle_epi8(
+      _mm_setr_epi8(
+          0x01,
+          0x02,
+          0x04,
+          0x08,
+          0x10,
+          0x20,
+          0x40,
+          static_cast<char>(0x80),
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0,
+          0),
+      higherNibbles);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(masks, bits), _mm_setzero_si128())) != 0)
+  {
+    return false;
+  }
+  // The offset to the value depends on the higher nibble, except for '/' which shares it with '+'.
+  __m128i const offsets = _mm_add_epi8(
+      _mm_shuffle_epi8(
+          _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0), higherNibbles),
+      _mm_and_si128(_mm_cmpeq_epi8(input, _mm_set1_epi8('/')), _mm_set1_epi8(-3)));
+  values = _mm_add_epi8(input, offsets);
+  return true;
+}
+
+// Decodes blocks of 16 characters while they are followed by the last 4 characters, which may be
+// padded, and 16 bytes can be written. Stops before a block with a character not in the Base64
+// alphabet. Returns the number of characters decoded.
+_azure_BASE64_TARGET("ssse3")
+size_t Base64DecodeSsse3(
+    char const* text,
+    size_t length,
+    uint8_t* destination,
+    size_t destinationSize)
+{
+  size_t sourceIndex = 0;
+  for (; sourceIndex + 16 < length && destinationSize >= 16;
+       sourceIndex += 16, destination += 12, destinationSize -= 12)
+  {
+    __m128i values;
+    if (!Base64DecodeLookupSsse3(
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(text + sourceIndex)), values))
+    {
+      break;
+    }
+    // Merge 4 values of 6 bits into 3 bytes, then put the 12 bytes first in big-endian order.
+    __m128i const merged = _mm_madd_epi16(
+        _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(destination),
+        _mm_shuffle_epi8(
+            merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+  }
+  return sourceIndex;
+}
+
+_azure_BASE64_TARGET("avx2")
+size_t Base64DecodeAvx2(
+    char const* text,
+    size_t length,
+    uint8_t* destination,
+    size_t destinationSize)
+{
+  __m256i const masks = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      static_cast<char>(0xa8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf8),
+      static_cast<char>(0xf0),
+      0x54,
+      0x50,
+      0x50,
+      0x50,
+      0x54));
+  __m256i const bits = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0));
+  __m256i const offsets = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+  __m256i const pack = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  size_t sourceIndex = 0;
+  // Each half of the register decodes to 12 bytes, the upper half is written 12 bytes further.
+  for (; sourceIndex + 32 < length && destinationSize >= 28;
+       sourceIndex += 32, destination += 24, destinationSize -= 24)
+  {
+    __m256i const input
+        = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(text + sourceIndex));
+    __m256i const higherNibbles
+        = _mm256_and_si256(_mm256_srli_epi32(input, 4), _mm256_set1_epi8(0x0f));
+    __m256i const lowerNibbles = _mm256_and_si256(input, _mm256_set1_epi8(0x0f));
+    __m256i const valid = _mm256_and_si256(
+        _mm256_shuffle_epi8(masks, lowerNibbles), _mm256_shuffle_epi8(bits, higherNibbles));
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(valid, _mm256_setzero_si256())) != 0)
+    {
+      break;
+    }
+    __m256i const values = _mm256_add_epi8(
+        input,
+        _mm256_add_epi8(
+            _mm256_shuffle_epi8(offsets, higherNibbles),
+            _mm256_and_si256(
+                _mm256_cmpeq_epi8(input, _mm256_set1_epi8('/')), _mm256_set1_epi8(-3))));
+    __m256i const merged = _mm256_shuffle_epi8(
+        _mm256_madd_epi16(
+            _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+            _mm256_set1_epi32(0x00011000)),
+        pack);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm256_castsi256_si128(merged));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(destination + 12), _mm256_extracti128_si256(merged, 1));
+  }
+  return sourceIndex
+      + Base64DecodeSsse3(
+             text + sourceIndex, length - sourceIndex, destination, destinationSize);
+}
+#endif
+
+size_t Base64EncodedSize(size_t dataSize) { return ((dataSize + 2) / 3) * 4; }
+
+size_t Base64DecodedSize(char const* text, size_t textSize)
+{
+  if (textSize % 4 != 0)
+  {
+    throw std::runtime_error("Unexpected end of Base64 encoded string.");
+  }
+
+  // An empty input should result in an empty output.
+  if (textSize == 0)
+  {
+    return 0;
+  }
+
+  auto decodedSize = (textSize / 4) * 3;
+  if (text[textSize - 2] == EncodingPad)
+  {
+    decodedSize -= 2;
+  }
+  else if (text[textSize - 1] == EncodingPad)
+  {
+    decodedSize -= 1;
+  }
+  return decodedSize;
+}
+
+// Writes Base64EncodedSize(length) characters to destination.
+void Base64Encode(uint8_t const* const data, size_t length, char* destination)
 {
   size_t sourceIndex = 0;
   auto inputSize = length;
-  auto maxEncodedSize = ((inputSize + 2) / 3) * 4;
-  // Use a string with size to the max possible result
-  std::string encodedResult(maxEncodedSize, '0');
-  // Removing const from the string to update the placeholder string
-  auto destination = const_cast<char*>(encodedResult.data());
+
+#if defined(_azure_BASE64_X64_KERNELS)
+  switch (GetBase64Kernels())
+  {
+    case Base64Kernels::Avx2:
+      sourceIndex = Base64EncodeAvx2(data, inputSize, destination);
+      break;
+    case Base64Kernels::Ssse3:
+      sourceIndex = Base64EncodeSsse3(data, inputSize, destination);
+      break;
+    case Base64Kernels::Scalar:
+      break;
+  }
+  destination += (sourceIndex / 3) * 4;
+#endif
 
   while (sourceIndex + 3 <= inputSize)
   {
@@ -340,7 +714,14 @@ std::string Base64Encode(uint8_t const* const data, size_t length)
     int32_t result = Base64EncodeAndPadOne(&data[sourceIndex]);
     Base64WriteIntAsFourBytes(destination, result);
   }
+}
 
+std::string Base64Encode(uint8_t const* const data, size_t length)
+{
+  // Use a string with size to the max possible result
+  std::string encodedResult(Base64EncodedSize(length), '0');
+  // Removing const from the string to update the placeholder string
+  Base64Encode(data, length, const_cast<char*>(encodedResult.data()));
   return encodedResult;
 }
 
@@ -379,42 +760,43 @@ int32_t Base64Decode(const char* encodedBytes)
   return i0;
 }
 
-void Base64WriteThreeLowOrderBytes(std::vector<uint8_t>::iterator destination, int64_t value)
+void Base64WriteThreeLowOrderBytes(uint8_t* destination, int64_t value)
 {
   destination[0] = static_cast<uint8_t>(value >> 16);
   destination[1] = static_cast<uint8_t>(value >> 8);
   destination[2] = static_cast<uint8_t>(value);
 }
 
-std::vector<uint8_t> Base64Decode(const std::string& text)
+// Writes decodedSize bytes, as returned by Base64DecodedSize(), to destinationPtr.
+void Base64Decode(
+    char const* inputPtr,
+    size_t inputSize,
+    uint8_t* destinationPtr,
+    size_t decodedSize)
 {
-  auto inputSize = text.size();
-  if (inputSize % 4 != 0)
-  {
-    throw std::runtime_error("Unexpected end of Base64 encoded string.");
-  }
-
-  // An empty input should result in an empty output.
   if (inputSize == 0)
   {
-    return std::vector<uint8_t>();
+    return;
   }
 
   size_t sourceIndex = 0;
-  auto inputPtr = text.data();
-  auto decodedSize = (inputSize / 4) * 3;
 
-  if (inputPtr[inputSize - 2] == EncodingPad)
+#if defined(_azure_BASE64_X64_KERNELS)
+  switch (GetBase64Kernels())
   {
-    decodedSize -= 2;
+    case Base64Kernels::Avx2:
+      sourceIndex = Base64DecodeAvx2(inputPtr, inputSize, destinationPtr, decodedSize);
+      break;
+    case Base64Kernels::Ssse3:
+      sourceIndex = Base64DecodeSsse3(inputPtr, inputSize, destinationPtr, decodedSize);
+      break;
+    case Base64Kernels::Scalar:
+      break;
   }
-  else if (inputPtr[inputSize - 1] == EncodingPad)
-  {
-    decodedSize -= 1;
-  }
-
-  std::vector<uint8_t> destination(decodedSize);
-  auto destinationPtr = destination.begin();
+  destinationPtr += (sourceIndex / 4) * 3;
+#else
+  static_cast<void>(decodedSize);
+#endif
 
   while (sourceIndex + 4 < inputSize)
   {
@@ -491,7 +873,12 @@ std::vector<uint8_t> Base64Decode(const std::string& text)
   {
     destinationPtr[0] = static_cast<uint8_t>(i0 >> 16);
   }
+}
 
+std::vector<uint8_t> Base64Decode(const std::string& text)
+{
+  std::vector<uint8_t> destination(Base64DecodedSize(text.data(), text.size()));
+  Base64Decode(text.data(), text.size(), destination.data(), destination.size());
   return destination;
 }
 
@@ -508,6 +895,44 @@ namespace Azure { namespace Core {
   {
     return ::Base64Decode(text);
   }
+
+  size_t Convert::GetBase64EncodedSize(size_t dataSize) { return ::Base64EncodedSize(dataSize); }
+
+  size_t Convert::GetBase64DecodedSize(char const* text, size_t textSize)
+  {
+    return ::Base64DecodedSize(text, textSize);
+  }
+
+  size_t Convert::Base64Encode(
+      uint8_t const* data,
+      size_t dataSize,
+      char* buffer,
+      size_t bufferSize)
+  {
+    auto const encodedSize = ::Base64EncodedSize(dataSize);
+    if (bufferSize < encodedSize)
+    {
+      throw std::invalid_argument("The buffer is too small for the Base64 encoded data.");
+    }
+    ::Base64Encode(data, dataSize, buffer);
+    return encodedSize;
+  }
+
+  size_t Convert::Base64Decode(
+      char const* text,
+      size_t textSize,
+      uint8_t* buffer,
+      size_t bufferSize)
+  {
+    auto const decodedSize = ::Base64DecodedSize(text, textSize);
+    if (bufferSize < decodedSize)
+    {
+      throw std::invalid_argument("The buffer is too small for the Base64 decoded data.");
+    }
+    ::Base64Decode(text, textSize, buffer, decodedSize);
+    return decodedSize;
+  }
+
   namespace _internal {
 
     std::string Convert::Base64Encode(const std::string& data)
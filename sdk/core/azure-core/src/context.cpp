@@ -3,6 +3,8 @@
 
 #include "azure/core/context.hpp"
 
+#include <memory>
+
 using namespace Azure::Core;
 
 // Disable deprecation warning
@@ -27,19 +29,196 @@ const Context Context::ApplicationContext;
 #pragma GCC diagnostic pop
 #endif // _MSC_VER
 
-Azure::DateTime Azure::Core::Context::GetDeadline() const
+Context::ContextSharedState::ContextSharedState(
+    const std::shared_ptr<ContextSharedState>& parent,
+    DateTime const& deadline,
+    Context::Key const* key,
+    void const* value
+#if defined(AZ_CORE_RTTI)
+    ,
+    const std::type_info& valueType
+#endif
+    )
+    : Parent(parent), Root(parent ? parent->Root : this),
+      Deadline(ToDateTimeRepresentation(deadline)), CheckedGeneration(0), CancellationGeneration(0),
+      Signals(nullptr), Value(value)
+#if defined(AZ_CORE_RTTI)
+      ,
+      ValueType(valueType)
+#endif
+{
+  if (key != nullptr)
+  {
+    Key = *key;
+  }
+
+  if (Parent)
+  {
+    // The deadline of the parent already is the earliest deadline of its branch, or the
+    // cancellation of the parent once it was checked. Contexts cancelled after the generation is
+    // read are found by the next check.
+    uint64_t const generation = Root->CancellationGeneration.load(std::memory_order_acquire);
+    DateTime::rep const parentDeadline = Parent->GetDeadline();
+    if (parentDeadline < Deadline)
+    {
+      Deadline = parentDeadline;
+    }
+    CheckParents(generation);
+  }
+}
+
+void Context::ContextSharedState::CheckParents(uint64_t generation)
+{
+  DateTime::rep const cancelled = ToDateTimeRepresentation((DateTime::min)());
+  if (Deadline.load(std::memory_order_acquire) != cancelled)
+  {
+    for (auto parent = Parent.get(); parent != nullptr; parent = parent->Parent.get())
+    {
+      if (parent->Deadline.load(std::memory_order_acquire) == cancelled)
+      {
+        Deadline.store(cancelled, std::memory_order_release);
+        break;
+      }
+      if (parent->CheckedGeneration.load(std::memory_order_acquire) == generation)
+      {
+        // The parent checked its own parents since the last cancellation.
+        break;
+      }
+    }
+  }
+  CheckedGeneration.store(generation, std::memory_order_release);
+}
+
+void Context::ContextSharedState::Cancel()
+{
+  DateTime::rep const cancelled = ToDateTimeRepresentation((DateTime::min)());
+  if (Deadline.exchange(cancelled) == cancelled)
+  {
+    // The signals were notified when the context or one of its parents was cancelled.
+    return;
+  }
+
+  Root->CancellationGeneration.fetch_add(1);
+  _internal::ContextCancellationSignal::NotifyCancelled(*Root);
+}
+
+using Azure::Core::_internal::ContextCancellationSignal;
+
+struct Context::ContextSharedState::SignalList final
 {
-  // Contexts form a tree. Here, we walk from a node all the way back to the root in order to find
-  // the earliest deadline value.
-  auto result = (DateTime::max)();
-  for (std::shared_ptr<ContextSharedState> ptr = m_contextSharedState; ptr; ptr = ptr->Parent)
+  std::mutex Mutex;
+  ContextCancellationSignal* First = nullptr;
+};
+
+Context::ContextSharedState::~ContextSharedState() { delete Signals.load(); }
+
+ContextCancellationSignal::ContextCancellationSignal(
+    Context const& context,
+    std::mutex& mutex,
+    std::condition_variable& signal)
+    : m_context(context), m_mutex(mutex), m_signal(signal)
+{
+  auto& root = *m_context.m_contextSharedState->Root;
+  auto list = root.Signals.load(std::memory_order_acquire);
+  if (list == nullptr)
   {
-    auto deadline = ContextSharedState::FromDateTimeRepresentation(ptr->Deadline);
-    if (result > deadline)
+    auto newList = std::make_unique<Context::ContextSharedState::SignalList>();
+    if (root.Signals.compare_exchange_strong(list, newList.get()))
     {
-      result = deadline;
+      list = newList.release();
     }
   }
 
-  return result;
+  std::lock_guard<std::mutex> lock(list->Mutex);
+  m_next = list->First;
+  if (m_next != nullptr)
+  {
+    m_next->m_previous = this;
+  }
+  list->First = this;
+}
+
+ContextCancellationSignal::~ContextCancellationSignal()
+{
+  auto& list = *m_context.m_contextSharedState->Root->Signals.load(std::memory_order_acquire);
+  std::lock_guard<std::mutex> lock(list.Mutex);
+  if (m_previous != nullptr)
+  {
+    m_previous->m_next = m_next;
+  }
+  else
+  {
+    list.First = m_next;
+  }
+  if (m_next != nullptr)
+  {
+    m_next->m_previous = m_previous;
+  }
+}
+
+void ContextCancellationSignal::NotifyCancelled(Context::ContextSharedState& root)
+{
+  auto list = root.Signals.load(std::memory_order_acquire);
+  if (list == nullptr)
+  {
+    return;
+  }
+
+  DateTime::rep const cancelled
+      = Context::ContextSharedState::ToDateTimeRepresentation((DateTime::min)());
+  std::lock_guard<std::mutex> lock(list->Mutex);
+  for (auto signal = list->First; signal != nullptr; signal = signal->m_next)
+  {
+    if (signal->m_context.m_contextSharedState->GetDeadline() == cancelled)
+    {
+      signal->Notify();
+    }
+  }
+}
+
+void ContextCancellationSignal::Notify()
+{
+  // Locking the mutex makes sure that a thread which found the context not cancelled is waiting
+  // before it is notified.
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_signal.notify_all();
+}
+
+void ContextCancellationSignal::WaitFor(
+    std::unique_lock<std::mutex>& lock,
+    std::chrono::steady_clock::duration timeout) const
+{
+  if (m_context.IsCancelled())
+  {
+    return;
+  }
+
+  // The deadline passing isn't notified, so wake up when it passes.
+  auto const deadline = m_context.GetDeadline();
+  if (deadline != (DateTime::max)())
+  {
+    auto const untilDeadline = deadline - DateTime(std::chrono::system_clock::now());
+    if (untilDeadline < std::chrono::duration_cast<DateTime::duration>(timeout))
+    {
+      timeout = std::chrono::duration_cast<std::chrono::steady_clock::duration>(untilDeadline);
+    }
+  }
+  m_signal.wait_for(lock, timeout);
+}
+
+void ContextCancellationSignal::Sleep(Context const& context, std::chrono::milliseconds duration)
+{
+  std::mutex mutex;
+  std::condition_variable signal;
+  ContextCancellationSignal const cancellationSignal(context, mutex, signal);
+  auto const end = std::chrono::steady_clock::now() + duration;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto now = std::chrono::steady_clock::now(); now < end && !context.IsCancelled();
+         now = std::chrono::steady_clock::now())
+    {
+      cancellationSignal.WaitFor(lock, end - now);
+    }
+  }
+  context.ThrowIfCancelled();
 }
@@ -24,6 +24,7 @@
 
 #include "azure/core/internal/cryptography/sha_hash.hpp"
 
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -42,9 +43,105 @@ enum class SHASize
   SHA512
 };
 
+// EVP_sha256() and the like make OpenSSL 3 look up the implementation of the digest each time a
+// context is initialized with them, so the digests are fetched once.
+const EVP_MD* GetDigest(SHASize size)
+{
+  auto const getLegacyDigest = [](SHASize legacySize) {
+    switch (legacySize)
+    {
+      case SHASize::SHA1:
+        return EVP_sha1();
+      case SHASize::SHA256:
+        return EVP_sha256();
+      case SHASize::SHA384:
+        return EVP_sha384();
+      case SHASize::SHA512:
+        return EVP_sha512();
+      default:
+        // impossible to get here
+        AZURE_UNREACHABLE_CODE();
+    }
+  };
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  struct FetchedDigests final
+  {
+    std::array<EVP_MD*, 4> Digests;
+
+    FetchedDigests()
+        : Digests{
+            EVP_MD_fetch(nullptr, "SHA1", nullptr),
+            EVP_MD_fetch(nullptr, "SHA256", nullptr),
+            EVP_MD_fetch(nullptr, "SHA384", nullptr),
+            EVP_MD_fetch(nullptr, "SHA512", nullptr)}
+    {
+    }
+
+    ~FetchedDigests()
+    {
+      for (auto digest : Digests)
+      {
+        EVP_MD_free(digest);
+      }
+    }
+  };
+  static FetchedDigests const fetchedDigests;
+  auto const digest = fetchedDigests.Digests[static_cast<size_t>(size)];
+  return digest != nullptr ? digest : getLegacyDigest(size);
+#else
+  return getLegacyDigest(size);
+#endif
+}
+
+// Each thread keeps one context of each size from the hashes it destroyed, for the next hash of
+// that size to reuse instead of allocating a new one. The cache is plain data which outlives the
+// cleanup, so a hash destroyed after the cleanup of its thread frees its context.
+thread_local std::array<EVP_MD_CTX*, 4> CachedDigestContexts = {};
+thread_local bool DigestContextCacheClosed = false;
+
+struct DigestContextCacheCleanup final
+{
+  ~DigestContextCacheCleanup()
+  {
+    for (auto& context : CachedDigestContexts)
+    {
+      EVP_MD_CTX_free(context);
+      context = nullptr;
+    }
+    DigestContextCacheClosed = true;
+  }
+};
+thread_local DigestContextCacheCleanup DigestContextCacheCleanupInstance;
+
+EVP_MD_CTX* TakeDigestContext(SHASize size)
+{
+  auto& cached = CachedDigestContexts[static_cast<size_t>(size)];
+  if (cached != nullptr)
+  {
+    auto const context = cached;
+    cached = nullptr;
+    return context;
+  }
+  return EVP_MD_CTX_new();
+}
+
+void ReturnDigestContext(SHASize size, EVP_MD_CTX* context)
+{
+  auto& cached = CachedDigestContexts[static_cast<size_t>(size)];
+  if (!DigestContextCacheClosed && cached == nullptr)
+  {
+    // Registers the cleanup of the cache with the thread.
+    static_cast<void>(&DigestContextCacheCleanupInstance);
+    cached = context;
+    return;
+  }
+  EVP_MD_CTX_free(context);
+}
+
 /*************************** Sha256Hash *******************/
 class SHAWithOpenSSL final : public Azure::Core::Cryptography::Hash {
 private:
+  SHASize m_size;
   EVP_MD_CTX* m_context;
 
   std::vector<uint8_t> OnFinal(const uint8_t* data, size_t length) override
@@ -52,7 +149,7 @@ private:
     OnAppend(data, length);
     unsigned int size;
     unsigned char finalHash[EVP_MAX_MD_SIZE];
-    if (1 != EVP_DigestFinal(m_context, finalHash, &size))
+    if (1 != EVP_DigestFinal_ex(m_context, finalHash, &size))
     {
       throw std::runtime_error("Crypto error while computing Sha256Hash.");
     }
@@ -68,49 +165,34 @@ private:
   }
 
 public:
-  SHAWithOpenSSL(SHASize size)
+  SHAWithOpenSSL(SHASize size) : m_size(size)
   {
-    if ((m_context = EVP_MD_CTX_new()) == NULL)
+    if ((m_context = TakeDigestContext(size)) == NULL)
     {
       throw std::runtime_error("Crypto error while creating EVP context.");
     }
-    switch (size)
+    // A context reused with the same digest keeps the state allocated by the digest.
+    if (1 != EVP_DigestInit_ex(m_context, GetDigest(size), NULL))
     {
-      case SHASize::SHA1: {
-        if (1 != EVP_DigestInit_ex(m_context, EVP_sha1(), NULL))
-        {
+      EVP_MD_CTX_free(m_context);
+      switch (size)
+      {
+        case SHASize::SHA1:
           throw std::runtime_error("Crypto error while initializing Sha1Hash.");
-        }
-        break;
-      }
-      case SHASize::SHA256: {
-        if (1 != EVP_DigestInit_ex(m_context, EVP_sha256(), NULL))
-        {
+        case SHASize::SHA256:
           throw std::runtime_error("Crypto error while init Sha256Hash.");
-        }
-        break;
-      }
-      case SHASize::SHA384: {
-        if (1 != EVP_DigestInit_ex(m_context, EVP_sha384(), NULL))
-        {
+        case SHASize::SHA384:
           throw std::runtime_error("Crypto error while init Sha384Hash.");
-        }
-        break;
-      }
-      case SHASize::SHA512: {
-        if (1 != EVP_DigestInit_ex(m_context, EVP_sha512(), NULL))
-        {
+        case SHASize::SHA512:
           throw std::runtime_error("Crypto error while init Sha512Hash.");
-        }
-        break;
+        default:
+          // impossible to get here
+          AZURE_UNREACHABLE_CODE();
       }
-      default:
-        // impossible to get here
-        AZURE_UNREACHABLE_CODE();
     }
   }
 
-  ~SHAWithOpenSSL() { EVP_MD_CTX_free(m_context); }
+  ~SHAWithOpenSSL() { ReturnDigestContext(m_size, m_context); }
 };
 
 } // namespace
@@ -6,11 +6,10 @@
 #include "azure/core/internal/strings.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <ctime>
-#include <iomanip>
 #include <limits>
 #include <ratio>
-#include <sstream>
 #include <stdexcept>
 #include <type_traits>
 
@@ -120,7 +119,7 @@ void ValidateDateElementRange(
     T value,
     decltype(value) minValue,
     decltype(value) maxValue,
-    std::string const& valueName)
+    char const* valueName)
 {
   auto outOfRange = 0;
 
@@ -136,7 +135,7 @@ void ValidateDateElementRange(
   if (outOfRange != 0)
   {
     throw std::invalid_argument(
-        "Azure::DateTime " + valueName + " (" + std::to_string(value) + ") cannot be "
+        std::string("Azure::DateTime ") + valueName + " (" + std::to_string(value) + ") cannot be "
         + (outOfRange < 0 ? std::string("less than ") + std::to_string(minValue)
                           : std::string("greater than ") + std::to_string(maxValue))
         + ".");
@@ -444,6 +443,135 @@ void ParseSingleOptionalChar(
     IncreaseAndCheckMinLength(minLength, actualLength, 1);
   }
 }
+// Reads the `count` digits at `offset`, or returns -1 if one of them is not a digit.
+int32_t ParseFixedDigits(std::string const& str, std::string::size_type offset, int count)
+{
+  int32_t value = 0;
+  for (auto i = 0; i < count; ++i)
+  {
+    auto const digit = static_cast<unsigned>(static_cast<unsigned char>(str[offset + i]))
+        - static_cast<unsigned>('0');
+    if (digit > 9)
+    {
+      return -1;
+    }
+    value = (value * 10) + static_cast<int32_t>(digit);
+  }
+
+  return value;
+}
+
+// Parses the "Sun, 06 Nov 1994 08:49:37 GMT" shape of the Date and Last-Modified headers without
+// looking for the optional parts of RFC 1123. Returns false for any other shape, which is left to
+// the general parser. The values are validated by the DateTime constructor.
+bool ParseFixedRfc1123(
+    std::string const& str,
+    int16_t* year,
+    int8_t* month,
+    int8_t* day,
+    int8_t* hour,
+    int8_t* minute,
+    int8_t* second,
+    int8_t* dayOfWeek)
+{
+  if (str.length() != 29 || str[3] != ',' || str[4] != ' ' || str[7] != ' ' || str[11] != ' '
+      || str[16] != ' ' || str[19] != ':' || str[22] != ':' || str.compare(25, 4, " GMT") != 0)
+  {
+    return false;
+  }
+
+  auto const weekDay = SubstringEqualsAny(str, 0, 3, DayNames);
+  auto const monthIndex = SubstringEqualsAny(str, 8, 3, MonthNames);
+  auto const dayValue = ParseFixedDigits(str, 5, 2);
+  auto const yearValue = ParseFixedDigits(str, 12, 4);
+  auto const hourValue = ParseFixedDigits(str, 17, 2);
+  auto const minuteValue = ParseFixedDigits(str, 20, 2);
+  auto const secondValue = ParseFixedDigits(str, 23, 2);
+  if (weekDay < 0 || monthIndex < 0 || dayValue < 0 || yearValue < 0 || hourValue < 0
+      || minuteValue < 0 || secondValue < 0)
+  {
+    return false;
+  }
+
+  *year = static_cast<int16_t>(yearValue);
+  *month = static_cast<int8_t>(monthIndex + 1);
+  *day = static_cast<int8_t>(dayValue);
+  *hour = static_cast<int8_t>(hourValue);
+  *minute = static_cast<int8_t>(minuteValue);
+  *second = static_cast<int8_t>(secondValue);
+  *dayOfWeek = weekDay;
+  return true;
+}
+
+// Parses the "2021-02-05T08:49:37.1234567Z" shape the services send, with up to 7 fraction digits
+// or none. Returns false for any other shape, which is left to the general parser. The values are
+// validated by the DateTime constructor.
+bool ParseFixedRfc3339(
+    std::string const& str,
+    int16_t* year,
+    int8_t* month,
+    int8_t* day,
+    int8_t* hour,
+    int8_t* minute,
+    int8_t* second,
+    int32_t* fracSec)
+{
+  auto const length = str.length();
+  if (length < 20 || length == 21 || length > 28 || str[4] != '-' || str[7] != '-'
+      || str[10] != 'T' || str[13] != ':' || str[16] != ':' || str[length - 1] != 'Z')
+  {
+    return false;
+  }
+
+  int32_t fraction = 0;
+  if (length != 20)
+  {
+    if (str[19] != '.')
+    {
+      return false;
+    }
+
+    auto const digits = static_cast<int>(length) - 21;
+    fraction = ParseFixedDigits(str, 20, digits);
+    for (auto i = digits; i < 7; ++i)
+    {
+      fraction *= 10;
+    }
+  }
+
+  auto const yearValue = ParseFixedDigits(str, 0, 4);
+  auto const monthValue = ParseFixedDigits(str, 5, 2);
+  auto const dayValue = ParseFixedDigits(str, 8, 2);
+  auto const hourValue = ParseFixedDigits(str, 11, 2);
+  auto const minuteValue = ParseFixedDigits(str, 14, 2);
+  auto const secondValue = ParseFixedDigits(str, 17, 2);
+  if (fraction < 0 || yearValue < 0 || monthValue < 0 || dayValue < 0 || hourValue < 0
+      || minuteValue < 0 || secondValue < 0)
+  {
+    return false;
+  }
+
+  *year = static_cast<int16_t>(yearValue);
+  *month = static_cast<int8_t>(monthValue);
+  *day = static_cast<int8_t>(dayValue);
+  *hour = static_cast<int8_t>(hourValue);
+  *minute = static_cast<int8_t>(minuteValue);
+  *second = static_cast<int8_t>(secondValue);
+  *fracSec = fraction;
+  return true;
+}
+
+// Writes `value` as `count` digits, padded with zeros, and returns the end of the digits.
+char* WriteFixedDigits(char* out, int32_t value, int count)
+{
+  for (auto i = count - 1; i >= 0; --i)
+  {
+    out[i] = static_cast<char>('0' + (value % 10));
+    value /= 10;
+  }
+
+  return out + count;
+}
 } // namespace
 
 DateTime const DateTime::SystemClockEpoch = GetSystemClockEpoch();
@@ -530,6 +658,28 @@ DateTime DateTime::Parse(std::string const& dateTime, DateFormat format)
   int8_t localDiffHours = 0;
   int8_t localDiffMinutes = 0;
   bool roundFracSecUp = false;
+
+  // Most dates come from the services in one fixed shape, which is parsed without the general
+  // parser.
+  if ((format == DateFormat::Rfc1123
+       && ParseFixedRfc1123(dateTime, &year, &month, &day, &hour, &minute, &second, &dayOfWeek))
+      || (format == DateFormat::Rfc3339
+          && ParseFixedRfc3339(dateTime, &year, &month, &day, &hour, &minute, &second, &fracSec)))
+  {
+    return DateTime(
+        year,
+        month,
+        day,
+        hour,
+        minute,
+        second,
+        fracSec,
+        dayOfWeek,
+        localDiffHours,
+        localDiffMinutes,
+        roundFracSecUp);
+  }
+
   {
     std::string::size_type const DateTimeLength = dateTime.length();
     std::string::size_type minDateTimeLength = 0;
@@ -901,15 +1051,29 @@ std::string DateTime::ToStringRfc1123() const
 
   GetDateTimeParts(&year, &month, &day, &hour, &minute, &second, &fracSec, &dayOfWeek);
 
-  std::ostringstream dateString;
-
-  dateString << DayNames[dayOfWeek] << ", " << std::setfill('0') << std::setw(2)
-             << static_cast<int>(day) << ' ' << MonthNames[month - 1] << ' ' << std::setw(4)
-             << static_cast<int>(year) << ' ' << std::setw(2) << static_cast<int>(hour) << ':'
-             << std::setw(2) << static_cast<int>(minute) << ':' << std::setw(2)
-             << static_cast<int>(second) << " GMT";
-
-  return dateString.str();
+  // "Sun, 06 Nov 1994 08:49:37 GMT"
+  char dateString[29];
+  auto out = dateString;
+  std::memcpy(out, DayNames[dayOfWeek].data(), 3);
+  out += 3;
+  *out++ = ',';
+  *out++ = ' ';
+  out = WriteFixedDigits(out, day, 2);
+  *out++ = ' ';
+  std::memcpy(out, MonthNames[month - 1].data(), 3);
+  out += 3;
+  *out++ = ' ';
+  out = WriteFixedDigits(out, year, 4);
+  *out++ = ' ';
+  out = WriteFixedDigits(out, hour, 2);
+  *out++ = ':';
+  out = WriteFixedDigits(out, minute, 2);
+  *out++ = ':';
+  out = WriteFixedDigits(out, second, 2);
+  std::memcpy(out, " GMT", 4);
+  out += 4;
+
+  return std::string(dateString, out);
 }
 
 std::string DateTime::ToString(DateFormat format) const
@@ -960,37 +1124,42 @@ std::string DateTime::ToString(DateFormat format, TimeFractionFormat fractionFor
 
   GetDateTimeParts(&year, &month, &day, &hour, &minute, &second, &fracSec, &dayOfWeek);
 
-  std::ostringstream dateString;
-
-  dateString << std::setfill('0') << std::setw(4) << static_cast<int>(year) << '-' << std::setw(2)
-             << static_cast<int>(month) << '-' << std::setw(2) << static_cast<int>(day) << 'T'
-             << std::setw(2) << static_cast<int>(hour) << ':' << std::setw(2)
-             << static_cast<int>(minute) << ':' << std::setw(2) << static_cast<int>(second);
+  // "2021-02-05T08:49:37.1234567Z"
+  char dateString[28];
+  auto out = WriteFixedDigits(dateString, year, 4);
+  *out++ = '-';
+  out = WriteFixedDigits(out, month, 2);
+  *out++ = '-';
+  out = WriteFixedDigits(out, day, 2);
+  *out++ = 'T';
+  out = WriteFixedDigits(out, hour, 2);
+  *out++ = ':';
+  out = WriteFixedDigits(out, minute, 2);
+  *out++ = ':';
+  out = WriteFixedDigits(out, second, 2);
 
   if (fractionFormat == TimeFractionFormat::AllDigits)
   {
-    dateString << '.' << std::setw(7) << static_cast<int>(fracSec);
+    *out++ = '.';
+    out = WriteFixedDigits(out, fracSec, 7);
   }
   else if (fracSec != 0 && fractionFormat != TimeFractionFormat::Truncate)
   {
     // Append fractional second, which is a 7-digit value with no trailing zeros
     // This way, '0001200' becomes '00012'
-    auto setw = 1;
+    auto digits = 7;
     auto frac = fracSec;
-    for (auto div = 1000000; div >= 1; div /= 10)
+    while (frac % 10 == 0)
     {
-      if ((fracSec % div) == 0)
-      {
-        frac /= div;
-        break;
-      }
-      ++setw;
+      frac /= 10;
+      --digits;
     }
 
-    dateString << '.' << std::setw(setw) << static_cast<int>(frac);
+    *out++ = '.';
+    out = WriteFixedDigits(out, frac, digits);
   }
 
-  dateString << 'Z';
+  *out++ = 'Z';
 
-  return dateString.str();
+  return std::string(dateString, out);
 }
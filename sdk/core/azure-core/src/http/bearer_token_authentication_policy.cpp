@@ -4,8 +4,12 @@
 #include "azure/core/credentials/credentials.hpp"
 #include "azure/core/http/policies/policy.hpp"
 #include "azure/core/internal/credentials/authorization_challenge_parser.hpp"
+#include "azure/core/internal/diagnostics/log.hpp"
 
 #include <chrono>
+#include <exception>
+#include <future>
+#include <system_error>
 
 using Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy;
 
@@ -13,6 +17,8 @@ using Azure::Core::Context;
 using Azure::Core::Credentials::AuthenticationException;
 using Azure::Core::Credentials::TokenRequestContext;
 using Azure::Core::Credentials::_detail::AuthorizationChallengeHelper;
+using Azure::Core::Diagnostics::Logger;
+using Azure::Core::Diagnostics::_internal::Log;
 using Azure::Core::Http::RawResponse;
 using Azure::Core::Http::Request;
 using Azure::Core::Http::Policies::NextHttpPolicy;
@@ -76,6 +82,19 @@ bool TokenNeedsRefresh(
       || currentTime > (cachedToken.ExpiresOn - newTokenRequestContext.MinimumExpiration);
 }
 
+// How long to wait before starting a new background refresh after one failed.
+constexpr std::chrono::seconds BackgroundRefreshRetryDelay(30);
+// How often a request waiting for the background refresh checks whether it was cancelled.
+constexpr std::chrono::milliseconds BackgroundRefreshWaitInterval(50);
+
+bool TokenInRefreshWindow(
+    Azure::Core::Credentials::AccessToken const& cachedToken,
+    Azure::DateTime const& currentTime,
+    Azure::DateTime::duration refreshWindow)
+{
+  return currentTime > (cachedToken.ExpiresOn - refreshWindow);
+}
+
 void ApplyBearerToken(
     Azure::Core::Http::Request& request,
     Azure::Core::Credentials::AccessToken const& token)
@@ -90,6 +109,7 @@ void BearerTokenAuthenticationPolicy::AuthenticateAndAuthorizeRequest(
     Context const& context) const
 {
   DateTime const currentTime = std::chrono::system_clock::now();
+  bool const refreshInBackground = m_tokenRefreshWindow > tokenRequestContext.MinimumExpiration;
 
   {
     std::shared_lock<std::shared_timed_mutex> readLock(m_accessTokenMutex);
@@ -101,10 +121,35 @@ void BearerTokenAuthenticationPolicy::AuthenticateAndAuthorizeRequest(
             m_invalidateToken))
     {
       ApplyBearerToken(request, m_accessToken);
+      if (refreshInBackground
+          && TokenInRefreshWindow(m_accessToken, currentTime, m_tokenRefreshWindow))
+      {
+        readLock.unlock();
+        RefreshTokenInBackground(tokenRequestContext, currentTime);
+      }
       return;
     }
   }
 
+  if (refreshInBackground)
+  {
+    // A background refresh may be about to replace the token, wait for it rather than asking the
+    // credential for a second one.
+    std::shared_future<void> backgroundRefresh;
+    {
+      std::lock_guard<std::mutex> lock(m_backgroundRefreshMutex);
+      backgroundRefresh = m_backgroundRefresh;
+    }
+    if (backgroundRefresh.valid())
+    {
+      while (backgroundRefresh.wait_for(BackgroundRefreshWaitInterval)
+             != std::future_status::ready)
+      {
+        context.ThrowIfCancelled();
+      }
+    }
+  }
+
   std::unique_lock<std::shared_timed_mutex> writeLock(m_accessTokenMutex);
   // Check if token needs refresh for the second time in case another thread has just updated it.
   if (TokenNeedsRefresh(
@@ -125,3 +170,82 @@ void BearerTokenAuthenticationPolicy::AuthenticateAndAuthorizeRequest(
 
   ApplyBearerToken(request, m_accessToken);
 }
+
+BearerTokenAuthenticationPolicy::~BearerTokenAuthenticationPolicy()
+{
+  // The pipelines clone and destroy their policies routinely, only a running refresh needs to be
+  // cancelled.
+  bool isRefreshing;
+  {
+    std::lock_guard<std::mutex> lock(m_backgroundRefreshMutex);
+    isRefreshing = m_backgroundRefresh.valid()
+        && m_backgroundRefresh.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+  }
+  if (isRefreshing)
+  {
+    m_backgroundRefreshContext.Cancel();
+  }
+}
+
+void BearerTokenAuthenticationPolicy::RefreshTokenInBackground(
+    TokenRequestContext const& tokenRequestContext,
+    DateTime const& currentTime) const
+{
+  std::lock_guard<std::mutex> lock(m_backgroundRefreshMutex);
+  if (currentTime < m_backgroundRefreshRetryTime
+      || (m_backgroundRefresh.valid()
+          && m_backgroundRefresh.wait_for(std::chrono::seconds(0)) != std::future_status::ready))
+  {
+    return;
+  }
+
+  try
+  {
+    m_backgroundRefresh
+        = std::async(std::launch::async, [this, tokenRequestContext]() {
+            TokenRequestContext trcCopy = tokenRequestContext;
+            // The credential may cache the token as well, make it return a token which is not
+            // within the refresh window.
+            trcCopy.MinimumExpiration = m_tokenRefreshWindow;
+            try
+            {
+              // The refresh outlives the request which started it, so it is not cancelled with
+              // the request context, only when the policy is destroyed.
+              auto const accessToken
+                  = m_credential->GetToken(trcCopy, m_backgroundRefreshContext);
+
+              std::unique_lock<std::shared_timed_mutex> writeLock(m_accessTokenMutex);
+              // Keep the cached token if it was replaced while the refresh was running, e.g.
+              // after an unauthorized response or for another scope.
+              if (m_accessTokenContext.Scopes == tokenRequestContext.Scopes
+                  && m_accessTokenContext.TenantId == tokenRequestContext.TenantId
+                  && accessToken.ExpiresOn > m_accessToken.ExpiresOn)
+              {
+                m_accessToken = accessToken;
+              }
+            }
+            catch (std::exception const& e)
+            {
+              if (m_backgroundRefreshContext.IsCancelled())
+              {
+                // The policy is being destroyed.
+                return;
+              }
+              // The cached token is still valid, the request which finds it expiring will get a
+              // new one.
+              Log::Write(
+                  Logger::Level::Warning,
+                  std::string("Background access token refresh failed: ") + e.what());
+              std::lock_guard<std::mutex> lock(m_backgroundRefreshMutex);
+              m_backgroundRefreshRetryTime
+                  = DateTime(std::chrono::system_clock::now()) + BackgroundRefreshRetryDelay;
+            }
+          }).share();
+  }
+  catch (std::system_error const& e)
+  {
+    Log::Write(
+        Logger::Level::Warning,
+        std::string("Failed to start the background access token refresh: ") + e.what());
+  }
+}
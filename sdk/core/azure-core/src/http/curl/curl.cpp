@@ -67,11 +67,16 @@
 #endif // AZ_PLATFORM_POSIX/AZ_PLATFORM_WINDOWS
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <exception>
 #include <iomanip>
+#include <limits>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace {
 std::string const LogMsgPrefix = "[CURL Transport Adapter]: ";
@@ -92,13 +97,14 @@ inline bool SetLibcurlOption(
   return *outError == CURLE_OK;
 }
 
+template <typename T>
 inline bool SetLibcurlShareOption(
-    std::unique_ptr<Azure::Core::_detail::CURLSHWrapper> const& handle,
+    Azure::Core::_detail::CURLSHWrapper const& handle,
     CURLSHoption option,
-    curl_lock_data value,
+    T value,
     CURLSHcode* outError)
 {
-  *outError = curl_share_setopt(handle->share_handle, option, value);
+  *outError = curl_share_setopt(handle.share_handle, option, value);
   return *outError == CURLSHE_OK;
 }
 
@@ -208,81 +214,6 @@ void WinSocketSetBuffSize(curl_socket_t socket)
 }
 #endif
 
-static void CleanupThread()
-{
-  // NOTE: Avoid using Log::Write in here as it may fail on macOS,
-  // see issue: https://github.com/Azure/azure-sdk-for-cpp/issues/3224
-  // This method can wake up in de-attached mode after the application has been terminated.
-  // If that happens, trying to use `Log` would cause `abort` as it was previously deallocated.
-  using namespace Azure::Core::Http::_detail;
-  for (;;)
-  {
-    // Won't continue until the ConnectionPoolMutex is released from MoveConnectionBackToPool
-    std::unique_lock<std::mutex> lockForPoolCleaning(
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-
-    // Wait for the default time OR to the signal from the conditional variable.
-    // wait_for releases the mutex lock when it goes to sleep and it takes the lock again when it
-    // wakes up (or it's cancelled).
-    if (CurlConnectionPool::g_curlConnectionPool.ConditionalVariableForCleanThread.wait_for(
-            lockForPoolCleaning,
-            std::chrono::milliseconds(DefaultCleanerIntervalMilliseconds),
-            []() {
-              return CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size() == 0;
-            }))
-    {
-      // Cancelled by another thread or no connections on wakeup
-      CurlConnectionPool::g_curlConnectionPool.IsCleanThreadRunning = false;
-      break;
-    }
-
-    decltype(CurlConnectionPool::g_curlConnectionPool
-                 .ConnectionPoolIndex)::mapped_type connectionsToBeCleaned;
-
-    // loop the connection pool index - Note: lock is re-taken for the mutex
-    // Notes: The size of each host-index is always expected to be greater than 0 because the
-    // host-index is removed anytime it becomes empty.
-    for (auto index = CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.begin();
-         index != CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.end();)
-    {
-      // Each pool index behaves as a Last-in-First-out (connections are added to the pool with
-      // push_front). The last connection moved to the pool will be the first to be re-used. Because
-      // of this, the oldest connection in the pool can be found at the end of the list. Looping the
-      // connection pool backwards until a connection that is not expired is found or until all
-      // connections are removed.
-      auto& connectionList = index->second;
-      auto connectionIter = connectionList.end();
-      while (connectionIter != connectionList.begin())
-      {
-        --connectionIter;
-        if ((*connectionIter)->IsExpired())
-        {
-          // remove connection from the pool and update the connection to the next one
-          // which is going to be list.end()
-          connectionsToBeCleaned.emplace_back(std::move(*connectionIter));
-          connectionIter = connectionList.erase(connectionIter);
-        }
-        else
-        {
-          break;
-        }
-      }
-
-      if (connectionList.empty())
-      {
-        index = CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.erase(index);
-      }
-      else
-      {
-        ++index;
-      }
-    }
-
-    lockForPoolCleaning.unlock();
-    // Do actual connections release work here, without holding the mutex.
-  }
-}
-
 // This function is only used when ExpectedTlsRootCertificate transport options is set to non empty.
 // And that capability only impacts the curl transport behavior in versions of libcurl >= 7.77.0.
 #if LIBCURL_VERSION_NUM >= 0x074D00 // 7.77.0
@@ -306,7 +237,10 @@ std::string PemEncodeFromBase64(std::string const& base64, std::string const& pe
 }
 #endif
 
-Azure::Core::Http::CurlTransportOptions CurlTransportOptionsFromTransportOptions(
+} // namespace
+
+Azure::Core::Http::CurlTransportOptions
+Azure::Core::Http::_detail::CurlTransportOptionsFromTransportOptions(
     Azure::Core::Http::Policies::TransportOptions const& transportOptions)
 {
   Azure::Core::Http::CurlTransportOptions curlOptions;
@@ -331,8 +265,6 @@ Azure::Core::Http::CurlTransportOptions CurlTransportOptionsFromTransportOptions
   return curlOptions;
 }
 
-} // namespace
-
 using Azure::Core::Context;
 using Azure::Core::Http::CurlConnection;
 using Azure::Core::Http::CurlNetworkConnection;
@@ -348,13 +280,87 @@ using Azure::Core::Http::_detail::CurlConnectionPool;
 Azure::Core::Http::_detail::CurlConnectionPool
     Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool;
 
+CurlTransport::CurlTransport(CurlTransportOptions const& options) : m_options(options)
+{
+  if (m_options.EnableHttp2)
+  {
+    m_http2Transport = std::make_shared<Azure::Core::Http::CurlMultiTransport>(m_options);
+  }
+}
+
 CurlTransport::CurlTransport(Azure::Core::Http::Policies::TransportOptions const& options)
-    : CurlTransport(CurlTransportOptionsFromTransportOptions(options))
+    : CurlTransport(_detail::CurlTransportOptionsFromTransportOptions(options))
 {
 }
 
+void CurlTransport::Prewarm(Url const& url, size_t connectionCount, Context const& context)
+{
+  if (m_http2Transport)
+  {
+    return;
+  }
+
+  // The connections are opened by a few threads, so they don't all wait for each other to resolve
+  // the host name and do the TLS handshake, without starting one thread per connection.
+  std::atomic<size_t> nextConnection{0};
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  auto const openConnections = [&]() {
+    while (nextConnection++ < connectionCount && !context.IsCancelled())
+    {
+      try
+      {
+        Request request(HttpMethod::Get, url);
+        CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+            CurlConnectionPool::g_curlConnectionPool.CreateCurlConnection(request, m_options),
+            m_options.HttpKeepAlive,
+            m_options.MaxPooledConnectionsPerHost,
+            m_options.MaxPooledConnections);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  auto const workerCount = (std::min)(connectionCount, _detail::MaxPrewarmThreads);
+  // The calling thread is one of the workers.
+  for (size_t count = 1; count < workerCount; count++)
+  {
+    workers.emplace_back(openConnections);
+  }
+  openConnections();
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+  context.ThrowIfCancelled();
+}
+
+Azure::Core::Http::CurlConnectionPoolStatistics CurlTransport::GetConnectionPoolStatistics()
+{
+  return CurlConnectionPool::g_curlConnectionPool.GetStatistics();
+}
+
 std::unique_ptr<RawResponse> CurlTransport::Send(Request& request, Context const& context)
 {
+  // WebSockets upgrade the HTTP/1.1 connection, so they never use the HTTP/2 transport.
+  if (m_http2Transport && !HasWebSocketSupport())
+  {
+    return m_http2Transport->Send(request, context);
+  }
+
   // Create CurlSession to perform request
   Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Creating a new session.");
 
@@ -437,7 +443,7 @@ CURLcode CurlSession::Perform(Context const& context)
 
   // libcurl settings after connection is open (headers)
   {
-    auto headers = this->m_request.GetHeaders();
+    auto const& headers = this->m_request.GetHeaders();
     auto hostHeader = headers.find("Host");
     if (hostHeader == headers.end())
     {
@@ -485,7 +491,10 @@ CURLcode CurlSession::Perform(Context const& context)
   // (https://curl.haxx.se/libcurl/c/curl_easy_send.html). Return the error back.
   Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Send request without payload");
 
+  auto const sendStart = std::chrono::steady_clock::now();
   auto result = SendRawHttp(context);
+  m_transportMetrics->SendTime += std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - sendStart);
   if (result != CURLE_OK)
   {
     return result;
@@ -531,7 +540,10 @@ CURLcode CurlSession::Perform(Context const& context)
   }
 
   // Start upload
+  auto const uploadStart = std::chrono::steady_clock::now();
   result = this->UploadBody(context);
+  m_transportMetrics->SendTime += std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - uploadStart);
   if (result != CURLE_OK)
   {
     m_sessionState = SessionState::STREAMING;
@@ -554,6 +566,7 @@ std::unique_ptr<CurlNetworkConnection> CurlSession::ExtractConnection()
 {
   if (m_connectionUpgraded)
   {
+    m_connection->SetTransportMetrics(nullptr);
     return std::move(m_connection);
   }
   else
@@ -602,6 +615,41 @@ static std::unique_ptr<RawResponse> CreateHTTPResponse(std::string const& header
       reinterpret_cast<const uint8_t*>(header.data() + header.size()));
 }
 
+void CurlConnection::RecordTlsHandshake()
+{
+  m_tlsHandshakeRecorded = true;
+#if defined(AZ_PLATFORM_POSIX)
+  // libcurl only exposes the TLS session of a connect-only handle once it has sent data, and only
+  // OpenSSL tells if the session was resumed.
+  struct curl_tlssessioninfo* tlsSession = nullptr;
+  if (curl_easy_getinfo(m_handle.get(), CURLINFO_TLS_SSL_PTR, &tlsSession) == CURLE_OK
+      && tlsSession != nullptr && tlsSession->backend == CURLSSLBACKEND_OPENSSL
+      && tlsSession->internals != nullptr)
+  {
+    CurlConnectionPool::g_curlConnectionPool.RecordTlsHandshake(
+        SSL_session_reused(static_cast<SSL*>(tlsSession->internals)) == 1);
+  }
+#endif
+}
+
+void CurlConnection::SetTransportMetrics(TransportMetrics* metrics)
+{
+  m_transportMetrics = metrics;
+  if (metrics == nullptr)
+  {
+    return;
+  }
+  if (m_setupTimesReported)
+  {
+    metrics->ConnectionReused = true;
+    return;
+  }
+  m_setupTimesReported = true;
+  metrics->NameLookupTime = m_nameLookupTime;
+  metrics->ConnectTime = m_connectTime;
+  metrics->TlsHandshakeTime = m_tlsHandshakeTime;
+}
+
 // Send buffer thru the wire
 CURLcode CurlConnection::SendBuffer(
     uint8_t const* buffer,
@@ -650,9 +698,17 @@ CURLcode CurlConnection::SendBuffer(
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
           }
           sentBytesTotal += sentBytesPerRequest;
+          if (m_transportMetrics != nullptr)
+          {
+            m_transportMetrics->BytesSent += static_cast<int64_t>(sentBytesPerRequest);
+          }
           break;
         }
         case CURLE_AGAIN: {
+          if (m_transportMetrics != nullptr)
+          {
+            ++m_transportMetrics->SocketWaits;
+          }
           // start polling operation with 1 min timeout
           auto pollUntilSocketIsReady = pollSocketUntilEventOrTimeout(
               context, m_curlSocket, PollSocketDirection::Write, 60000L);
@@ -675,26 +731,54 @@ CURLcode CurlConnection::SendBuffer(
       }
     }
   }
+  if (!m_tlsHandshakeRecorded)
+  {
+    RecordTlsHandshake();
+  }
 #if defined(AZ_PLATFORM_WINDOWS)
   WinSocketSetBuffSize(m_curlSocket);
 #endif
   return CURLE_OK;
 }
 
+size_t CurlSession::GetUploadChunkSize() const
+{
+  return this->m_request.GetUploadChunkSize() == 0 ? _detail::DefaultUploadChunkSize
+                                                   : this->m_request.GetUploadChunkSize();
+}
+
 CURLcode CurlSession::UploadBody(Context const& context)
 {
-  // Send body UploadStreamPageSize at a time (libcurl default)
-  // NOTE: if stream is on top a contiguous memory, we can avoid allocating this copying buffer
+  // Send body one upload chunk at a time (64k by default, same as libcurl)
   auto streamBody = this->m_request.GetBodyStream();
+  auto const chunkSize = GetUploadChunkSize();
   CURLcode sendResult = CURLE_OK;
 
-  auto unique_buffer
-      = std::make_unique<uint8_t[]>(static_cast<size_t>(_detail::DefaultUploadChunkSize));
+  // A stream on top of contiguous memory is sent straight from it, without a copying buffer.
+  while (true)
+  {
+    uint8_t const* data = nullptr;
+    size_t rawRequestLen = streamBody->ReadInPlace(data, chunkSize, context);
+    if (data == nullptr)
+    {
+      break;
+    }
+    if (rawRequestLen == 0)
+    {
+      return sendResult;
+    }
+    sendResult = m_connection->SendBuffer(data, rawRequestLen, context);
+    if (sendResult != CURLE_OK)
+    {
+      return sendResult;
+    }
+  }
+
+  auto unique_buffer = std::make_unique<uint8_t[]>(chunkSize);
 
   while (true)
   {
-    size_t rawRequestLen
-        = streamBody->Read(unique_buffer.get(), _detail::DefaultUploadChunkSize, context);
+    size_t rawRequestLen = streamBody->Read(unique_buffer.get(), chunkSize, context);
     if (rawRequestLen == 0)
     {
       break;
@@ -715,6 +799,22 @@ CURLcode CurlSession::SendRawHttp(Context const& context)
   auto rawRequest = GetHTTPMessagePreBody(this->m_request);
   auto rawRequestLen = rawRequest.size();
 
+  // A body fitting in one upload chunk is sent together with the headers, so the whole request
+  // goes out with a single send. PUT waits for the server to accept the upload before sending it.
+  auto const bodyLength = this->m_request.GetBodyStream()->Length();
+  if (this->m_request.GetMethod() != HttpMethod::Put && bodyLength > 0
+      && static_cast<uint64_t>(bodyLength) <= GetUploadChunkSize())
+  {
+    rawRequest.resize(rawRequestLen + static_cast<size_t>(bodyLength));
+    rawRequestLen += this->m_request.GetBodyStream()->ReadToCount(
+        reinterpret_cast<uint8_t*>(&rawRequest[rawRequestLen]),
+        static_cast<size_t>(bodyLength),
+        context);
+
+    return m_connection->SendBuffer(
+        reinterpret_cast<uint8_t const*>(rawRequest.data()), rawRequestLen, context);
+  }
+
   CURLcode sendResult = m_connection->SendBuffer(
       reinterpret_cast<uint8_t const*>(rawRequest.data()),
       static_cast<size_t>(rawRequestLen),
@@ -781,83 +881,149 @@ inline std::string CurlSession::GetHTTPMessagePreBody(Azure::Core::Http::Request
   return httpRequest;
 }
 
-void CurlSession::ParseChunkSize(Context const& context)
+namespace {
+[[noreturn]] void ThrowUnexpectedChunkFraming(uint8_t expected, uint8_t found)
+{
+  throw Azure::Core::Http::TransportException(
+      "Unexpected format in HTTP response. Expecting: " + std::to_string(expected)
+      + ", but found: " + std::to_string(found) + ".");
+}
+
+// Returns the value of a hex digit, or -1 if the byte is not a hex digit.
+int HexDigitValue(uint8_t byte)
 {
-  // Use this string to construct the chunk size. This is because we could have an internal
-  // buffer like [headers...\r\n123], where 123 is chunk size but we still need to pull more
-  // data fro wire to get the full chunkSize. Next data could be just [\r\n] or [456\r\n]
-  auto strChunkSize = std::string();
+  if (byte >= '0' && byte <= '9')
+  {
+    return byte - '0';
+  }
+  if (byte >= 'a' && byte <= 'f')
+  {
+    return byte - 'a' + 10;
+  }
+  if (byte >= 'A' && byte <= 'F')
+  {
+    return byte - 'A' + 10;
+  }
+  return -1;
+}
+} // namespace
 
-  // Move to after chunk size
-  for (bool keepPolling = true; keepPolling;)
+size_t CurlSession::ParseChunkFraming(uint8_t const* data, size_t size)
+{
+  size_t index = 0;
+  while (index < size && this->m_chunkParserState != ChunkParserState::ChunkData
+         && this->m_chunkParserState != ChunkParserState::End)
   {
-    for (size_t index = this->m_bodyStartInBuffer, iteration = 0; index < this->m_innerBufferSize;
-         index++, iteration++)
+    auto const byte = data[index++];
+
+    if (this->m_chunkParserState == ChunkParserState::ChunkDataEnd)
     {
-      strChunkSize.append(reinterpret_cast<char*>(&this->m_readBuffer[index]), 1);
-      if (iteration > 1 && this->m_readBuffer[index] == '\n')
+      // The chunk data is followed by exactly `\r\n`.
+      if (!this->m_chunkLineCR)
       {
-        // get chunk size. Chunk size comes in Hex value
-        try
+        if (byte != '\r')
         {
-          // Required cast for MSVC x86
-          this->m_chunkSize = static_cast<size_t>(std::stoull(strChunkSize, nullptr, 16));
-        }
-        catch (std::invalid_argument const&)
-        {
-          // Server can return something like `\n\r\n` for a chunk of zero length data. This is
-          // allowed by RFC. `stoull` will throw invalid_argument if there is not at least one hex
-          // digit to be parsed. For those cases, we consider the response as zero-length.
-          this->m_chunkSize = 0;
-        }
-
-        if (this->m_chunkSize == 0)
-        { // Response with no content. end of chunk
-          keepPolling = false;
-          /*
-           * The index represents the current position while reading.
-           * When the chunkSize is 0, the index should have already read up to the next CRLF.
-           * When reading again, we want to start reading from the next position, so we need to add
-           * 1 to the index.
-           */
-          this->m_bodyStartInBuffer = index + 1;
-          break;
+          ThrowUnexpectedChunkFraming('\r', byte);
         }
+        this->m_chunkLineCR = true;
+        continue;
+      }
+      if (byte != '\n')
+      {
+        ThrowUnexpectedChunkFraming('\n', byte);
+      }
+      this->m_chunkLineCR = false;
+      this->m_chunkLineLength = 0;
+      this->m_chunkSize = 0;
+      this->m_chunkParserState = ChunkParserState::ChunkSize;
+      continue;
+    }
 
-        if (index + 1 == this->m_innerBufferSize)
-        {
-          /*
-           * index + 1 represents the next position to Read. If that's equal to the inner buffer
-           * size it means that there is no more data and we need to fetch more from network. And
-           * whatever we fetch will be the start of the chunk data. The bodyStart is set to 0 to
-           * indicate the the next read call should read from the inner buffer start.
-           */
-          this->m_innerBufferSize = m_connection->ReadFromSocket(
-              this->m_readBuffer, _detail::DefaultLibcurlReaderSize, context);
-          this->m_bodyStartInBuffer = 0;
-        }
-        else
+    // Chunk size lines and trailers end with `\n`, which can come after a `\r`.
+    if (byte == '\n')
+    {
+      if (this->m_chunkParserState == ChunkParserState::Trailer)
+      {
+        // An empty line ends the trailers, and the response.
+        if (this->m_chunkLineLength == 0)
         {
-          /*
-           * index + 1 represents the next position to Read. If that's NOT equal to the inner
-           * buffer size, it means that there is chunk data in the inner buffer. So, we set the
-           * start to the next position to read.
-           */
-          this->m_bodyStartInBuffer = index + 1;
+          this->m_chunkParserState = ChunkParserState::End;
         }
+      }
+      else if (this->m_chunkSize == 0)
+      {
+        // The last chunk. A line with no size at all, like `\n\r\n`, is allowed by the RFC
+        // for a chunk of zero length data and is also the last one.
+        this->m_chunkParserState = ChunkParserState::Trailer;
+      }
+      else
+      {
+        this->m_sessionTotalRead = 0;
+        this->m_chunkParserState = ChunkParserState::ChunkData;
+      }
+      this->m_chunkLineCR = false;
+      this->m_chunkLineLength = 0;
+      continue;
+    }
+    if (this->m_chunkLineCR)
+    {
+      ThrowUnexpectedChunkFraming('\n', byte);
+    }
+    if (byte == '\r')
+    {
+      this->m_chunkLineCR = true;
+      continue;
+    }
 
-        keepPolling = false;
-        break;
+    ++this->m_chunkLineLength;
+    if (this->m_chunkParserState == ChunkParserState::ChunkSize)
+    {
+      // Chunk size comes in Hex value. Anything after it, like chunk extensions, is ignored.
+      auto const digit = HexDigitValue(byte);
+      if (digit < 0)
+      {
+        this->m_chunkParserState = ChunkParserState::ChunkExtension;
+      }
+      else if (this->m_chunkSize > ((std::numeric_limits<size_t>::max)() >> 4))
+      {
+        throw TransportException("Chunk size in HTTP response is too large.");
+      }
+      else
+      {
+        this->m_chunkSize = (this->m_chunkSize << 4) | static_cast<size_t>(digit);
       }
     }
-    if (keepPolling)
-    { // Read all internal buffer and \n was not found, pull from wire
-      this->m_innerBufferSize = m_connection->ReadFromSocket(
-          this->m_readBuffer, _detail::DefaultLibcurlReaderSize, context);
-      this->m_bodyStartInBuffer = 0;
+  }
+  return index;
+}
+
+void CurlSession::ReadChunkFraming(Context const& context)
+{
+  for (;;)
+  {
+    if (this->m_bodyStartInBuffer < this->m_innerBufferSize)
+    {
+      this->m_bodyStartInBuffer += ParseChunkFraming(
+          this->m_readBuffer.data() + this->m_bodyStartInBuffer,
+          this->m_innerBufferSize - this->m_bodyStartInBuffer);
     }
+    if (this->m_chunkParserState == ChunkParserState::ChunkData
+        || this->m_chunkParserState == ChunkParserState::End)
+    {
+      return;
+    }
+
+    // The whole inner buffer was parsed, pull data from wire
+    this->m_innerBufferSize = m_connection->ReadFromSocket(
+        this->m_readBuffer.data(), this->m_readBuffer.size(), context);
+    if (this->m_innerBufferSize == 0)
+    {
+      // closed connection, prevent application from keep trying to pull more bytes from the wire
+      throw TransportException(
+          "Connection was closed by the server while trying to read a response");
+    }
+    this->m_bodyStartInBuffer = 0;
   }
-  return;
 }
 
 // Read status line plus headers to create a response with no body
@@ -867,6 +1033,9 @@ CURLcode CurlSession::ReadStatusLineAndHeadersFromRawResponse(
 {
   auto parser = ResponseBufferParser();
   auto bufferSize = size_t();
+  // The response is read right after the request is sent.
+  auto const sentTime = std::chrono::steady_clock::now();
+  bool firstRead = true;
 
   // Keep reading until all headers were read
   while (!parser.IsParseCompleted())
@@ -877,26 +1046,33 @@ CURLcode CurlSession::ReadStatusLineAndHeadersFromRawResponse(
       // parse from internal buffer. This means previous read from server got more than one
       // response. This happens when Server returns a 100-continue plus an error code
       bufferSize = this->m_innerBufferSize - this->m_bodyStartInBuffer;
-      bytesParsed = parser.Parse(this->m_readBuffer + this->m_bodyStartInBuffer, bufferSize);
+      bytesParsed
+          = parser.Parse(this->m_readBuffer.data() + this->m_bodyStartInBuffer, bufferSize);
       // if parsing from internal buffer is not enough, do next read from wire
       reuseInternalBuffer = false;
       // reset body start
-      this->m_bodyStartInBuffer = _detail::DefaultLibcurlReaderSize;
+      this->m_bodyStartInBuffer = this->m_readBuffer.size();
     }
     else
     {
       // Try to fill internal buffer from socket.
       // If response is smaller than buffer, we will get back the size of the response
       bufferSize = m_connection->ReadFromSocket(
-          this->m_readBuffer, _detail::DefaultLibcurlReaderSize, context);
+          this->m_readBuffer.data(), this->m_readBuffer.size(), context);
       if (bufferSize == 0)
       {
         // closed connection, prevent application from keep trying to pull more bytes from the wire
         Log::Write(Logger::Level::Error, "Failed to read from socket");
         return CURLE_RECV_ERROR;
       }
+      if (firstRead)
+      {
+        firstRead = false;
+        m_transportMetrics->TimeToFirstByte = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - sentTime);
+      }
       // returns the number of bytes parsed up to the body Start
-      bytesParsed = parser.Parse(this->m_readBuffer, bufferSize);
+      bytesParsed = parser.Parse(this->m_readBuffer.data(), bufferSize);
     }
 
     if (bytesParsed < bufferSize)
@@ -984,7 +1160,7 @@ CURLcode CurlSession::ReadStatusLineAndHeadersFromRawResponse(
     {
       std::string connectionHeaderValue;
       {
-        const Core::CaseInsensitiveMap& responseHeaders = m_response->GetHeaders();
+        auto const& responseHeaders = m_response->GetHeaders();
         const auto connectionHeader = responseHeaders.find("Connection");
         if (connectionHeader != responseHeaders.cend())
         {
@@ -1028,7 +1204,7 @@ CURLcode CurlSession::ReadStatusLineAndHeadersFromRawResponse(
       || this->m_lastStatusCode == HttpStatusCode::NotModified)
   {
     this->m_contentLength = 0;
-    this->m_bodyStartInBuffer = _detail::DefaultLibcurlReaderSize;
+    this->m_bodyStartInBuffer = this->m_readBuffer.size();
     return CURLE_OK;
   }
 
@@ -1059,8 +1235,7 @@ CURLcode CurlSession::ReadStatusLineAndHeadersFromRawResponse(
   auto isContentLengthHeaderInResponse = headers.find("content-length");
   if (isContentLengthHeaderInResponse != headers.end())
   {
-    this->m_contentLength
-        = static_cast<int64_t>(std::stoull(isContentLengthHeaderInResponse->second.data()));
+    this->m_contentLength = _detail::ParseContentLength(isContentLengthHeaderInResponse->second);
     return CURLE_OK;
   }
 
@@ -1082,7 +1257,7 @@ CURLcode CurlSession::ReadStatusLineAndHeadersFromRawResponse(
       if (this->m_bodyStartInBuffer >= this->m_innerBufferSize)
       { // if nothing on inner buffer, pull from wire
         this->m_innerBufferSize = m_connection->ReadFromSocket(
-            this->m_readBuffer, _detail::DefaultLibcurlReaderSize, context);
+            this->m_readBuffer.data(), this->m_readBuffer.size(), context);
         if (this->m_innerBufferSize == 0)
         {
           // closed connection, prevent application from keep trying to pull more bytes from the
@@ -1093,7 +1268,7 @@ CURLcode CurlSession::ReadStatusLineAndHeadersFromRawResponse(
         this->m_bodyStartInBuffer = 0;
       }
 
-      ParseChunkSize(context);
+      ReadChunkFraming(context);
       return CURLE_OK;
     }
   }
@@ -1107,43 +1282,6 @@ CURLcode CurlSession::ReadStatusLineAndHeadersFromRawResponse(
   return CURLE_OK;
 }
 
-/**
- * @brief Reads data from network and validates the data is equal to \p expected.
- *
- * @param expected The data that should came from the wire.
- * @param context A context to control the request lifetime.
- */
-void CurlSession::ReadExpected(uint8_t expected, Context const& context)
-{
-  if (this->m_bodyStartInBuffer >= this->m_innerBufferSize)
-  {
-    // end of buffer, pull data from wire
-    this->m_innerBufferSize = m_connection->ReadFromSocket(
-        this->m_readBuffer, _detail::DefaultLibcurlReaderSize, context);
-    if (this->m_innerBufferSize == 0)
-    {
-      // closed connection, prevent application from keep trying to pull more bytes from the wire
-      throw TransportException(
-          "Connection was closed by the server while trying to read a response");
-    }
-    this->m_bodyStartInBuffer = 0;
-  }
-  auto data = this->m_readBuffer[this->m_bodyStartInBuffer];
-  if (data != expected)
-  {
-    throw TransportException(
-        "Unexpected format in HTTP response. Expecting: " + std::to_string(expected)
-        + ", but found: " + std::to_string(data) + ".");
-  }
-  this->m_bodyStartInBuffer += 1;
-}
-
-void CurlSession::ReadCRLF(Context const& context)
-{
-  ReadExpected('\r', context);
-  ReadExpected('\n', context);
-}
-
 // Read from curl session
 size_t CurlSession::OnRead(uint8_t* buffer, size_t count, Context const& context)
 {
@@ -1152,30 +1290,25 @@ size_t CurlSession::OnRead(uint8_t* buffer, size_t count, Context const& context
     return 0;
   }
 
-  // check if all chunked is all read already
-  if (this->m_isChunkedResponseType && this->m_chunkSize == this->m_sessionTotalRead)
+  // Adds the time spent in this read to the metrics, even when the read throws.
+  struct BodyReadTimer final
   {
-    ReadCRLF(context);
-    // Reset session read counter for next chunk
-    this->m_sessionTotalRead = 0;
-    // get the size of next chunk
-    ParseChunkSize(context);
-
-    if (this->IsEOF())
+    std::chrono::microseconds& BodyReadTime;
+    std::chrono::steady_clock::time_point Start;
+    ~BodyReadTimer()
     {
-      /* For a chunk response, EOF means that the last chunk was found.
-       *  As per RFC, after the last chunk, there should be one last CRLF
-       */
-      ReadCRLF(context);
-      // after parsing next chunk, check if it is zero
-      return 0;
+      BodyReadTime += std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - Start);
     }
+  } const bodyReadTimer{m_transportMetrics->BodyReadTime, std::chrono::steady_clock::now()};
+
+  if (this->m_isChunkedResponseType)
+  {
+    return ReadChunkedBody(buffer, count, context);
   }
 
   auto totalRead = size_t();
-  size_t readRequestLength = this->m_isChunkedResponseType
-      ? (std::min)(this->m_chunkSize - this->m_sessionTotalRead, count)
-      : count;
+  size_t readRequestLength = count;
 
   // For responses with content-length, avoid trying to read beyond Content-length or
   // libcurl could return a second response as BadRequest.
@@ -1187,56 +1320,178 @@ size_t CurlSession::OnRead(uint8_t* buffer, size_t count, Context const& context
     readRequestLength = (std::min)(readRequestLength, remainingBodyContent);
   }
 
+  // The data goes straight from the socket to the caller buffer. When the content length is known
+  // and the caller buffer is larger than the inner buffer, keep reading until it is full so large
+  // downloads need fewer calls. Otherwise, return what has arrived so far, a streaming response
+  // might not send more for a long time.
+  bool const fillBuffer
+      = this->m_contentLength > 0 && readRequestLength > this->m_readBuffer.size();
+
   // Take data from inner buffer if any
   if (this->m_bodyStartInBuffer < this->m_innerBufferSize)
   {
     // still have data to take from innerbuffer
-    Azure::Core::IO::MemoryBodyStream innerBufferMemoryStream(
-        this->m_readBuffer + this->m_bodyStartInBuffer,
-        this->m_innerBufferSize - this->m_bodyStartInBuffer);
-
-    // From code inspection, it is guaranteed that the readRequestLength will fit within size_t
-    // since count is bounded by size_t.
-    totalRead = innerBufferMemoryStream.Read(buffer, readRequestLength, context);
+    totalRead = (std::min)(readRequestLength, this->m_innerBufferSize - this->m_bodyStartInBuffer);
+    std::copy(
+        this->m_readBuffer.begin() + this->m_bodyStartInBuffer,
+        this->m_readBuffer.begin() + this->m_bodyStartInBuffer + totalRead,
+        buffer);
     this->m_bodyStartInBuffer += totalRead;
     this->m_sessionTotalRead += totalRead;
 
-    return totalRead;
+    // A caller buffer larger than the inner buffer continues to be filled from the socket.
+    if (totalRead == readRequestLength || !fillBuffer)
+    {
+      return totalRead;
+    }
   }
 
   // Head request have contentLength = 0, so we won't read more, just return 0
   // Also if we have already read all contentLength
   if (this->m_sessionTotalRead == static_cast<size_t>(this->m_contentLength) || this->IsEOF())
   {
-    return 0;
+    return totalRead;
   }
 
   // If we no longer have a connection, read 0 bytes.
   if (!m_connection)
   {
-    return 0;
+    return totalRead;
   }
+
   // Read from socket when no more data on internal buffer
-  // For chunk request, read a chunk based on chunk size
-  totalRead = m_connection->ReadFromSocket(buffer, static_cast<size_t>(readRequestLength), context);
-  this->m_sessionTotalRead += totalRead;
+  do
+  {
+    auto const bytesRead = m_connection->ReadFromSocket(
+        buffer + totalRead, readRequestLength - totalRead, context);
+    this->m_sessionTotalRead += bytesRead;
+    totalRead += bytesRead;
+
+    // Reading 0 bytes means closed connection.
+    // For known content length, this means there is nothing else to read from server or lost
+    // connection before getting full response. For unknown response size, it means the end of
+    // response and it's fine.
+    if (bytesRead == 0)
+    {
+      if (this->m_contentLength > 0
+          && this->m_sessionTotalRead < static_cast<size_t>(this->m_contentLength))
+      {
+        throw TransportException(
+            "Connection closed before getting full response or response is less than "
+            "expected. "
+            "Expected response length = "
+            + std::to_string(this->m_contentLength)
+            + ". Read until now = " + std::to_string(this->m_sessionTotalRead));
+      }
+      break;
+    }
+  } while (fillBuffer && totalRead < readRequestLength);
+
+  return totalRead;
+}
 
-  // Reading 0 bytes means closed connection.
-  // For known content length and chunked response, this means there is nothing else to read
-  // from server or lost connection before getting full response. For unknown response size,
-  // it means the end of response and it's fine.
-  if (totalRead == 0 && (this->m_contentLength > 0 || this->m_isChunkedResponseType))
+size_t CurlSession::ReadChunkedBody(uint8_t* buffer, size_t count, Context const& context)
+{
+  auto totalRead = size_t();
+  while (totalRead < count)
   {
-    auto expectedToRead = this->m_isChunkedResponseType ? this->m_chunkSize : this->m_contentLength;
-    if (this->m_sessionTotalRead < expectedToRead)
+    if (this->m_chunkParserState != ChunkParserState::ChunkData)
+    {
+      if (this->m_bodyStartInBuffer < this->m_innerBufferSize)
+      {
+        this->m_bodyStartInBuffer += ParseChunkFraming(
+            this->m_readBuffer.data() + this->m_bodyStartInBuffer,
+            this->m_innerBufferSize - this->m_bodyStartInBuffer);
+      }
+      if (this->m_chunkParserState != ChunkParserState::ChunkData
+          && this->m_chunkParserState != ChunkParserState::End)
+      {
+        // Return the data already read instead of waiting for the wire.
+        if (totalRead > 0)
+        {
+          break;
+        }
+        ReadChunkFraming(context);
+      }
+      if (this->m_chunkParserState == ChunkParserState::End)
+      {
+        break;
+      }
+    }
+
+    auto const readRequestLength
+        = (std::min)(this->m_chunkSize - this->m_sessionTotalRead, count - totalRead);
+    auto bytesRead = size_t();
+    if (this->m_bodyStartInBuffer < this->m_innerBufferSize)
+    {
+      // Take data from inner buffer. It can hold more than one chunk.
+      bytesRead
+          = (std::min)(readRequestLength, this->m_innerBufferSize - this->m_bodyStartInBuffer);
+      std::copy(
+          this->m_readBuffer.begin() + this->m_bodyStartInBuffer,
+          this->m_readBuffer.begin() + this->m_bodyStartInBuffer + bytesRead,
+          buffer + totalRead);
+      this->m_bodyStartInBuffer += bytesRead;
+    }
+    else if (readRequestLength < this->m_readBuffer.size())
+    {
+      // Return the data already read instead of waiting for the wire.
+      if (totalRead > 0)
+      {
+        break;
+      }
+      // A small read fills the inner buffer instead, so the framing after the chunk data and the
+      // next chunks usually come with the same read.
+      this->m_innerBufferSize = m_connection->ReadFromSocket(
+          this->m_readBuffer.data(), this->m_readBuffer.size(), context);
+      this->m_bodyStartInBuffer = 0;
+      if (this->m_innerBufferSize > 0)
+      {
+        continue;
+      }
+    }
+    else
+    {
+      // The data goes straight from the socket to the caller buffer, up to the end of the chunk.
+      do
+      {
+        auto const socketRead = m_connection->ReadFromSocket(
+            buffer + totalRead + bytesRead, readRequestLength - bytesRead, context);
+        if (socketRead == 0)
+        {
+          break;
+        }
+        bytesRead += socketRead;
+      } while (bytesRead < readRequestLength);
+    }
+
+    // Reading 0 bytes means closed connection before getting the full chunk.
+    if (bytesRead == 0)
     {
       throw TransportException(
           "Connection closed before getting full response or response is less than "
           "expected. "
           "Expected response length = "
-          + std::to_string(expectedToRead)
+          + std::to_string(this->m_chunkSize)
           + ". Read until now = " + std::to_string(this->m_sessionTotalRead));
     }
+
+    totalRead += bytesRead;
+    this->m_sessionTotalRead += bytesRead;
+    if (this->m_sessionTotalRead == this->m_chunkSize)
+    {
+      this->m_chunkParserState = ChunkParserState::ChunkDataEnd;
+    }
+  }
+
+  // Consume the framing already in the inner buffer, so the end of the response is found as soon
+  // as its last byte is read.
+  if (this->m_chunkParserState == ChunkParserState::ChunkDataEnd
+      && this->m_bodyStartInBuffer < this->m_innerBufferSize)
+  {
+    this->m_bodyStartInBuffer += ParseChunkFraming(
+        this->m_readBuffer.data() + this->m_bodyStartInBuffer,
+        this->m_innerBufferSize - this->m_bodyStartInBuffer);
   }
 
   return totalRead;
@@ -1262,6 +1517,10 @@ size_t CurlConnection::ReadFromSocket(uint8_t* buffer, size_t bufferSize, Contex
     switch (readResult)
     {
       case CURLE_AGAIN: {
+        if (m_transportMetrics != nullptr)
+        {
+          ++m_transportMetrics->SocketWaits;
+        }
         // start polling operation
         auto pollUntilSocketIsReady = pollSocketUntilEventOrTimeout(
             context, m_curlSocket, PollSocketDirection::Read, 60000L);
@@ -1292,10 +1551,22 @@ size_t CurlConnection::ReadFromSocket(uint8_t* buffer, size_t bufferSize, Contex
 #if defined(AZ_PLATFORM_WINDOWS)
   WinSocketSetBuffSize(m_curlSocket);
 #endif
+  if (m_transportMetrics != nullptr)
+  {
+    ++m_transportMetrics->SocketReads;
+    m_transportMetrics->BytesReceived += static_cast<int64_t>(readBytes);
+  }
   return readBytes;
 }
 
-std::unique_ptr<RawResponse> CurlSession::ExtractResponse() { return std::move(this->m_response); }
+std::unique_ptr<RawResponse> CurlSession::ExtractResponse()
+{
+  if (this->m_response)
+  {
+    this->m_response->SetTransportMetrics(m_transportMetrics);
+  }
+  return std::move(this->m_response);
+}
 
 size_t CurlSession::ResponseBufferParser::Parse(
     uint8_t const* const buffer,
@@ -1416,10 +1687,9 @@ size_t CurlSession::ResponseBufferParser::Parse(
   return index;
 }
 
-namespace {
 // Calculates the effective timeout value, based on options.ConnectionTimeout and
 // connectionTimeoutOverride. Returns 0 if default.
-long GetConnectionTimeout(
+long Azure::Core::Http::_detail::GetConnectionTimeout(
     CurlTransportOptions const& options,
     std::chrono::milliseconds connectionTimeoutOverride)
 {
@@ -1445,6 +1715,32 @@ long GetConnectionTimeout(
   return connectionTimeoutLong;
 }
 
+int64_t Azure::Core::Http::_detail::ParseContentLength(std::string const& value)
+{
+  if (value.empty())
+  {
+    throw Azure::Core::Http::TransportException("Empty Content-Length in the HTTP response.");
+  }
+  int64_t length = 0;
+  for (auto const c : value)
+  {
+    if (c < '0' || c > '9' || length > (std::numeric_limits<int64_t>::max() - (c - '0')) / 10)
+    {
+      throw Azure::Core::Http::TransportException(
+          "Invalid Content-Length in the HTTP response: " + value + ".");
+    }
+    length = length * 10 + (c - '0');
+  }
+  return length;
+}
+
+namespace {
+// The connection pool timer wheel tick a time point falls in.
+inline int64_t GetTimerWheelTick(std::chrono::steady_clock::time_point time)
+{
+  return time.time_since_epoch() / Azure::Core::Http::_detail::TimerWheelTick;
+}
+
 // Calculate the connection key.
 // The connection key is a tuple of host, proxy info, TLS info, etc. Basically any characteristics
 // of the connection that should indicate that the connection shouldn't be re-used should be listed
@@ -1489,7 +1785,8 @@ inline std::string GetConnectionKey(
   key.append("0");
 #endif
   key.append(",");
-  key.append(std::to_string(GetConnectionTimeout(options, connectionTimeoutOverride)));
+  key.append(std::to_string(
+      Azure::Core::Http::_detail::GetConnectionTimeout(options, connectionTimeoutOverride)));
 
   return key;
 }
@@ -2245,6 +2542,19 @@ int CurlConnection::SslCtxCallback(CURL*, void* sslctx)
 }
 #endif
 
+std::unique_lock<std::mutex> CurlConnectionPool::LockShard(ConnectionPoolShard& shard)
+{
+  std::unique_lock<std::mutex> lock(shard.Mutex, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    // Only measure the time when the lock is contended, so the common path doesn't pay for it.
+    auto const waitStart = std::chrono::steady_clock::now();
+    lock.lock();
+    shard.LockWaitTime += std::chrono::steady_clock::now() - waitStart;
+  }
+  return lock;
+}
+
 std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::ExtractOrCreateCurlConnection(
     Request& request,
     CurlTransportOptions const& options,
@@ -2259,48 +2569,52 @@ std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::ExtractOrCreateCurlCo
       = GetConnectionKey(hostDisplayName, options, connectionTimeoutOverride);
 
   {
-    decltype(CurlConnectionPool::g_curlConnectionPool
-                 .ConnectionPoolIndex)::mapped_type connectionsToBeReset;
+    std::vector<std::unique_ptr<CurlNetworkConnection>> connectionsToBeReset;
 
-    // Critical section. Needs to own ConnectionPoolMutex before executing
-    // Lock mutex to access connection pool. mutex is unlock as soon as lock is out of scope
-    std::unique_lock<std::mutex> lock(CurlConnectionPool::ConnectionPoolMutex);
+    // Critical section. Only the shard for the connection key is locked. Mutex is unlock as soon
+    // as lock is out of scope
+    auto& shard = GetShard(connectionKey);
+    auto lock = LockShard(shard);
 
     // get a ref to the pool from the map of pools
-    auto hostPoolIndex = g_curlConnectionPool.ConnectionPoolIndex.find(connectionKey);
+    auto hostPoolIndex = shard.Index.find(connectionKey);
 
-    if (hostPoolIndex != g_curlConnectionPool.ConnectionPoolIndex.end()
-        && hostPoolIndex->second.size() > 0)
+    if (hostPoolIndex != shard.Index.end() && hostPoolIndex->second.size() > 0)
     {
+      auto& connectionList = hostPoolIndex->second;
       if (resetPool)
       {
-        connectionsToBeReset = std::move(hostPoolIndex->second);
         // clean the pool-index as requested in the call. Typically to force a new connection to be
         // created and to discard all current connections in the pool for the host-index. A caller
         // might request this after getting broken/closed connections multiple-times.
-        hostPoolIndex->second.clear();
+        while (!connectionList.empty())
+        {
+          connectionsToBeReset.emplace_back(
+              RemoveFromShard(shard, connectionList, connectionList.begin()));
+        }
+        shard.Index.erase(hostPoolIndex);
         Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Reset connection pool requested.");
       }
       else
       {
         // get ref to first connection
-        auto fistConnectionIterator = hostPoolIndex->second.begin();
-        // move the connection ref to temp ref
-        auto connection = std::move(*fistConnectionIterator);
-        // Remove the connection ref from list
-        hostPoolIndex->second.erase(fistConnectionIterator);
+        auto connection = RemoveFromShard(shard, connectionList, connectionList.begin());
 
         // Remove index if there are no more connections
-        if (hostPoolIndex->second.size() == 0)
+        if (connectionList.empty())
         {
-          g_curlConnectionPool.ConnectionPoolIndex.erase(hostPoolIndex);
+          shard.Index.erase(hostPoolIndex);
         }
+        ++shard.Hits;
 
         Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Re-using connection from the pool.");
         // return connection ref
         return connection;
       }
     }
+    ++shard.Misses;
+    lock.unlock();
+    // connectionsToBeReset are closed here, without holding the shard lock.
   }
 
   // Creating a new connection is thread safe. No need to lock mutex here.
@@ -2311,11 +2625,32 @@ std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::ExtractOrCreateCurlCo
       request, options, hostDisplayName, connectionKey, connectionTimeoutOverride);
 }
 
+std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::CreateCurlConnection(
+    Request& request,
+    CurlTransportOptions const& options,
+    std::chrono::milliseconds connectionTimeoutOverride)
+{
+  uint16_t port = request.GetUrl().GetPort();
+  std::string const& hostDisplayName = request.GetUrl().GetScheme() + "://"
+      + request.GetUrl().GetHost() + (port != 0 ? ":" + std::to_string(port) : "");
+
+  Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Spawn new connection.");
+
+  return std::make_unique<CurlConnection>(
+      request,
+      options,
+      hostDisplayName,
+      GetConnectionKey(hostDisplayName, options, connectionTimeoutOverride),
+      connectionTimeoutOverride);
+}
+
 // Move the connection back to the connection pool. Push it to the front so it becomes the
 // first connection to be picked next time some one ask for a connection to the pool (LIFO)
 void CurlConnectionPool::MoveConnectionBackToPool(
     std::unique_ptr<CurlNetworkConnection> connection,
-    bool httpKeepAlive)
+    bool httpKeepAlive,
+    size_t maxConnectionsPerHost,
+    size_t maxConnections)
 {
   if (!httpKeepAlive)
   {
@@ -2330,54 +2665,353 @@ void CurlConnectionPool::MoveConnectionBackToPool(
 
   Log::Write(Logger::Level::Verbose, "Moving connection to pool...");
 
-  decltype(CurlConnectionPool::g_curlConnectionPool
-               .ConnectionPoolIndex)::mapped_type::value_type connectionToBeRemoved;
+  std::unique_ptr<CurlNetworkConnection> connectionToBeRemoved;
+  {
+    auto& poolId = connection->GetConnectionKey();
+    auto& shard = GetShard(poolId);
+    // Lock the shard to access its index. mutex is unlock as soon as lock is out of scope
+    auto lock = LockShard(shard);
+
+    // update the time when connection was moved back to pool
+    connection->UpdateLastUsageTime();
+    auto const expiryTime = connection->GetExpiryTime();
 
-  // Lock mutex to access connection pool. mutex is unlock as soon as lock is out of scope
-  std::unique_lock<std::mutex> lock(CurlConnectionPool::ConnectionPoolMutex);
-  auto& poolId = connection->GetConnectionKey();
-  auto& hostPool = g_curlConnectionPool.ConnectionPoolIndex[poolId];
+    if (maxConnectionsPerHost == 0 || (maxConnections != 0 && m_connectionCount >= maxConnections)
+        || expiryTime <= std::chrono::steady_clock::now())
+    {
+      // The pool is full or the connection reached its maximum lifetime. Close the connection
+      // (when going out of scope) instead of keeping it.
+      connectionToBeRemoved = std::move(connection);
+      ++shard.Evictions;
+      return;
+    }
+
+    auto& hostPool = shard.Index[poolId];
+    if (hostPool.size() >= maxConnectionsPerHost && !hostPool.empty())
+    {
+      // Remove the last connection from the pool to insert this one.
+      connectionToBeRemoved = RemoveFromShard(shard, hostPool, --hostPool.end());
+      ++shard.Evictions;
+    }
+
+    AddToShard(shard, hostPool, std::move(connection), expiryTime);
+  }
 
-  if (hostPool.size() >= _detail::MaxConnectionsPerIndex && !hostPool.empty())
+  EnsureCleanThreadIsRunning();
+}
+
+void CurlConnectionPool::EnsureCleanThreadIsRunning()
+{
+  // Cleanup will start a background thread which will close abandoned connections from the pool.
+  // This will free-up resources from the app
+  // The flag is checked without the lock first, so returning a connection to the pool doesn't
+  // take a global lock while the clean thread is running (the common case).
+  if (m_isCleanThreadRunning)
   {
-    // Remove the last connection from the pool to insert this one.
-    auto lastConnection = --hostPool.end();
-    connectionToBeRemoved = std::move(*lastConnection);
-    hostPool.erase(lastConnection);
+    Log::Write(Logger::Level::Verbose, "Clean thread running. Won't start a new one.");
+    return;
   }
 
-  // update the time when connection was moved back to pool
-  connection->UpdateLastUsageTime();
-  hostPool.push_front(std::move(connection));
+  std::lock_guard<std::mutex> lock(m_cleanThreadMutex);
+  if (m_isCleanThreadRunning)
+  {
+    return;
+  }
 
-  if (m_cleanThread.joinable() && !IsCleanThreadRunning)
+  if (m_cleanThread.joinable())
   {
     // Clean thread was running before but it's finished, join it to finalize
     m_cleanThread.join();
   }
 
-  // Cleanup will start a background thread which will close abandoned connections from the pool.
-  // This will free-up resources from the app
-  // This is the only call to cleanup.
-  if (!m_cleanThread.joinable())
+  Log::Write(Logger::Level::Verbose, "Start clean thread");
+  // The first wake up looks at every slot of the timer wheel once.
+  m_lastCleanedTick = GetTimerWheelTick(std::chrono::steady_clock::now())
+      - static_cast<int64_t>(TimerWheelSlotCount);
+  m_isCleanThreadRunning = true;
+  m_cleanThread = std::thread([this]() { CleanupThread(); });
+}
+
+void CurlConnectionPool::AddToShard(
+    ConnectionPoolShard& shard,
+    ConnectionList& connections,
+    std::unique_ptr<CurlNetworkConnection> connection,
+    std::chrono::steady_clock::time_point expiryTime)
+{
+  if (shard.SpareConnections.empty())
+  {
+    shard.SpareConnections.emplace_back();
+    shard.SpareSlotPositions.emplace_back();
+  }
+
+  // The slot of the tick after the expiry time, so the connection has expired when the clean
+  // thread gets to it.
+  auto const tick = GetTimerWheelTick(expiryTime) + 1;
+  auto& slot = shard.TimerWheel[static_cast<size_t>(tick) % TimerWheelSlotCount];
+  connections.splice(connections.begin(), shard.SpareConnections, shard.SpareConnections.begin());
+  slot.splice(slot.end(), shard.SpareSlotPositions, shard.SpareSlotPositions.begin());
+
+  auto& pooledConnection = connections.front();
+  pooledConnection.Connection = std::move(connection);
+  pooledConnection.ExpiryTime = expiryTime;
+  pooledConnection.Slot = &slot;
+  pooledConnection.SlotPosition = --slot.end();
+  slot.back() = connections.begin();
+  ++m_connectionCount;
+}
+
+std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::RemoveFromShard(
+    ConnectionPoolShard& shard,
+    ConnectionList& connections,
+    ConnectionList::iterator position)
+{
+  auto connection = std::move(position->Connection);
+  shard.SpareSlotPositions.splice(
+      shard.SpareSlotPositions.end(), *position->Slot, position->SlotPosition);
+  shard.SpareConnections.splice(shard.SpareConnections.end(), connections, position);
+  --m_connectionCount;
+  return connection;
+}
+
+void CurlConnectionPool::CleanTimerWheelSlot(
+    ConnectionPoolShard& shard,
+    size_t slot,
+    std::chrono::steady_clock::time_point now)
+{
+  auto& timerWheelSlot = shard.TimerWheel[slot];
+  // Connections expiring in a later turn of the wheel are moved to the back of the slot, so each
+  // connection in the slot is looked at once.
+  size_t connectionsToCheck = 0;
   {
-    Log::Write(Logger::Level::Verbose, "Start clean thread");
-    IsCleanThreadRunning = true;
-    m_cleanThread = std::thread(CleanupThread);
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    connectionsToCheck = timerWheelSlot.size();
   }
-  else
+
+  for (; connectionsToCheck > 0; --connectionsToCheck)
   {
-    Log::Write(Logger::Level::Verbose, "Clean thread running. Won't start a new one.");
+    std::unique_ptr<CurlNetworkConnection> connectionToBeCleaned;
+    {
+      std::lock_guard<std::mutex> lock(shard.Mutex);
+      if (timerWheelSlot.empty())
+      {
+        break;
+      }
+
+      auto position = timerWheelSlot.front();
+      if (position->ExpiryTime > now)
+      {
+        timerWheelSlot.splice(timerWheelSlot.end(), timerWheelSlot, timerWheelSlot.begin());
+        continue;
+      }
+
+      auto index = shard.Index.find(position->Connection->GetConnectionKey());
+      connectionToBeCleaned = RemoveFromShard(shard, index->second, position);
+      if (index->second.empty())
+      {
+        shard.Index.erase(index);
+      }
+      ++shard.Evictions;
+    }
+    // Do actual connection release work here, without holding the mutex.
   }
 }
 
+void CurlConnectionPool::CleanupThread()
+{
+  // NOTE: Avoid using Log::Write in here as it may fail on macOS,
+  // see issue: https://github.com/Azure/azure-sdk-for-cpp/issues/3224
+  // This method can wake up in de-attached mode after the application has been terminated.
+  // If that happens, trying to use `Log` would cause `abort` as it was previously deallocated.
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> lockForPoolCleaning(m_cleanThreadMutex);
+
+      // Wait for the next tick OR to the signal from the conditional variable.
+      // wait_for releases the mutex lock when it goes to sleep and it takes the lock again when it
+      // wakes up (or it's cancelled).
+      if (ConditionalVariableForCleanThread.wait_for(
+              lockForPoolCleaning, TimerWheelTick, [this]() { return m_connectionCount == 0; }))
+      {
+        // Cancelled by another thread or no connections on wakeup.
+        m_isCleanThreadRunning = false;
+        // A connection could have been moved to the pool after checking the count, but before
+        // clearing the flag, and that thread would have seen the clean thread as running.
+        // Re-check to avoid leaving that connection without a clean thread.
+        if (m_connectionCount == 0)
+        {
+          break;
+        }
+        m_isCleanThreadRunning = true;
+      }
+    }
+
+    // Clean the slots of the ticks that passed since the last wake up. Each shard is locked only
+    // while one connection is removed, so requests can still get and return connections.
+    auto const now = std::chrono::steady_clock::now();
+    auto const currentTick = GetTimerWheelTick(now);
+    for (auto tick
+         = std::max(m_lastCleanedTick, currentTick - static_cast<int64_t>(TimerWheelSlotCount)) + 1;
+         tick <= currentTick;
+         ++tick)
+    {
+      for (auto& shard : m_shards)
+      {
+        CleanTimerWheelSlot(shard, static_cast<size_t>(tick) % TimerWheelSlotCount, now);
+      }
+    }
+    m_lastCleanedTick = currentTick;
+  }
+}
+
+void CurlConnectionPool::ClearConnectionPool()
+{
+  for (auto& shard : m_shards)
+  {
+    decltype(shard.Index) connectionsToBeCleaned;
+    {
+      std::lock_guard<std::mutex> lock(shard.Mutex);
+      for (auto const& hostPool : shard.Index)
+      {
+        m_connectionCount -= hostPool.second.size();
+      }
+      connectionsToBeCleaned.swap(shard.Index);
+      for (auto& slot : shard.TimerWheel)
+      {
+        slot.clear();
+      }
+      shard.SpareConnections.clear();
+      shard.SpareSlotPositions.clear();
+    }
+  }
+}
+
+size_t CurlConnectionPool::ConnectionPoolIndexSize()
+{
+  size_t size = 0;
+  for (auto& shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    size += shard.Index.size();
+  }
+  return size;
+}
+
+size_t CurlConnectionPool::ConnectionsOnPool(std::string const& host)
+{
+  auto& shard = GetShard(host);
+  std::lock_guard<std::mutex> lock(shard.Mutex);
+  auto hostPool = shard.Index.find(host);
+  return hostPool == shard.Index.end() ? 0 : hostPool->second.size();
+}
+
+Azure::Core::Http::CurlConnectionPoolStatistics CurlConnectionPool::GetStatistics()
+{
+  Azure::Core::Http::CurlConnectionPoolStatistics statistics;
+  for (auto& shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    statistics.Hits += shard.Hits;
+    statistics.Misses += shard.Misses;
+    statistics.Evictions += shard.Evictions;
+    statistics.LockWaitTime += shard.LockWaitTime;
+  }
+  statistics.PooledConnections = m_connectionCount;
+  statistics.FullTlsHandshakes = m_fullTlsHandshakes;
+  statistics.ResumedTlsHandshakes = m_resumedTlsHandshakes;
+  return statistics;
+}
+
+namespace {
+void LockShareHandle(CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+{
+  static_cast<Azure::Core::_detail::CURLSHWrapper*>(userptr)->Locks[data].lock();
+}
+
+void UnlockShareHandle(CURL*, curl_lock_data data, void* userptr)
+{
+  static_cast<Azure::Core::_detail::CURLSHWrapper*>(userptr)->Locks[data].unlock();
+}
+} // namespace
+
+std::shared_ptr<Azure::Core::_detail::CURLSHWrapper> CurlConnectionPool::GetShareHandle(
+    std::string const& host,
+    bool shareSslSessions,
+    std::string const& hostDisplayName)
+{
+  auto const key = host + (shareSslSessions ? ",1" : ",0");
+  std::lock_guard<std::mutex> lock(m_shareHandlesMutex);
+  auto const existing = m_shareHandles.find(key);
+  if (existing != m_shareHandles.end())
+  {
+    return existing->second;
+  }
+
+  if (m_shareHandles.size() >= _detail::MaxShareHandles)
+  {
+    // Drop the handles no connection uses anymore, so the map doesn't grow with every host the
+    // process ever talked to. A handle can only be handed out under the mutex, so one that only
+    // the map holds can't be picked up while it is erased.
+    for (auto shareHandle = m_shareHandles.begin(); shareHandle != m_shareHandles.end();)
+    {
+      if (shareHandle->second.use_count() == 1)
+      {
+        shareHandle = m_shareHandles.erase(shareHandle);
+      }
+      else
+      {
+        ++shareHandle;
+      }
+    }
+  }
+  auto& shareHandle = m_shareHandles[key];
+
+  auto newShareHandle = std::make_shared<Azure::Core::_detail::CURLSHWrapper>();
+  if (!newShareHandle->share_handle)
+  {
+    m_shareHandles.erase(key);
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string("curl_share_init returned Null"));
+  }
+
+  // Connections to the same host run on different threads, libcurl needs the lock callbacks to
+  // use the share handle from all of them.
+  CURLSHcode shResult;
+  if (!SetLibcurlShareOption(*newShareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS, &shResult)
+      || (shareSslSessions
+          && !SetLibcurlShareOption(
+              *newShareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION, &shResult))
+      || !SetLibcurlShareOption(
+          *newShareHandle, CURLSHOPT_USERDATA, newShareHandle.get(), &shResult)
+      || !SetLibcurlShareOption(*newShareHandle, CURLSHOPT_LOCKFUNC, LockShareHandle, &shResult)
+      || !SetLibcurlShareOption(
+          *newShareHandle, CURLSHOPT_UNLOCKFUNC, UnlockShareHandle, &shResult))
+  {
+    m_shareHandles.erase(key);
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string(curl_share_strerror(shResult)));
+  }
+
+  shareHandle = newShareHandle;
+  return shareHandle;
+}
+
 CurlConnection::CurlConnection(
     Request& request,
     CurlTransportOptions const& options,
     std::string const& hostDisplayName,
     std::string const& connectionPropertiesKey,
     std::chrono::milliseconds connectionTimeoutOverride)
-    : m_connectionKey(connectionPropertiesKey)
+    : m_idleTimeout(
+        options.ConnectionIdleTimeout.count() > 0 ? options.ConnectionIdleTimeout
+                                                  : _detail::DefaultConnectionIdleTimeout),
+      m_maxLifetimeExpiryTime(
+          options.ConnectionMaxLifetime.count() > 0
+              ? std::chrono::steady_clock::now() + options.ConnectionMaxLifetime
+              : std::chrono::steady_clock::time_point::max()),
+      m_connectionKey(connectionPropertiesKey)
 {
   m_handle = Azure::Core::_internal::UniqueHandle<CURL>(curl_easy_init());
   if (!m_handle)
@@ -2398,32 +3032,24 @@ CurlConnection::CurlConnection(
           + std::string(curl_easy_strerror(result)));
     }
   }
-  else
-  {
-    m_sslShareHandle = std::make_unique<Azure::Core::_detail::CURLSHWrapper>();
 
-    if (!m_sslShareHandle->share_handle)
-    {
-      throw Azure::Core::Http::TransportException(
-          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
-          + std::string("curl_share_init returned Null"));
-    }
+  // The DNS entries, and the TLS sessions when they are cached, are shared with all the
+  // connections to the host, so a new connection doesn't resolve the host name again and can
+  // resume a TLS session instead of doing a full handshake.
+  m_shareHandle = CurlConnectionPool::g_curlConnectionPool.GetShareHandle(
+      request.GetUrl().GetScheme() + "://" + request.GetUrl().GetHost() + ":"
+          + std::to_string(request.GetUrl().GetPort()),
+      options.EnableCurlSslCaching,
+      hostDisplayName);
 
-    CURLSHcode shResult;
-    if (!SetLibcurlShareOption(
-            m_sslShareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION, &shResult))
-    {
-      throw Azure::Core::Http::TransportException(
-          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
-          + std::string(curl_share_strerror(shResult)));
-    }
-
-    if (!SetLibcurlOption(m_handle, CURLOPT_SHARE, m_sslShareHandle->share_handle, &result))
-    {
-      throw Azure::Core::Http::TransportException(
-          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
-          + std::string(curl_easy_strerror(result)));
-    }
+  if (!SetLibcurlOption(m_handle, CURLOPT_SHARE, m_shareHandle->share_handle, &result)
+      || !SetLibcurlOption(
+          m_handle, CURLOPT_DNS_CACHE_TIMEOUT, static_cast<long>(options.DnsCacheTimeout.count()),
+          &result))
+  {
+    throw Azure::Core::Http::TransportException(
+        _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName + ". "
+        + std::string(curl_easy_strerror(result)));
   }
 
   if (options.EnableCurlTracing)
@@ -2480,7 +3106,8 @@ CurlConnection::CurlConnection(
   }
 
   {
-    const long connectionTimeout = GetConnectionTimeout(options, connectionTimeoutOverride);
+    const long connectionTimeout
+        = _detail::GetConnectionTimeout(options, connectionTimeoutOverride);
     if (connectionTimeout > 0)
     {
       if (!SetLibcurlOption(m_handle, CURLOPT_CONNECTTIMEOUT_MS, connectionTimeout, &result))
@@ -2697,4 +3324,24 @@ CurlConnection::CurlConnection(
         "Broken connection. Couldn't get the active socket for it."
         + std::string(curl_easy_strerror(result)));
   }
+
+#if LIBCURL_VERSION_NUM >= 0x073D00 // 7.61.0
+  // Each time is measured from the start of curl_easy_perform and includes the previous steps.
+  curl_off_t nameLookupTime = 0;
+  curl_off_t connectTime = 0;
+  curl_off_t tlsHandshakeTime = 0;
+  if (curl_easy_getinfo(m_handle.get(), CURLINFO_NAMELOOKUP_TIME_T, &nameLookupTime) == CURLE_OK
+      && curl_easy_getinfo(m_handle.get(), CURLINFO_CONNECT_TIME_T, &connectTime) == CURLE_OK
+      && curl_easy_getinfo(m_handle.get(), CURLINFO_APPCONNECT_TIME_T, &tlsHandshakeTime)
+          == CURLE_OK)
+  {
+    m_nameLookupTime = std::chrono::microseconds(nameLookupTime);
+    m_connectTime = std::chrono::microseconds(connectTime - nameLookupTime);
+    // The TLS handshake time is 0 for plain HTTP connections.
+    if (tlsHandshakeTime > connectTime)
+    {
+      m_tlsHandshakeTime = std::chrono::microseconds(tlsHandshakeTime - connectTime);
+    }
+  }
+#endif
 }
@@ -15,6 +15,7 @@
 
 #include <azure/core/http/curl_transport.hpp>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -31,6 +32,9 @@ namespace Azure { namespace Core { namespace Test {
   class CurlConnectionPool_DISABLED_connectionPoolTest_Test;
   class CurlConnectionPool_uniquePort_Test;
   class CurlConnectionPool_connectionClose_Test;
+  class CurlConnectionPool_poolLimits_Test;
+  class CurlConnectionPool_timerWheelExpiry_Test;
+  class CurlConnectionPool_shareHandleLimit_Test;
   class SdkWithLibcurl_globalCleanUp_Test;
 }}} // namespace Azure::Core::Test
 #endif
@@ -43,6 +47,14 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
    *
    * This pool offers static methods and it is allocated statically. There can be only one
    * connection pool per application.
+   *
+   * @remark The pool is split into #ConnectionPoolShardCount shards. Each connection key is
+   * mapped to one shard and only that shard's mutex is taken to extract or return a connection,
+   * so threads working against different hosts don't contend on a single lock.
+   *
+   * @remark Idle connections are closed by a timer wheel. Each shard has one slot per
+   * #TimerWheelTick and a connection is linked to the slot of the tick it expires in, so the
+   * clean thread only looks at the connections expiring in the current tick.
    */
   class CurlConnectionPool final {
 #if defined(_azure_TESTING_BUILD)
@@ -51,6 +63,9 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
     friend class Azure::Core::Test::CurlConnectionPool_DISABLED_connectionPoolTest_Test;
     friend class Azure::Core::Test::CurlConnectionPool_uniquePort_Test;
     friend class Azure::Core::Test::CurlConnectionPool_connectionClose_Test;
+    friend class Azure::Core::Test::CurlConnectionPool_poolLimits_Test;
+    friend class Azure::Core::Test::CurlConnectionPool_timerWheelExpiry_Test;
+    friend class Azure::Core::Test::CurlConnectionPool_shareHandleLimit_Test;
     friend class Azure::Core::Test::SdkWithLibcurl_globalCleanUp_Test;
 #endif
 
@@ -60,10 +75,12 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
       using namespace Azure::Core::Http::_detail;
       if (m_cleanThread.joinable())
       {
+        // Remove all connections
+        ClearConnectionPool();
         {
-          std::unique_lock<std::mutex> lock(ConnectionPoolMutex);
-          // Remove all connections
-          g_curlConnectionPool.ConnectionPoolIndex.clear();
+          // Take the lock so the clean thread is either waiting (and gets the signal) or has not
+          // checked the pool yet (and finds it empty).
+          std::lock_guard<std::mutex> lock(m_cleanThreadMutex);
         }
         // Signal clean thread to wake up
         ConditionalVariableForCleanThread.notify_one();
@@ -93,29 +110,80 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
         std::chrono::milliseconds connectionTimeoutOverride = std::chrono::milliseconds{0},
         bool resetPool = false);
 
+    /**
+     * @brief Creates a new connection, without looking for one in the pool.
+     *
+     * @param request HTTP request to get #Azure::Core::Http::CurlNetworkConnection for.
+     * @param options The connection settings which includes host name and libcurl handle specific
+     * configuration.
+     * @param connectionTimeoutOverride If greater than 0, specifies the override value for the
+     * ConnectionTimeout value, specified in options.
+     *
+     * @return #Azure::Core::Http::CurlNetworkConnection to use.
+     */
+    std::unique_ptr<CurlNetworkConnection> CreateCurlConnection(
+        Request& request,
+        CurlTransportOptions const& options,
+        std::chrono::milliseconds connectionTimeoutOverride = std::chrono::milliseconds{0});
+
     /**
      * @brief Moves a connection back to the pool to be re-used.
      *
      * @param connection CURL HTTP connection to add to the pool.
      * @param httpKeepAlive The status of keep-alive behavior, based on HTTP protocol version and
      * the most recent response header received through the \p connection.
+     * @param maxConnectionsPerHost The maximum number of idle connections to keep for the
+     * connection key of \p connection. The oldest one is closed when the limit is reached.
+     * @param maxConnections The maximum number of idle connections to keep in the whole pool. `0`
+     * means no limit. When the limit is reached, \p connection is closed instead of pooled.
      */
     void MoveConnectionBackToPool(
         std::unique_ptr<CurlNetworkConnection> connection,
-        bool httpKeepAlive);
+        bool httpKeepAlive,
+        size_t maxConnectionsPerHost = DefaultMaxPooledConnectionsPerHost,
+        size_t maxConnections = 0);
+
+    /**
+     * @brief Removes and closes all the connections from the pool.
+     */
+    void ClearConnectionPool();
+
+    /**
+     * @brief Gets the number of connection keys with at least one connection in the pool.
+     */
+    size_t ConnectionPoolIndexSize();
 
     /**
-     * @brief Keeps a unique key for each host and creates a connection pool for each key.
+     * @brief Collects the counters from all the shards of the pool.
+     */
+    CurlConnectionPoolStatistics GetStatistics();
+
+    /**
+     * @brief Gets the libcurl share handle caching the DNS entries and, optionally, the TLS
+     * sessions for a host. The handle is created the first time a host is seen. Once the pool
+     * has #MaxShareHandles of them, the ones no connection uses are dropped.
      *
-     * @details This way getting a connection for a specific host can be done in O(1) instead of
-     * looping a single connection list to find the first connection for the required host.
+     * @param host The scheme, host and port the caches are for.
+     * @param shareSslSessions `true` to share the TLS sessions too. Connections which don't cache
+     * TLS sessions get a different handle.
+     * @param hostDisplayName The host name used in error messages.
      *
-     * @remark There might be multiple connections for each host.
+     * @throw TransportException if the share handle can't be created.
      */
-    std::unordered_map<std::string, std::list<std::unique_ptr<CurlNetworkConnection>>>
-        ConnectionPoolIndex;
+    std::shared_ptr<Azure::Core::_detail::CURLSHWrapper> GetShareHandle(
+        std::string const& host,
+        bool shareSslSessions,
+        std::string const& hostDisplayName);
 
-    std::mutex ConnectionPoolMutex;
+    /**
+     * @brief Counts a TLS handshake done by a new connection.
+     *
+     * @param resumed `true` if the handshake resumed a cached TLS session.
+     */
+    void RecordTlsHandshake(bool resumed)
+    {
+      ++(resumed ? m_resumedTlsHandshakes : m_fullTlsHandshakes);
+    }
 
     // This is used to put the cleaning pool thread to sleep and yet to be able to wake it if the
     // application finishes.
@@ -124,17 +192,109 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
     AZ_CORE_DLLEXPORT
     static Azure::Core::Http::_detail::CurlConnectionPool g_curlConnectionPool;
 
-    bool IsCleanThreadRunning = false;
-
   private:
+    struct PooledConnection;
+    using ConnectionList = std::list<PooledConnection>;
+    using TimerWheelSlot = std::list<ConnectionList::iterator>;
+
+    /**
+     * @brief A connection waiting in the pool. It's linked from the list of its connection key
+     * and from the timer wheel slot of the tick it expires in, so it can be removed from either
+     * side with one list operation.
+     */
+    struct PooledConnection final
+    {
+      std::unique_ptr<CurlNetworkConnection> Connection;
+      std::chrono::steady_clock::time_point ExpiryTime;
+      TimerWheelSlot* Slot;
+      TimerWheelSlot::iterator SlotPosition;
+    };
+
+    /**
+     * @brief One partition of the pool. The mutex guards the index, the timer wheel and the
+     * counters.
+     *
+     * @details The index keeps a unique key for each host, so getting a connection for a specific
+     * host is O(1). There might be multiple connections for each host and keys are removed as
+     * soon as their list becomes empty.
+     */
+    struct ConnectionPoolShard final
+    {
+      std::mutex Mutex;
+      std::unordered_map<std::string, ConnectionList> Index;
+      std::array<TimerWheelSlot, TimerWheelSlotCount> TimerWheel;
+      // List nodes of connections which left the pool, re-used by the next connection moved to
+      // the pool so moving connections in and out of the pool doesn't allocate.
+      ConnectionList SpareConnections;
+      TimerWheelSlot SpareSlotPositions;
+      uint64_t Hits = 0;
+      uint64_t Misses = 0;
+      uint64_t Evictions = 0;
+      std::chrono::nanoseconds LockWaitTime{0};
+    };
+
     // private constructor to keep this as singleton.
     CurlConnectionPool() { curl_global_init(CURL_GLOBAL_ALL); }
 
+    ConnectionPoolShard& GetShard(std::string const& connectionKey)
+    {
+      return m_shards[std::hash<std::string>{}(connectionKey) % m_shards.size()];
+    }
+
+    // Locks the shard and accounts for the time spent waiting when the lock is contended.
+    static std::unique_lock<std::mutex> LockShard(ConnectionPoolShard& shard);
+
+    // Starts the clean thread if it is not running.
+    void EnsureCleanThreadIsRunning();
+
+    // Runs on m_cleanThread, removes the connections expiring in each tick of the timer wheel.
+    void CleanupThread();
+
+    // Closes the expired connections in one timer wheel slot of the shard. The shard is locked
+    // for each connection removed, not for the whole slot.
+    void CleanTimerWheelSlot(
+        ConnectionPoolShard& shard,
+        size_t slot,
+        std::chrono::steady_clock::time_point now);
+
+    // Adds a connection to the front of the list of its key and to the timer wheel. The shard must
+    // be locked.
+    void AddToShard(
+        ConnectionPoolShard& shard,
+        ConnectionList& connections,
+        std::unique_ptr<CurlNetworkConnection> connection,
+        std::chrono::steady_clock::time_point expiryTime);
+
+    // Removes a connection from the list of its key and from the timer wheel. The shard must be
+    // locked.
+    std::unique_ptr<CurlNetworkConnection> RemoveFromShard(
+        ConnectionPoolShard& shard,
+        ConnectionList& connections,
+        ConnectionList::iterator position);
+
     // Makes possible to know the number of current connections in the connection pool for an
     // index
-    size_t ConnectionsOnPool(std::string const& host) { return ConnectionPoolIndex[host].size(); }
+    size_t ConnectionsOnPool(std::string const& host);
 
+    std::array<ConnectionPoolShard, ConnectionPoolShardCount> m_shards;
+
+    // Total number of connections in all the shards. Used for the global limit and to let the
+    // clean thread know when there is nothing left to clean.
+    std::atomic<size_t> m_connectionCount{0};
+
+    std::mutex m_cleanThreadMutex;
+    std::atomic<bool> m_isCleanThreadRunning{false};
     std::thread m_cleanThread;
+    // The last timer wheel tick cleaned. Only used by the clean thread.
+    int64_t m_lastCleanedTick = 0;
+
+    // DNS and TLS session caches, one for each scheme, host and port. libcurl keeps a few
+    // sessions in each of them.
+    std::mutex m_shareHandlesMutex;
+    std::unordered_map<std::string, std::shared_ptr<Azure::Core::_detail::CURLSHWrapper>>
+        m_shareHandles;
+    std::atomic<uint64_t> m_fullTlsHandshakes{0};
+    std::atomic<uint64_t> m_resumedTlsHandshakes{0};
   };
 
 }}}} // namespace Azure::Core::Http::_detail
@@ -9,10 +9,15 @@
 
 #pragma once
 
+#include "azure/core/http/curl_transport.hpp"
 #include "azure/core/http/http.hpp"
 #include "azure/core/internal/unique_handle.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #if defined(_MSC_VER)
@@ -53,6 +58,9 @@ namespace Azure { namespace Core {
     struct CURLSHWrapper
     {
       CURLSH* share_handle;
+      // Used by the lock callbacks when the share handle is used from many threads, one mutex for
+      // each kind of shared data.
+      std::array<std::mutex, CURL_LOCK_DATA_LAST> Locks;
 
       CURLSHWrapper() : share_handle{curl_share_init()} {};
 
@@ -84,14 +92,45 @@ namespace Azure { namespace Core {
       // After 3 connections are received from the pool and failed to send a request, the next
       // connections would ask the pool to be clean and spawn new connection.
       constexpr static int32_t RequestPoolResetAfterConnectionFailed = 3;
-      // 90 sec -> cleaner wait time before next clean routine
-      constexpr static int32_t DefaultCleanerIntervalMilliseconds = 1000 * 90;
-      // 60 sec -> expired connection is when it waits for 60 sec or more and it's not re-used
-      constexpr static int32_t DefaultConnectionExpiredMilliseconds = 1000 * 60;
-      // Define the maximum allowed connections per host-index in the pool. If this number is
-      // reached for the host-index, next connections trying to be added to the pool will be
-      // ignored.
-      constexpr static int32_t MaxConnectionsPerIndex = 1024;
+      // The clean thread wakes up once per tick of the connection pool timer wheel and closes the
+      // connections which expired during that tick.
+      constexpr static std::chrono::seconds TimerWheelTick{1};
+      // Number of slots in the connection pool timer wheel, one per tick. A connection expiring
+      // more than one turn of the wheel away is looked at once per turn until it expires.
+      constexpr static size_t TimerWheelSlotCount = 64;
+      // Number of shards the connection pool is split into. Each shard has its own lock, so
+      // requests to hosts that land on different shards never wait for each other.
+      constexpr static size_t ConnectionPoolShardCount = 64;
+      // Number of threads opening connections at the same time in CurlTransport::Prewarm.
+      constexpr static size_t MaxPrewarmThreads = 8;
+      // Number of hosts the connection pool keeps DNS and TLS session caches for. Past that, the
+      // caches not used by any connection are dropped.
+      constexpr static size_t MaxShareHandles = 64;
+
+      struct CurlMultiTransfer;
+
+      /**
+       * @brief Calculates the connection timeout in milliseconds to set on a libcurl handle.
+       *
+       * @return The effective timeout, or 0 to keep the libcurl default.
+       */
+      long GetConnectionTimeout(
+          CurlTransportOptions const& options,
+          std::chrono::milliseconds connectionTimeoutOverride);
+
+      /**
+       * @brief Parses the value of a `Content-Length` response header.
+       *
+       * @return The content length.
+       * @throw TransportException if the value is not a valid non-negative 64-bit integer.
+       */
+      int64_t ParseContentLength(std::string const& value);
+
+      /**
+       * @brief Maps the common Azure transport options to the libcurl transport options.
+       */
+      CurlTransportOptions CurlTransportOptionsFromTransportOptions(
+          Policies::TransportOptions const& transportOptions);
 
     } // namespace _detail
 
@@ -106,6 +145,13 @@ namespace Azure { namespace Core {
     private:
       bool m_isShutDown = false;
 
+    protected:
+      /**
+       * @brief Metrics of the request using the connection, or `nullptr`.
+       *
+       */
+      TransportMetrics* m_transportMetrics = nullptr;
+
     public:
       /**
        * @brief Allow derived classes calling a destructor.
@@ -131,6 +177,26 @@ namespace Azure { namespace Core {
        */
       virtual bool IsExpired() = 0;
 
+      /**
+       * @brief Gets the time when the connection expires if it stays idle from its last usage
+       * time.
+       *
+       * @remark The connection pool closes an idle connection at this time. The default
+       * implementation never expires.
+       *
+       */
+      virtual std::chrono::steady_clock::time_point GetExpiryTime() const
+      {
+        return std::chrono::steady_clock::time_point::max();
+      }
+
+      /**
+       * @brief Set the metrics of the request using the connection. The connection adds its socket
+       * counters to them until it is set to `nullptr`.
+       *
+       */
+      virtual void SetTransportMetrics(TransportMetrics* metrics) { m_transportMetrics = metrics; }
+
       /**
        * @brief This function is used when working with streams to pull more data from the wire.
        * Function will try to keep pulling data from socket until the buffer is all written or until
@@ -168,15 +234,29 @@ namespace Azure { namespace Core {
      */
     class CurlConnection final : public CurlNetworkConnection {
     private:
-      Azure::Core::_detail::UniqueCURLSHHandle m_sslShareHandle;
+      // Shared with all the connections to the same host, see
+      // #Azure::Core::Http::_detail::CurlConnectionPool::GetShareHandle.
+      std::shared_ptr<Azure::Core::_detail::CURLSHWrapper> m_shareHandle;
       Azure::Core::_internal::UniqueHandle<CURL> m_handle;
       curl_socket_t m_curlSocket = CURL_SOCKET_BAD;
       std::chrono::steady_clock::time_point m_lastUseTime;
+      std::chrono::milliseconds m_idleTimeout;
+      // When the connection reaches its maximum lifetime, or `max()` if it has none.
+      std::chrono::steady_clock::time_point m_maxLifetimeExpiryTime;
       std::string m_connectionKey;
+      // Time to set up the connection, reported to the first request using it.
+      std::chrono::microseconds m_nameLookupTime{0};
+      std::chrono::microseconds m_connectTime{0};
+      std::chrono::microseconds m_tlsHandshakeTime{0};
+      bool m_setupTimesReported{false};
       // CRL validation is disabled by default to be consistent with WinHTTP behavior
       bool m_enableCrlValidation{false};
       // Allow the connection to proceed if retrieving the CRL failed.
       bool m_allowFailedCrlRetrieval{true};
+      // The TLS handshake is counted after the connection first sends data.
+      bool m_tlsHandshakeRecorded{false};
+
+      void RecordTlsHandshake();
 
       static int CurlLoggingCallback(
           CURL* handle,
@@ -189,6 +269,9 @@ namespace Azure { namespace Core {
       int SslCtxCallback(CURL* curl, void* sslctx);
       int VerifyCertificateError(int ok, X509_STORE_CTX* storeContext);
 
+      // The multi transport sets up its handles with the same logging callback.
+      friend struct _detail::CurlMultiTransfer;
+
     public:
       /**
        * @brief Construct CURL HTTP connection.
@@ -229,13 +312,25 @@ namespace Azure { namespace Core {
        * @brief Checks whether this CURL connection is expired.
        * @return `true` if this connection is considered expired; otherwise, `false`.
        */
-      bool IsExpired() override
+      bool IsExpired() override { return std::chrono::steady_clock::now() >= GetExpiryTime(); }
+
+      /**
+       * @brief Gets the time when the connection expires, either because it was idle for longer
+       * than the idle timeout or because it reached its maximum lifetime.
+       */
+      std::chrono::steady_clock::time_point GetExpiryTime() const override
       {
-        auto connectionOnWaitingTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - this->m_lastUseTime);
-        return connectionOnWaitingTimeMs.count() >= _detail::DefaultConnectionExpiredMilliseconds;
+        return std::min(m_lastUseTime + m_idleTimeout, m_maxLifetimeExpiryTime);
       }
 
+      /**
+       * @brief Set the metrics of the request using the connection.
+       *
+       * @remark The first request gets the time it took to set up the connection. The next ones
+       * are marked as using a reused connection.
+       */
+      void SetTransportMetrics(TransportMetrics* metrics) override;
+
       /**
        * @brief This function is used when working with streams to pull more data from the wire.
        * Function will try to keep pulling data from socket until the buffer is all written or until
@@ -0,0 +1,896 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/platform.hpp"
+
+#if defined(AZ_PLATFORM_WINDOWS)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#endif
+
+#include "azure/core/http/curl_transport.hpp"
+#include "azure/core/http/http.hpp"
+#include "azure/core/internal/diagnostics/log.hpp"
+
+// Private include
+#include "curl_connection_private.hpp"
+#include "curl_multi_private.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+using Azure::Core::Context;
+using Azure::Core::Diagnostics::Logger;
+using Azure::Core::Diagnostics::_internal::Log;
+using Azure::Core::Http::CurlMultiTransport;
+using Azure::Core::Http::CurlTransportOptions;
+using Azure::Core::Http::HttpMethod;
+using Azure::Core::Http::HttpStatusCode;
+using Azure::Core::Http::RawResponse;
+using Azure::Core::Http::Request;
+using Azure::Core::Http::TransportException;
+using Azure::Core::Http::_detail::CurlMultiBodyStream;
+using Azure::Core::Http::_detail::CurlMultiEventLoop;
+using Azure::Core::Http::_detail::CurlMultiTransfer;
+
+namespace {
+std::string const LogMsgPrefix = "[CURL Multi Transport Adapter]: ";
+
+template <typename T>
+#if defined(_MSC_VER)
+#pragma warning(push)
+// C26812: The enum type 'CURLoption' is un-scoped. Prefer 'enum class' over 'enum' (Enum.3)
+#pragma warning(disable : 26812)
+#endif
+inline void SetTransferOption(
+    Azure::Core::_internal::UniqueHandle<CURL> const& handle,
+    CURLoption option,
+    T value,
+    std::string const& description)
+{
+  auto const result = curl_easy_setopt(handle.get(), option, value);
+  if (result != CURLE_OK)
+  {
+    throw TransportException(
+        "Failed to set up the request. Could not set " + description + ". "
+        + std::string(curl_easy_strerror(result)));
+  }
+}
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+// Parses a status line like `HTTP/1.1 200 OK` or `HTTP/2 200`.
+std::unique_ptr<RawResponse> CreateHTTPResponse(
+    uint8_t const* const begin,
+    uint8_t const* const last)
+{
+  auto readNumber = [last](uint8_t const*& position) {
+    int value = 0;
+    for (; position < last && *position >= '0' && *position <= '9'; ++position)
+    {
+      value = value * 10 + (*position - '0');
+    }
+    return value;
+  };
+
+  auto position = begin + 5; // HTTP = 4, / = 1, moving to 5th place for version
+  auto const majorVersion = readNumber(position);
+  auto minorVersion = 0;
+  if (position < last && *position == '.')
+  {
+    ++position;
+    minorVersion = readNumber(position);
+  }
+  if (position == last || *position != ' ')
+  {
+    throw TransportException("Invalid status line in the HTTP response.");
+  }
+  ++position;
+  auto const statusCode = readNumber(position);
+  if (position < last && *position == ' ')
+  {
+    ++position;
+  }
+  auto const reasonPhrase = std::string(position, std::find(position, last, '\r'));
+
+  return std::make_unique<RawResponse>(
+      static_cast<uint16_t>(majorVersion),
+      static_cast<uint16_t>(minorVersion),
+      HttpStatusCode(statusCode),
+      reasonPhrase);
+}
+
+// Fills the metrics of a transfer from libcurl, once its response headers are complete. Each time
+// is measured from the start of the transfer and includes the previous steps.
+void SetTransportMetrics(CurlMultiTransfer& transfer)
+{
+  auto& metrics = *transfer.Metrics;
+  long connects = 0;
+  long requestSize = 0;
+  curl_off_t uploadSize = 0;
+  if (curl_easy_getinfo(transfer.Handle.get(), CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK)
+  {
+    metrics.ConnectionReused = connects == 0;
+  }
+  if (curl_easy_getinfo(transfer.Handle.get(), CURLINFO_REQUEST_SIZE, &requestSize) == CURLE_OK
+      && curl_easy_getinfo(transfer.Handle.get(), CURLINFO_SIZE_UPLOAD_T, &uploadSize) == CURLE_OK)
+  {
+    metrics.BytesSent = static_cast<int64_t>(requestSize) + static_cast<int64_t>(uploadSize);
+  }
+#if LIBCURL_VERSION_NUM >= 0x073D00 // 7.61.0
+  curl_off_t nameLookupTime = 0;
+  curl_off_t connectTime = 0;
+  curl_off_t tlsHandshakeTime = 0;
+  curl_off_t preTransferTime = 0;
+  curl_off_t startTransferTime = 0;
+  if (curl_easy_getinfo(transfer.Handle.get(), CURLINFO_NAMELOOKUP_TIME_T, &nameLookupTime)
+          != CURLE_OK
+      || curl_easy_getinfo(transfer.Handle.get(), CURLINFO_CONNECT_TIME_T, &connectTime)
+          != CURLE_OK
+      || curl_easy_getinfo(transfer.Handle.get(), CURLINFO_APPCONNECT_TIME_T, &tlsHandshakeTime)
+          != CURLE_OK
+      || curl_easy_getinfo(transfer.Handle.get(), CURLINFO_PRETRANSFER_TIME_T, &preTransferTime)
+          != CURLE_OK
+      || curl_easy_getinfo(
+             transfer.Handle.get(), CURLINFO_STARTTRANSFER_TIME_T, &startTransferTime)
+          != CURLE_OK)
+  {
+    return;
+  }
+  if (!metrics.ConnectionReused)
+  {
+    metrics.NameLookupTime = std::chrono::microseconds(nameLookupTime);
+    metrics.ConnectTime = std::chrono::microseconds(connectTime - nameLookupTime);
+    // The TLS handshake time is 0 for plain HTTP connections.
+    if (tlsHandshakeTime > connectTime)
+    {
+      metrics.TlsHandshakeTime = std::chrono::microseconds(tlsHandshakeTime - connectTime);
+    }
+  }
+  // libcurl only tells when the upload ended since 8.10.0. Before, the time to first byte includes
+  // the send time.
+  curl_off_t sendEndTime = preTransferTime;
+#if LIBCURL_VERSION_NUM >= 0x080A00 // 8.10.0
+  curl_off_t postTransferTime = 0;
+  if (curl_easy_getinfo(transfer.Handle.get(), CURLINFO_POSTTRANSFER_TIME_T, &postTransferTime)
+          == CURLE_OK
+      && postTransferTime >= preTransferTime && postTransferTime <= startTransferTime)
+  {
+    sendEndTime = postTransferTime;
+  }
+#endif
+  metrics.SendTime = std::chrono::microseconds(sendEndTime - preTransferTime);
+  if (startTransferTime > sendEndTime)
+  {
+    metrics.TimeToFirstByte = std::chrono::microseconds(startTransferTime - sendEndTime);
+  }
+#endif
+}
+
+size_t HeaderCallback(char* buffer, size_t size, size_t count, void* userdata)
+{
+  auto transfer = static_cast<CurlMultiTransfer*>(userdata);
+  auto const length = size * count;
+  auto const first = reinterpret_cast<uint8_t const*>(buffer);
+  auto const last = first + length;
+
+  std::lock_guard<std::mutex> lock(transfer->Mutex);
+  transfer->Metrics->BytesReceived += static_cast<int64_t>(length);
+  try
+  {
+    if (length >= 5 && std::memcmp(buffer, "HTTP/", 5) == 0)
+    {
+      // A new status line, either the first one or the final one after a 1xx response.
+      transfer->Response = CreateHTTPResponse(first, last);
+      transfer->HeadersCompleted = false;
+    }
+    else if (length == 0 || buffer[0] == '\r' || buffer[0] == '\n')
+    {
+      // The empty line is the end of headers. Only a final response completes them.
+      if (transfer->Response && static_cast<int>(transfer->Response->GetStatusCode()) >= 200)
+      {
+        // Set here rather than when the transfer is done, so that the policies can read them as
+        // soon as the response is returned.
+        SetTransportMetrics(*transfer);
+        transfer->Response->SetTransportMetrics(transfer->Metrics);
+        transfer->HeadersCompleted = true;
+        transfer->Signal.notify_all();
+      }
+    }
+    else if (transfer->Response)
+    {
+      Azure::Core::Http::_detail::RawResponseHelpers::SetHeader(*transfer->Response, first, last);
+    }
+  }
+  catch (std::exception const& ex)
+  {
+    Log::Write(Logger::Level::Error, LogMsgPrefix + "Invalid response header. " + ex.what());
+    // Returning a different size than the one received makes libcurl fail the transfer.
+    return 0;
+  }
+  return length;
+}
+
+size_t WriteCallback(char* buffer, size_t size, size_t count, void* userdata)
+{
+  auto transfer = static_cast<CurlMultiTransfer*>(userdata);
+  auto const length = size * count;
+
+  std::lock_guard<std::mutex> lock(transfer->Mutex);
+  // Keep buffering while uploading, the caller won't read the body until the upload is done.
+  if (transfer->UploadCompleted
+      && transfer->Body.size() - transfer->BodyOffset
+          >= Azure::Core::Http::_detail::DefaultMultiResponseBufferSize)
+  {
+    transfer->Paused = true;
+    return CURL_WRITEFUNC_PAUSE;
+  }
+  transfer->Body.insert(transfer->Body.end(), buffer, buffer + length);
+  transfer->Signal.notify_all();
+  return length;
+}
+
+size_t ReadCallback(char* buffer, size_t size, size_t count, void* userdata)
+{
+  auto transfer = static_cast<CurlMultiTransfer*>(userdata);
+
+  std::lock_guard<std::mutex> lock(transfer->Mutex);
+  if (transfer->UploadAborted)
+  {
+    return CURL_READFUNC_ABORT;
+  }
+  if (transfer->UploadBufferOffset == transfer->UploadBuffer.size())
+  {
+    if (transfer->UploadEnded)
+    {
+      transfer->UploadCompleted = true;
+      transfer->Signal.notify_all();
+      return 0;
+    }
+    // Wait for the sender to read more of the request body, it resumes the transfer.
+    transfer->UploadPaused = true;
+    transfer->Signal.notify_all();
+    return CURL_READFUNC_PAUSE;
+  }
+
+  auto const read
+      = (std::min)(size * count, transfer->UploadBuffer.size() - transfer->UploadBufferOffset);
+  std::copy_n(transfer->UploadBuffer.begin() + transfer->UploadBufferOffset, read, buffer);
+  transfer->UploadBufferOffset += read;
+  if (transfer->UploadBufferOffset == transfer->UploadBuffer.size())
+  {
+    // libcurl doesn't call back once it has read a known upload size.
+    transfer->UploadCompleted = transfer->UploadEnded;
+    transfer->Signal.notify_all();
+  }
+  return read;
+}
+
+int ProgressCallback(void* userdata, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+{
+  auto transfer = static_cast<CurlMultiTransfer*>(userdata);
+  // A non-zero value makes libcurl abort the transfer with CURLE_ABORTED_BY_CALLBACK.
+  return transfer->SendContext.IsCancelled() ? 1 : 0;
+}
+} // namespace
+
+void CurlMultiTransfer::Setup(
+    Request& request,
+    CurlTransportOptions const& options,
+    std::chrono::milliseconds connectionTimeoutOverride)
+{
+  Handle = Azure::Core::_internal::UniqueHandle<CURL>(curl_easy_init());
+  if (!Handle)
+  {
+    throw TransportException(
+        "Failed to set up the request. " + std::string("curl_easy_init returned Null"));
+  }
+  Metrics = std::make_shared<Azure::Core::Http::TransportMetrics>();
+
+  if (options.EnableCurlTracing)
+  {
+    SetTransferOption(
+        Handle, CURLOPT_DEBUGFUNCTION, CurlConnection::CurlLoggingCallback, "logging callback");
+    SetTransferOption(Handle, CURLOPT_VERBOSE, 1L, "verbose logging");
+  }
+
+  SetTransferOption(Handle, CURLOPT_URL, request.GetUrl().GetAbsoluteUrl().c_str(), "url");
+
+  {
+    long const connectionTimeout = GetConnectionTimeout(options, connectionTimeoutOverride);
+    if (connectionTimeout > 0)
+    {
+      SetTransferOption(Handle, CURLOPT_CONNECTTIMEOUT_MS, connectionTimeout, "connect timeout");
+    }
+  }
+
+  if (options.Proxy)
+  {
+    SetTransferOption(Handle, CURLOPT_PROXY, options.Proxy->c_str(), "proxy");
+  }
+  if (options.ProxyUsername.HasValue())
+  {
+    SetTransferOption(
+        Handle, CURLOPT_PROXYUSERNAME, options.ProxyUsername.Value().c_str(), "proxy username");
+  }
+  if (options.ProxyPassword.HasValue())
+  {
+    SetTransferOption(
+        Handle, CURLOPT_PROXYPASSWORD, options.ProxyPassword.Value().c_str(), "proxy password");
+  }
+
+  if (!options.CAInfo.empty())
+  {
+    SetTransferOption(Handle, CURLOPT_CAINFO, options.CAInfo.c_str(), "CA cert file");
+  }
+  if (!options.CAPath.empty())
+  {
+    SetTransferOption(Handle, CURLOPT_CAPATH, options.CAPath.c_str(), "CA path");
+  }
+
+#if LIBCURL_VERSION_NUM >= 0x074D00 // 7.77.0
+  if (!options.SslOptions.PemEncodedExpectedRootCertificates.empty())
+  {
+    curl_blob rootCertBlob
+        = {const_cast<void*>(reinterpret_cast<const void*>(
+               options.SslOptions.PemEncodedExpectedRootCertificates.c_str())),
+           options.SslOptions.PemEncodedExpectedRootCertificates.size(),
+           CURL_BLOB_COPY};
+    SetTransferOption(Handle, CURLOPT_CAINFO_BLOB, &rootCertBlob, "CA cert");
+  }
+#endif
+
+#if defined(AZ_PLATFORM_WINDOWS)
+  if (!options.SslOptions.EnableCertificateRevocationListCheck)
+  {
+    SetTransferOption(Handle, CURLOPT_SSL_OPTIONS, long(CURLSSLOPT_NO_REVOKE), "ssl options");
+  }
+#endif
+
+  if (!options.SslVerifyPeer)
+  {
+    SetTransferOption(Handle, CURLOPT_SSL_VERIFYPEER, 0L, "ssl verify peer");
+  }
+  if (options.NoSignal)
+  {
+    SetTransferOption(Handle, CURLOPT_NOSIGNAL, 1L, "NOSIGNAL");
+  }
+  if (!options.EnableCurlSslCaching)
+  {
+    SetTransferOption(Handle, CURLOPT_SSL_SESSIONID_CACHE, 0L, "ssl session id cache");
+  }
+  SetTransferOption(
+      Handle,
+      CURLOPT_DNS_CACHE_TIMEOUT,
+      static_cast<long>(options.DnsCacheTimeout.count()),
+      "DNS cache timeout");
+#if LIBCURL_VERSION_NUM >= 0x074100 // 7.65.0
+  if (options.ConnectionIdleTimeout.count() > 0)
+  {
+    // libcurl takes whole seconds, round up so a connection is never dropped early.
+    SetTransferOption(
+        Handle,
+        CURLOPT_MAXAGE_CONN,
+        static_cast<long>((options.ConnectionIdleTimeout.count() + 999) / 1000),
+        "connection idle timeout");
+  }
+#endif
+#if LIBCURL_VERSION_NUM >= 0x075000 // 7.80.0
+  if (options.ConnectionMaxLifetime.count() > 0)
+  {
+    SetTransferOption(
+        Handle,
+        CURLOPT_MAXLIFETIME_CONN,
+        static_cast<long>((options.ConnectionMaxLifetime.count() + 999) / 1000),
+        "connection max lifetime");
+  }
+#endif
+  if (!options.HttpKeepAlive)
+  {
+    SetTransferOption(Handle, CURLOPT_FORBID_REUSE, 1L, "forbid reuse");
+  }
+
+  if (options.EnableHttp2)
+  {
+    // HTTP/2 is negotiated with ALPN for https only. Waiting for a connection that is still being
+    // set up lets libcurl multiplex this request on it instead of opening a new one.
+    SetTransferOption(Handle, CURLOPT_HTTP_VERSION, long(CURL_HTTP_VERSION_2TLS), "HTTP/2");
+    SetTransferOption(Handle, CURLOPT_PIPEWAIT, 1L, "pipe wait");
+  }
+  else
+  {
+    SetTransferOption(Handle, CURLOPT_HTTP_VERSION, long(CURL_HTTP_VERSION_1_1), "HTTP/1.1");
+  }
+  // Same as the CurlTransport, only TLS v1.2 or later is used.
+  SetTransferOption(Handle, CURLOPT_SSLVERSION, long(CURL_SSLVERSION_TLSv1_2), "TLS v1.2");
+
+  // Method and request body.
+  // Like the CurlTransport, a body is sent whenever there is one, whatever the method.
+  auto const method = request.GetMethod();
+  auto const length = request.GetBodyStream()->Length();
+  bool const hasBody = method != HttpMethod::Head
+      && (length > 0 || (method != HttpMethod::Get && method != HttpMethod::Delete));
+  if (method == HttpMethod::Head)
+  {
+    SetTransferOption(Handle, CURLOPT_NOBODY, 1L, "HEAD method");
+  }
+  else if (hasBody)
+  {
+    UploadEnded = length == 0;
+    UploadCompleted = length == 0;
+    SetTransferOption(Handle, CURLOPT_UPLOAD, 1L, "upload");
+    SetTransferOption(Handle, CURLOPT_INFILESIZE_LARGE, curl_off_t(length), "upload size");
+    SetTransferOption(Handle, CURLOPT_READFUNCTION, ReadCallback, "read callback");
+    SetTransferOption(Handle, CURLOPT_READDATA, static_cast<void*>(this), "read data");
+    if (request.GetUploadChunkSize() != 0)
+    {
+      // libcurl clamps the upload buffer size to its own limits.
+      SetTransferOption(
+          Handle,
+          CURLOPT_UPLOAD_BUFFERSIZE,
+          static_cast<long>(request.GetUploadChunkSize()),
+          "upload buffer size");
+    }
+  }
+  // An upload is a PUT for libcurl unless the method is set explicitly.
+  if (method != HttpMethod::Head && (method != HttpMethod::Get || hasBody))
+  {
+    SetTransferOption(Handle, CURLOPT_CUSTOMREQUEST, method.ToString().c_str(), "method");
+  }
+
+  // Request headers. libcurl sets the content-length from the upload size.
+  for (auto const& header : request.GetHeaders())
+  {
+    if (hasBody && header.first == "content-length")
+    {
+      continue;
+    }
+    // libcurl only sends a header with an empty value when it ends with a semicolon.
+    auto const line = header.second.empty() ? header.first + ";"
+                                            : header.first + ": " + header.second;
+    RequestHeaders = curl_slist_append(RequestHeaders, line.c_str());
+  }
+  // Use expect:100 only for PUT requests, like the CurlTransport does.
+  if (hasBody && method != HttpMethod::Put)
+  {
+    RequestHeaders = curl_slist_append(RequestHeaders, "Expect:");
+  }
+  SetTransferOption(Handle, CURLOPT_HTTPHEADER, RequestHeaders, "request headers");
+
+  SetTransferOption(Handle, CURLOPT_HEADERFUNCTION, HeaderCallback, "header callback");
+  SetTransferOption(Handle, CURLOPT_HEADERDATA, static_cast<void*>(this), "header data");
+  SetTransferOption(Handle, CURLOPT_WRITEFUNCTION, WriteCallback, "write callback");
+  SetTransferOption(Handle, CURLOPT_WRITEDATA, static_cast<void*>(this), "write data");
+  SetTransferOption(Handle, CURLOPT_NOPROGRESS, 0L, "progress");
+  SetTransferOption(Handle, CURLOPT_XFERINFOFUNCTION, ProgressCallback, "progress callback");
+  SetTransferOption(Handle, CURLOPT_XFERINFODATA, static_cast<void*>(this), "progress data");
+}
+
+CurlMultiEventLoop::CurlMultiEventLoop() : m_multiHandle(curl_multi_init())
+{
+  if (m_multiHandle == nullptr)
+  {
+    throw TransportException("Failed to create the event loop. curl_multi_init returned Null");
+  }
+  // Concurrent HTTP/2 requests to the same host share one connection.
+  curl_multi_setopt(m_multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  m_thread = std::thread([this]() { Run(); });
+}
+
+CurlMultiEventLoop::~CurlMultiEventLoop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_operationsMutex);
+    m_stop = true;
+  }
+  WakeUp();
+  m_thread.join();
+
+  // Anything left is failed, nobody is waiting for those transfers at this point.
+  while (!m_transfers.empty())
+  {
+    CompleteTransfer(m_transfers.begin()->first, CURLE_ABORTED_BY_CALLBACK);
+  }
+  curl_multi_cleanup(m_multiHandle);
+}
+
+void CurlMultiEventLoop::Add(std::shared_ptr<CurlMultiTransfer> transfer)
+{
+  Enqueue(Operation::Add, std::move(transfer));
+}
+
+void CurlMultiEventLoop::Resume(std::shared_ptr<CurlMultiTransfer> transfer)
+{
+  Enqueue(Operation::Resume, std::move(transfer));
+}
+
+void CurlMultiEventLoop::Remove(std::shared_ptr<CurlMultiTransfer> transfer)
+{
+  Enqueue(Operation::Remove, std::move(transfer));
+}
+
+void CurlMultiEventLoop::Enqueue(Operation operation, std::shared_ptr<CurlMultiTransfer> transfer)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_operationsMutex);
+    m_operations.emplace_back(operation, std::move(transfer));
+  }
+  WakeUp();
+}
+
+void CurlMultiEventLoop::WakeUp()
+{
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  curl_multi_wakeup(m_multiHandle);
+#endif
+}
+
+void CurlMultiEventLoop::Wait()
+{
+#if LIBCURL_VERSION_NUM >= 0x074200 // 7.66.0
+  curl_multi_poll(
+      m_multiHandle,
+      nullptr,
+      0,
+      Azure::Core::Http::_detail::DefaultMultiPollIntervalMilliseconds,
+      nullptr);
+#else
+  // Without curl_multi_poll and curl_multi_wakeup, queued operations are only picked up after the
+  // wait times out. curl_multi_wait returns right away when there is nothing to wait on.
+  int descriptors = 0;
+  curl_multi_wait(
+      m_multiHandle,
+      nullptr,
+      0,
+      Azure::Core::Http::_detail::LegacyMultiWaitIntervalMilliseconds,
+      &descriptors);
+  if (descriptors == 0)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+        Azure::Core::Http::_detail::LegacyMultiWaitIntervalMilliseconds));
+  }
+#endif
+}
+
+bool CurlMultiEventLoop::RunOperations()
+{
+  decltype(m_operations) operations;
+  {
+    std::lock_guard<std::mutex> lock(m_operationsMutex);
+    if (m_stop)
+    {
+      return false;
+    }
+    operations.swap(m_operations);
+  }
+
+  for (auto& operation : operations)
+  {
+    auto handle = operation.second->Handle.get();
+    switch (operation.first)
+    {
+      case Operation::Add: {
+        auto const result = curl_multi_add_handle(m_multiHandle, handle);
+        if (result != CURLM_OK)
+        {
+          Log::Write(
+              Logger::Level::Error,
+              LogMsgPrefix + "Failed to add transfer. " + curl_multi_strerror(result));
+          std::lock_guard<std::mutex> lock(operation.second->Mutex);
+          operation.second->Completed = true;
+          operation.second->Result = CURLE_FAILED_INIT;
+          operation.second->Signal.notify_all();
+          break;
+        }
+        m_transfers.emplace(handle, std::move(operation.second));
+        break;
+      }
+      case Operation::Resume:
+        if (m_transfers.find(handle) != m_transfers.end())
+        {
+          curl_easy_pause(handle, CURLPAUSE_CONT);
+        }
+        break;
+      case Operation::Remove:
+        if (m_transfers.find(handle) != m_transfers.end())
+        {
+          CompleteTransfer(handle, CURLE_ABORTED_BY_CALLBACK);
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+void CurlMultiEventLoop::CompleteTransfer(CURL* handle, CURLcode result)
+{
+  auto transfer = m_transfers.find(handle);
+  if (transfer == m_transfers.end())
+  {
+    return;
+  }
+  long connects = 0;
+  if (curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK)
+  {
+    m_connectionsOpened += static_cast<size_t>(connects);
+  }
+  curl_multi_remove_handle(m_multiHandle, handle);
+  {
+    std::lock_guard<std::mutex> lock(transfer->second->Mutex);
+    transfer->second->Completed = true;
+    transfer->second->Result = result;
+    transfer->second->Signal.notify_all();
+  }
+  m_transfers.erase(transfer);
+}
+
+void CurlMultiEventLoop::Run()
+{
+  while (RunOperations())
+  {
+    int running = 0;
+    auto const result = curl_multi_perform(m_multiHandle, &running);
+    if (result != CURLM_OK)
+    {
+      Log::Write(
+          Logger::Level::Error,
+          LogMsgPrefix + "curl_multi_perform failed. " + curl_multi_strerror(result));
+    }
+
+    int pending = 0;
+    while (CURLMsg* message = curl_multi_info_read(m_multiHandle, &pending))
+    {
+      if (message->msg == CURLMSG_DONE)
+      {
+        // The message is released when the handle is removed, copy what is needed first.
+        auto const handle = message->easy_handle;
+        auto const transferResult = message->data.result;
+        CompleteTransfer(handle, transferResult);
+      }
+    }
+
+    Wait();
+  }
+}
+
+size_t CurlMultiBodyStream::OnRead(uint8_t* buffer, size_t count, Context const& context)
+{
+  // Only the reader of the body updates the metrics once the headers are complete.
+  auto& metrics = *m_transfer->Metrics;
+  struct BodyReadTimer final
+  {
+    std::chrono::microseconds& BodyReadTime;
+    std::chrono::steady_clock::time_point Start;
+    ~BodyReadTimer()
+    {
+      BodyReadTime += std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - Start);
+    }
+  } const bodyReadTimer{metrics.BodyReadTime, std::chrono::steady_clock::now()};
+
+  bool resume = false;
+  size_t read = 0;
+  {
+    Azure::Core::_internal::ContextCancellationSignal const cancellationSignal(
+        context, m_transfer->Mutex, m_transfer->Signal);
+    std::unique_lock<std::mutex> lock(m_transfer->Mutex);
+    while (m_transfer->Body.size() == m_transfer->BodyOffset && !m_transfer->Completed)
+    {
+      context.ThrowIfCancelled();
+      cancellationSignal.WaitFor(
+          lock,
+          std::chrono::milliseconds(
+              Azure::Core::Http::_detail::DefaultMultiPollIntervalMilliseconds));
+    }
+
+    read = (std::min)(count, m_transfer->Body.size() - m_transfer->BodyOffset);
+    if (read == 0)
+    {
+      if (m_transfer->Result != CURLE_OK)
+      {
+        throw TransportException(
+            "Error while reading the response body. "
+            + std::string(curl_easy_strerror(m_transfer->Result)));
+      }
+      return 0;
+    }
+
+    std::copy_n(m_transfer->Body.begin() + m_transfer->BodyOffset, read, buffer);
+    m_transfer->BodyOffset += read;
+    if (m_transfer->BodyOffset == m_transfer->Body.size())
+    {
+      m_transfer->Body.clear();
+      m_transfer->BodyOffset = 0;
+    }
+    else if (m_transfer->BodyOffset > m_transfer->Body.size() / 2)
+    {
+      m_transfer->Body.erase(
+          m_transfer->Body.begin(), m_transfer->Body.begin() + m_transfer->BodyOffset);
+      m_transfer->BodyOffset = 0;
+    }
+
+    if (m_transfer->Paused
+        && m_transfer->Body.size() - m_transfer->BodyOffset
+            < Azure::Core::Http::_detail::DefaultMultiResponseBufferSize)
+    {
+      m_transfer->Paused = false;
+      resume = true;
+    }
+  }
+
+  if (resume)
+  {
+    m_eventLoop->Resume(m_transfer);
+  }
+  metrics.BytesReceived += static_cast<int64_t>(read);
+  return read;
+}
+
+CurlMultiBodyStream::~CurlMultiBodyStream()
+{
+  bool completed;
+  {
+    std::lock_guard<std::mutex> lock(m_transfer->Mutex);
+    completed = m_transfer->Completed;
+  }
+  if (!completed)
+  {
+    // The caller didn't read the whole body, there is no point on downloading the rest of it.
+    m_eventLoop->Remove(m_transfer);
+  }
+}
+
+CurlMultiTransport::CurlMultiTransport(CurlTransportOptions const& options, size_t eventLoopCount)
+    : m_options(options)
+{
+  if (eventLoopCount == 0)
+  {
+    throw std::invalid_argument("The CurlMultiTransport needs at least one event loop.");
+  }
+#if !defined(AZ_PLATFORM_WINDOWS) && !defined(AZ_PLATFORM_MAC)
+  if (options.SslOptions.EnableCertificateRevocationListCheck)
+  {
+    throw std::invalid_argument(
+        "Certificate revocation list checks are not supported by the CurlMultiTransport.");
+  }
+#endif
+
+  m_eventLoops.reserve(eventLoopCount);
+  for (size_t i = 0; i < eventLoopCount; ++i)
+  {
+    m_eventLoops.emplace_back(std::make_shared<CurlMultiEventLoop>());
+  }
+}
+
+CurlMultiTransport::CurlMultiTransport(
+    Azure::Core::Http::Policies::TransportOptions const& options)
+    : CurlMultiTransport(_detail::CurlTransportOptionsFromTransportOptions(options))
+{
+}
+
+CurlMultiTransport::~CurlMultiTransport() = default;
+
+std::unique_ptr<RawResponse> CurlMultiTransport::Send(Request& request, Context const& context)
+{
+  context.ThrowIfCancelled();
+
+  auto connectionTimeoutOverride = std::chrono::milliseconds{0};
+  {
+    std::chrono::milliseconds contextConnectionTimeout{0};
+    if (context.TryGetValue(Http::_internal::HttpConnectionTimeout, contextConnectionTimeout)
+        && contextConnectionTimeout.count() > 0)
+    {
+      connectionTimeoutOverride = contextConnectionTimeout;
+    }
+  }
+
+  // The requests to a host are pinned to one event loop, so that they share its connection cache.
+  // Otherwise each event loop would open its own connections to the host.
+  auto const& url = request.GetUrl();
+  auto const hostKey
+      = url.GetScheme() + "://" + url.GetHost() + ":" + std::to_string(url.GetPort());
+  auto eventLoop = m_eventLoops[std::hash<std::string>{}(hostKey) % m_eventLoops.size()];
+  auto transfer = std::make_shared<_detail::CurlMultiTransfer>();
+  transfer->SendContext = context;
+  transfer->Setup(request, m_options, connectionTimeoutOverride);
+
+  Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Adding transfer to the event loop.");
+  eventLoop->Add(transfer);
+
+  std::unique_ptr<RawResponse> response;
+  {
+    Azure::Core::_internal::ContextCancellationSignal const cancellationSignal(
+        context, transfer->Mutex, transfer->Signal);
+    std::unique_lock<std::mutex> lock(transfer->Mutex);
+    auto const abort = [&]() {
+      transfer->UploadAborted = true;
+      lock.unlock();
+      eventLoop->Remove(transfer);
+    };
+    std::vector<uint8_t> uploadChunk;
+    int64_t uploadRemaining = request.GetBodyStream()->Length();
+    while (!transfer->Completed && !(transfer->HeadersCompleted && transfer->UploadCompleted))
+    {
+      if (context.IsCancelled())
+      {
+        abort();
+        context.ThrowIfCancelled();
+      }
+      if (!transfer->UploadEnded && transfer->UploadBufferOffset == transfer->UploadBuffer.size())
+      {
+        // Read the next part of the request body on this thread, the event loop only sends it.
+        lock.unlock();
+        uploadChunk.resize(
+            request.GetUploadChunkSize() == 0 ? _detail::DefaultUploadChunkSize
+                                              : request.GetUploadChunkSize());
+        size_t read = 0;
+        try
+        {
+          read = request.GetBodyStream()->Read(uploadChunk.data(), uploadChunk.size(), context);
+        }
+        catch (...)
+        {
+          lock.lock();
+          abort();
+          throw;
+        }
+        uploadChunk.resize(read);
+        if (uploadRemaining > 0)
+        {
+          uploadRemaining -= static_cast<int64_t>(read);
+        }
+        lock.lock();
+        transfer->UploadBuffer.swap(uploadChunk);
+        transfer->UploadBufferOffset = 0;
+        transfer->UploadEnded = read == 0 || uploadRemaining == 0;
+        if (transfer->UploadPaused)
+        {
+          transfer->UploadPaused = false;
+          lock.unlock();
+          eventLoop->Resume(transfer);
+          lock.lock();
+        }
+        continue;
+      }
+      cancellationSignal.WaitFor(
+          lock, std::chrono::milliseconds(_detail::DefaultMultiPollIntervalMilliseconds));
+    }
+    // The request body isn't read anymore, the request might be gone from now on.
+    transfer->UploadAborted = !transfer->UploadCompleted;
+
+    if (!transfer->HeadersCompleted)
+    {
+      context.ThrowIfCancelled();
+      throw TransportException(
+          "Error while sending request. " + std::string(curl_easy_strerror(transfer->Result)));
+    }
+    response = std::move(transfer->Response);
+  }
+
+  int64_t length = -1;
+  if (request.GetMethod() == HttpMethod::Head)
+  {
+    length = 0;
+  }
+  else
+  {
+    auto const& headers = response->GetHeaders();
+    auto const contentLength = headers.find("content-length");
+    if (contentLength != headers.end())
+    {
+      length = Azure::Core::Http::_detail::ParseContentLength(contentLength->second);
+    }
+  }
+
+  response->SetBodyStream(
+      std::make_unique<CurlMultiBodyStream>(std::move(eventLoop), std::move(transfer), length));
+  return response;
+}
@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief The libcurl multi event loop drives many transfers from a single thread.
+ */
+
+#pragma once
+
+#include "azure/core/context.hpp"
+#include "azure/core/http/curl_transport.hpp"
+#include "azure/core/http/http.hpp"
+#include "azure/core/io/body_stream.hpp"
+#include "curl_connection_private.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Http { namespace _detail {
+  // A response body bigger than this is not buffered. The transfer is paused until the caller
+  // reads from the body stream.
+  constexpr static size_t DefaultMultiResponseBufferSize = 1024 * 1024;
+  // The event loop wakes up at least this often to check for cancelled transfers.
+  constexpr static int DefaultMultiPollIntervalMilliseconds = 1000;
+  // libcurl older than 7.68.0 can't wake up the event loop, so it waits for a short time instead.
+  constexpr static int LegacyMultiWaitIntervalMilliseconds = 10;
+
+  /**
+   * @brief The state of one request driven by a #CurlMultiEventLoop.
+   *
+   * @remark The libcurl callbacks run on the event loop thread, while the thread that sent the
+   * request waits for the response headers and then reads the body. All the members below the
+   * mutex are guarded by it.
+   */
+  struct CurlMultiTransfer final
+  {
+    Azure::Core::_internal::UniqueHandle<CURL> Handle;
+    curl_slist* RequestHeaders = nullptr;
+    // Copy of the context used to send the request, so the callbacks can check for cancellation.
+    Context SendContext;
+
+    std::mutex Mutex;
+    std::condition_variable Signal;
+    // The request body is read by the thread that sent the request, never by the event loop, so a
+    // slow body stream doesn't stall the other transfers. The upload callback takes the bytes from
+    // this buffer and pauses the transfer when it is empty until the sender refills it.
+    std::vector<uint8_t> UploadBuffer;
+    size_t UploadBufferOffset = 0;
+    // The whole request body is in the upload buffer, or was already taken from it.
+    bool UploadEnded = true;
+    bool UploadPaused = false;
+    // The sender gave up on the request, the upload callback fails the transfer.
+    bool UploadAborted = false;
+    bool UploadCompleted = true;
+    std::unique_ptr<RawResponse> Response;
+    bool HeadersCompleted = false;
+    std::vector<uint8_t> Body;
+    size_t BodyOffset = 0;
+    bool Paused = false;
+    bool Completed = false;
+    CURLcode Result = CURLE_OK;
+    // Filled by the event loop until the response headers are complete, then only updated by the
+    // reader of the body.
+    std::shared_ptr<TransportMetrics> Metrics;
+
+    CurlMultiTransfer() = default;
+    CurlMultiTransfer(CurlMultiTransfer const&) = delete;
+    CurlMultiTransfer& operator=(CurlMultiTransfer const&) = delete;
+
+    ~CurlMultiTransfer()
+    {
+      if (RequestHeaders != nullptr)
+      {
+        curl_slist_free_all(RequestHeaders);
+      }
+    }
+
+    /**
+     * @brief Creates the easy handle and sets it up to send \p request.
+     *
+     * @throw TransportException if libcurl rejects any of the options.
+     */
+    void Setup(
+        Request& request,
+        CurlTransportOptions const& options,
+        std::chrono::milliseconds connectionTimeoutOverride);
+  };
+
+  /**
+   * @brief A thread running `curl_multi_perform` for all the transfers added to it.
+   *
+   * @remark Transfers are added, resumed and removed through a queue of operations, so the multi
+   * handle is only used from the event loop thread.
+   */
+  class CurlMultiEventLoop final {
+  public:
+    CurlMultiEventLoop();
+    ~CurlMultiEventLoop();
+
+    CurlMultiEventLoop(CurlMultiEventLoop const&) = delete;
+    CurlMultiEventLoop& operator=(CurlMultiEventLoop const&) = delete;
+
+    /**
+     * @brief Starts driving the transfer.
+     */
+    void Add(std::shared_ptr<CurlMultiTransfer> transfer);
+
+    /**
+     * @brief Unpauses a transfer after the caller consumed some of the buffered body, or after
+     * the sender refilled the upload buffer.
+     */
+    void Resume(std::shared_ptr<CurlMultiTransfer> transfer);
+
+    /**
+     * @brief Stops a transfer which is not completed yet. The transfer completes with
+     * `CURLE_ABORTED_BY_CALLBACK`.
+     */
+    void Remove(std::shared_ptr<CurlMultiTransfer> transfer);
+
+    /**
+     * @brief Gets the number of connections opened by the transfers completed so far.
+     */
+    size_t ConnectionsOpened() const { return m_connectionsOpened; }
+
+  private:
+    enum class Operation
+    {
+      Add,
+      Resume,
+      Remove,
+    };
+
+    CURLM* m_multiHandle;
+    std::mutex m_operationsMutex;
+    std::vector<std::pair<Operation, std::shared_ptr<CurlMultiTransfer>>> m_operations;
+    bool m_stop = false;
+    std::atomic<size_t> m_connectionsOpened{0};
+    // Only used from the event loop thread.
+    std::unordered_map<CURL*, std::shared_ptr<CurlMultiTransfer>> m_transfers;
+    std::thread m_thread;
+
+    void Enqueue(Operation operation, std::shared_ptr<CurlMultiTransfer> transfer);
+    // Interrupts Wait from another thread.
+    void WakeUp();
+    // Waits for activity on the transfers, or until WakeUp is called.
+    void Wait();
+    void Run();
+    bool RunOperations();
+    void CompleteTransfer(CURL* handle, CURLcode result);
+  };
+
+  /**
+   * @brief The response body of a request sent by the #CurlMultiTransport.
+   */
+  class CurlMultiBodyStream final : public Azure::Core::IO::BodyStream {
+  private:
+    std::shared_ptr<CurlMultiEventLoop> m_eventLoop;
+    std::shared_ptr<CurlMultiTransfer> m_transfer;
+    int64_t m_length;
+
+    size_t OnRead(uint8_t* buffer, size_t count, Context const& context) override;
+
+  public:
+    CurlMultiBodyStream(
+        std::shared_ptr<CurlMultiEventLoop> eventLoop,
+        std::shared_ptr<CurlMultiTransfer> transfer,
+        int64_t length)
+        : m_eventLoop(std::move(eventLoop)), m_transfer(std::move(transfer)), m_length(length)
+    {
+    }
+
+    ~CurlMultiBodyStream() override;
+
+    int64_t Length() const override { return m_length; }
+  };
+}}}} // namespace Azure::Core::Http::_detail
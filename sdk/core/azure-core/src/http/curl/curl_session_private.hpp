@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #ifdef _azure_TESTING_BUILD
 // Define the class name that reads from ConnectionPool private members
@@ -48,19 +49,6 @@ namespace Azure { namespace Core { namespace Http {
     friend class Azure::Core::Test::CurlConnectionPool_DISABLED_connectionPoolTest_Test;
 #endif
   private:
-    /**
-     * @brief Read one expected byte and throw if it is different than the \p expected
-     *
-     */
-    void ReadExpected(uint8_t expected, Context const& context);
-
-    /**
-     * @brief Read `\\r\\n` from internal buffer or from the wire.
-     *
-     * @remark throw if `\\r\\n` are not the next data read.
-     */
-    void ReadCRLF(Context const& context);
-
     /**
      * @brief This is used to set the current state of a session.
      *
@@ -89,6 +77,22 @@ namespace Azure { namespace Core { namespace Http {
       EndOfHeaders,
     };
 
+    /*
+     * Enum used by ParseChunkFraming to control where the parser is within a chunked response
+     * body. Every state but `ChunkData` is chunk framing, which is consumed by the session and
+     * never returned to the caller.
+     *
+     */
+    enum class ChunkParserState
+    {
+      ChunkSize,
+      ChunkExtension,
+      ChunkData,
+      ChunkDataEnd,
+      Trailer,
+      End,
+    };
+
     /**
      * @brief stateful component used to read and parse a buffer to construct a valid HTTP
      * RawResponse.
@@ -245,7 +249,7 @@ namespace Azure { namespace Core { namespace Http {
      * @note The initial value is set to the size of the inner buffer as a sentinel that indicate
      * that the buffer has not data or all data has already taken from it.
      */
-    size_t m_bodyStartInBuffer = _detail::DefaultLibcurlReaderSize;
+    size_t m_bodyStartInBuffer;
 
     /**
      * @brief Control field to handle the number of bytes containing relevant data within the
@@ -253,7 +257,7 @@ namespace Azure { namespace Core { namespace Http {
      * from wire into it, it can be holding less then N bytes.
      *
      */
-    size_t m_innerBufferSize = _detail::DefaultLibcurlReaderSize;
+    size_t m_innerBufferSize;
 
     bool m_isChunkedResponseType = false;
 
@@ -275,6 +279,20 @@ namespace Azure { namespace Core { namespace Http {
      */
     size_t m_chunkSize = 0;
 
+    /**
+     * @brief For chunked responses, what the session expects next from the wire.
+     *
+     */
+    ChunkParserState m_chunkParserState = ChunkParserState::ChunkSize;
+
+    /**
+     * @brief For chunked responses, the number of bytes in the chunk framing line being parsed and
+     * whether its last byte was a `\\r`. A line can be split across several socket reads.
+     *
+     */
+    size_t m_chunkLineLength = 0;
+    bool m_chunkLineCR = false;
+
     size_t m_sessionTotalRead = 0;
 
     /**
@@ -288,9 +306,9 @@ namespace Azure { namespace Core { namespace Http {
      * used while constructing an HTTP RawResponse without adding a body to it. Customers would
      * provide their own buffer to copy from socket when reading the HTTP body using streams.
      *
+     * @remark The size is taken from #Azure::Core::Http::CurlTransportOptions::HeaderBufferSize.
      */
-    uint8_t m_readBuffer[_detail::DefaultLibcurlReaderSize]
-        = {0}; // to work with libcurl custom read.
+    std::vector<uint8_t> m_readBuffer;
 
     /**
      * @brief Function used when working with Streams to manually write from the HTTP Request to
@@ -311,6 +329,13 @@ namespace Azure { namespace Core { namespace Http {
      */
     CURLcode UploadBody(Context const& context);
 
+    /**
+     * @brief Gets the upload chunk size of the request, or the default one if the request does
+     * not set it.
+     *
+     */
+    size_t GetUploadChunkSize() const;
+
     /**
      * @brief This function is used after sending an HTTP request to the server to read the HTTP
      * RawResponse from wire until the end of headers only.
@@ -325,12 +350,37 @@ namespace Azure { namespace Core { namespace Http {
         bool reuseInternalBuffer = false);
 
     /**
-     * @brief Reads from inner buffer or from Wire until chunkSize is parsed and converted to
-     * unsigned long long
+     * @brief Parses the chunk framing (chunk sizes, extensions, the `\\r\\n` after the chunk data
+     * and the trailers) from \p data.
+     *
+     * @remark Parsing stops at the start of the chunk data or at the end of the response. The
+     * framing can be split across several calls.
+     *
+     * @param data Bytes read from the wire.
+     * @param size Number of bytes in \p data.
+     * @return The number of bytes consumed from \p data.
+     */
+    size_t ParseChunkFraming(uint8_t const* data, size_t size);
+
+    /**
+     * @brief Parses the chunk framing from the inner buffer, reading from the wire into the inner
+     * buffer as many times as needed, until the next chunk data or the end of the response.
      *
      * @param context A context to control the request lifetime.
      */
-    void ParseChunkSize(Context const& context);
+    void ReadChunkFraming(Context const& context);
+
+    /**
+     * @brief Reads the body of a chunked response, removing the chunk framing.
+     *
+     * @remark Several chunks already in the inner buffer are returned in one call.
+     *
+     * @param buffer Buffer where the body is written to.
+     * @param count The size of \p buffer.
+     * @param context A context to control the request lifetime.
+     * @return The number of bytes written to \p buffer.
+     */
+    size_t ReadChunkedBody(uint8_t* buffer, size_t count, Context const& context);
 
     /**
      * @brief Last HTTP status code read.
@@ -355,7 +405,7 @@ namespace Azure { namespace Core { namespace Http {
     bool IsEOF()
     {
       auto eof = m_isChunkedResponseType
-          ? m_chunkSize == 0
+          ? m_chunkParserState == ChunkParserState::End
           : static_cast<size_t>(m_contentLength) == m_sessionTotalRead;
 
       // `IsEOF` is called before trying to move a connection back to the connection pool.
@@ -380,6 +430,20 @@ namespace Azure { namespace Core { namespace Http {
     Azure::Nullable<std::string> m_httpProxyUser;
     Azure::Nullable<std::string> m_httpProxyPassword;
 
+    /**
+     * @brief Metrics of the request, shared with the response so they can be updated while the
+     * body is read.
+     *
+     */
+    std::shared_ptr<TransportMetrics> m_transportMetrics;
+
+    /**
+     * @brief Connection pool limits applied when the connection is moved back to the pool.
+     *
+     */
+    size_t m_maxPooledConnectionsPerHost;
+    size_t m_maxPooledConnections;
+
     /**
      * @brief Implement Azure::Core::IO::BodyStream::OnRead. Calling this function pulls data
      * from the wire.
@@ -410,9 +474,18 @@ namespace Azure { namespace Core { namespace Http {
         std::unique_ptr<CurlNetworkConnection> connection,
         CurlTransportOptions curlOptions)
         : m_connection(std::move(connection)), m_request(request),
+          m_readBuffer(
+              curlOptions.HeaderBufferSize == 0 ? _detail::DefaultLibcurlReaderSize
+                                                : curlOptions.HeaderBufferSize),
           m_keepAlive(curlOptions.HttpKeepAlive), m_httpProxy(curlOptions.Proxy),
-          m_httpProxyUser(curlOptions.ProxyUsername), m_httpProxyPassword(curlOptions.ProxyPassword)
+          m_httpProxyUser(curlOptions.ProxyUsername), m_httpProxyPassword(curlOptions.ProxyPassword),
+          m_transportMetrics(std::make_shared<TransportMetrics>()),
+          m_maxPooledConnectionsPerHost(curlOptions.MaxPooledConnectionsPerHost),
+          m_maxPooledConnections(curlOptions.MaxPooledConnections)
     {
+      m_bodyStartInBuffer = m_readBuffer.size();
+      m_innerBufferSize = m_readBuffer.size();
+      m_connection->SetTransportMetrics(m_transportMetrics.get());
     }
 
     ~CurlSession() override
@@ -423,10 +496,17 @@ namespace Azure { namespace Core { namespace Http {
       // By not moving the connection back to the pool, it gets destroyed calling the connection
       // destructor to clean libcurl handle and close the connection.
       // IsEOF will also handle a connection that fail to complete an upload request.
+      if (m_connection)
+      {
+        m_connection->SetTransportMetrics(nullptr);
+      }
       if (IsEOF() && m_keepAlive && !m_connectionUpgraded)
       {
         _detail::CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
-            std::move(m_connection), m_httpKeepAlive);
+            std::move(m_connection),
+            m_httpKeepAlive,
+            m_maxPooledConnectionsPerHost,
+            m_maxPooledConnections);
       }
     }
 
@@ -41,7 +41,7 @@ bool IsInvalidHeaderNameChar(char c)
 } // namespace
 
 void Azure::Core::Http::_detail::RawResponseHelpers::InsertHeaderWithValidation(
-    Azure::Core::CaseInsensitiveMap& headers,
+    HttpHeaders& headers,
     std::string const& headerName,
     std::string const& headerValue)
 {
@@ -54,5 +54,5 @@ void Azure::Core::Http::_detail::RawResponseHelpers::InsertHeaderWithValidation(
   }
 
   // insert (override if duplicated)
-  headers[headerName] = headerValue;
+  headers.insert_or_assign(headerName, headerValue);
 }
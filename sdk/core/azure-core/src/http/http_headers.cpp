@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/http/http_headers.hpp"
+
+#include "azure/core/internal/strings.hpp"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+using Azure::Core::Http::HttpHeaders;
+using Azure::Core::_internal::StringExtensions;
+
+namespace {
+// Orders header names like Azure::Core::CaseInsensitiveMap does.
+int CompareNames(std::string const& headerName, char const* name, size_t length)
+{
+  size_t const commonLength = (std::min)(headerName.size(), length);
+  for (size_t i = 0; i < commonLength; ++i)
+  {
+    char const lhs = StringExtensions::ToLower(headerName[i]);
+    char const rhs = StringExtensions::ToLower(name[i]);
+    if (lhs != rhs)
+    {
+      return lhs < rhs ? -1 : 1;
+    }
+  }
+  return headerName.size() < length ? -1 : (headerName.size() > length ? 1 : 0);
+}
+} // namespace
+
+HttpHeaders::HttpHeaders(HttpHeaders const& other) : HttpHeaders()
+{
+  Reserve(other.m_size);
+  for (auto const& header : other)
+  {
+    new (m_data + m_size) value_type(header);
+    ++m_size;
+  }
+}
+
+HttpHeaders::HttpHeaders(HttpHeaders&& other) noexcept : HttpHeaders() { MoveFrom(other); }
+
+HttpHeaders& HttpHeaders::operator=(HttpHeaders const& other)
+{
+  if (this != &other)
+  {
+    HttpHeaders copy(other);
+    Release();
+    MoveFrom(copy);
+  }
+  return *this;
+}
+
+HttpHeaders& HttpHeaders::operator=(HttpHeaders&& other) noexcept
+{
+  if (this != &other)
+  {
+    Release();
+    MoveFrom(other);
+  }
+  return *this;
+}
+
+HttpHeaders::~HttpHeaders() { Release(); }
+
+HttpHeaders::const_iterator HttpHeaders::upper_bound(std::string const& name) const
+{
+  return std::upper_bound(
+      begin(), end(), name, [](std::string const& lhs, value_type const& header) {
+        return CompareNames(header.first, lhs.data(), lhs.size()) > 0;
+      });
+}
+
+void HttpHeaders::insert_or_assign(std::string const& name, std::string const& value)
+{
+  auto const index = static_cast<size_type>(LowerBound(name.data(), name.size()) - m_data);
+  if (index != m_size && CompareNames(m_data[index].first, name.data(), name.size()) == 0)
+  {
+    m_data[index].second = value;
+    return;
+  }
+
+  if (m_size == m_capacity)
+  {
+    Reserve(m_capacity * 2);
+  }
+  // Add the header last, then rotate it to its place.
+  new (m_data + m_size) value_type(StringExtensions::ToLower(name), value);
+  ++m_size;
+  std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+}
+
+HttpHeaders::size_type HttpHeaders::erase(std::string const& name)
+{
+  auto const header = Find(name.data(), name.size());
+  if (header == end())
+  {
+    return 0;
+  }
+
+  auto const position = m_data + (header - m_data);
+  std::move(position + 1, m_data + m_size, position);
+  --m_size;
+  m_data[m_size].~value_type();
+  return 1;
+}
+
+void HttpHeaders::clear() noexcept
+{
+  for (size_type i = 0; i < m_size; ++i)
+  {
+    m_data[i].~value_type();
+  }
+  m_size = 0;
+}
+
+HttpHeaders::const_iterator HttpHeaders::LowerBound(char const* name, size_t length) const
+{
+  return std::lower_bound(
+      begin(), end(), name, [length](value_type const& header, char const* rhs) {
+        return CompareNames(header.first, rhs, length) < 0;
+      });
+}
+
+HttpHeaders::const_iterator HttpHeaders::Find(char const* name, size_t length) const
+{
+  auto const header = LowerBound(name, length);
+  return header != end() && CompareNames(header->first, name, length) == 0 ? header : end();
+}
+
+std::string const& HttpHeaders::At(char const* name, size_t length) const
+{
+  auto const header = Find(name, length);
+  if (header == end())
+  {
+    throw std::out_of_range("Header not found: " + std::string(name, length));
+  }
+  return header->second;
+}
+
+void HttpHeaders::Reserve(size_type capacity)
+{
+  if (capacity <= m_capacity)
+  {
+    return;
+  }
+
+  auto const data = static_cast<value_type*>(::operator new(capacity * sizeof(value_type)));
+  for (size_type i = 0; i < m_size; ++i)
+  {
+    new (data + i) value_type(std::move(m_data[i]));
+    m_data[i].~value_type();
+  }
+  if (!IsInline())
+  {
+    ::operator delete(m_data);
+  }
+  m_data = data;
+  m_capacity = capacity;
+}
+
+void HttpHeaders::Release() noexcept
+{
+  clear();
+  if (!IsInline())
+  {
+    ::operator delete(m_data);
+    m_data = GetInlineData();
+    m_capacity = InlineCapacity;
+  }
+}
+
+void HttpHeaders::MoveFrom(HttpHeaders& other) noexcept
+{
+  // The headers are empty and use their inline storage.
+  if (!other.IsInline())
+  {
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_capacity = other.m_capacity;
+    other.m_data = other.GetInlineData();
+    other.m_size = 0;
+    other.m_capacity = InlineCapacity;
+    return;
+  }
+
+  for (size_type i = 0; i < other.m_size; ++i)
+  {
+    new (m_data + i) value_type(std::move(other.m_data[i]));
+  }
+  m_size = other.m_size;
+  other.clear();
+}
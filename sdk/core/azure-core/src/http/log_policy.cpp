@@ -19,7 +19,7 @@ std::string RedactedPlaceholder = "REDACTED";
 inline void AppendHeaders(
     std::ostringstream& log,
     Azure::Core::Http::_internal::HttpSanitizer const& httpSanitizer,
-    Azure::Core::CaseInsensitiveMap const& headers)
+    Azure::Core::Http::HttpHeaders const& headers)
 {
   for (auto const& header : headers)
   {
@@ -46,6 +46,35 @@ inline std::string GetRequestLogMessage(
   return log.str();
 }
 
+inline long long ToMilliseconds(std::chrono::microseconds duration)
+{
+  return static_cast<long long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+}
+
+inline std::string GetTransportMetricsLogMessage(TransportMetrics const& metrics)
+{
+  std::ostringstream log;
+
+  log << "HTTP Transport Metrics : ";
+  if (metrics.ConnectionReused)
+  {
+    log << "reused connection";
+  }
+  else
+  {
+    log << "new connection: name lookup " << ToMilliseconds(metrics.NameLookupTime)
+        << "ms, connect " << ToMilliseconds(metrics.ConnectTime) << "ms, TLS handshake "
+        << ToMilliseconds(metrics.TlsHandshakeTime) << "ms";
+  }
+  log << "; send " << ToMilliseconds(metrics.SendTime) << "ms; time to first byte "
+      << ToMilliseconds(metrics.TimeToFirstByte) << "ms; body "
+      << ToMilliseconds(metrics.BodyReadTime) << "ms; " << metrics.BytesSent << " bytes sent, "
+      << metrics.BytesReceived << " bytes received in " << metrics.SocketReads
+      << " socket reads, " << metrics.SocketWaits << " socket waits";
+  return log.str();
+}
+
 inline std::string GetResponseLogMessage(
     Azure::Core::Http::_internal::HttpSanitizer const& httpSanitizer,
     RawResponse const& response,
@@ -125,6 +154,14 @@ std::unique_ptr<RawResponse> LogPolicy::Send(
 
   Log::Write(
       Logger::Level::Informational, GetResponseLogMessage(m_httpSanitizer, *response, end - start));
+  // The transport breakdown, when the HTTP transport measures it, goes on its own line so the
+  // response line keeps its format.
+  if (response->GetTransportMetrics())
+  {
+    Log::Write(
+        Logger::Level::Informational,
+        GetTransportMetricsLogMessage(*response->GetTransportMetrics()));
+  }
 
   return response;
 }
@@ -4,6 +4,7 @@
 #include "azure/core/http/policies/policy.hpp"
 
 #include "azure/core/http/http.hpp"
+#include "azure/core/http/policies/policy_latency_recorder.hpp"
 
 using Azure::Core::Context;
 using namespace Azure::Core::Http;
@@ -19,5 +20,10 @@ std::unique_ptr<RawResponse> NextHttpPolicy::Send(Request& request, Context cons
     throw std::invalid_argument("Invalid pipeline. No transport policy found. Endless policy.");
   }
 
+  if (m_timings != nullptr)
+  {
+    return m_timings->Send(m_index + 1, request, context);
+  }
+
   return m_policies[m_index + 1]->Send(request, NextHttpPolicy{m_index + 1, m_policies}, context);
 }
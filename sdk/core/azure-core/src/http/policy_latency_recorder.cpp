@@ -0,0 +1,254 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/http/policies/policy_latency_recorder.hpp"
+
+#include "azure/core/internal/tracing/service_tracing.hpp"
+#include "azure/core/rtti.hpp"
+
+#include <algorithm>
+
+#if defined(AZ_CORE_RTTI)
+#include <typeinfo>
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+#endif
+
+using Azure::Core::Context;
+using namespace Azure::Core::Http;
+using namespace Azure::Core::Http::Policies;
+using Azure::Core::Http::Policies::_detail::PipelineLatencyRecorder;
+using Azure::Core::Http::Policies::_detail::PolicyLatencyTimings;
+using Azure::Core::Tracing::_internal::TracingContextFactory;
+
+constexpr size_t PolicyLatencyHistogram::BucketCount;
+
+struct PolicyLatencyRecorder::Histogram final
+{
+  std::string const PolicyName;
+  std::atomic<uint64_t> Count;
+  std::atomic<int64_t> TotalNanoseconds;
+  std::atomic<uint64_t> BucketCounts[PolicyLatencyHistogram::BucketCount];
+
+  explicit Histogram(std::string policyName) : PolicyName(std::move(policyName)) { Reset(); }
+
+  void Record(std::chrono::nanoseconds latency)
+  {
+    auto const microseconds = static_cast<uint64_t>(latency.count()) / 1000;
+    size_t bucket = 0;
+    while (bucket < PolicyLatencyHistogram::BucketCount - 1
+           && (uint64_t{1} << bucket) <= microseconds)
+    {
+      ++bucket;
+    }
+
+    BucketCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+    TotalNanoseconds.fetch_add(latency.count(), std::memory_order_relaxed);
+    Count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Reset()
+  {
+    Count.store(0, std::memory_order_relaxed);
+    TotalNanoseconds.store(0, std::memory_order_relaxed);
+    for (auto& bucketCount : BucketCounts)
+    {
+      bucketCount.store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+namespace {
+std::string GetPolicyName(HttpPolicy const& policy, size_t index)
+{
+#if defined(AZ_CORE_RTTI)
+  static_cast<void>(index);
+  auto const typeName = typeid(policy).name();
+#if defined(__GNUG__)
+  int status = 0;
+  std::unique_ptr<char, void (*)(void*)> demangledName(
+      abi::__cxa_demangle(typeName, nullptr, nullptr, &status), std::free);
+  return status == 0 && demangledName ? std::string(demangledName.get()) : std::string(typeName);
+#else
+  // Drop the "class " or "struct " of the MSVC type names.
+  std::string name(typeName);
+  auto const space = name.find(' ');
+  return space == std::string::npos ? name : name.substr(space + 1);
+#endif
+#else
+  static_cast<void>(policy);
+  return "Policy " + std::to_string(index);
+#endif
+}
+
+// Adds the time spent in its scope to a duration, even when leaving the scope with an exception.
+class ScopedStopwatch final {
+  std::chrono::steady_clock::duration& m_duration;
+  std::chrono::steady_clock::time_point const m_start;
+
+public:
+  explicit ScopedStopwatch(std::chrono::steady_clock::duration& duration)
+      : m_duration(duration), m_start(std::chrono::steady_clock::now())
+  {
+  }
+
+  ~ScopedStopwatch() { m_duration += std::chrono::steady_clock::now() - m_start; }
+
+  ScopedStopwatch(ScopedStopwatch const&) = delete;
+  ScopedStopwatch& operator=(ScopedStopwatch const&) = delete;
+};
+} // namespace
+
+PolicyLatencyRecorder::PolicyLatencyRecorder(PolicyLatencyRecorderOptions const& options)
+    : m_options(options)
+{
+}
+
+PolicyLatencyRecorder::~PolicyLatencyRecorder() = default;
+
+std::vector<PolicyLatencyHistogram> PolicyLatencyRecorder::GetHistograms() const
+{
+  std::lock_guard<std::mutex> lock(m_histogramsMutex);
+  std::vector<PolicyLatencyHistogram> histograms;
+  histograms.reserve(m_histograms.size());
+  for (auto const& histogram : m_histograms)
+  {
+    PolicyLatencyHistogram result;
+    result.PolicyName = histogram->PolicyName;
+    result.Count = histogram->Count.load(std::memory_order_relaxed);
+    result.TotalLatency
+        = std::chrono::nanoseconds(histogram->TotalNanoseconds.load(std::memory_order_relaxed));
+    result.BucketCounts.reserve(PolicyLatencyHistogram::BucketCount);
+    for (auto const& bucketCount : histogram->BucketCounts)
+    {
+      result.BucketCounts.push_back(bucketCount.load(std::memory_order_relaxed));
+    }
+    histograms.push_back(std::move(result));
+  }
+
+  return histograms;
+}
+
+void PolicyLatencyRecorder::Reset()
+{
+  std::lock_guard<std::mutex> lock(m_histogramsMutex);
+  for (auto const& histogram : m_histograms)
+  {
+    histogram->Reset();
+  }
+}
+
+PolicyLatencyRecorder::Histogram* PolicyLatencyRecorder::GetHistogram(std::string const& policyName)
+{
+  std::lock_guard<std::mutex> lock(m_histogramsMutex);
+  auto const histogram = std::find_if(
+      m_histograms.begin(), m_histograms.end(), [&policyName](std::unique_ptr<Histogram> const& h) {
+        return h->PolicyName == policyName;
+      });
+  if (histogram != m_histograms.end())
+  {
+    return histogram->get();
+  }
+
+  m_histograms.emplace_back(std::make_unique<Histogram>(policyName));
+  return m_histograms.back().get();
+}
+
+bool PolicyLatencyRecorder::IsSampled()
+{
+  return m_options.SamplingInterval <= 1
+      || m_requestCount.fetch_add(1, std::memory_order_relaxed) % m_options.SamplingInterval == 0;
+}
+
+std::unique_ptr<RawResponse> PolicyLatencyTimings::Send(
+    size_t index,
+    Request& request,
+    Context const& context)
+{
+  auto& timing = m_timings[index];
+  timing.IsCalled = true;
+  ScopedStopwatch const stopwatch(timing.Duration);
+  return m_policies[index]->Send(request, NextHttpPolicy(index, m_policies, this), context);
+}
+
+PipelineLatencyRecorder::PipelineLatencyRecorder(
+    std::shared_ptr<PolicyLatencyRecorder> recorder,
+    std::vector<std::unique_ptr<HttpPolicy>> const& policies)
+    : m_recorder(std::move(recorder))
+{
+  m_histograms.reserve(policies.size());
+  for (size_t i = 0; i < policies.size(); ++i)
+  {
+    m_histograms.push_back(m_recorder->GetHistogram(GetPolicyName(*policies[i], i)));
+  }
+}
+
+std::unique_ptr<RawResponse> PipelineLatencyRecorder::Send(
+    std::vector<std::unique_ptr<HttpPolicy>> const& policies,
+    Request& request,
+    Context const& context) const
+{
+  if (!m_recorder->IsSampled())
+  {
+    return policies[0]->Send(request, NextHttpPolicy(0, policies), context);
+  }
+
+  PolicyLatencyTimings timings(policies);
+  std::unique_ptr<RawResponse> response;
+  try
+  {
+    response = timings.Send(0, request, context);
+  }
+  catch (...)
+  {
+    Record(timings, context);
+    throw;
+  }
+
+  Record(timings, context);
+  return response;
+}
+
+void PipelineLatencyRecorder::Record(PolicyLatencyTimings const& timings, Context const& context)
+    const
+{
+  // The latency of a policy is its duration minus the duration of the next policy, which only it
+  // calls.
+  auto const& policyTimings = timings.m_timings;
+  std::vector<std::chrono::nanoseconds> latencies(policyTimings.size());
+  for (size_t i = 0; i < policyTimings.size(); ++i)
+  {
+    auto latency = policyTimings[i].Duration;
+    if (i + 1 < policyTimings.size())
+    {
+      latency -= policyTimings[i + 1].Duration;
+    }
+    latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(latency);
+    if (policyTimings[i].IsCalled)
+    {
+      m_histograms[i]->Record(latencies[i]);
+    }
+  }
+
+  auto const tracingFactory = TracingContextFactory::CreateFromContext(context);
+  std::shared_ptr<Azure::Core::Tracing::_internal::Span> span;
+  if (!tracingFactory || !tracingFactory->HasTracer()
+      || !context.TryGetValue(TracingContextFactory::ContextSpanKey, span) || !span)
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < policyTimings.size(); ++i)
+  {
+    if (policyTimings[i].IsCalled)
+    {
+      auto const microseconds
+          = std::chrono::duration_cast<std::chrono::microseconds>(latencies[i]).count();
+      auto attributes = tracingFactory->CreateAttributeSet();
+      attributes->AddAttribute("az.policy.latency_us", static_cast<int64_t>(microseconds));
+      span->AddEvent(m_histograms[i]->PolicyName, *attributes);
+    }
+  }
+}
@@ -12,7 +12,7 @@ HttpStatusCode RawResponse::GetStatusCode() const { return m_statusCode; }
 
 std::string const& RawResponse::GetReasonPhrase() const { return m_reasonPhrase; }
 
-Azure::Core::CaseInsensitiveMap const& RawResponse::GetHeaders() const { return this->m_headers; }
+HttpHeaders const& RawResponse::GetHeaders() const { return this->m_headers; }
 
 void RawResponse::SetHeader(std::string const& name, std::string const& value)
 {
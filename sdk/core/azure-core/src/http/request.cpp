@@ -5,26 +5,15 @@
 #include "azure/core/internal/io/null_body_stream.hpp"
 #include "azure/core/internal/strings.hpp"
 
-#include <map>
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace Azure::Core;
 using namespace Azure::Core::Http;
 using namespace Azure::Core::IO::_internal;
 
-namespace {
-// returns left map plus all items in right
-// when duplicates, left items are preferred
-static Azure::Core::CaseInsensitiveMap MergeMaps(
-    Azure::Core::CaseInsensitiveMap left,
-    Azure::Core::CaseInsensitiveMap const& right)
-{
-  left.insert(right.begin(), right.end());
-  return left;
-}
-} // namespace
-
 Request::Request(HttpMethod httpMethod, Url url, bool shouldBufferResponse)
     : Request(httpMethod, std::move(url), NullBodyStream::GetNullBodyStream(), shouldBufferResponse)
 {
@@ -37,13 +26,10 @@ Request::Request(HttpMethod httpMethod, Url url)
 
 Azure::Nullable<std::string> Request::GetHeader(std::string const& name)
 {
-  for (auto const& hdrs : {m_retryHeaders, m_headers})
+  auto const header = m_headers.find(name);
+  if (header != m_headers.end())
   {
-    auto const header = hdrs.find(name);
-    if (header != hdrs.end())
-    {
-      return header->second;
-    }
+    return header->second;
   }
 
   return {};
@@ -51,22 +37,63 @@ Azure::Nullable<std::string> Request::GetHeader(std::string const& name)
 
 void Request::SetHeader(std::string const& name, std::string const& value)
 {
-  return _detail::RawResponseHelpers::InsertHeaderWithValidation(
-      m_retryModeEnabled ? m_retryHeaders : m_headers,
-      Azure::Core::_internal::StringExtensions::ToLower(name),
-      value);
+  if (m_retryModeEnabled)
+  {
+    // Keep the value the header had before the try, the first time the try sets it.
+    auto const headerBeforeTry = std::find_if(
+        m_headersBeforeTry.begin(), m_headersBeforeTry.end(), [&name](auto const& header) {
+          return Azure::Core::_internal::StringExtensions::LocaleInvariantCaseInsensitiveEqual(
+              header.first, name);
+        });
+    if (headerBeforeTry == m_headersBeforeTry.end())
+    {
+      Azure::Nullable<std::string> valueBeforeTry;
+      auto const header = m_headers.find(name);
+      if (header != m_headers.end())
+      {
+        valueBeforeTry = header->second;
+      }
+      _detail::RawResponseHelpers::InsertHeaderWithValidation(m_headers, name, value);
+      m_headersBeforeTry.emplace_back(
+          Azure::Core::_internal::StringExtensions::ToLower(name), std::move(valueBeforeTry));
+      return;
+    }
+  }
+
+  _detail::RawResponseHelpers::InsertHeaderWithValidation(m_headers, name, value);
 }
 
 void Request::RemoveHeader(std::string const& name)
 {
   this->m_headers.erase(name);
-  this->m_retryHeaders.erase(name);
+  // The header is removed for the next tries too.
+  this->m_headersBeforeTry.erase(
+      std::remove_if(
+          m_headersBeforeTry.begin(),
+          m_headersBeforeTry.end(),
+          [&name](auto const& header) {
+            return Azure::Core::_internal::StringExtensions::LocaleInvariantCaseInsensitiveEqual(
+                header.first, name);
+          }),
+      m_headersBeforeTry.end());
 }
 
 void Request::StartTry()
 {
   this->m_retryModeEnabled = true;
-  this->m_retryHeaders.clear();
+  // Restore the headers set during the previous try, last set first.
+  for (auto header = m_headersBeforeTry.rbegin(); header != m_headersBeforeTry.rend(); ++header)
+  {
+    if (header->second.HasValue())
+    {
+      m_headers.insert_or_assign(header->first, header->second.Value());
+    }
+    else
+    {
+      m_headers.erase(header->first);
+    }
+  }
+  this->m_headersBeforeTry.clear();
 
   // Make sure to rewind the body stream before each attempt, including the first.
   // It's possible the request doesn't have a body, so make sure to check if a body stream exists.
@@ -77,10 +104,3 @@ void Request::StartTry()
 }
 
 HttpMethod const& Request::GetMethod() const { return this->m_method; }
-
-Azure::Core::CaseInsensitiveMap Request::GetHeaders() const
-{
-  // create map with retry headers which are the most important and we don't want
-  // to override them with any duplicate header
-  return MergeMaps(this->m_retryHeaders, this->m_headers);
-}
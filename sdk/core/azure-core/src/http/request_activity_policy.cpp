@@ -6,6 +6,7 @@
 #include "azure/core/internal/tracing/service_tracing.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <thread>
 
@@ -83,6 +84,22 @@ std::unique_ptr<RawResponse> RequestActivityPolicy::Send(
       scope.AddAttribute(
           TracingAttributes::HttpStatusCode.ToString(),
           std::to_string(static_cast<int>(response->GetStatusCode())));
+      // And where the time went inside the transport, when it measures it.
+      auto const& transportMetrics = response->GetTransportMetrics();
+      if (transportMetrics)
+      {
+        auto const connectTime = transportMetrics->NameLookupTime + transportMetrics->ConnectTime
+            + transportMetrics->TlsHandshakeTime;
+        scope.AddAttribute(
+            TracingAttributes::TransportConnectTime.ToString(),
+            std::to_string(
+                std::chrono::duration_cast<std::chrono::milliseconds>(connectTime).count()));
+        scope.AddAttribute(
+            TracingAttributes::TransportTimeToFirstByte.ToString(),
+            std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                               transportMetrics->TimeToFirstByte)
+                               .count()));
+      }
       auto const& responseHeaders = response->GetHeaders();
       auto serviceRequestId = responseHeaders.find("x-ms-request-id");
       if (serviceRequestId != responseHeaders.end())
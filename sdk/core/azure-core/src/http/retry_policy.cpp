@@ -8,7 +8,6 @@
 #include <cstdlib>
 #include <limits>
 #include <sstream>
-#include <thread>
 
 using Azure::Core::Context;
 using namespace Azure::Core::Http;
@@ -176,9 +175,8 @@ std::unique_ptr<RawResponse> RetryPolicyBase::Send(
     // we proceed immediately if it is 0.
     if (retryAfter.count() > 0)
     {
-      // Before sleeping, check to make sure that the context hasn't already been cancelled.
-      context.ThrowIfCancelled();
-      std::this_thread::sleep_for(retryAfter);
+      // Wake up as soon as the context is cancelled.
+      Azure::Core::_internal::ContextCancellationSignal::Sleep(context, retryAfter);
     }
 
     // Restore the original query parameters before next retry
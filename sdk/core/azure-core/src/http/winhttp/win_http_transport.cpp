@@ -274,9 +274,7 @@ std::string GetHeadersAsString(Azure::Core::Http::Request const& request)
 {
   std::string requestHeaderString;
 
-  // request.GetHeaders() aggregates the pre- and post-retry headers into a single map. Capture it
-  // so we don't recalculate the merge multiple times.
-  auto requestHeaders = request.GetHeaders();
+  auto const& requestHeaders = request.GetHeaders();
 
   for (auto const& header : requestHeaders)
   {
@@ -1542,7 +1540,7 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
     std::wstring encodedHeaders;
     int encodedHeadersLength = 0;
 
-    auto requestHeaders = request.GetHeaders();
+    auto const& requestHeaders = request.GetHeaders();
     if (requestHeaders.size() != 0)
     {
       // The encodedHeaders will be null-terminated and the length is calculated.
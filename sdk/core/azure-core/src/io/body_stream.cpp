@@ -91,6 +91,16 @@ size_t MemoryBodyStream::OnRead(uint8_t* buffer, size_t count, Context const& co
   return copy_length;
 }
 
+size_t MemoryBodyStream::OnReadInPlace(uint8_t const*& data, size_t count, Context const& context)
+{
+  (void)context;
+  size_t readLength = (std::min)(count, this->m_length - this->m_offset);
+  data = this->m_data + m_offset;
+  m_offset += readLength;
+
+  return readLength;
+}
+
 FileBodyStream::FileBodyStream(const std::string& filename)
 {
   AZURE_ASSERT_MSG(filename.size() > 0, "The file name must not be an empty string.");
@@ -219,6 +229,21 @@ size_t ProgressBodyStream::OnRead(
   return read;
 }
 
+size_t ProgressBodyStream::OnReadInPlace(
+    uint8_t const*& data,
+    size_t count,
+    Azure::Core::Context const& context)
+{
+  size_t read = m_bodyStream->ReadInPlace(data, count, context);
+  if (data != nullptr)
+  {
+    m_bytesTransferred += read;
+    m_callback(m_bytesTransferred);
+  }
+
+  return read;
+}
+
 int64_t ProgressBodyStream::Length() const { return m_bodyStream->Length(); }
 
 using Azure::Core::IO::_internal::NullBodyStream;
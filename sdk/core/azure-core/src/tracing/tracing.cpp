@@ -27,6 +27,9 @@ namespace Azure { namespace Core { namespace Tracing { namespace _internal {
   const TracingAttributes TracingAttributes::AzNamespace("az.namespace");
   const TracingAttributes TracingAttributes::RequestId("az.client_request_id");
   const TracingAttributes TracingAttributes::ServiceRequestId("az.service_request_id");
+  const TracingAttributes TracingAttributes::TransportConnectTime("az.transport.connect_time_ms");
+  const TracingAttributes TracingAttributes::TransportTimeToFirstByte(
+      "az.transport.time_to_first_byte_ms");
 
   using Azure::Core::Context;
 
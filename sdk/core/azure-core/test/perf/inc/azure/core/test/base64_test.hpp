@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of encoding and decoding Base64.
+ *
+ */
+
+#pragma once
+
+#include <azure/core.hpp>
+#include <azure/core/base64.hpp>
+#include <azure/perf.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+
+  /**
+   * @brief Measure the Base64 encoding or decoding throughput.
+   *
+   * @remark Use `--size` to set the size of the binary data, `--decode 1` to measure the
+   * decoding and `--buffer 1` to write into a buffer allocated once instead of a new string or
+   * vector for each operation.
+   */
+  class Base64Test : public Azure::Perf::PerfTest {
+    std::vector<uint8_t> m_data;
+    std::string m_encoded;
+    std::vector<uint8_t> m_decodeBuffer;
+    std::string m_encodeBuffer;
+    bool m_decode = false;
+    bool m_useBuffer = false;
+
+  public:
+    /**
+     * @brief Construct a new Base64Test test.
+     *
+     * @param options The test options.
+     */
+    Base64Test(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      m_data.resize(m_options.GetOptionOrDefault<size_t>("Size", 4096));
+      for (size_t i = 0; i < m_data.size(); ++i)
+      {
+        m_data[i] = static_cast<uint8_t>(i * 131 + 7);
+      }
+      m_encoded = Azure::Core::Convert::Base64Encode(m_data);
+      m_decode = m_options.GetOptionOrDefault<bool>("Decode", false);
+      m_useBuffer = m_options.GetOptionOrDefault<bool>("Buffer", false);
+      m_encodeBuffer.resize(m_encoded.size());
+      m_decodeBuffer.resize(m_data.size());
+    }
+
+    /**
+     * @brief Encode or decode the data once.
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      if (m_decode)
+      {
+        if (m_useBuffer)
+        {
+          Azure::Core::Convert::Base64Decode(
+              m_encoded.data(), m_encoded.size(), m_decodeBuffer.data(), m_decodeBuffer.size());
+        }
+        else
+        {
+          Azure::Core::Convert::Base64Decode(m_encoded);
+        }
+      }
+      else
+      {
+        if (m_useBuffer)
+        {
+          Azure::Core::Convert::Base64Encode(
+              m_data.data(), m_data.size(), &m_encodeBuffer[0], m_encodeBuffer.size());
+        }
+        else
+        {
+          Azure::Core::Convert::Base64Encode(m_data);
+        }
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Size", {"--size"}, "Size of the binary data (in bytes). Default 4096.", 1, false},
+          {"Decode", {"--decode"}, "Measure decoding instead of encoding.", 1, false},
+          {"Buffer", {"--buffer"}, "Write into a caller provided buffer.", 1, false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "base64",
+          "Measures Base64 encoding and decoding",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::Base64Test>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the request latency while the bearer token authentication policy refreshes its
+ * token.
+ *
+ */
+
+#pragma once
+
+#include <azure/core.hpp>
+#include <azure/core/http/policies/policy.hpp>
+#include <azure/core/internal/http/pipeline.hpp>
+#include <azure/perf.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+
+  namespace _detail {
+    /**
+     * @brief A credential which takes as long as a call to the identity service to get a token.
+     */
+    class SlowTokenCredential final : public Azure::Core::Credentials::TokenCredential {
+      std::chrono::milliseconds m_delay;
+      std::chrono::milliseconds m_tokenLifetime;
+
+    public:
+      SlowTokenCredential(std::chrono::milliseconds delay, std::chrono::milliseconds tokenLifetime)
+          : TokenCredential("SlowTokenCredential"), m_delay(delay), m_tokenLifetime(tokenLifetime)
+      {
+      }
+
+      Azure::Core::Credentials::AccessToken GetToken(
+          Azure::Core::Credentials::TokenRequestContext const&,
+          Azure::Core::Context const&) const override
+      {
+        std::this_thread::sleep_for(m_delay);
+        return {"token", std::chrono::system_clock::now() + m_tokenLifetime};
+      }
+    };
+  } // namespace _detail
+
+  /**
+   * @brief Measure the latency of requests authenticated with a token which expires during the
+   * test.
+   *
+   * @remark Use `--token-lifetime` to set how long the tokens are valid and `--token-delay` to set
+   * how long it takes to get one. Tokens are refreshed one second before they expire, by the
+   * request which finds the token expiring or, with `--refresh-window`, in the background. Each
+   * test instance waits `--interval` between its requests, like a client sending requests at a
+   * steady rate.
+   */
+  class BearerTokenRefreshTest : public Azure::Perf::PerfTest {
+    std::unique_ptr<Azure::Core::Http::_internal::HttpPipeline> m_pipeline;
+    std::chrono::microseconds m_interval{0};
+
+    static Azure::Perf::LatencyCollector& RequestLatency()
+    {
+      static Azure::Perf::LatencyCollector latency;
+      return latency;
+    }
+
+  public:
+    /**
+     * @brief Construct a new BearerTokenRefreshTest test.
+     *
+     * @param options The test options.
+     */
+    BearerTokenRefreshTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      Azure::Core::Credentials::TokenRequestContext tokenRequestContext;
+      tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+      tokenRequestContext.MinimumExpiration = std::chrono::seconds(1);
+
+      std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> policies;
+      policies.emplace_back(
+          std::make_unique<Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy>(
+              std::make_shared<_detail::SlowTokenCredential>(
+                  std::chrono::milliseconds(m_options.GetOptionOrDefault<int>("TokenDelay", 200)),
+                  std::chrono::milliseconds(
+                      m_options.GetOptionOrDefault<int>("TokenLifetime", 3000))),
+              tokenRequestContext,
+              std::chrono::milliseconds(m_options.GetOptionOrDefault<int>("RefreshWindow", 0))));
+      Azure::Core::Http::Policies::TransportOptions transportOptions;
+      transportOptions.Transport = std::make_shared<Azure::Perf::NoNetworkTransport>();
+      policies.emplace_back(
+          std::make_unique<Azure::Core::Http::Policies::_internal::TransportPolicy>(
+              transportOptions));
+      m_pipeline = std::make_unique<Azure::Core::Http::_internal::HttpPipeline>(policies);
+      m_interval
+          = std::chrono::microseconds(m_options.GetOptionOrDefault<int>("Interval", 1000));
+
+      // Get the first token before the requests are timed.
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url("https://www.azure.com"));
+      m_pipeline->Send(request, Azure::Core::Context{});
+    }
+
+    /**
+     * @brief Send one authenticated request and record its latency.
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      auto const start = std::chrono::steady_clock::now();
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url("https://www.azure.com"));
+      m_pipeline->Send(request, context);
+      RequestLatency().Record(std::chrono::steady_clock::now() - start);
+      std::this_thread::sleep_for(m_interval);
+    }
+
+    void GlobalCleanup() override
+    {
+      auto const latency = RequestLatency().Summarize();
+      std::cout << "Request latency p50: " << latency.P50Ms << "ms, p99: " << latency.P99Ms
+                << "ms, p99.9: " << latency.P999Ms << "ms, max: " << latency.P100Ms << "ms"
+                << std::endl;
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"TokenDelay",
+           {"--token-delay"},
+           "How long it takes to get a token (in ms). Default 200.",
+           1,
+           false},
+          {"TokenLifetime",
+           {"--token-lifetime"},
+           "How long a token is valid (in ms). Default 3000.",
+           1,
+           false},
+          {"RefreshWindow",
+           {"--refresh-window"},
+           "Refresh the token in the background when it expires within this window (in ms). "
+           "Default 0, the token is not refreshed in the background.",
+           1,
+           false},
+          {"Interval",
+           {"--interval"},
+           "The time to wait between two requests (in us). Default 1000.",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "bearerTokenRefresh",
+          "Measures the request latency while the bearer token is refreshed",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::BearerTokenRefreshTest>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
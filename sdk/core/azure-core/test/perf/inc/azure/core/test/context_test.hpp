@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of checking a context for cancellation.
+ *
+ */
+
+#pragma once
+
+#include "../../../core/perf/inc/azure/perf.hpp"
+
+#include <azure/core/context.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+
+  /**
+   * @brief Measure `Context::IsCancelled()` on a chain of contexts.
+   *
+   * @remark Use `--depth` to set the number of contexts in the chain, like the contexts the
+   * clients and policies derive from the context of an operation, and `--deadline 1` to give the
+   * root context a deadline. Each operation checks the last context of the chain 100 times. With
+   * `--derive 1`, all the test instances share the root context, and each operation creates a
+   * context from the last context of the chain before checking it, like the requests of an
+   * application sharing one context. Run it with `--parallel` to measure many threads creating
+   * contexts from the same root.
+   */
+  class ContextTest : public Azure::Perf::PerfTest {
+    Azure::Core::Context m_context;
+    bool m_derive = false;
+    bool m_cancelled = false;
+
+  public:
+    /**
+     * @brief Construct a new ContextTest test.
+     *
+     * @param options The test options.
+     */
+    ContextTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      static Azure::Core::Context::Key const key;
+      static Azure::Core::Context const sharedContext;
+      auto const deadline = std::chrono::system_clock::now() + std::chrono::hours(1);
+      bool const hasDeadline = m_options.GetOptionOrDefault<bool>("Deadline", false);
+      m_derive = m_options.GetOptionOrDefault<bool>("Derive", false);
+      if (m_derive)
+      {
+        m_context = hasDeadline ? sharedContext.WithDeadline(deadline) : sharedContext;
+      }
+      else if (hasDeadline)
+      {
+        m_context = Azure::Core::Context(deadline);
+      }
+      auto const depth = m_options.GetOptionOrDefault<int>("Depth", 1);
+      for (int i = 1; i < depth; ++i)
+      {
+        m_context = m_context.WithValue(key, i);
+      }
+    }
+
+    /**
+     * @brief Check the context for cancellation.
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      auto const context = m_derive ? m_context.WithDeadline((Azure::DateTime::max)()) : m_context;
+      for (int i = 0; i < 100; ++i)
+      {
+        m_cancelled = context.IsCancelled() || m_cancelled;
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Depth", {"--depth"}, "The number of contexts in the chain. Default 1.", 1, false},
+          {"Deadline", {"--deadline"}, "Give the root context a deadline.", 1, false},
+          {"Derive",
+           {"--derive"},
+           "Create a context from a root shared by the test instances in each operation.",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "context",
+          "Measures checking a chain of contexts for cancellation",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::ContextTest>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
@@ -0,0 +1,184 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the libcurl session performance when reading a chunked response.
+ *
+ */
+
+#pragma once
+
+#if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
+#include <azure/core.hpp>
+#include <azure/core/http/curl_transport.hpp>
+#include <azure/perf.hpp>
+
+// Private azure-core headers, the curl session is not part of the public API.
+#include <http/curl/curl_connection_private.hpp>
+#include <http/curl/curl_session_private.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+
+  namespace _detail {
+    /**
+     * @brief A connection which reads a response from memory instead of the network, so only the
+     * session parsing the response is measured.
+     */
+    class InMemoryCurlNetworkConnection final : public Azure::Core::Http::CurlNetworkConnection {
+      std::string m_connectionKey = "in-memory";
+      std::string const& m_response;
+      size_t m_maxSocketRead;
+      size_t m_offset = 0;
+
+    public:
+      InMemoryCurlNetworkConnection(std::string const& response, size_t maxSocketRead)
+          : m_response(response), m_maxSocketRead(maxSocketRead)
+      {
+      }
+      std::string const& GetConnectionKey() const override { return m_connectionKey; }
+      void UpdateLastUsageTime() override {}
+      bool IsExpired() override { return false; }
+      size_t ReadFromSocket(uint8_t* buffer, size_t bufferSize, Context const&) override
+      {
+        auto const count
+            = (std::min)({bufferSize, m_maxSocketRead, m_response.size() - m_offset});
+        std::copy(
+            m_response.begin() + m_offset, m_response.begin() + m_offset + count, buffer);
+        m_offset += count;
+        return count;
+      }
+      CURLcode SendBuffer(uint8_t const*, size_t, Context const&) override { return CURLE_OK; }
+    };
+  } // namespace _detail
+
+  /**
+   * @brief Measure reading a chunked response body through the libcurl session.
+   *
+   * @remark The response is synthetic and served from memory. Use `--chunk-size` to set the size
+   * of the chunks, `--socket-read` to set the most bytes a socket read returns and `--read-size`
+   * to set the size of the buffer the body is read into.
+   */
+  class CurlChunkedResponseTest : public Azure::Perf::PerfTest {
+    std::string m_response;
+    size_t m_bodySize = 0;
+    size_t m_socketRead = 0;
+    std::vector<uint8_t> m_buffer;
+    std::unique_ptr<Azure::Core::Http::Request> m_request;
+
+  public:
+    /**
+     * @brief Construct a new CurlChunkedResponseTest test.
+     *
+     * @param options The test options.
+     */
+    CurlChunkedResponseTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      m_bodySize = m_options.GetOptionOrDefault<size_t>("Size", 1024 * 1024);
+      auto const chunkSize = m_options.GetOptionOrDefault<size_t>("ChunkSize", 1024);
+      m_socketRead = m_options.GetOptionOrDefault<size_t>("SocketRead", 16 * 1024);
+      m_buffer.resize(m_options.GetOptionOrDefault<size_t>("ReadSize", 64 * 1024));
+      if (chunkSize == 0 || m_socketRead == 0 || m_buffer.empty())
+      {
+        throw std::runtime_error("--chunk-size, --socket-read and --read-size must not be 0.");
+      }
+
+      m_response = "HTTP/1.1 200 OK\r\ntransfer-encoding: chunked\r\n\r\n";
+      std::string const data(chunkSize, 'x');
+      for (size_t written = 0; written < m_bodySize; written += chunkSize)
+      {
+        auto const size = (std::min)(chunkSize, m_bodySize - written);
+        char chunkHeader[20];
+        std::snprintf(chunkHeader, sizeof(chunkHeader), "%zx\r\n", size);
+        m_response += chunkHeader;
+        m_response.append(data, 0, size);
+        m_response += "\r\n";
+      }
+      m_response += "0\r\n\r\n";
+
+      m_request = std::make_unique<Azure::Core::Http::Request>(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url("http://chunked-host"));
+    }
+
+    /**
+     * @brief Parse the response and read its whole body.
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      // The in-memory connection is used once and never moved to the connection pool.
+      transportOptions.HttpKeepAlive = false;
+      auto session = std::make_unique<Azure::Core::Http::CurlSession>(
+          *m_request,
+          std::make_unique<_detail::InMemoryCurlNetworkConnection>(m_response, m_socketRead),
+          transportOptions);
+      session->Perform(context);
+      auto response = session->ExtractResponse();
+      response->SetBodyStream(std::move(session));
+      auto body = response->ExtractBodyStream();
+
+      size_t totalRead = 0;
+      for (size_t read; (read = body->Read(m_buffer.data(), m_buffer.size(), context)) > 0;)
+      {
+        totalRead += read;
+      }
+      if (totalRead != m_bodySize)
+      {
+        throw std::runtime_error("Unexpected body size " + std::to_string(totalRead));
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Size", {"--size"}, "Size of the response body (in bytes). Default 1 MiB.", 1, false},
+          {"ChunkSize",
+           {"--chunk-size"},
+           "Size of each chunk of the response (in bytes). Default 1024.",
+           1,
+           false},
+          {"SocketRead",
+           {"--socket-read"},
+           "The most bytes returned by one socket read. Default 16 KiB.",
+           1,
+           false},
+          {"ReadSize",
+           {"--read-size"},
+           "Size of the buffer the body is read into (in bytes). Default 64 KiB.",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "curlChunkedResponse",
+          "Measures reading a chunked response body with the libcurl session",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::CurlChunkedResponseTest>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
+#endif
@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the libcurl connection pool checkout and checkin performance.
+ *
+ */
+
+#pragma once
+
+#if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
+#include <azure/core.hpp>
+#include <azure/core/http/curl_transport.hpp>
+#include <azure/perf.hpp>
+
+// Private azure-core headers, the connection pool is not part of the public API.
+#include <http/curl/curl_connection_pool_private.hpp>
+#include <http/curl/curl_connection_private.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace Azure { namespace Core { namespace Test {
+
+  namespace _detail {
+    /**
+     * @brief A connection which never touches the network, so only the pool itself is measured.
+     */
+    class NoOpCurlNetworkConnection final : public Azure::Core::Http::CurlNetworkConnection {
+      std::string m_connectionKey;
+
+    public:
+      NoOpCurlNetworkConnection(std::string connectionKey)
+          : m_connectionKey(std::move(connectionKey))
+      {
+      }
+      std::string const& GetConnectionKey() const override { return m_connectionKey; }
+      void UpdateLastUsageTime() override {}
+      bool IsExpired() override { return false; }
+      size_t ReadFromSocket(uint8_t*, size_t, Context const&) override { return 0; }
+      CURLcode SendBuffer(uint8_t const*, size_t, Context const&) override { return CURLE_OK; }
+    };
+  } // namespace _detail
+
+  /**
+   * @brief Measure the libcurl connection pool when many threads get and return connections.
+   *
+   * @remark Use `--parallel` to set the number of threads and `--hosts` to spread them across
+   * different hosts.
+   */
+  class CurlConnectionPoolTest : public Azure::Perf::PerfTest {
+    std::unique_ptr<Azure::Core::Http::Request> m_request;
+    int m_count = 0;
+
+    static std::atomic<int>& InstanceCount()
+    {
+      static std::atomic<int> instanceCount{0};
+      return instanceCount;
+    }
+
+  public:
+    /**
+     * @brief Construct a new CurlConnectionPoolTest test.
+     *
+     * @param options The test options.
+     */
+    CurlConnectionPoolTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      using Azure::Core::Http::_detail::CurlConnectionPool;
+
+      m_count = m_options.GetMandatoryOption<int>("Count");
+      auto const hosts = m_options.GetOptionOrDefault<int>("Hosts", 1);
+      std::string const host = "pool-host-" + std::to_string(InstanceCount()++ % hosts);
+      m_request = std::make_unique<Azure::Core::Http::Request>(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url("http://" + host));
+
+      // Each parallel instance adds one connection, so a checkout always finds one in the pool.
+      // The key must match the one the pool creates for a request with default options.
+      CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+          std::make_unique<_detail::NoOpCurlNetworkConnection>(
+              "http://" + host + ",0,0,0,0,0,1,1,0,0,0,1,0,0"),
+          true);
+    }
+
+    /**
+     * @brief Get a connection from the pool and move it back, count times.
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      using Azure::Core::Http::_detail::CurlConnectionPool;
+
+      Azure::Core::Http::CurlTransportOptions const options;
+      for (auto count = 0; count < m_count; count++)
+      {
+        CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+            CurlConnectionPool::g_curlConnectionPool.ExtractOrCreateCurlConnection(
+                *m_request, options),
+            true);
+      }
+    }
+
+    void GlobalCleanup() override
+    {
+      auto const statistics = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      std::cout << "Pool hits: " << statistics.Hits << ", misses: " << statistics.Misses
+                << ", evictions: " << statistics.Evictions << ", lock wait: "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(statistics.LockWaitTime)
+                       .count()
+                << "ms" << std::endl;
+      Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Count", {"--count"}, "The number of checkout and checkin per run.", 1, true},
+          {"Hosts",
+           {"--hosts"},
+           "The number of hosts the parallel instances are spread across. Default 1.",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "curlConnectionPool",
+          "Measures libcurl connection pool checkout and checkin throughput",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::CurlConnectionPoolTest>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
+#endif
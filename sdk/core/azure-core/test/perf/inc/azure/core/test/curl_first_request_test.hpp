@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the latency of the first request to a host with the libcurl transport.
+ *
+ */
+
+#pragma once
+
+#if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
+#include <azure/core.hpp>
+#include <azure/core/http/curl_transport.hpp>
+#include <azure/perf.hpp>
+
+// Private azure-core headers, the connection pool is not part of the public API.
+#include <http/curl/curl_connection_pool_private.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace Azure { namespace Core { namespace Test {
+
+  /**
+   * @brief Measure the latency of the first request sent to a host, when the connection pool has
+   * no connection for it.
+   *
+   * @remark Each run empties the connection pool, so use `--parallel 1`. Use `--prewarm` to open
+   * connections with #Azure::Core::Http::CurlTransport::Prewarm before the request is timed and
+   * `--dns-cache-timeout 0` to resolve the host name for every connection.
+   */
+  class CurlFirstRequestTest : public Azure::Perf::PerfTest {
+    std::unique_ptr<Azure::Core::Http::CurlTransport> m_transport;
+    std::unique_ptr<Azure::Core::Url> m_url;
+    size_t m_prewarm = 0;
+
+    static Azure::Perf::LatencyCollector& FirstRequestLatency()
+    {
+      static Azure::Perf::LatencyCollector latency;
+      return latency;
+    }
+
+  public:
+    /**
+     * @brief Construct a new CurlFirstRequestTest test.
+     *
+     * @param options The test options.
+     */
+    CurlFirstRequestTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      m_url = std::make_unique<Azure::Core::Url>(m_options.GetMandatoryOption<std::string>("Url"));
+      m_prewarm = m_options.GetOptionOrDefault<size_t>("Prewarm", 0);
+
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      transportOptions.SslVerifyPeer = false;
+      transportOptions.DnsCacheTimeout = std::chrono::seconds(
+          m_options.GetOptionOrDefault<long>("DnsCacheTimeout", 60));
+      m_transport = std::make_unique<Azure::Core::Http::CurlTransport>(transportOptions);
+    }
+
+    /**
+     * @brief Send one request over a new or pre-warmed connection and record its latency.
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+      if (m_prewarm > 0)
+      {
+        m_transport->Prewarm(*m_url, m_prewarm, context);
+      }
+
+      auto const start = std::chrono::steady_clock::now();
+      Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Get, *m_url);
+      auto response = m_transport->Send(request, context);
+      // Make sure to pull all bytes from network.
+      response->ExtractBodyStream()->ReadToEnd(context);
+      FirstRequestLatency().Record(std::chrono::steady_clock::now() - start);
+    }
+
+    void GlobalCleanup() override
+    {
+      auto const latency = FirstRequestLatency().Summarize();
+      std::cout << "First request latency p50: " << latency.P50Ms << "ms, p90: " << latency.P90Ms
+                << "ms, p99: " << latency.P99Ms << "ms, max: " << latency.P100Ms << "ms"
+                << std::endl;
+      Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Url", {"--url"}, "The URL to send the requests to.", 1, true},
+          {"Prewarm",
+           {"--prewarm"},
+           "The number of connections to pre-warm before each request. Default 0.",
+           1,
+           false},
+          {"DnsCacheTimeout",
+           {"--dns-cache-timeout"},
+           "The DNS cache timeout (in seconds). Default 60.",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "curlFirstRequest",
+          "Measures the latency of the first request to a host with the libcurl transport",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::CurlFirstRequestTest>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
+#endif
@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the libcurl transport upload performance.
+ *
+ */
+
+#pragma once
+
+#if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
+#include <azure/core.hpp>
+#include <azure/core/http/curl_transport.hpp>
+#include <azure/perf.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+
+  /**
+   * @brief Measure uploading a request body with the libcurl transport.
+   *
+   * @remark The body is sent with a PUT request to `--url`, which can be any HTTP server accepting
+   * uploads. Use `--source file` to upload from a file instead of memory, and `--chunk-size` to
+   * change the request upload chunk size.
+   */
+  class CurlUploadTest : public Azure::Perf::PerfTest {
+    std::unique_ptr<Azure::Core::Http::CurlTransport> m_transport;
+    std::string m_url;
+    size_t m_chunkSize = 0;
+    std::vector<uint8_t> m_buffer;
+    std::string m_fileName;
+
+  public:
+    /**
+     * @brief Construct a new CurlUploadTest test.
+     *
+     * @param options The test options.
+     */
+    CurlUploadTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      m_url = m_options.GetMandatoryOption<std::string>("Url");
+      m_chunkSize = m_options.GetOptionOrDefault<size_t>("ChunkSize", 0);
+      auto const size = m_options.GetOptionOrDefault<size_t>("Size", 1024 * 1024 * 1024);
+      auto const source = m_options.GetOptionOrDefault<std::string>("Source", "memory");
+
+      m_buffer = Azure::Perf::RandomStream::Create(size)->ReadToEnd(Azure::Core::Context{});
+      if (source == "file")
+      {
+        m_fileName = "curl-upload-" + Azure::Core::Uuid::CreateUuid().ToString();
+        std::ofstream file(m_fileName, std::ios::binary);
+        file.write(reinterpret_cast<char const*>(m_buffer.data()), m_buffer.size());
+        m_buffer.clear();
+        m_buffer.shrink_to_fit();
+      }
+      else if (source != "memory")
+      {
+        throw std::runtime_error("Invalid --source '" + source + "'. Expected memory or file.");
+      }
+
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      transportOptions.SslVerifyPeer = false;
+      m_transport = std::make_unique<Azure::Core::Http::CurlTransport>(transportOptions);
+    }
+
+    void Cleanup() override
+    {
+      if (!m_fileName.empty())
+      {
+        std::remove(m_fileName.c_str());
+      }
+    }
+
+    /**
+     * @brief Upload the body once.
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      std::unique_ptr<Azure::Core::IO::BodyStream> body;
+      if (m_fileName.empty())
+      {
+        body = std::make_unique<Azure::Core::IO::MemoryBodyStream>(m_buffer);
+      }
+      else
+      {
+        body = std::make_unique<Azure::Core::IO::FileBodyStream>(m_fileName);
+      }
+
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Put, Azure::Core::Url(m_url), body.get());
+      request.SetHeader("content-length", std::to_string(body->Length()));
+      request.SetUploadChunkSize(m_chunkSize);
+
+      auto response = m_transport->Send(request, context);
+      // Make sure to pull all bytes from network.
+      response->ExtractBodyStream()->ReadToEnd(context);
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Url", {"--url"}, "The URL to upload to.", 1, true},
+          {"Size", {"--size"}, "Size of the upload (in bytes). Default 1 GiB.", 1, false},
+          {"ChunkSize",
+           {"--chunk-size"},
+           "The request upload chunk size (in bytes). Default uses the transport default.",
+           1,
+           false},
+          {"Source", {"--source"}, "Upload from memory or file. Default memory.", 1, false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "curlUpload",
+          "Measures uploading a request body with the libcurl transport",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::CurlUploadTest>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
+#endif
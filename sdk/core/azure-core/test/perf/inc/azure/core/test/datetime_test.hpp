@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of parsing and formatting dates.
+ *
+ */
+
+#pragma once
+
+#include <azure/core/datetime.hpp>
+#include <azure/perf.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+
+  /**
+   * @brief Measure `DateTime::Parse()` or `DateTime::ToString()` on the dates the services send,
+   * like "Thu, 15 Oct 2026 12:34:56 GMT" and "2026-10-15T12:34:56.1234567Z".
+   *
+   * @remark The test parses RFC 3339 dates by default. Use `--rfc1123 1` for RFC 1123 dates and
+   * `--format 1` to measure formatting instead of parsing.
+   */
+  class DateTimeTest : public Azure::Perf::PerfTest {
+    Azure::DateTime::DateFormat m_dateFormat = Azure::DateTime::DateFormat::Rfc3339;
+    std::string m_dateString;
+    Azure::DateTime m_dateTime;
+    bool m_format = false;
+
+  public:
+    /**
+     * @brief Construct a new DateTimeTest test.
+     *
+     * @param options The test options.
+     */
+    DateTimeTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      if (m_options.GetOptionOrDefault<bool>("Rfc1123", false))
+      {
+        m_dateFormat = Azure::DateTime::DateFormat::Rfc1123;
+        m_dateString = "Thu, 15 Oct 2026 12:34:56 GMT";
+      }
+      else
+      {
+        m_dateString = "2026-10-15T12:34:56.1234567Z";
+      }
+      m_dateTime = Azure::DateTime::Parse(m_dateString, m_dateFormat);
+      m_format = m_options.GetOptionOrDefault<bool>("Format", false);
+    }
+
+    /**
+     * @brief Parse or format one date.
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      if (m_format)
+      {
+        m_dateTime.ToString(m_dateFormat);
+      }
+      else
+      {
+        Azure::DateTime::Parse(m_dateString, m_dateFormat);
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Rfc1123", {"--rfc1123"}, "Use RFC 1123 dates instead of RFC 3339 ones.", 1, false},
+          {"Format", {"--format"}, "Measure formatting instead of parsing.", 1, false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "datetime",
+          "Measures parsing and formatting dates",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::DateTimeTest>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
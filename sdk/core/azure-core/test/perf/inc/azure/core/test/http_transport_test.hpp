@@ -82,10 +82,27 @@ namespace Azure { namespace Core { namespace Test {
         transportOptions.SslVerifyPeer = false;
         m_transport = std::make_shared<Azure::Core::Http::CurlTransport>(transportOptions);
       }
+      else if ("curlmulti" == m_options.GetMandatoryOption<std::string>("Transport"))
+      {
+        // One transport for all the parallel instances, so a single event loop drives them all.
+        static std::shared_ptr<Azure::Core::Http::CurlMultiTransport> multiTransport = [] {
+          Azure::Core::Http::CurlTransportOptions transportOptions;
+          transportOptions.SslVerifyPeer = false;
+          return std::make_shared<Azure::Core::Http::CurlMultiTransport>(transportOptions);
+        }();
+        m_transport = multiTransport;
+      }
 #endif
       m_httpMethod
           = Azure::Core::Http::HttpMethod(m_options.GetMandatoryOption<std::string>("Method"));
 
+      // Any local HTTP server can be used instead of the test proxy to compare the transports.
+      m_target = m_options.GetOptionOrDefault<std::string>("Url", "");
+      if (!m_target.empty())
+      {
+        return;
+      }
+
       if (m_httpMethod == Azure::Core::Http::HttpMethod::Get)
       {
         m_target = GetTestProxy() + "/Admin/isAlive";
@@ -128,7 +145,12 @@ namespace Azure { namespace Core { namespace Test {
     {
       return {
           {"Method", {"--method"}, "The HTTP method e.g. GET, POST etc.", 1, true},
-          {"Transport", {"--transport"}, "The HTTP Transport curl/winhttp.", 1, true}};
+          {"Transport", {"--transport"}, "The HTTP Transport curl/curlmulti/winhttp.", 1, true},
+          {"Url",
+           {"--url"},
+           "The URL to send the requests to. Defaults to the test proxy.",
+           1,
+           false}};
     }
 
     /**
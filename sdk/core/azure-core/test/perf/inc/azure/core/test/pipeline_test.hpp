@@ -16,6 +16,8 @@
 #include <azure/core/internal/http/pipeline.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <iostream>
 #include <memory>
 using namespace Azure::Core;
 using namespace Azure::Core::_internal;
@@ -26,6 +28,28 @@ using namespace Azure::Core::Http::Policies::_internal;
 
 namespace Azure { namespace Core { namespace Test {
 
+  /**
+   * @brief Get the number of allocations counted by the perf test program.
+   *
+   * @remark The program replaces the global `operator new` to count the allocations, only while
+   * #AllocationCountingEnabled is set.
+   */
+  inline std::atomic<uint64_t>& AllocationCount()
+  {
+    static std::atomic<uint64_t> count{0};
+    return count;
+  }
+
+  /**
+   * @brief Get whether `operator new` counts the allocations. Only set while a test reporting
+   * them runs, the other tests only pay for reading the flag.
+   */
+  inline std::atomic<bool>& AllocationCountingEnabled()
+  {
+    static std::atomic<bool> enabled{false};
+    return enabled;
+  }
+
   class TestPolicy : public HttpPolicy {
 
   public:
@@ -45,10 +69,34 @@ namespace Azure { namespace Core { namespace Test {
 
   /**
    * @brief Measure the http pipeline / policies performance.
+   *
+   * @remark With `--no-network 1`, the requests get a response without being sent, so that the
+   * test measures the pipeline and the request and response headers. The number of allocations
+   * per operation is printed at the end of the test, and is exact with one thread. With
+   * `--latency-sampling N`, the policies of one request out of `N` are timed, and their mean
+   * latencies are printed at the end of the test.
    */
   class PipelineTest : public Azure::Perf::PerfTest {
     std::unique_ptr<HttpPipeline> m_pipeline;
 
+    static std::atomic<uint64_t>& Operations()
+    {
+      static std::atomic<uint64_t> operations{0};
+      return operations;
+    }
+
+    static std::atomic<uint64_t>& OperationAllocations()
+    {
+      static std::atomic<uint64_t> allocations{0};
+      return allocations;
+    }
+
+    static std::shared_ptr<PolicyLatencyRecorder>& LatencyRecorder()
+    {
+      static std::shared_ptr<PolicyLatencyRecorder> recorder;
+      return recorder;
+    }
+
   public:
     /**
      * @brief Construct a new PipelineTest test.
@@ -57,6 +105,8 @@ namespace Azure { namespace Core { namespace Test {
      */
     PipelineTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
 
+    void GlobalSetup() override { AllocationCountingEnabled() = true; }
+
     void Setup() override
     {
       const std::string packageName = "test";
@@ -118,8 +168,24 @@ namespace Azure { namespace Core { namespace Test {
         }
       }
 
+      ClientOptions clientOptions;
+      if (m_options.GetOptionOrDefault<bool>("NoNetwork", false))
+      {
+        clientOptions.Transport.Transport = std::make_shared<Azure::Perf::NoNetworkTransport>(true);
+      }
+      auto const latencySampling = m_options.GetOptionOrDefault<int>("LatencySampling", 0);
+      if (latencySampling > 0)
+      {
+        if (!LatencyRecorder())
+        {
+          PolicyLatencyRecorderOptions recorderOptions;
+          recorderOptions.SamplingInterval = static_cast<uint32_t>(latencySampling);
+          LatencyRecorder() = std::make_shared<PolicyLatencyRecorder>(recorderOptions);
+        }
+        clientOptions.Telemetry.LatencyRecorder = LatencyRecorder();
+      }
       m_pipeline = std::make_unique<HttpPipeline>(
-          ClientOptions(), packageName, packageVersion, std::move(policies), std::move(policies2));
+          clientOptions, packageName, packageVersion, std::move(policies), std::move(policies2));
     }
 
     /**
@@ -128,6 +194,7 @@ namespace Azure { namespace Core { namespace Test {
      */
     void Run(Context const&) override
     {
+      auto const allocationsBefore = AllocationCount().load();
       try
       {
         Azure::Core::Http::Request request(
@@ -139,6 +206,32 @@ namespace Azure { namespace Core { namespace Test {
       {
         // don't print exceptions, they are happening at each request, this is the point of the test
       }
+      OperationAllocations() += AllocationCount().load() - allocationsBefore;
+      ++Operations();
+    }
+
+    void GlobalCleanup() override
+    {
+      AllocationCountingEnabled() = false;
+      if (Operations() > 0)
+      {
+        auto const allocations = static_cast<double>(OperationAllocations().load());
+        std::cout << "Allocations per operation: "
+                  << allocations / static_cast<double>(Operations().load()) << std::endl;
+      }
+      if (LatencyRecorder())
+      {
+        for (auto const& histogram : LatencyRecorder()->GetHistograms())
+        {
+          if (histogram.Count > 0)
+          {
+            auto const meanLatency = static_cast<double>(histogram.TotalLatency.count())
+                / static_cast<double>(histogram.Count);
+            std::cout << histogram.PolicyName << ": " << meanLatency << " ns mean latency over "
+                      << histogram.Count << " requests" << std::endl;
+          }
+        }
+      }
     }
 
     /**
@@ -156,6 +249,16 @@ namespace Azure { namespace Core { namespace Test {
            "default:TestPolicy \n others: "
            "RetryPolicy,RequestIdPolicy,RequestActivityPolicy,TelemetryPolicy,LogPolicy",
            1,
+           false},
+          {"NoNetwork",
+           {"--no-network"},
+           "Answer the requests without sending them.",
+           1,
+           false},
+          {"LatencySampling",
+           {"--latency-sampling"},
+           "Time the policies of one request out of this many. Default 0, for none.",
+           1,
            false}};
     }
 
@@ -1,6 +1,14 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 
+#include "azure/core/test/base64_test.hpp"
+#include "azure/core/test/bearer_token_refresh_test.hpp"
+#include "azure/core/test/context_test.hpp"
+#include "azure/core/test/curl_chunked_response_test.hpp"
+#include "azure/core/test/curl_connection_pool_test.hpp"
+#include "azure/core/test/curl_first_request_test.hpp"
+#include "azure/core/test/curl_upload_test.hpp"
+#include "azure/core/test/datetime_test.hpp"
 #include "azure/core/test/delay_test.hpp"
 #include "azure/core/test/exception_test.hpp"
 #include "azure/core/test/extended_options_test.hpp"
@@ -13,13 +21,37 @@
 
 #include <azure/perf.hpp>
 
+#include <cstdlib>
+#include <new>
 #include <vector>
 
+// Count the allocations while a test which reports them runs.
+void* operator new(std::size_t size)
+{
+  if (Azure::Core::Test::AllocationCountingEnabled().load(std::memory_order_relaxed))
+  {
+    ++Azure::Core::Test::AllocationCount();
+  }
+  if (void* memory = std::malloc(size == 0 ? 1 : size))
+  {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
 int main(int argc, char** argv)
 {
 
   // Create the test list
   std::vector<Azure::Perf::TestMetadata> tests{
+      Azure::Core::Test::Base64Test::GetTestMetadata(),
+      Azure::Core::Test::BearerTokenRefreshTest::GetTestMetadata(),
+      Azure::Core::Test::ContextTest::GetTestMetadata(),
+      Azure::Core::Test::DateTimeTest::GetTestMetadata(),
       Azure::Core::Test::DelayTest::GetTestMetadata(),
       Azure::Core::Test::ExceptionTest::GetTestMetadata(),
       Azure::Core::Test::ExtendedOptionsTest::GetTestMetadata(),
@@ -29,6 +61,12 @@ int main(int argc, char** argv)
       Azure::Core::Test::NullableTest::GetTestMetadata(),
       Azure::Core::Test::PipelineTest::GetTestMetadata(),
       Azure::Core::Test::UuidTest::GetTestMetadata()};
+#if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
+  tests.emplace_back(Azure::Core::Test::CurlChunkedResponseTest::GetTestMetadata());
+  tests.emplace_back(Azure::Core::Test::CurlConnectionPoolTest::GetTestMetadata());
+  tests.emplace_back(Azure::Core::Test::CurlFirstRequestTest::GetTestMetadata());
+  tests.emplace_back(Azure::Core::Test::CurlUploadTest::GetTestMetadata());
+#endif
 
   Azure::Perf::Program::Run(Azure::Core::Context{}, tests, argc, argv);
 
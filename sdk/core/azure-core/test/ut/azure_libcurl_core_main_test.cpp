@@ -70,11 +70,10 @@ namespace Azure { namespace Core { namespace Test {
     }
     // here the session is destroyed and the connection is moved to the pool
     // the same destructor also makes a call to start the cleanup thread
-    // which will sleep for DefaultCleanerIntervalMilliseconds then loop through the connections
-    // in the pool and check for the ones that are expired(DefaultConnectionExpiredMilliseconds) and
-    // remove them which will be the case here if we wait long enough.
+    // which will wake up every TimerWheelTick and remove the connections in the pool which
+    // expired (DefaultConnectionIdleTimeout) which will be the case here if we wait long enough.
     // without the calculations below test is flaky due to the
-    // fact that tests in the CI pipeline might take longer than 90 sec to execute thus the cleanup
+    // fact that tests in the CI pipeline might take longer than 60 sec to execute thus the cleanup
     // thread strikes. to have this test be predictable we need to be aware of when we attempt to
     // read pool size, also we should let things run to completion and then check the pool size thus
     // the sleep below plus another second to let the for loop in the cleanup thread do its thing.
@@ -84,19 +83,19 @@ namespace Azure { namespace Core { namespace Test {
     // Getting number of milliseconds as a double.
     duration<double, std::milli> ms_double = t2 - t1;
     if (ms_double < duration<double, std::milli>(
-            Azure::Core::Http::_detail::DefaultCleanerIntervalMilliseconds))
+            Azure::Core::Http::_detail::DefaultConnectionIdleTimeout))
     {
       // if the destructor execution took less than the cleanup thread sleep the size should be 1
       EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
+          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
+              .ConnectionPoolIndexSize(),
           1);
 
       std::uint16_t waitRepeats{0};
       // wait for the cleanup thread to wake up and run. since this is a timing matter based on when
       // the thread is scheduled we should let it run to completion max 2 minutes (12*10s)
       while (Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                     .ConnectionPoolIndex.size()
+                     .ConnectionPoolIndexSize()
                  == 1
              && waitRepeats < 12)
       {
@@ -106,8 +105,8 @@ namespace Azure { namespace Core { namespace Test {
 
       // Check that after the connection is gone and cleaned up, the pool is empty
       EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
+          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
+              .ConnectionPoolIndexSize(),
           0);
     }
     else
@@ -115,8 +114,8 @@ namespace Azure { namespace Core { namespace Test {
       // we got back from the destructor and thread creation after the cleanup thread hit thus it
       // will be empty
       EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
+          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
+              .ConnectionPoolIndexSize(),
           0);
     }
   }
@@ -229,6 +229,114 @@ TEST(Base64, InvalidDecode)
   // cspell::enable
 }
 
+namespace {
+std::string ReferenceBase64Encode(std::vector<uint8_t> const& data)
+{
+  char const alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  for (size_t i = 0; i < data.size(); i += 3)
+  {
+    uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+    if (i + 1 < data.size())
+    {
+      group |= static_cast<uint32_t>(data[i + 1]) << 8;
+    }
+    if (i + 2 < data.size())
+    {
+      group |= data[i + 2];
+    }
+    encoded += alphabet[(group >> 18) & 0x3F];
+    encoded += alphabet[(group >> 12) & 0x3F];
+    encoded += i + 1 < data.size() ? alphabet[(group >> 6) & 0x3F] : '=';
+    encoded += i + 2 < data.size() ? alphabet[group & 0x3F] : '=';
+  }
+  return encoded;
+}
+} // namespace
+
+TEST(Base64, AllSizes)
+{
+  // Covers the sizes the vectorized kernels stop at, and the data they leave to the scalar code.
+  for (size_t len = 0; len < 200; ++len)
+  {
+    std::vector<uint8_t> data(len);
+    RandomBuffer(data.data(), data.size());
+    auto const encoded = Convert::Base64Encode(data);
+    EXPECT_EQ(encoded, ReferenceBase64Encode(data));
+    EXPECT_EQ(Convert::Base64Decode(encoded), data);
+  }
+
+  // Every byte value, so every character of the alphabet is encoded and decoded.
+  std::vector<uint8_t> data(256 * 3);
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<uint8_t>(i % 256);
+  }
+  auto const encoded = Convert::Base64Encode(data);
+  EXPECT_EQ(encoded, ReferenceBase64Encode(data));
+  EXPECT_EQ(Convert::Base64Decode(encoded), data);
+}
+
+TEST(Base64, InvalidDecodeAnyPosition)
+{
+  std::vector<uint8_t> data(120);
+  RandomBuffer(data.data(), data.size());
+  auto const encoded = Convert::Base64Encode(data);
+  for (char invalid : {'\x80', '\xFF', '\x00', '=', '-', '_', ':', '@', '[', '`', '{'})
+  {
+    for (size_t i = 0; i < encoded.size(); ++i)
+    {
+      auto text = encoded;
+      text[i] = invalid;
+      // '=' is valid padding as the last character.
+      if (invalid == '=' && i == text.size() - 1)
+      {
+        continue;
+      }
+      EXPECT_THROW(Convert::Base64Decode(text), std::runtime_error) << "position " << i;
+    }
+  }
+}
+
+TEST(Base64, BufferOverloads)
+{
+  std::vector<uint8_t> data(100);
+  RandomBuffer(data.data(), data.size());
+  auto const expected = Convert::Base64Encode(data);
+
+  EXPECT_EQ(Convert::GetBase64EncodedSize(0), 0U);
+  EXPECT_EQ(Convert::GetBase64EncodedSize(1), 4U);
+  EXPECT_EQ(Convert::GetBase64EncodedSize(3), 4U);
+  EXPECT_EQ(Convert::GetBase64EncodedSize(data.size()), expected.size());
+  EXPECT_EQ(Convert::GetBase64DecodedSize("", 0), 0U);
+  EXPECT_EQ(Convert::GetBase64DecodedSize("AQ==", 4), 1U);
+  EXPECT_EQ(Convert::GetBase64DecodedSize("AQI=", 4), 2U);
+  EXPECT_EQ(Convert::GetBase64DecodedSize(expected.data(), expected.size()), data.size());
+  EXPECT_THROW(Convert::GetBase64DecodedSize("AQI", 3), std::runtime_error);
+
+  // The buffers are larger than needed, nothing is written past the returned size.
+  std::string encoded(expected.size() + 8, '*');
+  EXPECT_EQ(
+      Convert::Base64Encode(data.data(), data.size(), &encoded[0], encoded.size()),
+      expected.size());
+  EXPECT_EQ(encoded, expected + "********");
+
+  std::vector<uint8_t> decoded(data.size() + 8, 0xAA);
+  EXPECT_EQ(
+      Convert::Base64Decode(expected.data(), expected.size(), decoded.data(), decoded.size()),
+      data.size());
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), decoded.begin()));
+  EXPECT_TRUE(std::all_of(
+      decoded.begin() + data.size(), decoded.end(), [](uint8_t b) { return b == 0xAA; }));
+
+  EXPECT_THROW(
+      Convert::Base64Encode(data.data(), data.size(), &encoded[0], expected.size() - 1),
+      std::invalid_argument);
+  EXPECT_THROW(
+      Convert::Base64Decode(expected.data(), expected.size(), decoded.data(), data.size() - 1),
+      std::invalid_argument);
+}
+
 // Base64Url Tests
 TEST(Base64Url, BasicEncode)
 {
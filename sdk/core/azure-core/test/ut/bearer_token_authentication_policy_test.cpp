@@ -5,6 +5,13 @@
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/core/internal/http/pipeline.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy;
@@ -301,6 +308,199 @@ TEST(BearerTokenAuthenticationPolicy, RefreshAfterExpiry)
   }
 }
 
+namespace {
+// Returns the first token right away and waits to be released before returning the next ones.
+class SlowTokenCredential final : public TokenCredential {
+private:
+  std::vector<AccessToken> m_accessTokens;
+  std::shared_future<void> m_release;
+  mutable std::atomic<size_t> m_getTokenCalls{0};
+
+public:
+  SlowTokenCredential(std::vector<AccessToken> accessTokens, std::shared_future<void> release)
+      : TokenCredential("SlowTokenCredential"), m_accessTokens(std::move(accessTokens)),
+        m_release(std::move(release))
+  {
+  }
+
+  AccessToken GetToken(TokenRequestContext const&, Context const&) const override
+  {
+    auto const call = m_getTokenCalls++;
+    if (call > 0)
+    {
+      m_release.wait();
+    }
+    return m_accessTokens[(std::min)(call, m_accessTokens.size() - 1)];
+  }
+
+  size_t GetTokenCalls() const { return m_getTokenCalls; }
+};
+
+std::string SendAndGetAuthorization(HttpPipeline& pipeline)
+{
+  Request request(HttpMethod::Get, Url("https://www.azure.com"));
+  pipeline.Send(request, Context());
+  return request.GetHeaders().at("authorization");
+}
+} // namespace
+
+TEST(BearerTokenAuthenticationPolicy, RefreshInBackground)
+{
+  using namespace std::chrono_literals;
+  std::promise<void> release;
+  auto credential = std::make_shared<SlowTokenCredential>(
+      std::vector<AccessToken>{
+          {"ACCESSTOKEN1", std::chrono::system_clock::now() + 4min},
+          {"ACCESSTOKEN2", std::chrono::system_clock::now() + 1h}},
+      release.get_future().share());
+
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+
+  TokenRequestContext tokenRequestContext;
+  tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+
+  // The token expires in 4 minutes, within the refresh window but not within MinimumExpiration.
+  policies.emplace_back(
+      std::make_unique<BearerTokenAuthenticationPolicy>(credential, tokenRequestContext, 5min));
+
+  policies.emplace_back(std::make_unique<TestTransportPolicy>());
+
+  HttpPipeline pipeline(policies);
+
+  // The first request starts a background refresh, the next ones don't wait for it.
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+  }
+  EXPECT_LE(credential->GetTokenCalls(), 2U);
+
+  release.set_value();
+  auto const deadline = std::chrono::steady_clock::now() + 10s;
+  std::string authorization;
+  while ((authorization = SendAndGetAuthorization(pipeline)) != "Bearer ACCESSTOKEN2"
+         && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_EQ(authorization, "Bearer ACCESSTOKEN2");
+  EXPECT_EQ(credential->GetTokenCalls(), 2U);
+}
+
+TEST(BearerTokenAuthenticationPolicy, RefreshWindowAfterExpiry)
+{
+  using namespace std::chrono_literals;
+  auto accessToken = std::make_shared<AccessToken>();
+
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+
+  TokenRequestContext tokenRequestContext;
+  tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+
+  policies.emplace_back(std::make_unique<BearerTokenAuthenticationPolicy>(
+      std::make_shared<TestTokenCredential>(accessToken), tokenRequestContext, 5min));
+
+  policies.emplace_back(std::make_unique<TestTransportPolicy>());
+
+  HttpPipeline pipeline(policies);
+
+  *accessToken = {"ACCESSTOKEN1", std::chrono::system_clock::now() + 1min};
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+
+  // The token expires within MinimumExpiration, the request waits for a new one.
+  *accessToken = {"ACCESSTOKEN2", std::chrono::system_clock::now() + 1h};
+  EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN2");
+}
+
+namespace {
+// Returns the first token right away, the next calls only return when their context is cancelled.
+class HungTokenCredential final : public TokenCredential {
+private:
+  AccessToken m_accessToken;
+  mutable std::atomic<size_t> m_getTokenCalls{0};
+
+public:
+  explicit HungTokenCredential(AccessToken accessToken)
+      : TokenCredential("HungTokenCredential"), m_accessToken(std::move(accessToken))
+  {
+  }
+
+  AccessToken GetToken(TokenRequestContext const&, Context const& context) const override
+  {
+    if (m_getTokenCalls++ > 0)
+    {
+      while (!context.IsCancelled())
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      context.ThrowIfCancelled();
+    }
+    return m_accessToken;
+  }
+
+  size_t GetTokenCalls() const { return m_getTokenCalls; }
+};
+} // namespace
+
+TEST(BearerTokenAuthenticationPolicy, HungBackgroundRefreshIsCancellable)
+{
+  using namespace std::chrono_literals;
+
+  TokenRequestContext tokenRequestContext;
+  tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+  tokenRequestContext.MinimumExpiration = 1min;
+
+  // The token is within the refresh window, and within MinimumExpiration shortly after.
+  auto credential = std::make_shared<HungTokenCredential>(
+      AccessToken{"ACCESSTOKEN1", std::chrono::system_clock::now() + 1min + 200ms});
+
+  {
+    std::vector<std::unique_ptr<HttpPolicy>> policies;
+    policies.emplace_back(
+        std::make_unique<BearerTokenAuthenticationPolicy>(credential, tokenRequestContext, 5min));
+    policies.emplace_back(std::make_unique<TestTransportPolicy>());
+    HttpPipeline pipeline(policies);
+
+    // Starts the background refresh, which hangs.
+    EXPECT_EQ(SendAndGetAuthorization(pipeline), "Bearer ACCESSTOKEN1");
+    std::this_thread::sleep_for(300ms);
+
+    // The next request waits for the hung refresh, but gives up when its context is cancelled.
+    Request request(HttpMethod::Get, Url("https://www.azure.com"));
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_THROW(
+        pipeline.Send(request, Context{}.WithDeadline(std::chrono::system_clock::now() + 100ms)),
+        Azure::Core::OperationCancelledException);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+    EXPECT_EQ(credential->GetTokenCalls(), 2U);
+
+    // Destroying the pipeline cancels the background refresh instead of waiting for it forever.
+  }
+  EXPECT_EQ(credential->GetTokenCalls(), 2U);
+}
+
+namespace Azure { namespace Core { namespace Test {
+  TEST(BearerTokenAuthenticationPolicy, IdlePolicyDestructionDoesNotCancel)
+  {
+    using namespace std::chrono_literals;
+    TokenRequestContext tokenRequestContext;
+    tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+    auto policy = std::make_unique<BearerTokenAuthenticationPolicy>(
+        std::make_shared<TestTokenCredential>(std::make_shared<AccessToken>()),
+        tokenRequestContext,
+        5min);
+    // The pipelines clone their policies.
+    auto clone = policy->Clone();
+    Context const policyContext = policy->m_backgroundRefreshContext;
+    Context const cloneContext
+        = static_cast<BearerTokenAuthenticationPolicy&>(*clone).m_backgroundRefreshContext;
+
+    policy.reset();
+    clone.reset();
+    EXPECT_FALSE(policyContext.IsCancelled());
+    EXPECT_FALSE(cloneContext.IsCancelled());
+  }
+}}} // namespace Azure::Core::Test
+
 TEST(BearerTokenAuthenticationPolicy, NonHttps)
 {
   using namespace std::chrono_literals;
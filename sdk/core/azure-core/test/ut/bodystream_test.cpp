@@ -152,6 +152,42 @@ TEST(FileBodyStream, Read)
   EXPECT_EQ(buffer[FileSize], 0);
 }
 
+TEST(MemoryBodyStream, ReadInPlace)
+{
+  std::vector<uint8_t> const data{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  MemoryBodyStream stream(data);
+
+  uint8_t const* readData = nullptr;
+  EXPECT_EQ(stream.ReadInPlace(readData, 4), 4);
+  EXPECT_EQ(readData, data.data());
+
+  // Reading in place and copying move the same offset.
+  std::vector<uint8_t> buffer(2);
+  EXPECT_EQ(stream.Read(buffer.data(), buffer.size()), 2);
+  EXPECT_EQ(buffer[0], 5);
+
+  EXPECT_EQ(stream.ReadInPlace(readData, 100, Azure::Core::Context{}), 4);
+  EXPECT_EQ(readData, data.data() + 6);
+  EXPECT_EQ(stream.ReadInPlace(readData, 100), 0);
+
+  stream.Rewind();
+  EXPECT_EQ(stream.ReadInPlace(readData, 100), data.size());
+  EXPECT_EQ(readData, data.data());
+}
+
+TEST(FileBodyStream, ReadInPlace)
+{
+  std::string testDataPath(AZURE_TEST_DATA_PATH);
+  testDataPath.append("/fileData");
+
+  // A file is not kept in memory, nothing is read in place.
+  Azure::Core::IO::FileBodyStream stream(testDataPath);
+  uint8_t const* readData = reinterpret_cast<uint8_t const*>(&testDataPath);
+  EXPECT_EQ(stream.ReadInPlace(readData, 10), 0);
+  EXPECT_EQ(readData, nullptr);
+  EXPECT_EQ(stream.ReadToEnd().size(), FileSize);
+}
+
 TEST(ProgressBodyStream, Init)
 {
   int64_t bytesTransferred = -1;
@@ -185,6 +221,20 @@ TEST(ProgressBodyStream, ReadChunk)
   EXPECT_EQ(readSize, 10);
 }
 
+TEST(ProgressBodyStream, ReadInPlace)
+{
+  int64_t bytesTransferred = -1;
+  std::vector<uint8_t> const data(100);
+  MemoryBodyStream stream(data);
+
+  ProgressBodyStream progress(stream, [&bytesTransferred](int64_t bt) { bytesTransferred = bt; });
+
+  uint8_t const* readData = nullptr;
+  EXPECT_EQ(progress.ReadInPlace(readData, 30), 30);
+  EXPECT_EQ(readData, data.data());
+  EXPECT_EQ(bytesTransferred, 30);
+}
+
 TEST(ProgressBodyStream, MultiWrapProgressStream)
 {
   int64_t bytesTransferred = -1;
@@ -4,9 +4,13 @@
 #include "azure/core/context.hpp"
 
 #include <chrono>
+#include <condition_variable>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -512,3 +516,130 @@ TEST(Context, KeyTypePairPrecondition)
   EXPECT_TRUE(c3.TryGetValue<std::string>(key, strValue));
   EXPECT_EQ(strValue, s);
 }
+
+TEST(Context, CancelChildren)
+{
+  Context::Key const key;
+  Context context;
+  auto const child = context.WithValue(key, 1);
+  auto const sibling = context.WithDeadline((Azure::DateTime::max)());
+  auto grandChild = child.WithDeadline((Azure::DateTime::max)());
+  Context const otherTree;
+  auto const otherTreeChild = otherTree.WithValue(key, 4);
+
+  grandChild.Cancel();
+  EXPECT_TRUE(grandChild.IsCancelled());
+  EXPECT_FALSE(child.IsCancelled());
+  EXPECT_FALSE(context.IsCancelled());
+
+  {
+    // Destroying a child doesn't change its parent.
+    auto const temporary = context.WithValue(key, 2);
+  }
+  context.Cancel();
+  EXPECT_TRUE(context.IsCancelled());
+  EXPECT_TRUE(child.IsCancelled());
+  EXPECT_TRUE(sibling.IsCancelled());
+  EXPECT_EQ(child.GetDeadline(), (Azure::DateTime::min)());
+  EXPECT_EQ(sibling.GetDeadline(), (Azure::DateTime::min)());
+  EXPECT_TRUE(child.WithValue(key, 3).IsCancelled());
+  // Only the contexts of the tree are cancelled.
+  EXPECT_FALSE(otherTree.IsCancelled());
+  EXPECT_FALSE(otherTreeChild.IsCancelled());
+
+  int value = 0;
+  EXPECT_TRUE(grandChild.TryGetValue(key, value));
+  EXPECT_EQ(value, 1);
+}
+
+TEST(Context, EarliestDeadline)
+{
+  auto const deadline = Azure::DateTime(2021, 4, 1, 23, 45, 15);
+  Context::Key const key;
+
+  auto const context = Context().WithDeadline(deadline);
+  EXPECT_EQ(context.WithDeadline(deadline + std::chrono::hours(1)).GetDeadline(), deadline);
+  EXPECT_EQ(
+      context.WithValue(key, 1).WithDeadline(deadline - std::chrono::hours(1)).GetDeadline(),
+      deadline - std::chrono::hours(1));
+  EXPECT_TRUE(context.WithValue(key, 1).IsCancelled());
+}
+
+TEST(Context, CancelConcurrently)
+{
+  // Cancel the contexts while other threads create and destroy their children.
+  for (int i = 0; i < 20; ++i)
+  {
+    Context context;
+    std::vector<std::future<void>> threads;
+    for (int thread = 0; thread < 4; ++thread)
+    {
+      threads.emplace_back(std::async(std::launch::async, [context]() {
+        Context::Key const key;
+        while (!context.IsCancelled())
+        {
+          auto const child = context.WithValue(key, 1).WithDeadline((Azure::DateTime::max)());
+          if (child.IsCancelled())
+          {
+            EXPECT_TRUE(context.IsCancelled());
+          }
+        }
+        EXPECT_TRUE(context.WithValue(key, 1).IsCancelled());
+      }));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    context.Cancel();
+    for (auto& thread : threads)
+    {
+      thread.get();
+    }
+  }
+}
+
+TEST(Context, CancellationSignal)
+{
+  std::mutex mutex;
+  std::condition_variable signal;
+  Context context;
+  auto const child = context.WithDeadline((Azure::DateTime::max)());
+
+  auto const start = std::chrono::steady_clock::now();
+  auto waiter = std::async(std::launch::async, [&]() {
+    Azure::Core::_internal::ContextCancellationSignal const cancellationSignal(
+        child, mutex, signal);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!child.IsCancelled())
+    {
+      cancellationSignal.WaitFor(lock, std::chrono::minutes(1));
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  context.Cancel();
+  waiter.get();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(30));
+}
+
+TEST(Context, CancellationSleep)
+{
+  Context context;
+  auto start = std::chrono::steady_clock::now();
+  auto sleeper = std::async(std::launch::async, [&]() {
+    Azure::Core::_internal::ContextCancellationSignal::Sleep(context, std::chrono::minutes(1));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  context.Cancel();
+  EXPECT_THROW(sleeper.get(), Azure::Core::OperationCancelledException);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(30));
+
+  // The deadline passing ends the sleep too.
+  start = std::chrono::steady_clock::now();
+  EXPECT_THROW(
+      Azure::Core::_internal::ContextCancellationSignal::Sleep(
+          Context(std::chrono::system_clock::now() + std::chrono::milliseconds(50)),
+          std::chrono::minutes(1)),
+      Azure::Core::OperationCancelledException);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(30));
+
+  EXPECT_NO_THROW(Azure::Core::_internal::ContextCancellationSignal::Sleep(
+      Context(), std::chrono::milliseconds(10)));
+}
@@ -4,6 +4,7 @@
 #include "transport_adapter_base_test.hpp"
 
 #include <azure/core/context.hpp>
+#include <azure/core/internal/environment.hpp>
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/core/response.hpp>
 
@@ -11,9 +12,11 @@
 #include "azure/core/http/curl_transport.hpp"
 #endif
 
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <thread>
+#include <utility>
 
 // The next includes are from Azure Core private headers.
 // They are included to test the connection pool from the libcurl transport adapter implementation.
@@ -35,6 +38,33 @@ inline std::string CreateConnectionKey(
 {
   return schema + "://" + host + configurationKey;
 }
+
+// A connection which never touches the network and expires at a fixed time.
+class ExpiringCurlNetworkConnection final : public Azure::Core::Http::CurlNetworkConnection {
+  std::string m_connectionKey;
+  std::chrono::steady_clock::time_point m_expiryTime;
+  std::atomic<int>& m_closedConnections;
+
+public:
+  ExpiringCurlNetworkConnection(
+      std::string connectionKey,
+      std::chrono::steady_clock::time_point expiryTime,
+      std::atomic<int>& closedConnections)
+      : m_connectionKey(std::move(connectionKey)), m_expiryTime(expiryTime),
+        m_closedConnections(closedConnections)
+  {
+  }
+  ~ExpiringCurlNetworkConnection() override { ++m_closedConnections; }
+  std::string const& GetConnectionKey() const override { return m_connectionKey; }
+  void UpdateLastUsageTime() override {}
+  bool IsExpired() override { return std::chrono::steady_clock::now() >= m_expiryTime; }
+  std::chrono::steady_clock::time_point GetExpiryTime() const override { return m_expiryTime; }
+  size_t ReadFromSocket(uint8_t*, size_t, Azure::Core::Context const&) override { return 0; }
+  CURLcode SendBuffer(uint8_t const*, size_t, Azure::Core::Context const&) override
+  {
+    return CURLE_OK;
+  }
+};
 } // namespace
 
 namespace Azure { namespace Core { namespace Test {
@@ -53,11 +83,9 @@ namespace Azure { namespace Core { namespace Test {
       }
 
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+        CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
         // Make sure there are nothing in the pool
-        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size(), 0);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
       }
 
       // Use the same request for all connections.
@@ -85,18 +113,9 @@ namespace Azure { namespace Core { namespace Test {
       }
       // Check that after the connection is gone, it is moved back to the pool
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            1);
-        auto connectionFromPool
-            = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.begin()
-                  ->second.begin()
-                  ->get();
-        EXPECT_EQ(connectionFromPool->GetConnectionKey(), expectedConnectionKey);
+            CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(expectedConnectionKey), 1);
       }
 
       // Test that asking a connection with same config will re-use the same connection
@@ -107,10 +126,7 @@ namespace Azure { namespace Core { namespace Test {
             = CurlConnectionPool::g_curlConnectionPool.ExtractOrCreateCurlConnection(req, options);
 
         // There was just one connection in the pool, it should be empty now
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            0);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
         // And the connection key for the connection we got is the expected
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
 
@@ -122,17 +138,10 @@ namespace Azure { namespace Core { namespace Test {
         session->m_httpKeepAlive = true;
       }
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // Check that after the connection is gone, it is moved back to the pool
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            1);
-        auto values = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                          .ConnectionPoolIndex.begin();
-        EXPECT_EQ(values->second.size(), 1);
-        EXPECT_EQ(values->second.begin()->get()->GetConnectionKey(), expectedConnectionKey);
+            CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(expectedConnectionKey), 1);
       }
 
       // Now test that using a different connection config won't re-use the same connection
@@ -148,17 +157,9 @@ namespace Azure { namespace Core { namespace Test {
         EXPECT_EQ(connection->GetConnectionKey(), secondExpectedKey);
         // One connection still in the pool after getting a new connection and with first expected
         // key
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            1);
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .begin()
-                ->second.begin()
-                ->get()
-                ->GetConnectionKey(),
-            expectedConnectionKey);
+            CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(expectedConnectionKey), 1);
 
         auto session
             = std::make_unique<Azure::Core::Http::CurlSession>(req, std::move(connection), options);
@@ -169,29 +170,12 @@ namespace Azure { namespace Core { namespace Test {
       }
 
       // Now there should be 2 index wit one connection each
-      EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
-          2);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 2);
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        for (auto& val : Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                             .ConnectionPoolIndex)
-        {
-          EXPECT_EQ(val.second.size(), 1);
-        }
-        // The connection pool should have the two connections we added earlier.
-        EXPECT_NE(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .end(),
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .find(expectedConnectionKey));
-        EXPECT_NE(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .end(),
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .find(secondExpectedKey));
+        // The connection pool should have the two connections we added earlier, one per key.
+        EXPECT_EQ(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(expectedConnectionKey), 1);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(secondExpectedKey), 1);
       }
 
       {
@@ -213,17 +197,8 @@ namespace Azure { namespace Core { namespace Test {
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
         // One connection still in the pool after getting a new connection and with first expected
         // key
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            1);
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .begin()
-                ->second.begin()
-                ->get()
-                ->GetConnectionKey(),
-            secondExpectedKey);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(secondExpectedKey), 1);
 
         auto session
             = std::make_unique<Azure::Core::Http::CurlSession>(req, std::move(connection), options);
@@ -233,47 +208,23 @@ namespace Azure { namespace Core { namespace Test {
         session->m_httpKeepAlive = true;
       }
       // Now there should be 2 index wit one connection each
-      EXPECT_EQ(
-          Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-              .size(),
-          2);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 2);
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        for (auto& val : Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                             .ConnectionPoolIndex)
-        {
-          EXPECT_EQ(val.second.size(), 1);
-        }
-        // The connection pool should have the two connections we added earlier.
-        EXPECT_NE(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .end(),
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .find(expectedConnectionKey));
-        EXPECT_NE(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .end(),
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .find(secondExpectedKey));
+        // The connection pool should have the two connections we added earlier, one per key.
+        EXPECT_EQ(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(expectedConnectionKey), 1);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(secondExpectedKey), 1);
       }
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // clean the pool
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+        CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
       }
 
 #ifdef RUN_LONG_UNIT_TESTS
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // clean the pool
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            0);
+        CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
       }
 
       // Test pool clean routine.
@@ -299,17 +250,9 @@ namespace Azure { namespace Core { namespace Test {
       }
 
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            1);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
         EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                .ConnectionPoolIndex[expectedConnectionKey]
-                .size(),
-            5);
+            CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(expectedConnectionKey), 5);
       }
 
       // Wait for 60 secs (default time to expire a connection)
@@ -326,11 +269,7 @@ namespace Azure { namespace Core { namespace Test {
           std::this_thread::sleep_for(10ms);
           // If test wakes while clean pool is running, it will wait until lock is released by
           // the clean pool thread.
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-          poolIsEmpty = Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                            .ConnectionPoolIndex.size()
-              == 0;
+          poolIsEmpty = CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize() == 0;
         }
         EXPECT_TRUE(poolIsEmpty);
       }
@@ -347,7 +286,7 @@ namespace Azure { namespace Core { namespace Test {
       //       std::lock_guard<std::mutex> lock(
       //           CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
       //       // clean the pool
-      //       CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+      //       CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
       //     }
 
       //     std::string hostKey("key");
@@ -422,7 +361,7 @@ namespace Azure { namespace Core { namespace Test {
       //       std::lock_guard<std::mutex> lock(
       //           CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
       //       // clean the pool
-      //       CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+      //       CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
       //     }
       //   }
     }
@@ -435,15 +374,9 @@ namespace Azure { namespace Core { namespace Test {
       }
 
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-            .clear();
+        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
         // Make sure there is nothing in the pool
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            0);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
       }
 
       {
@@ -461,12 +394,7 @@ namespace Azure { namespace Core { namespace Test {
                               .ExtractOrCreateCurlConnection(req, {});
 
         {
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-          EXPECT_EQ(
-              Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.size(),
-              0);
+          EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
           EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
         }
         // move connection back to the pool
@@ -475,13 +403,8 @@ namespace Azure { namespace Core { namespace Test {
       }
 
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // Test connection was moved to the pool
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            1);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
       }
 
       {
@@ -500,26 +423,16 @@ namespace Azure { namespace Core { namespace Test {
 
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
         {
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
           // Check connection in pool is not re-used because the port is different
-          EXPECT_EQ(
-              Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.size(),
-              1);
+          EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
         }
         // move connection back to the pool
         Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
             .MoveConnectionBackToPool(std::move(connection), true);
       }
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
         // Check 2 connections in the pool
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            2);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 2);
       }
 
       // Re-use connections
@@ -538,12 +451,7 @@ namespace Azure { namespace Core { namespace Test {
                               .ExtractOrCreateCurlConnection(req, {});
 
         {
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-          EXPECT_EQ(
-              Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.size(),
-              1);
+          EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
         }
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
         // move connection back to the pool
@@ -553,12 +461,7 @@ namespace Azure { namespace Core { namespace Test {
 
       {
         // Make sure there is nothing in the pool
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            2);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 2);
       }
       {
         // Request with port
@@ -576,28 +479,240 @@ namespace Azure { namespace Core { namespace Test {
 
         EXPECT_EQ(connection->GetConnectionKey(), expectedConnectionKey);
         {
-          std::lock_guard<std::mutex> lock(
-              CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
           // Check connection in pool is not re-used because the port is different
-          EXPECT_EQ(
-              Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                  .ConnectionPoolIndex.size(),
-              1);
+          EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 1);
         }
         // move connection back to the pool
         Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
             .MoveConnectionBackToPool(std::move(connection), true);
       }
+      {
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 2);
+        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+      }
+    }
+
+    TEST(CurlConnectionPool, poolLimits)
+    {
+      using ::testing::AnyNumber;
+      using ::testing::Return;
+      using ::testing::ReturnRef;
+
+      CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+      auto const statisticsBefore = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+
+      Azure::Core::Http::Request req(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url("http://localhost"));
+      // Same key the pool generates for the request above with default options.
+      std::string const hostKey(
+          CreateConnectionKey("http", "localhost", ",0,0,0,0,0,1,1,0,0,0,1,0,0"));
+      std::string const otherKey(CreateConnectionKey("http", "otherhost", ",0"));
+
+      auto createConnection = [](std::string const& key) {
+        auto connection = std::make_unique<MockCurlNetworkConnection>();
+        EXPECT_CALL(*connection, GetConnectionKey()).WillRepeatedly(ReturnRef(key));
+        EXPECT_CALL(*connection, UpdateLastUsageTime()).Times(AnyNumber());
+        EXPECT_CALL(*connection, IsExpired()).WillRepeatedly(Return(false));
+        EXPECT_CALL(*connection, DestructObj());
+        return connection;
+      };
+
+      // Per host limit. The oldest connection is closed when a third one is returned.
+      for (int count = 0; count < 3; count++)
+      {
+        CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+            createConnection(hostKey), true, 2, 0);
+      }
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(hostKey), 2);
+
+      // Global limit. Only one more connection fits in the pool.
+      for (int count = 0; count < 2; count++)
+      {
+        CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+            createConnection(otherKey), true, 2, 3);
+      }
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(otherKey), 1);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 2);
+
+      // A zero per host limit disables pooling.
+      CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+          createConnection(otherKey), true, 0, 0);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(otherKey), 1);
+
+      // Both pooled connections for the host are re-used.
+      for (int count = 0; count < 2; count++)
+      {
+        auto connection = CurlConnectionPool::g_curlConnectionPool.ExtractOrCreateCurlConnection(
+            req, Azure::Core::Http::CurlTransportOptions());
+        EXPECT_EQ(connection->GetConnectionKey(), hostKey);
+      }
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(hostKey), 0);
+
+      auto const statistics = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      EXPECT_EQ(statistics.Hits - statisticsBefore.Hits, 2);
+      EXPECT_EQ(statistics.Misses - statisticsBefore.Misses, 0);
+      EXPECT_EQ(statistics.Evictions - statisticsBefore.Evictions, 3);
+      EXPECT_EQ(statistics.PooledConnections, 1);
+
+      CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
+      EXPECT_EQ(
+          Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics().PooledConnections, 0);
+    }
+
+    TEST(CurlConnectionPool, timerWheelExpiry)
+    {
+      CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+      auto const statisticsBefore = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      std::atomic<int> closedConnections{0};
+      std::string const hostKey(CreateConnectionKey("http", "expiring", ",0"));
+      auto const now = std::chrono::steady_clock::now();
+
+      // A connection which is already expired is not pooled.
+      CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+          std::make_unique<ExpiringCurlNetworkConnection>(hostKey, now - 1s, closedConnections),
+          true);
+      EXPECT_EQ(closedConnections, 1);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(hostKey), 0);
+
+      CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+          std::make_unique<ExpiringCurlNetworkConnection>(
+              hostKey, std::chrono::steady_clock::time_point::max(), closedConnections),
+          true);
+      CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+          std::make_unique<ExpiringCurlNetworkConnection>(hostKey, now + 1500ms, closedConnections),
+          true);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(hostKey), 2);
+
+      // The clean thread closes the expiring connection a tick after its expiry time.
+      auto const timeOut = now + 10s;
+      while (closedConnections < 2 && std::chrono::steady_clock::now() < timeOut)
+      {
+        std::this_thread::sleep_for(10ms);
+      }
+      EXPECT_EQ(closedConnections, 2);
+      EXPECT_GE(std::chrono::steady_clock::now(), now + 1500ms);
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionsOnPool(hostKey), 1);
+
+      auto const statistics = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      EXPECT_EQ(statistics.Evictions - statisticsBefore.Evictions, 2);
+      EXPECT_EQ(statistics.PooledConnections, 1);
+
+      CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+      EXPECT_EQ(closedConnections, 3);
+    }
+
+    TEST(CurlConnectionPool, prewarm)
+    {
+      if (!AzureSdkHttpbinServer::IsEnabled())
+      {
+        GTEST_SKIP_("Skipping the test because httpbin URL environment variable is not set.");
+      }
+
+      CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+      Azure::Core::Http::CurlTransportOptions options;
+      options.DnsCacheTimeout = 10s;
+      options.MaxPooledConnectionsPerHost = 3;
+      Azure::Core::Http::CurlTransport transport(options);
+      auto const statisticsBefore = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+
+      // Only the per host limit is kept in the pool.
+      transport.Prewarm(Azure::Core::Url(AzureSdkHttpbinServer::Get()), 4);
+      EXPECT_EQ(
+          Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics().PooledConnections, 3);
+
+      // Requests use the pre-warmed connections.
+      for (int count = 0; count < 3; count++)
+      {
+        Azure::Core::Http::Request request(
+            Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(AzureSdkHttpbinServer::Get()));
+        auto response = transport.Send(request, Azure::Core::Context{});
+        EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+        response->ExtractBodyStream()->ReadToEnd();
+      }
+
+      auto const statistics = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+      EXPECT_EQ(statistics.Hits - statisticsBefore.Hits, 3);
+      EXPECT_EQ(statistics.Misses - statisticsBefore.Misses, 0);
+      EXPECT_EQ(statistics.Evictions - statisticsBefore.Evictions, 1);
+
+      // A connection which can't be opened is reported.
+      EXPECT_THROW(
+          transport.Prewarm(Azure::Core::Url("http://localhost:1"), 1),
+          Azure::Core::Http::TransportException);
+
+      CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+    }
+
+    TEST(CurlConnectionPool, tlsSessionResumption)
+    {
+      // An https URL of a local TLS server, i.e. nghttpx in front of httpbin.
+      auto const tlsServerUrl
+          = Azure::Core::_internal::Environment::GetVariable("AZSDKCPPTEST_TLS_URL");
+      if (tlsServerUrl.empty())
+      {
+        GTEST_SKIP_("Skipping the test because TLS server URL environment variable is not set.");
+      }
+
+      auto const countHandshakes = [&](bool enableSslCaching) {
+        Azure::Core::Http::CurlTransportOptions options;
+        options.SslVerifyPeer = false;
+        options.EnableCurlSslCaching = enableSslCaching;
+        // No connection is re-used, each request does a TLS handshake.
+        options.MaxPooledConnectionsPerHost = 0;
+        Azure::Core::Http::CurlTransport transport(options);
+
+        auto const statisticsBefore
+            = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+        for (int count = 0; count < 4; count++)
+        {
+          Azure::Core::Http::Request request(
+              Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(tlsServerUrl));
+          auto response = transport.Send(request, Azure::Core::Context{});
+          EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+          response->ExtractBodyStream()->ReadToEnd();
+        }
+        auto const statistics = Azure::Core::Http::CurlTransport::GetConnectionPoolStatistics();
+        return std::make_pair(
+            statistics.FullTlsHandshakes - statisticsBefore.FullTlsHandshakes,
+            statistics.ResumedTlsHandshakes - statisticsBefore.ResumedTlsHandshakes);
+      };
+
+      // Every connection is counted once. The server has to support resumption, the ones after
+      // the first full handshake resume the cached session.
+      auto const cached = countHandshakes(true);
+      EXPECT_EQ(cached.first + cached.second, 4);
+      EXPECT_GT(cached.second, 0);
+
+      auto const notCached = countHandshakes(false);
+      EXPECT_EQ(notCached.first, 4);
+      EXPECT_EQ(notCached.second, 0);
+
+      EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
+    }
+
+    TEST(CurlConnectionPool, shareHandleLimit)
+    {
+      CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
       {
         std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            2);
-        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-            .clear();
+            CurlConnectionPool::g_curlConnectionPool.m_shareHandlesMutex);
+        CurlConnectionPool::g_curlConnectionPool.m_shareHandles.clear();
       }
+
+      // A handle still used by a connection is kept.
+      auto const inUse = CurlConnectionPool::g_curlConnectionPool.GetShareHandle(
+          "https://in-use:443", true, "in-use");
+      for (size_t count = 0; count < MaxShareHandles * 2; count++)
+      {
+        auto const host = "https://host" + std::to_string(count) + ":443";
+        CurlConnectionPool::g_curlConnectionPool.GetShareHandle(host, true, host);
+        EXPECT_LE(CurlConnectionPool::g_curlConnectionPool.m_shareHandles.size(), MaxShareHandles);
+      }
+      EXPECT_EQ(
+          CurlConnectionPool::g_curlConnectionPool.GetShareHandle(
+              "https://in-use:443", true, "in-use"),
+          inUse);
     }
 
     TEST(CurlConnectionPool, resiliencyOnConnectionClosed)
@@ -671,11 +786,9 @@ namespace Azure { namespace Core { namespace Test {
       /// When getting the header connection: close from an HTTP response, the connection should not
       /// be moved back to the pool.
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+        CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
         // Make sure there are nothing in the pool
-        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size(), 0);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
       }
 
       // Use the same request for all connections.
@@ -698,12 +811,7 @@ namespace Azure { namespace Core { namespace Test {
 
       // Check that after the connection is gone, it is moved back to the pool
       {
-        std::lock_guard<std::mutex> lock(
-            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
-        EXPECT_EQ(
-            Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-                .size(),
-            0);
+        EXPECT_EQ(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndexSize(), 0);
       }
     }
 #endif
@@ -4,6 +4,7 @@
 #include <azure/core/context.hpp>
 #include <azure/core/http/http.hpp>
 #include <azure/core/http/policies/policy.hpp>
+#include <azure/core/internal/environment.hpp>
 #include <azure/core/internal/http/pipeline.hpp>
 #include <azure/core/platform.hpp>
 
@@ -26,10 +27,12 @@
 #include "transport_adapter_base_test.hpp"
 
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <http/curl/curl_connection_pool_private.hpp>
 #include <http/curl/curl_connection_private.hpp>
+#include <http/curl/curl_multi_private.hpp>
 
 namespace Azure { namespace Core { namespace Test {
 
@@ -115,7 +118,7 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .ClearConnectionPool());
   }
 
   class CurlDerived : public Azure::Core::Http::CurlTransport {
@@ -262,7 +265,7 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .ClearConnectionPool());
   }
 
 #if !defined(AZ_PLATFORM_MAC)
@@ -312,7 +315,7 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .ClearConnectionPool());
 #else
     EXPECT_THROW(
         pipeline.Send(request, Azure::Core::Context{}), Azure::Core::Http::TransportException);
@@ -370,7 +373,7 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .ClearConnectionPool());
   }
 
 #if _azure_DISABLE_HTTP_BIN_TESTS
@@ -415,8 +418,8 @@ namespace Azure { namespace Core { namespace Test {
     }
     // Make sure there are no connections in the pool
     EXPECT_EQ(
-        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-            .size(),
+        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
+            .ConnectionPoolIndexSize(),
         0);
   }
 
@@ -463,6 +466,216 @@ namespace Azure { namespace Core { namespace Test {
     // Clean the connection from the pool *Windows fails to clean if we leave to be clean upon
     // app-destruction
     EXPECT_NO_THROW(Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
-                        .ConnectionPoolIndex.clear());
+                        .ClearConnectionPool());
+  }
+
+#if _azure_DISABLE_HTTP_BIN_TESTS
+  TEST(CurlTransportOptions, DISABLED_transportMetrics)
+#else
+  TEST(CurlTransportOptions, transportMetrics)
+#endif
+  {
+    if (!AzureSdkHttpbinServer::IsEnabled())
+    {
+      GTEST_SKIP_("Skipping the test because httpbin URL environment variable is not set.");
+    }
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+
+    Azure::Core::Http::CurlTransport transport;
+    Azure::Core::Url url(AzureSdkHttpbinServer::Get());
+
+    for (auto const reused : {false, true})
+    {
+      Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Get, url);
+      auto response = transport.Send(request, Azure::Core::Context{});
+      auto const body = response->ExtractBodyStream()->ReadToEnd(Azure::Core::Context{});
+
+      auto const& metrics = response->GetTransportMetrics();
+      ASSERT_NE(metrics, nullptr);
+      EXPECT_EQ(metrics->ConnectionReused, reused);
+      if (reused)
+      {
+        EXPECT_EQ(metrics->NameLookupTime.count(), 0);
+        EXPECT_EQ(metrics->ConnectTime.count(), 0);
+      }
+      // A local server can answer before the response is read, so the time may round to 0.
+      EXPECT_GE(metrics->TimeToFirstByte.count(), 0);
+      EXPECT_GT(metrics->BytesSent, 0);
+      // The headers are received with the body.
+      EXPECT_GT(metrics->BytesReceived, static_cast<int64_t>(body.size()));
+      EXPECT_GT(metrics->SocketReads, 0);
+    }
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+  }
+
+#if _azure_DISABLE_HTTP_BIN_TESTS
+  TEST(CurlMultiTransport, DISABLED_transportMetrics)
+#else
+  TEST(CurlMultiTransport, transportMetrics)
+#endif
+  {
+    if (!AzureSdkHttpbinServer::IsEnabled())
+    {
+      GTEST_SKIP_("Skipping the test because httpbin URL environment variable is not set.");
+    }
+
+    Azure::Core::Http::CurlMultiTransport transport;
+    Azure::Core::Url url(AzureSdkHttpbinServer::Get());
+
+    for (auto const reused : {false, true})
+    {
+      Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Get, url);
+      auto response = transport.Send(request, Azure::Core::Context{});
+
+      // The metrics are set when the response is returned, before the body is read.
+      auto const metrics = response->GetTransportMetrics();
+      ASSERT_NE(metrics, nullptr);
+      EXPECT_EQ(metrics->ConnectionReused, reused);
+      if (reused)
+      {
+        EXPECT_EQ(metrics->NameLookupTime.count(), 0);
+        EXPECT_EQ(metrics->ConnectTime.count(), 0);
+      }
+      EXPECT_GE(metrics->TimeToFirstByte.count(), 0);
+      EXPECT_GT(metrics->BytesSent, 0);
+
+      auto const body = response->ExtractBodyStream()->ReadToEnd(Azure::Core::Context{});
+      // The headers are received with the body.
+      EXPECT_GT(metrics->BytesReceived, static_cast<int64_t>(body.size()));
+    }
+  }
+
+  /******************************* HTTP/2. ************************/
+  namespace {
+    // An https URL of a local server which supports HTTP/2 (i.e. nghttpx in front of httpbin).
+    std::string Http2ServerUrl()
+    {
+      return Azure::Core::_internal::Environment::GetVariable("AZSDKCPPTEST_HTTP2_URL");
+    }
+  } // namespace
+
+  TEST(CurlMultiTransport, http2Multiplexing)
+  {
+    if (Http2ServerUrl().empty())
+    {
+      GTEST_SKIP_("Skipping the test because HTTP/2 server URL environment variable is not set.");
+    }
+
+    Azure::Core::Http::CurlTransportOptions curlOptions;
+    curlOptions.EnableHttp2 = true;
+    curlOptions.SslVerifyPeer = false;
+    Azure::Core::Http::CurlMultiTransport transport(curlOptions, 4);
+    auto connectionsOpened = [&transport]() {
+      size_t count = 0;
+      for (auto const& eventLoop : transport.m_eventLoops)
+      {
+        count += eventLoop->ConnectionsOpened();
+      }
+      return count;
+    };
+
+    constexpr int concurrentRequests = 32;
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<Azure::Core::Http::RawResponse>> responses(concurrentRequests);
+    for (int i = 0; i < concurrentRequests; i++)
+    {
+      threads.emplace_back([&, i]() {
+        Azure::Core::Http::Request request(
+            Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(Http2ServerUrl()));
+        responses[i] = transport.Send(request, Azure::Core::Context{});
+        responses[i]->SetBody(responses[i]->ExtractBodyStream()->ReadToEnd());
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (auto const& response : responses)
+    {
+      EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+      EXPECT_EQ(response->GetMajorVersion(), 2);
+      EXPECT_FALSE(response->GetBody().empty());
+    }
+    // All the requests were multiplexed over a single connection, by the event loop of the host.
+    EXPECT_EQ(connectionsOpened(), 1U);
+
+    // Sequential requests re-use the connection too.
+    for (int i = 0; i < 4; i++)
+    {
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(Http2ServerUrl()));
+      auto response = transport.Send(request, Azure::Core::Context{});
+      response->ExtractBodyStream()->ReadToEnd();
+    }
+    EXPECT_EQ(connectionsOpened(), 1U);
+  }
+
+#if _azure_DISABLE_HTTP_BIN_TESTS
+  TEST(CurlMultiTransport, DISABLED_connectionReuse)
+#else
+  TEST(CurlMultiTransport, connectionReuse)
+#endif
+  {
+    if (!AzureSdkHttpbinServer::IsEnabled())
+    {
+      GTEST_SKIP_("Skipping the test because httpbin URL environment variable is not set.");
+    }
+
+    Azure::Core::Http::CurlMultiTransport transport(Azure::Core::Http::CurlTransportOptions{}, 4);
+    for (int i = 0; i < 8; i++)
+    {
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(AzureSdkHttpbinServer::Get()));
+      auto response = transport.Send(request, Azure::Core::Context{});
+      response->ExtractBodyStream()->ReadToEnd();
+    }
+
+    // The requests to a host all go through its event loop, which re-uses one connection.
+    size_t connectionsOpened = 0;
+    for (auto const& eventLoop : transport.m_eventLoops)
+    {
+      connectionsOpened += eventLoop->ConnectionsOpened();
+    }
+    EXPECT_EQ(connectionsOpened, 1U);
+  }
+
+  TEST(CurlTransportOptions, enableHttp2)
+  {
+    if (Http2ServerUrl().empty())
+    {
+      GTEST_SKIP_("Skipping the test because HTTP/2 server URL environment variable is not set.");
+    }
+
+    Azure::Core::Http::CurlTransportOptions curlOptions;
+    curlOptions.EnableHttp2 = true;
+    curlOptions.SslVerifyPeer = false;
+    Azure::Core::Http::Policies::TransportOptions options;
+    options.Transport = std::make_shared<Azure::Core::Http::CurlTransport>(curlOptions);
+    std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> policies;
+    policies.emplace_back(
+        std::make_unique<Azure::Core::Http::Policies::_internal::TransportPolicy>(options));
+    Azure::Core::Http::_internal::HttpPipeline pipeline(policies);
+
+    Azure::Core::Http::Request request(
+        Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(Http2ServerUrl()));
+    auto response = pipeline.Send(request, Azure::Core::Context{});
+    EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+    EXPECT_EQ(response->GetMajorVersion(), 2);
+    EXPECT_FALSE(response->GetBody().empty());
+
+    // The default is HTTP/1.1.
+    curlOptions.EnableHttp2 = false;
+    options.Transport = std::make_shared<Azure::Core::Http::CurlTransport>(curlOptions);
+    std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> http1Policies;
+    http1Policies.emplace_back(
+        std::make_unique<Azure::Core::Http::Policies::_internal::TransportPolicy>(options));
+    Azure::Core::Http::_internal::HttpPipeline http1Pipeline(http1Policies);
+    Azure::Core::Http::Request http1Request(
+        Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(Http2ServerUrl()));
+    response = http1Pipeline.Send(http1Request, Azure::Core::Context{});
+    EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+    EXPECT_EQ(response->GetMajorVersion(), 1);
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
   }
 }}} // namespace Azure::Core::Test
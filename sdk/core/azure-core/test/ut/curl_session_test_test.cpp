@@ -11,6 +11,7 @@
 
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::ReturnRef;
 using ::testing::SetArrayArgument;
@@ -86,8 +87,7 @@ namespace Azure { namespace Core { namespace Test {
       EXPECT_NO_THROW(session->Perform(Azure::Core::Context{}));
     }
     // Clear the connections from the pool to invoke clean routine
-    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-        .clear();
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
   }
 
   TEST_F(CurlSession, chunkBadFormatResponse)
@@ -111,7 +111,8 @@ namespace Azure { namespace Core { namespace Test {
             SetArrayArgument<0>(response2.data(), response2.data() + payloadSize2),
             Return(payloadSize2)));
     EXPECT_CALL(*curlMock, GetConnectionKey()).WillRepeatedly(ReturnRef(connectionKey));
-    EXPECT_CALL(*curlMock, UpdateLastUsageTime());
+    // The response did not end as expected, so the connection is not moved back to the pool.
+    EXPECT_CALL(*curlMock, UpdateLastUsageTime()).Times(0);
     EXPECT_CALL(*curlMock, DestructObj());
 
     // Create the unique ptr to take care about memory free at the end
@@ -137,8 +138,7 @@ namespace Azure { namespace Core { namespace Test {
       EXPECT_THROW(bodyS->ReadToEnd(Azure::Core::Context{}), Azure::Core::Http::TransportException);
     }
     // Clear the connections from the pool to invoke clean routine
-    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-        .clear();
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
   }
 
   TEST_F(CurlSession, invalidHeader)
@@ -172,6 +172,34 @@ namespace Azure { namespace Core { namespace Test {
     EXPECT_THROW(session->Perform(Azure::Core::Context{}), std::invalid_argument);
   }
 
+  TEST_F(CurlSession, invalidContentLength)
+  {
+    for (std::string const contentLength : {"", "-1", "1x", "99999999999999999999"})
+    {
+      std::string response("HTTP/1.1 200 Ok\r\ncontent-length: " + contentLength + "\r\n\r\n");
+      int32_t const payloadSize = static_cast<int32_t>(response.size());
+
+      MockCurlNetworkConnection* curlMock = new MockCurlNetworkConnection();
+      EXPECT_CALL(*curlMock, SendBuffer(_, _, _)).WillOnce(Return(CURLE_OK));
+      EXPECT_CALL(*curlMock, ReadFromSocket(_, _, _))
+          .WillOnce(DoAll(
+              SetArrayArgument<0>(response.data(), response.data() + payloadSize),
+              Return(payloadSize)));
+      std::unique_ptr<MockCurlNetworkConnection> uniqueCurlMock(curlMock);
+
+      Azure::Core::Url url("http://microsoft.com");
+      Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Get, url);
+
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      transportOptions.HttpKeepAlive = true;
+      auto session = std::make_unique<Azure::Core::Http::CurlSession>(
+          request, std::move(uniqueCurlMock), transportOptions);
+
+      EXPECT_THROW(
+          session->Perform(Azure::Core::Context{}), Azure::Core::Http::TransportException);
+    }
+  }
+
   TEST_F(CurlSession, emptyHeaderValue)
   {
     std::string response("HTTP/1.1 200 Ok\r\nheader:\r\n\r\nbody");
@@ -317,14 +345,269 @@ namespace Azure { namespace Core { namespace Test {
       EXPECT_NO_THROW(bodyS->ReadToEnd(Azure::Core::Context{}));
     }
     // Clear the connections from the pool to invoke clean routine
-    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-        .clear();
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+  }
+
+  TEST_F(CurlSession, chunkedResponseFraming)
+  {
+    std::string const wire(
+        "HTTP/1.1 200 Ok\r\ntransfer-encoding: chunked\r\n\r\n"
+        "5;name=value\r\nHello\r\n1\r\n \r\nA\r\n0123456789\r\n"
+        "0\r\nx-trailer: value\r\n\r\n");
+    std::string const body("Hello 0123456789");
+
+    // The whole response in one socket read, then one byte on every read so the framing is split
+    // at every possible position.
+    for (size_t maxSocketRead : {wire.size(), size_t(1)})
+    {
+      size_t wireOffset = 0;
+      std::string connectionKey("connection-key");
+
+      MockCurlNetworkConnection* curlMock = new MockCurlNetworkConnection();
+      EXPECT_CALL(*curlMock, SendBuffer(_, _, _)).WillOnce(Return(CURLE_OK));
+      EXPECT_CALL(*curlMock, ReadFromSocket(_, _, _))
+          .WillRepeatedly(Invoke([&](uint8_t* buffer, size_t bufferSize, Context const&) {
+            auto const count = (std::min)({bufferSize, maxSocketRead, wire.size() - wireOffset});
+            std::copy(wire.begin() + wireOffset, wire.begin() + wireOffset + count, buffer);
+            wireOffset += count;
+            return count;
+          }));
+      EXPECT_CALL(*curlMock, GetConnectionKey()).WillRepeatedly(ReturnRef(connectionKey));
+      // The connection goes back to the pool only if the trailers were read.
+      EXPECT_CALL(*curlMock, UpdateLastUsageTime());
+      EXPECT_CALL(*curlMock, DestructObj());
+
+      std::unique_ptr<MockCurlNetworkConnection> uniqueCurlMock(curlMock);
+
+      Azure::Core::Url url("http://microsoft.com");
+      Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Get, url);
+
+      {
+        Azure::Core::Http::CurlTransportOptions transportOptions;
+        auto session = std::make_unique<Azure::Core::Http::CurlSession>(
+            request, std::move(uniqueCurlMock), transportOptions);
+
+        EXPECT_EQ(CURLE_OK, session->Perform(Azure::Core::Context{}));
+        auto response = session->ExtractResponse();
+        response->SetBodyStream(std::move(session));
+        auto bodyS = response->ExtractBodyStream();
+
+        std::vector<uint8_t> buffer(64);
+        if (maxSocketRead == wire.size())
+        {
+          // All the chunks in the inner buffer are returned by a single read.
+          EXPECT_EQ(body.size(), bodyS->Read(buffer.data(), buffer.size(), Context{}));
+          EXPECT_EQ(body, std::string(buffer.begin(), buffer.begin() + body.size()));
+        }
+        else
+        {
+          auto const data = bodyS->ReadToEnd(Context{});
+          EXPECT_EQ(body, std::string(data.begin(), data.end()));
+        }
+        EXPECT_EQ(0, bodyS->Read(buffer.data(), buffer.size(), Context{}));
+        EXPECT_EQ(wire.size(), wireOffset);
+      }
+      Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+    }
+  }
+
+  TEST_F(CurlSession, largeReadWithSmallHeaderBuffer)
+  {
+    std::string const body("0123456789abcdefghijklmnopqrstuvwxyzABCD");
+    std::string const wire("HTTP/1.1 200 Ok\r\ncontent-length: 40\r\n\r\n" + body);
+    size_t wireOffset = 0;
+    std::string connectionKey("connection-key");
+
+    // The socket never returns more than the buffer given to it, so the headers are parsed from a
+    // few reads into the small header buffer.
+    MockCurlNetworkConnection* curlMock = new MockCurlNetworkConnection();
+    EXPECT_CALL(*curlMock, SendBuffer(_, _, _)).WillOnce(Return(CURLE_OK));
+    EXPECT_CALL(*curlMock, ReadFromSocket(_, _, _))
+        .WillRepeatedly(Invoke([&](uint8_t* buffer, size_t bufferSize, Context const&) {
+          auto const count = (std::min)(bufferSize, wire.size() - wireOffset);
+          std::copy(wire.begin() + wireOffset, wire.begin() + wireOffset + count, buffer);
+          wireOffset += count;
+          return count;
+        }));
+    EXPECT_CALL(*curlMock, GetConnectionKey()).WillRepeatedly(ReturnRef(connectionKey));
+    EXPECT_CALL(*curlMock, UpdateLastUsageTime());
+    EXPECT_CALL(*curlMock, DestructObj());
+
+    std::unique_ptr<MockCurlNetworkConnection> uniqueCurlMock(curlMock);
+
+    Azure::Core::Url url("http://microsoft.com");
+    Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Get, url);
+
+    {
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      transportOptions.HttpKeepAlive = true;
+      transportOptions.HeaderBufferSize = 32;
+      auto session = std::make_unique<Azure::Core::Http::CurlSession>(
+          request, std::move(uniqueCurlMock), transportOptions);
+
+      EXPECT_EQ(CURLE_OK, session->Perform(Azure::Core::Context{}));
+      auto response = session->ExtractResponse();
+      EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+      response->SetBodyStream(std::move(session));
+      auto bodyS = response->ExtractBodyStream();
+
+      // A buffer larger than the header buffer takes the body left in the header buffer and the
+      // rest straight from the socket in a single read.
+      std::vector<uint8_t> buffer(64);
+      EXPECT_EQ(body.size(), bodyS->Read(buffer.data(), buffer.size(), Azure::Core::Context{}));
+      EXPECT_EQ(body, std::string(buffer.begin(), buffer.begin() + body.size()));
+      EXPECT_EQ(wire.size(), wireOffset);
+    }
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+  }
+
+  TEST_F(CurlSession, smallBodySentWithHeaders)
+  {
+    std::string response("HTTP/1.1 200 Ok\r\ncontent-length: 0\r\n\r\n");
+    int32_t const payloadSize = static_cast<int32_t>(response.size());
+    std::string connectionKey("connection-key");
+    std::string const body("{\"key\":\"value\"}");
+    std::string sent;
+
+    MockCurlNetworkConnection* curlMock = new MockCurlNetworkConnection();
+    // The headers and the body go out with a single send.
+    EXPECT_CALL(*curlMock, SendBuffer(_, _, _))
+        .WillOnce(Invoke([&](uint8_t const* buffer, size_t bufferSize, Context const&) {
+          sent.assign(reinterpret_cast<char const*>(buffer), bufferSize);
+          return CURLE_OK;
+        }));
+    EXPECT_CALL(*curlMock, ReadFromSocket(_, _, _))
+        .WillOnce(DoAll(
+            SetArrayArgument<0>(response.data(), response.data() + payloadSize),
+            Return(payloadSize)));
+
+    EXPECT_CALL(*curlMock, GetConnectionKey()).WillRepeatedly(ReturnRef(connectionKey));
+    EXPECT_CALL(*curlMock, UpdateLastUsageTime());
+    EXPECT_CALL(*curlMock, DestructObj());
+
+    std::unique_ptr<MockCurlNetworkConnection> uniqueCurlMock(curlMock);
+
+    Azure::Core::IO::MemoryBodyStream bodyStream(
+        reinterpret_cast<uint8_t const*>(body.data()), body.size());
+    Azure::Core::Url url("http://microsoft.com");
+    Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Post, url, &bodyStream);
+    request.SetHeader("content-length", std::to_string(body.size()));
+
+    {
+      // The session moves the connection to the pool when it is released
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      auto session = std::make_unique<Azure::Core::Http::CurlSession>(
+          request, std::move(uniqueCurlMock), transportOptions);
+
+      EXPECT_EQ(CURLE_OK, session->Perform(Azure::Core::Context{}));
+      EXPECT_EQ(0, sent.find("POST / HTTP/1.1\r\n"));
+      EXPECT_EQ(sent.size() - body.size(), sent.find("\r\n\r\n" + body) + 4);
+    }
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+  }
+
+  TEST_F(CurlSession, uploadChunkSize)
+  {
+    std::string response("HTTP/1.1 200 Ok\r\ncontent-length: 0\r\n\r\n");
+    int32_t const payloadSize = static_cast<int32_t>(response.size());
+    std::string connectionKey("connection-key");
+    std::vector<uint8_t> const body(1000, 'x');
+    std::vector<size_t> sendSizes;
+
+    MockCurlNetworkConnection* curlMock = new MockCurlNetworkConnection();
+    EXPECT_CALL(*curlMock, SendBuffer(_, _, _))
+        .WillRepeatedly(Invoke([&](uint8_t const*, size_t bufferSize, Context const&) {
+          sendSizes.push_back(bufferSize);
+          return CURLE_OK;
+        }));
+    EXPECT_CALL(*curlMock, ReadFromSocket(_, _, _))
+        .WillOnce(DoAll(
+            SetArrayArgument<0>(response.data(), response.data() + payloadSize),
+            Return(payloadSize)));
+
+    EXPECT_CALL(*curlMock, GetConnectionKey()).WillRepeatedly(ReturnRef(connectionKey));
+    EXPECT_CALL(*curlMock, UpdateLastUsageTime());
+    EXPECT_CALL(*curlMock, DestructObj());
+
+    std::unique_ptr<MockCurlNetworkConnection> uniqueCurlMock(curlMock);
+
+    Azure::Core::IO::MemoryBodyStream bodyStream(body);
+    Azure::Core::Url url("http://microsoft.com");
+    Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Post, url, &bodyStream);
+    request.SetUploadChunkSize(400);
+
+    {
+      // The session moves the connection to the pool when it is released
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      auto session = std::make_unique<Azure::Core::Http::CurlSession>(
+          request, std::move(uniqueCurlMock), transportOptions);
+
+      EXPECT_EQ(CURLE_OK, session->Perform(Azure::Core::Context{}));
+      // The headers, then the body in chunks of the request upload chunk size.
+      ASSERT_EQ(4, sendSizes.size());
+      EXPECT_EQ(400, sendSizes[1]);
+      EXPECT_EQ(400, sendSizes[2]);
+      EXPECT_EQ(200, sendSizes[3]);
+    }
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
+  }
+
+  TEST_F(CurlSession, unknownLengthReadReturnsAvailableData)
+  {
+    // No content-length, the body ends when the connection is closed. The body arrives in parts,
+    // the first one with the headers.
+    std::vector<std::string> const parts{"HTTP/1.1 200 Ok\r\n\r\nabc", "defgh"};
+    size_t partIndex = 0;
+    std::string connectionKey("connection-key");
+
+    MockCurlNetworkConnection* curlMock = new MockCurlNetworkConnection();
+    EXPECT_CALL(*curlMock, SendBuffer(_, _, _)).WillOnce(Return(CURLE_OK));
+    EXPECT_CALL(*curlMock, ReadFromSocket(_, _, _))
+        .WillRepeatedly(Invoke([&](uint8_t* buffer, size_t bufferSize, Context const&) {
+          if (partIndex == parts.size())
+          {
+            return size_t();
+          }
+          auto const& part = parts[partIndex++];
+          EXPECT_LE(part.size(), bufferSize);
+          std::copy(part.begin(), part.end(), buffer);
+          return part.size();
+        }));
+    EXPECT_CALL(*curlMock, GetConnectionKey()).WillRepeatedly(ReturnRef(connectionKey));
+    EXPECT_CALL(*curlMock, DestructObj());
+
+    std::unique_ptr<MockCurlNetworkConnection> uniqueCurlMock(curlMock);
+
+    Azure::Core::Url url("http://microsoft.com");
+    Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Get, url);
+
+    {
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      transportOptions.HttpKeepAlive = true;
+      transportOptions.HeaderBufferSize = 32;
+      auto session = std::make_unique<Azure::Core::Http::CurlSession>(
+          request, std::move(uniqueCurlMock), transportOptions);
+
+      EXPECT_EQ(CURLE_OK, session->Perform(Azure::Core::Context{}));
+      auto response = session->ExtractResponse();
+      response->SetBodyStream(std::move(session));
+      auto bodyS = response->ExtractBodyStream();
+
+      // Each read returns what has arrived instead of waiting for the whole buffer to fill.
+      std::vector<uint8_t> buffer(64);
+      EXPECT_EQ(3, bodyS->Read(buffer.data(), buffer.size(), Azure::Core::Context{}));
+      EXPECT_EQ("abc", std::string(buffer.begin(), buffer.begin() + 3));
+      EXPECT_EQ(1, partIndex);
+      EXPECT_EQ(5, bodyS->Read(buffer.data(), buffer.size(), Azure::Core::Context{}));
+      EXPECT_EQ("defgh", std::string(buffer.begin(), buffer.begin() + 5));
+      EXPECT_EQ(0, bodyS->Read(buffer.data(), buffer.size(), Azure::Core::Context{}));
+    }
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
   }
 
   TEST_F(CurlSession, DoNotReuseConnectionIfDownloadFail)
   {
-    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-        .clear();
+    Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ClearConnectionPool();
     // Can't mock the curlMock directly from a unique ptr, heap allocate it first and then make a
     // unique ptr for it
     MockCurlNetworkConnection* curlMock = new MockCurlNetworkConnection();
@@ -351,8 +634,8 @@ namespace Azure { namespace Core { namespace Test {
     }
     // Check connection pool is empty (connection was not moved to the pool)
     EXPECT_EQ(
-        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex
-            .size(),
+        Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool
+            .ConnectionPoolIndexSize(),
         0);
   }
 }}} // namespace Azure::Core::Test
@@ -909,3 +909,46 @@ TEST(DateTime, Rfc3339Space)
       = DateTime::Parse("2022-08-24 00:43:08.0004308Z", DateTime::DateFormat::Rfc3339);
   EXPECT_EQ(datetime.ToString(DateTime::DateFormat::Rfc3339), "2022-08-24T00:43:08.0004308Z");
 }
+
+TEST(DateTime, ParseFixedShapes)
+{
+  // The shapes the services send are parsed like the other shapes of the same dates.
+  EXPECT_EQ(
+      DateTime::Parse("Thu, 15 Oct 2026 12:34:56 GMT", DateTime::DateFormat::Rfc1123),
+      DateTime::Parse("15 Oct 2026 12:34:56 +0000", DateTime::DateFormat::Rfc1123));
+  EXPECT_EQ(
+      DateTime::Parse("2026-10-15T12:34:56Z", DateTime::DateFormat::Rfc3339),
+      DateTime::Parse("2026-10-15T12:34:56+00:00", DateTime::DateFormat::Rfc3339));
+  EXPECT_EQ(
+      DateTime::Parse("2026-10-15T12:34:56.1234567Z", DateTime::DateFormat::Rfc3339),
+      DateTime::Parse("2026-10-15T12:34:56.1234567+00:00", DateTime::DateFormat::Rfc3339));
+  EXPECT_EQ(
+      DateTime::Parse("2026-10-15T12:34:56.12Z", DateTime::DateFormat::Rfc3339),
+      DateTime::Parse("2026-10-15T12:34:56.1200000+00:00", DateTime::DateFormat::Rfc3339));
+  EXPECT_EQ(
+      DateTime::Parse("2026-10-15T12:34:56.12345678Z", DateTime::DateFormat::Rfc3339),
+      DateTime::Parse("2026-10-15T12:34:56.1234568Z", DateTime::DateFormat::Rfc3339));
+
+  EXPECT_THROW(
+      static_cast<void>(
+          DateTime::Parse("Fri, 15 Oct 2026 12:34:56 GMT", DateTime::DateFormat::Rfc1123)),
+      std::invalid_argument);
+  EXPECT_THROW(
+      static_cast<void>(
+          DateTime::Parse("Thu, 31 Sep 2026 12:34:56 GMT", DateTime::DateFormat::Rfc1123)),
+      std::invalid_argument);
+  EXPECT_THROW(
+      static_cast<void>(
+          DateTime::Parse("Thu, 15 Oct 2026 24:34:56 GMT", DateTime::DateFormat::Rfc1123)),
+      std::invalid_argument);
+  EXPECT_THROW(
+      static_cast<void>(DateTime::Parse("2026-13-15T12:34:56Z", DateTime::DateFormat::Rfc3339)),
+      std::invalid_argument);
+  EXPECT_THROW(
+      static_cast<void>(DateTime::Parse("2026-10-15T12:60:56Z", DateTime::DateFormat::Rfc3339)),
+      std::invalid_argument);
+  EXPECT_THROW(
+      static_cast<void>(
+          DateTime::Parse("2026-10-15T12:34:5x.1234567Z", DateTime::DateFormat::Rfc3339)),
+      std::invalid_argument);
+}
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/http/http_headers.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core;
+using namespace Azure::Core::Http;
+
+namespace {
+std::vector<std::pair<std::string, std::string>> ToVector(HttpHeaders const& headers)
+{
+  return {headers.begin(), headers.end()};
+}
+} // namespace
+
+TEST(HttpHeaders, SortedLowercaseNames)
+{
+  HttpHeaders headers;
+  EXPECT_TRUE(headers.empty());
+
+  headers.insert_or_assign("X-Ms-Version", "1");
+  headers.insert_or_assign("Content-Length", "2");
+  headers.insert_or_assign("accept", "3");
+  headers.insert_or_assign("content-length", "4");
+
+  std::vector<std::pair<std::string, std::string>> const expected
+      = {{"accept", "3"}, {"content-length", "4"}, {"x-ms-version", "1"}};
+  EXPECT_EQ(ToVector(headers), expected);
+  EXPECT_EQ(headers.size(), 3u);
+}
+
+TEST(HttpHeaders, FindIgnoresCase)
+{
+  HttpHeaders headers;
+  headers.insert_or_assign("Content-Length", "X");
+
+  auto pos = headers.find("CONTENT-LENGTH");
+  ASSERT_NE(pos, headers.end());
+  EXPECT_EQ(pos->first, "content-length");
+  EXPECT_EQ(pos->second, "X");
+  EXPECT_EQ(headers.find(std::string("content-Length")), pos);
+  EXPECT_EQ(headers.find("content-len"), headers.end());
+  EXPECT_EQ(headers.find("content-length-2"), headers.end());
+
+  EXPECT_EQ(headers.count("Content-length"), 1u);
+  EXPECT_EQ(headers.count(std::string("accept")), 0u);
+
+  EXPECT_EQ(headers.at("content-LENGTH"), "X");
+  EXPECT_THROW(headers.at("accept"), std::out_of_range);
+}
+
+TEST(HttpHeaders, Bounds)
+{
+  HttpHeaders headers;
+  headers.insert_or_assign("x-ms-meta-b", "2");
+  headers.insert_or_assign("x-ms-meta-a", "1");
+  headers.insert_or_assign("x-ms-version", "3");
+  headers.insert_or_assign("etag", "0");
+
+  auto const first = headers.lower_bound("X-MS-META-");
+  ASSERT_NE(first, headers.end());
+  EXPECT_EQ(first->first, "x-ms-meta-a");
+  EXPECT_EQ(headers.lower_bound("x-ms-meta-a"), first);
+  EXPECT_EQ(headers.upper_bound("x-ms-meta-a"), first + 1);
+  EXPECT_EQ(headers.upper_bound("x-ms-version"), headers.end());
+  EXPECT_EQ(headers.lower_bound("a"), headers.begin());
+}
+
+TEST(HttpHeaders, Erase)
+{
+  HttpHeaders headers;
+  headers.insert_or_assign("a", "1");
+  headers.insert_or_assign("b", "2");
+  headers.insert_or_assign("c", "3");
+
+  EXPECT_EQ(headers.erase("B"), 1u);
+  EXPECT_EQ(headers.erase("b"), 0u);
+  std::vector<std::pair<std::string, std::string>> const expected = {{"a", "1"}, {"c", "3"}};
+  EXPECT_EQ(ToVector(headers), expected);
+
+  headers.clear();
+  EXPECT_TRUE(headers.empty());
+  EXPECT_EQ(headers.begin(), headers.end());
+}
+
+TEST(HttpHeaders, CopyAndMove)
+{
+  // Beyond 16 headers, the headers don't fit in the object anymore.
+  for (int count : {3, 40})
+  {
+    HttpHeaders headers;
+    for (int i = 0; i < count; ++i)
+    {
+      headers.insert_or_assign(
+          "Header-" + std::to_string(i), std::string(30, static_cast<char>('a' + i % 26)));
+    }
+    auto const expected = ToVector(headers);
+    ASSERT_EQ(expected.size(), static_cast<size_t>(count));
+    EXPECT_TRUE(std::is_sorted(expected.begin(), expected.end()));
+
+    HttpHeaders copy(headers);
+    EXPECT_EQ(ToVector(copy), expected);
+    EXPECT_EQ(ToVector(headers), expected);
+
+    HttpHeaders moved(std::move(copy));
+    EXPECT_EQ(ToVector(moved), expected);
+    EXPECT_TRUE(copy.empty());
+
+    HttpHeaders assigned;
+    assigned.insert_or_assign("other", "value");
+    assigned = headers;
+    EXPECT_EQ(ToVector(assigned), expected);
+    auto const& self = assigned;
+    assigned = self;
+    EXPECT_EQ(ToVector(assigned), expected);
+
+    HttpHeaders moveAssigned;
+    moveAssigned.insert_or_assign("other", "value");
+    moveAssigned = std::move(moved);
+    EXPECT_EQ(ToVector(moveAssigned), expected);
+    EXPECT_TRUE(moved.empty());
+
+    // The moved from headers can be used again.
+    moved.insert_or_assign("a", "b");
+    EXPECT_EQ(moved.at("A"), "b");
+  }
+}
+
+TEST(HttpHeaders, ToCaseInsensitiveMap)
+{
+  HttpHeaders headers;
+  headers.insert_or_assign("B", "2");
+  headers.insert_or_assign("a", "1");
+
+  CaseInsensitiveMap const map = headers;
+  EXPECT_EQ(map, (CaseInsensitiveMap{{"a", "1"}, {"b", "2"}}));
+}
@@ -121,6 +121,20 @@ namespace Azure { namespace Core { namespace Test {
         (std::pair<std::string, std::string>("valid3", "header3")));
   }
 
+  // Response - Copy keeps the transport metrics
+  TEST(TestHttp, response_copy_transport_metrics)
+  {
+    Http::RawResponse response(1, 1, Http::HttpStatusCode::Ok, "Test");
+    auto metrics = std::make_shared<Http::TransportMetrics>();
+    metrics->BytesReceived = 42;
+    response.SetTransportMetrics(metrics);
+
+    Http::RawResponse const copy(response);
+    ASSERT_NE(copy.GetTransportMetrics(), nullptr);
+    EXPECT_EQ(copy.GetTransportMetrics(), response.GetTransportMetrics());
+    EXPECT_EQ(copy.GetTransportMetrics()->BytesReceived, 42);
+  }
+
   class ParameterizedTestForHttpVersions
       : public ::testing::TestWithParam<std::pair<std::int32_t, std::int32_t>> {
   protected:
@@ -249,4 +263,31 @@ namespace Azure { namespace Core { namespace Test {
     }
   }
 
+  TEST(TestHttp, RequestStartTryHeaders)
+  {
+    Http::Request request(Http::HttpMethod::Get, Url("http://test.com"));
+    request.SetHeader("Before", "before");
+    request.SetHeader("Removed", "removed");
+
+    request.StartTry();
+    request.SetHeader("before", "first try");
+    request.SetHeader("Before", "first try again");
+    request.SetHeader("During", "during");
+    request.RemoveHeader("removed");
+    EXPECT_EQ(request.GetHeaders().at("before"), "first try again");
+    EXPECT_EQ(request.GetHeaders().at("during"), "during");
+
+    // The next try starts with the headers set before the first one, without the removed ones.
+    request.StartTry();
+    EXPECT_EQ(request.GetHeaders().size(), 1u);
+    EXPECT_EQ(request.GetHeader("BEFORE").Value(), "before");
+    EXPECT_FALSE(request.GetHeader("during").HasValue());
+
+    // A header set and removed during a try is removed for the next tries too.
+    request.SetHeader("before", "second try");
+    request.RemoveHeader("before");
+    request.StartTry();
+    EXPECT_TRUE(request.GetHeaders().empty());
+  }
+
 }}} // namespace Azure::Core::Test
@@ -16,7 +16,8 @@ namespace {
 void SendRequest(
     LogOptions const& logOptions,
     bool addDefaultAllowedHeaders = false,
-    std::string const& portAndPath = "")
+    std::string const& portAndPath = "",
+    std::shared_ptr<Azure::Core::Http::TransportMetrics const> transportMetrics = nullptr)
 {
   using namespace Azure::Core;
   using namespace Azure::Core::IO;
@@ -26,7 +27,14 @@ void SendRequest(
   using namespace Azure::Core::Http::Policies::_internal;
 
   class TestTransportPolicy final : public HttpPolicy {
+    std::shared_ptr<TransportMetrics const> m_transportMetrics;
+
   public:
+    TestTransportPolicy(std::shared_ptr<TransportMetrics const> transportMetrics)
+        : m_transportMetrics(std::move(transportMetrics))
+    {
+    }
+
     std::unique_ptr<HttpPolicy> Clone() const override
     {
       return std::make_unique<TestTransportPolicy>(*this);
@@ -44,6 +52,8 @@ void SendRequest(
       response->SetBodyStream(
           std::make_unique<MemoryBodyStream>(responseBodyStream, sizeof(responseBodyStream) - 1));
 
+      response->SetTransportMetrics(m_transportMetrics);
+
       return response;
     }
   };
@@ -112,7 +122,7 @@ void SendRequest(
     std::vector<std::unique_ptr<HttpPolicy>> policies;
 
     policies.emplace_back(std::make_unique<LogPolicy>(logOptions));
-    policies.emplace_back(std::make_unique<TestTransportPolicy>());
+    policies.emplace_back(std::make_unique<TestTransportPolicy>(transportMetrics));
 
     HttpPipeline(policies).Send(request, Azure::Core::Context());
   }
@@ -424,3 +434,48 @@ TEST(LogPolicy, QueryParamsEncoded)
   EXPECT_TRUE(StartsWith(entry2.Message, "HTTP/1.1 Response ("));
   EXPECT_TRUE(EndsWith(entry2.Message, "ms) : 200 OKAY"));
 }
+
+TEST(LogPolicy, TransportMetrics)
+{
+  auto metrics = std::make_shared<Azure::Core::Http::TransportMetrics>();
+  metrics->NameLookupTime = std::chrono::milliseconds(1);
+  metrics->ConnectTime = std::chrono::milliseconds(2);
+  metrics->TlsHandshakeTime = std::chrono::milliseconds(3);
+  metrics->SendTime = std::chrono::milliseconds(4);
+  metrics->TimeToFirstByte = std::chrono::milliseconds(5);
+  metrics->BodyReadTime = std::chrono::milliseconds(6);
+  metrics->BytesSent = 7;
+  metrics->BytesReceived = 8;
+  metrics->SocketReads = 9;
+  metrics->SocketWaits = 10;
+
+  TestLogger const Log;
+  SendRequest(LogOptions(), false, "", metrics);
+
+  EXPECT_EQ(Log.Entries.size(), 3);
+
+  // The response line keeps its format, the metrics are on their own line.
+  auto const entry2 = Log.Entries.at(1);
+  EXPECT_TRUE(StartsWith(entry2.Message, "HTTP/1.1 Response ("));
+  EXPECT_TRUE(EndsWith(entry2.Message, "ms) : 200 OKAY"));
+
+  auto const entry3 = Log.Entries.at(2);
+  EXPECT_EQ(entry3.Level, Logger::Level::Informational);
+  EXPECT_EQ(
+      entry3.Message,
+      "HTTP Transport Metrics : new connection: name lookup 1ms, connect 2ms, TLS handshake 3ms; "
+      "send 4ms; time to first byte 5ms; body 6ms; 7 bytes sent, 8 bytes received in 9 socket "
+      "reads, 10 socket waits");
+}
+
+TEST(LogPolicy, TransportMetricsReusedConnection)
+{
+  auto metrics = std::make_shared<Azure::Core::Http::TransportMetrics>();
+  metrics->ConnectionReused = true;
+
+  TestLogger const Log;
+  SendRequest(LogOptions(), false, "", metrics);
+
+  EXPECT_EQ(Log.Entries.size(), 3);
+  EXPECT_TRUE(StartsWith(Log.Entries.at(2).Message, "HTTP Transport Metrics : reused connection;"));
+}
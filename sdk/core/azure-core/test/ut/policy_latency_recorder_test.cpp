@@ -0,0 +1,309 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/http/policies/policy_latency_recorder.hpp"
+#include "azure/core/internal/http/pipeline.hpp"
+#include "azure/core/internal/tracing/service_tracing.hpp"
+#include "azure/core/io/body_stream.hpp"
+#include "azure/core/tracing/tracing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core;
+using namespace Azure::Core::Http;
+using namespace Azure::Core::Http::Policies;
+using namespace Azure::Core::Tracing::_internal;
+
+namespace {
+class OkTransport final : public HttpTransport {
+public:
+  std::unique_ptr<RawResponse> Send(Request&, Context const&) override
+  {
+    auto response = std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "OK");
+    response->SetBodyStream(std::make_unique<IO::MemoryBodyStream>(nullptr, 0));
+    return response;
+  }
+};
+
+class SleepPolicy final : public HttpPolicy {
+  std::chrono::milliseconds m_delay;
+  bool m_throw;
+
+public:
+  explicit SleepPolicy(std::chrono::milliseconds delay, bool throwAfterDelay = false)
+      : m_delay(delay), m_throw(throwAfterDelay)
+  {
+  }
+
+  std::unique_ptr<HttpPolicy> Clone() const override
+  {
+    return std::make_unique<SleepPolicy>(*this);
+  }
+
+  std::unique_ptr<RawResponse> Send(
+      Request& request,
+      NextHttpPolicy nextPolicy,
+      Context const& context) const override
+  {
+    std::this_thread::sleep_for(m_delay);
+    if (m_throw)
+    {
+      throw std::runtime_error("SleepPolicy");
+    }
+    return nextPolicy.Send(request, context);
+  }
+};
+
+Http::_internal::HttpPipeline CreatePipeline(
+    std::shared_ptr<PolicyLatencyRecorder> recorder,
+    std::unique_ptr<HttpPolicy> perRetryPolicy)
+{
+  Azure::Core::_internal::ClientOptions clientOptions;
+  clientOptions.Telemetry.LatencyRecorder = std::move(recorder);
+  clientOptions.Transport.Transport = std::make_shared<OkTransport>();
+  std::vector<std::unique_ptr<HttpPolicy>> perRetryPolicies;
+  perRetryPolicies.emplace_back(std::move(perRetryPolicy));
+  return Http::_internal::HttpPipeline(
+      clientOptions, "test", "1.0.0", std::move(perRetryPolicies), {});
+}
+
+PolicyLatencyHistogram const* FindHistogram(
+    std::vector<PolicyLatencyHistogram> const& histograms,
+    std::string const& policyName)
+{
+  auto const histogram = std::find_if(
+      histograms.begin(), histograms.end(), [&](PolicyLatencyHistogram const& h) {
+        return h.PolicyName.find(policyName) != std::string::npos;
+      });
+  return histogram != histograms.end() ? &*histogram : nullptr;
+}
+
+class TestAttributeSet final : public AttributeSet {
+public:
+  void AddAttribute(std::string const&, bool) override {}
+  void AddAttribute(std::string const&, int32_t) override {}
+  void AddAttribute(std::string const&, int64_t) override {}
+  void AddAttribute(std::string const&, uint64_t) override {}
+  void AddAttribute(std::string const&, double) override {}
+  void AddAttribute(std::string const&, const char*) override {}
+  void AddAttribute(std::string const&, std::string const&) override {}
+};
+
+class TestSpan final : public Span {
+public:
+  std::vector<std::string> Events;
+
+  void AddAttributes(AttributeSet const&) override {}
+  void AddAttribute(std::string const&, std::string const&) override {}
+  void AddEvent(std::string const& eventName, AttributeSet const&) override
+  {
+    Events.push_back(eventName);
+  }
+  void AddEvent(std::string const& eventName) override { Events.push_back(eventName); }
+  void AddEvent(std::exception const& ex) override { Events.push_back(ex.what()); }
+  void SetStatus(SpanStatus const&, std::string const&) override {}
+  void End(Azure::Nullable<Azure::DateTime>) override {}
+  void PropagateToHttpHeaders(Request&) override {}
+};
+
+class TestTracer final : public Tracer {
+public:
+  mutable std::vector<std::shared_ptr<TestSpan>> Spans;
+
+  std::shared_ptr<Span> CreateSpan(std::string const&, CreateSpanOptions const&) const override
+  {
+    Spans.push_back(std::make_shared<TestSpan>());
+    return Spans.back();
+  }
+
+  std::unique_ptr<AttributeSet> CreateAttributeSet() const override
+  {
+    return std::make_unique<TestAttributeSet>();
+  }
+};
+
+class TestTracerProvider final : public Azure::Core::Tracing::TracerProvider {
+public:
+  std::shared_ptr<TestTracer> Tracer = std::make_shared<TestTracer>();
+
+  std::shared_ptr<Azure::Core::Tracing::_internal::Tracer> CreateTracer(
+      std::string const&,
+      std::string const&) const override
+  {
+    return Tracer;
+  }
+};
+} // namespace
+
+TEST(PolicyLatencyRecorder, RecordsEachPolicy)
+{
+  auto const recorder = std::make_shared<PolicyLatencyRecorder>();
+  auto const pipeline
+      = CreatePipeline(recorder, std::make_unique<SleepPolicy>(std::chrono::milliseconds(5)));
+
+  for (int i = 0; i < 3; ++i)
+  {
+    Request request(HttpMethod::Get, Url("https://www.microsoft.com"));
+    EXPECT_EQ(pipeline.Send(request, Context{})->GetStatusCode(), HttpStatusCode::Ok);
+  }
+
+  auto const histograms = recorder->GetHistograms();
+  // The request ID, telemetry, retry, sleep, request activity, log and transport policies.
+  EXPECT_EQ(histograms.size(), 7);
+  for (auto const& histogram : histograms)
+  {
+    EXPECT_EQ(histogram.Count, 3);
+    EXPECT_EQ(histogram.BucketCounts.size(), PolicyLatencyHistogram::BucketCount);
+    EXPECT_EQ(
+        std::accumulate(histogram.BucketCounts.begin(), histogram.BucketCounts.end(), uint64_t{0}),
+        3);
+  }
+
+#if defined(AZ_CORE_RTTI)
+  auto const sleepHistogram = FindHistogram(histograms, "SleepPolicy");
+  ASSERT_NE(sleepHistogram, nullptr);
+  EXPECT_GE(sleepHistogram->TotalLatency, std::chrono::milliseconds(15));
+  // The policies after the sleep policy don't count the sleep.
+  auto const transportHistogram = FindHistogram(histograms, "TransportPolicy");
+  ASSERT_NE(transportHistogram, nullptr);
+  EXPECT_LT(transportHistogram->TotalLatency, std::chrono::milliseconds(15));
+  // The retry policy before the sleep policy doesn't count it either.
+  auto const retryHistogram = FindHistogram(histograms, "RetryPolicy");
+  ASSERT_NE(retryHistogram, nullptr);
+  EXPECT_LT(retryHistogram->TotalLatency, std::chrono::milliseconds(15));
+  // 5 milliseconds are in the bucket from 4096 to 8192 microseconds, or a later one.
+  EXPECT_EQ(
+      std::accumulate(
+          sleepHistogram->BucketCounts.begin() + 13, sleepHistogram->BucketCounts.end(), 0),
+      3);
+#endif
+
+  recorder->Reset();
+  for (auto const& histogram : recorder->GetHistograms())
+  {
+    EXPECT_EQ(histogram.Count, 0);
+    EXPECT_EQ(histogram.TotalLatency.count(), 0);
+  }
+}
+
+TEST(PolicyLatencyRecorder, SharedByPipelines)
+{
+  auto const recorder = std::make_shared<PolicyLatencyRecorder>();
+  auto const pipeline1
+      = CreatePipeline(recorder, std::make_unique<SleepPolicy>(std::chrono::milliseconds(0)));
+  auto const pipeline2
+      = CreatePipeline(recorder, std::make_unique<SleepPolicy>(std::chrono::milliseconds(0)));
+
+  Request request1(HttpMethod::Get, Url("https://www.microsoft.com"));
+  pipeline1.Send(request1, Context{});
+  Request request2(HttpMethod::Get, Url("https://www.microsoft.com"));
+  pipeline2.Send(request2, Context{});
+
+  auto const histograms = recorder->GetHistograms();
+  EXPECT_EQ(histograms.size(), 7);
+  for (auto const& histogram : histograms)
+  {
+    EXPECT_EQ(histogram.Count, 2);
+  }
+}
+
+TEST(PolicyLatencyRecorder, PolicyVector)
+{
+  // The clients building their own policies pass the recorder of their options.
+  auto const recorder = std::make_shared<PolicyLatencyRecorder>();
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+  policies.emplace_back(std::make_unique<SleepPolicy>(std::chrono::milliseconds(0)));
+  TransportOptions transportOptions;
+  transportOptions.Transport = std::make_shared<OkTransport>();
+  policies.emplace_back(std::make_unique<Policies::_internal::TransportPolicy>(transportOptions));
+  Http::_internal::HttpPipeline const copiedPolicies(policies, recorder);
+  Http::_internal::HttpPipeline const movedPolicies(std::move(policies), recorder);
+
+  Request request1(HttpMethod::Get, Url("https://www.microsoft.com"));
+  copiedPolicies.Send(request1, Context{});
+  Request request2(HttpMethod::Get, Url("https://www.microsoft.com"));
+  movedPolicies.Send(request2, Context{});
+
+  auto const histograms = recorder->GetHistograms();
+  EXPECT_EQ(histograms.size(), 2);
+  for (auto const& histogram : histograms)
+  {
+    EXPECT_EQ(histogram.Count, 2);
+  }
+}
+
+TEST(PolicyLatencyRecorder, Sampling)
+{
+  PolicyLatencyRecorderOptions options;
+  options.SamplingInterval = 4;
+  auto const recorder = std::make_shared<PolicyLatencyRecorder>(options);
+  auto const pipeline
+      = CreatePipeline(recorder, std::make_unique<SleepPolicy>(std::chrono::milliseconds(0)));
+
+  for (int i = 0; i < 10; ++i)
+  {
+    Request request(HttpMethod::Get, Url("https://www.microsoft.com"));
+    pipeline.Send(request, Context{});
+  }
+
+  for (auto const& histogram : recorder->GetHistograms())
+  {
+    // The requests 0, 4 and 8.
+    EXPECT_EQ(histogram.Count, 3);
+  }
+}
+
+TEST(PolicyLatencyRecorder, Exception)
+{
+  auto const recorder = std::make_shared<PolicyLatencyRecorder>();
+  auto const pipeline = CreatePipeline(
+      recorder, std::make_unique<SleepPolicy>(std::chrono::milliseconds(0), true));
+
+  Request request(HttpMethod::Get, Url("https://www.microsoft.com"));
+  EXPECT_THROW(pipeline.Send(request, Context{}), std::runtime_error);
+
+  auto const histograms = recorder->GetHistograms();
+  EXPECT_EQ(histograms.size(), 7);
+  uint64_t recordedCount = 0;
+  for (auto const& histogram : histograms)
+  {
+    recordedCount += histogram.Count;
+  }
+  // The request ID, telemetry, retry and sleep policies ran, not the ones after them.
+  EXPECT_EQ(recordedCount, 4);
+}
+
+TEST(PolicyLatencyRecorder, SpanEvents)
+{
+  auto const tracerProvider = std::make_shared<TestTracerProvider>();
+  Azure::Core::_internal::ClientOptions clientOptions;
+  clientOptions.Telemetry.TracingProvider = tracerProvider;
+  TracingContextFactory tracingFactory(clientOptions, "My.Service", "my-service-cpp", "1.0.0");
+  auto contextAndSpan = tracingFactory.CreateTracingContext("My API", Context{});
+
+  auto const recorder = std::make_shared<PolicyLatencyRecorder>();
+  auto const pipeline
+      = CreatePipeline(recorder, std::make_unique<SleepPolicy>(std::chrono::milliseconds(0)));
+  Request request(HttpMethod::Get, Url("https://www.microsoft.com"));
+  pipeline.Send(request, contextAndSpan.Context);
+
+  // The operation span and the HTTP span of the request activity policy.
+  ASSERT_EQ(tracerProvider->Tracer->Spans.size(), 2);
+  auto const& events = tracerProvider->Tracer->Spans[0]->Events;
+  EXPECT_EQ(events.size(), 7);
+#if defined(AZ_CORE_RTTI)
+  EXPECT_NE(
+      std::find_if(
+          events.begin(),
+          events.end(),
+          [](std::string const& event) { return event.find("RetryPolicy") != std::string::npos; }),
+      events.end());
+#endif
+}
@@ -228,7 +228,7 @@ TEST(RequestActivityPolicy, Basic)
     EXPECT_EQ("HTTP GET", tracer->GetSpans()[1]->GetName());
     EXPECT_EQ("GET", tracer->GetSpans()[1]->GetAttributes().at("http.method"));
     EXPECT_EQ(
-        request.GetHeaders()["x-ms-client-request-id"],
+        request.GetHeaders().at("x-ms-client-request-id"),
         tracer->GetSpans()[1]->GetAttributes().at("az.client_request_id"));
     std::string expectedUserAgentPrefix{"azsdk-cpp-my-service/1.0.0.beta-2 ("};
     EXPECT_EQ(expectedUserAgentPrefix, userAgent.Value().substr(0, expectedUserAgentPrefix.size()));
@@ -4,6 +4,9 @@
 #include "azure/core/internal/cryptography/sha_hash.hpp"
 #include "gtest/gtest.h"
 
+#include <thread>
+#include <vector>
+
 using namespace Azure::Core::Cryptography::_internal;
 
 // cspell: words ABCDE FGHIJ
@@ -117,3 +120,42 @@ TEST(SHA, SHA512Test)
       printf("%02x", shaResult[i]);
   }
 }
+
+TEST(SHA, ReusedContexts)
+{
+  // sha256("abc") from FIPS 180-2.
+  std::vector<uint8_t> const expected
+      = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22,
+         0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00,
+         0x15, 0xad};
+  uint8_t const data[] = {'a', 'b', 'c'};
+  {
+    // Left without calling Final, the next hash must not see its data.
+    Sha256Hash unfinished;
+    unfinished.Append(data, sizeof(data));
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    Sha256Hash sha;
+    Sha256Hash sha2;
+    sha2.Append(data, 1);
+    EXPECT_EQ(sha.Final(data, sizeof(data)), expected);
+    EXPECT_EQ(sha2.Final(data + 1, sizeof(data) - 1), expected);
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 100; ++i)
+      {
+        Sha256Hash sha;
+        EXPECT_EQ(sha.Final(data, sizeof(data)), expected);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
@@ -187,6 +187,35 @@ namespace Azure { namespace Core { namespace Test {
     CheckBodyFromBuffer(*response, expectedResponseBodySize);
   }
 
+#if _azure_DISABLE_HTTP_BIN_TESTS
+  TEST_P(TransportAdapter, DISABLED_deleteRequestSendsBody)
+#else
+  TEST_P(TransportAdapter, deleteRequestSendsBody)
+#endif
+  {
+    if (!AzureSdkHttpbinServer::IsEnabled())
+    {
+      GTEST_SKIP_("Skipping the test because httpbin URL environment variable is not set.");
+    }
+
+    Azure::Core::Url host(AzureSdkHttpbinServer::Delete());
+
+    auto requestBodyVector = std::vector<uint8_t>(1024, 'x');
+    auto bodyRequest = Azure::Core::IO::MemoryBodyStream(requestBodyVector);
+    auto request
+        = Azure::Core::Http::Request(Azure::Core::Http::HttpMethod::Delete, host, &bodyRequest);
+    request.SetHeader("content-length", std::to_string(requestBodyVector.size()));
+    auto response = m_pipeline->Send(request, Context{});
+    checkResponseCode(response->GetStatusCode());
+
+    json responseJson = json::parse(response->GetBody());
+
+    // Make sure the server got the 1K sent with the DELETE.
+    std::string bodyAsString{
+        requestBodyVector.data(), requestBodyVector.data() + requestBodyVector.size()};
+    EXPECT_EQ(responseJson["data"].get<std::string>(), bodyAsString);
+  }
+
 #if _azure_DISABLE_HTTP_BIN_TESTS
   TEST_P(TransportAdapter, DISABLED_patch)
 #else
@@ -822,6 +851,8 @@ namespace Azure { namespace Core { namespace Test {
     Azure::Core::IO::FileBodyStream requestBodyStream(testDataPath);
     auto request = Azure::Core::Http::Request(
         Azure::Core::Http::HttpMethod::Put, host, &requestBodyStream, false);
+    // Make transport adapter to upload the file in chunks bigger than the default
+    request.SetUploadChunkSize(1024 * 1024);
     {
       auto response = m_pipeline->Send(request, Context{});
       checkResponseCode(response->GetStatusCode());
@@ -13,6 +13,7 @@
 #include "azure/perf/base_test.hpp"
 #include "azure/perf/dynamic_test_options.hpp"
 #include "azure/perf/latency_stats.hpp"
+#include "azure/perf/no_network_transport.hpp"
 #include "azure/perf/options.hpp"
 #include "azure/perf/program.hpp"
 #include "azure/perf/random_stream.hpp"
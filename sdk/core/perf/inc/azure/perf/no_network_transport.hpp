@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief An HTTP transport which answers the requests without sending them. Useful for test cases
+ * measuring the client side of a request only.
+ *
+ */
+
+#pragma once
+
+#include <azure/core/http/http.hpp>
+#include <azure/core/http/raw_response.hpp>
+#include <azure/core/http/transport.hpp>
+#include <azure/core/io/body_stream.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace Azure { namespace Perf {
+
+  /**
+   * @brief Answers every request without sending it to the network.
+   *
+   * @remark Use it as the transport of the client options, or wrap it in a `TransportPolicy` at
+   * the end of a pipeline.
+   *
+   */
+  class NoNetworkTransport final : public Azure::Core::Http::HttpTransport {
+  private:
+    bool m_serviceHeaders;
+    Azure::Core::Http::HttpStatusCode m_statusCode;
+    std::string m_reasonPhrase;
+
+  public:
+    /**
+     * @brief Construct a new NoNetworkTransport.
+     *
+     * @param serviceHeaders When `true`, the responses have the headers of a typical storage
+     * service response, so the test also measures handling them, like on a fast network.
+     * Otherwise, the responses only have a status.
+     * @param statusCode The status of the responses.
+     * @param reasonPhrase The reason phrase of the responses.
+     */
+    explicit NoNetworkTransport(
+        bool serviceHeaders = false,
+        Azure::Core::Http::HttpStatusCode statusCode = Azure::Core::Http::HttpStatusCode::Ok,
+        std::string reasonPhrase = "OK")
+        : m_serviceHeaders(serviceHeaders), m_statusCode(statusCode),
+          m_reasonPhrase(std::move(reasonPhrase))
+    {
+    }
+
+    std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+        Azure::Core::Http::Request& request,
+        Azure::Core::Context const&) override
+    {
+      auto response
+          = std::make_unique<Azure::Core::Http::RawResponse>(1, 1, m_statusCode, m_reasonPhrase);
+      if (m_serviceHeaders)
+      {
+        size_t headersLength = 0;
+        for (auto const& header : request.GetHeaders())
+        {
+          headersLength += header.first.size() + header.second.size();
+        }
+        response->SetHeader("Content-Length", "0");
+        response->SetHeader("Content-Type", "application/json");
+        response->SetHeader("Date", "Thu, 15 Oct 2026 12:00:00 GMT");
+        response->SetHeader("ETag", "\"0x8DCECB3B4A5E6F7\"");
+        response->SetHeader("Server", "Windows-Azure-Blob/1.0 Microsoft-HTTPAPI/2.0");
+        response->SetHeader(
+            "x-ms-client-request-id", request.GetHeader("x-ms-client-request-id").ValueOr(""));
+        response->SetHeader("x-ms-request-id", "5b0f6f1e-601e-0041-3c2a-1f5a3e000000");
+        response->SetHeader("x-ms-request-headers-length", std::to_string(headersLength));
+        response->SetHeader("x-ms-version", "2026-10-06");
+      }
+      response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(nullptr, 0));
+      return response;
+    }
+  };
+
+}} // namespace Azure::Perf
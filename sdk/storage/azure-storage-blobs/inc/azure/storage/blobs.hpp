@@ -14,6 +14,7 @@
 #include "azure/storage/blobs/blob_container_client.hpp"
 #include "azure/storage/blobs/blob_lease_client.hpp"
 #include "azure/storage/blobs/blob_options.hpp"
+#include "azure/storage/blobs/blob_read_stream.hpp"
 #include "azure/storage/blobs/blob_responses.hpp"
 #include "azure/storage/blobs/blob_sas_builder.hpp"
 #include "azure/storage/blobs/blob_service_client.hpp"
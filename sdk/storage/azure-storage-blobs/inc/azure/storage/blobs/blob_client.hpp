@@ -4,6 +4,7 @@
 #pragma once
 
 #include "azure/storage/blobs/blob_options.hpp"
+#include "azure/storage/blobs/blob_read_stream.hpp"
 #include "azure/storage/blobs/blob_responses.hpp"
 #include "azure/storage/blobs/dll_import_export.hpp"
 
@@ -300,6 +301,22 @@ namespace Azure { namespace Storage { namespace Blobs {
         const DownloadBlobToOptions& options = DownloadBlobToOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Opens a seekable stream over the content of the blob, downloading it in blocks as it's
+     * read.
+     *
+     * @details Reads from the stream download the blocks they need, and the blocks after them in
+     * parallel when reading sequentially. The stream keeps reading the version of the blob opened,
+     * identified by its ETag.
+     *
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A BlobReadStream reading the blob.
+     */
+    std::unique_ptr<BlobReadStream> OpenRead(
+        const OpenReadBlobOptions& options = OpenReadBlobOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Creates a read-only snapshot of a blob.
      *
@@ -285,6 +285,53 @@ namespace Azure { namespace Storage { namespace Blobs {
         const UploadBlockBlobOptions& options = UploadBlockBlobOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Uploads the files of a local directory and its subdirectories to block blobs named
+     * after their paths relative to the directory, under a prefix.
+     *
+     * @details The files are uploaded while the directory is listed, up to `Concurrency` at a
+     * time, and the files larger than `SingleUploadThreshold` are uploaded in chunks. The files and
+     * the chunks are transferred by the #Azure::Storage::TransferExecutor.
+     *
+     * @param sourceDirectory The path of the directory to upload.
+     * @param blobNamePrefix The prefix of the names of the blobs. A `/` is added if it doesn't end
+     * with one.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return An UploadBlobDirectoryResult describing the files uploaded.
+     * @remark The files uploaded before a failure are added to the journal, if there is one, and
+     * the first failure is thrown once the uploads in progress are done.
+     */
+    Models::UploadBlobDirectoryResult UploadDirectory(
+        const std::string& sourceDirectory,
+        const std::string& blobNamePrefix,
+        const UploadBlobDirectoryOptions& options = UploadBlobDirectoryOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Downloads the blobs under a prefix to files of a local directory, named after the
+     * rest of the blob names.
+     *
+     * @details The blobs are downloaded while they are listed, up to `Concurrency` at a time, and
+     * the blobs larger than `InitialChunkSize` are downloaded in chunks. The blobs and the chunks
+     * are transferred by the #Azure::Storage::TransferExecutor. The subdirectories are created as
+     * they are needed.
+     *
+     * @param blobNamePrefix The prefix of the names of the blobs. A `/` is added if it doesn't end
+     * with one.
+     * @param destinationDirectory The path of the directory to download to.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A DownloadBlobDirectoryResult describing the blobs downloaded.
+     * @remark The blobs downloaded before a failure are added to the journal, if there is one,
+     * and the first failure is thrown once the downloads in progress are done.
+     */
+    Models::DownloadBlobDirectoryResult DownloadDirectory(
+        const std::string& blobNamePrefix,
+        const std::string& destinationDirectory,
+        const DownloadBlobDirectoryOptions& options = DownloadBlobDirectoryOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief The Filter Blobs operation enables callers to list blobs in a container whose
      * tags match a given search expression.
@@ -345,6 +392,19 @@ namespace Azure { namespace Storage { namespace Blobs {
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> m_batchRequestPipeline;
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> m_batchSubrequestPipeline;
 
+    explicit BlobContainerClient(
+        Azure::Core::Url blobContainerUrl,
+        std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> pipeline,
+        _detail::BlobClientConfiguration clientConfiguration,
+        std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> batchRequestPipeline,
+        std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> batchSubrequestPipeline)
+        : m_blobContainerUrl(std::move(blobContainerUrl)), m_pipeline(std::move(pipeline)),
+          m_clientConfiguration(std::move(clientConfiguration)),
+          m_batchRequestPipeline(std::move(batchRequestPipeline)),
+          m_batchSubrequestPipeline(std::move(batchSubrequestPipeline))
+    {
+    }
+
     friend class BlobServiceClient;
     friend class BlobLeaseClient;
     friend class BlobContainerBatch;
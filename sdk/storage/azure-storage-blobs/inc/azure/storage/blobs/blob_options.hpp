@@ -271,6 +271,14 @@ namespace Azure { namespace Storage { namespace Blobs {
      */
     bool EnableTenantDiscovery = false;
 
+    /**
+     * When set, a token expiring within this window is refreshed in the background while the
+     * requests keep using it, when the client is configured to use a TokenCredential. Only the
+     * requests finding a token about to expire wait for a new one. By default, the token is
+     * refreshed by the request which finds it expiring.
+     */
+    Azure::DateTime::duration TokenRefreshWindow = Azure::DateTime::duration::zero();
+
     /**
      * The Audience to use for authentication with Azure Active Directory (AAD).
      * #Azure::Storage::Blobs::BlobAudience::DefaultAudience will be assumed if Audience is
@@ -574,6 +582,109 @@ namespace Azure { namespace Storage { namespace Blobs {
     BlobContainerAccessConditions AccessConditions;
   };
 
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobContainerClient::UploadDirectory.
+   */
+  struct UploadBlobDirectoryOptions final
+  {
+    /**
+     * @brief Indicates the tier to be set on the blobs.
+     */
+    Azure::Nullable<Models::AccessTier> AccessTier;
+
+    /**
+     * @brief The path of a journal of the files uploaded. The files listed in an existing journal
+     * are skipped, so that an upload that failed or was interrupted resumes where it stopped.
+     */
+    Azure::Nullable<std::string> JournalPath;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief Files smaller than this are uploaded with a single upload operation. This value
+       * cannot be larger than 5000 MiB.
+       */
+      int64_t SingleUploadThreshold = 256 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of bytes in a single request. This value cannot be larger than
+       * 4000 MiB.
+       */
+      Azure::Nullable<int64_t> ChunkSize;
+
+      /**
+       * @brief The maximum number of requests sent at the same time, over all the files. Files
+       * larger than SingleUploadThreshold are staged in chunks, one request each.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(32, 4 * _internal::GetHardwareConcurrency()));
+
+      /**
+       * @brief The maximum average number of bytes uploaded per second, over all the files. When
+       * set, the files larger than a chunk are staged in chunks, and each request waits for its
+       * share of the bandwidth.
+       */
+      Azure::Nullable<int64_t> MaxBytesPerSecond;
+    } TransferOptions;
+
+    /**
+     * @brief Optional. Configures whether to do content validation for blob uploads.
+     */
+    Azure::Nullable<TransferValidationOptions> ValidationOptions;
+  };
+
+  /**
+   * @brief Optional parameters for
+   * #Azure::Storage::Blobs::BlobContainerClient::DownloadDirectory.
+   */
+  struct DownloadBlobDirectoryOptions final
+  {
+    /**
+     * @brief The path of a journal of the blobs downloaded. The blobs listed in an existing
+     * journal are skipped, so that a download that failed or was interrupted resumes where it
+     * stopped.
+     */
+    Azure::Nullable<std::string> JournalPath;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The size of the first range request in bytes. Blobs smaller than this limit will be
+       * downloaded in a single request. Blobs larger than this limit will continue being downloaded
+       * in chunks of size ChunkSize.
+       */
+      int64_t InitialChunkSize = 256 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of bytes in a single request.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of requests sent at the same time, over all the blobs. Blobs
+       * larger than InitialChunkSize are downloaded in chunks of ChunkSize, one request each.
+       */
+      int32_t Concurrency = (std::min)(96, (std::max)(32, 4 * _internal::GetHardwareConcurrency()));
+
+      /**
+       * @brief The maximum average number of bytes downloaded per second, over all the blobs.
+       * When set, the blobs larger than a chunk are downloaded in chunks, and each request waits
+       * for its share of the bandwidth.
+       */
+      Azure::Nullable<int64_t> MaxBytesPerSecond;
+    } TransferOptions;
+
+    /**
+     * @brief Optional. Configures whether to do content validation for blob downloads.
+     */
+    Azure::Nullable<TransferValidationOptions> ValidationOptions;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Blobs::BlobClient::GetProperties.
    */
@@ -840,6 +951,52 @@ namespace Azure { namespace Storage { namespace Blobs {
      * @brief Optional. Configures whether to do content validation for blob downloads.
      */
     Azure::Nullable<TransferValidationOptions> ValidationOptions;
+
+    /**
+     * @brief The path of a checkpoint of the chunks written, when downloading to a file. A
+     * download of the same version of the blob to the same file which failed or was interrupted
+     * resumes from its checkpoint: the chunks of the file which still have the same content aren't
+     * downloaded again. The checkpoint is deleted once the download is done.
+     */
+    Azure::Nullable<std::string> CheckpointPath;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobClient::OpenRead.
+   */
+  struct OpenReadBlobOptions final
+  {
+    /**
+     * @brief Optional conditions that must be met to open the blob.
+     */
+    BlobAccessConditions AccessConditions;
+
+    /**
+     * @brief Options for the blocks downloaded by the stream.
+     */
+    struct
+    {
+      /**
+       * @brief The size of the blocks the blob is downloaded in, and cached.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The number of blocks downloaded in parallel ahead of sequential reads.
+       */
+      int32_t Concurrency = 4;
+
+      /**
+       * @brief The maximum number of blocks kept in memory. The least recently read blocks are
+       * dropped first. At least `Concurrency + 1` blocks are kept.
+       */
+      int32_t MaxCachedChunks = 16;
+    } TransferOptions;
+
+    /**
+     * @brief Optional. Configures whether to do content validation for blob downloads.
+     */
+    Azure::Nullable<TransferValidationOptions> ValidationOptions;
   };
 
   /**
@@ -1097,6 +1254,14 @@ namespace Azure { namespace Storage { namespace Blobs {
      * @brief Optional. Configures whether to do content validation for blob uploads.
      */
     Azure::Nullable<TransferValidationOptions> ValidationOptions;
+
+    /**
+     * @brief The path of a checkpoint of the blocks staged, when uploading a file in blocks. An
+     * upload of the same file which failed or was interrupted resumes from its checkpoint: the
+     * blocks still staged with the same content aren't staged again. The checkpoint is deleted
+     * once the upload is done.
+     */
+    Azure::Nullable<std::string> CheckpointPath;
   };
 
   /**
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/storage/blobs/blob_options.hpp"
+
+#include <azure/core/etag.hpp>
+#include <azure/core/io/body_stream.hpp>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs {
+
+  class BlobClient;
+
+  /**
+   * @brief A seekable stream over the content of a blob, returned by
+   * #Azure::Storage::Blobs::BlobClient::OpenRead.
+   *
+   * @details The blob is downloaded in blocks of `ChunkSize` bytes as it's read, and the least
+   * recently read blocks are dropped when more than `MaxCachedChunks` blocks are cached. When a
+   * read starts where the previous one ended, the next `Concurrency` blocks are downloaded in
+   * parallel ahead of it by the #Azure::Storage::TransferExecutor. The block a read needs is
+   * downloaded by the reading thread, unless its download ahead has started. Reads after a #Seek
+   * to another position only download the blocks they need.
+   *
+   * @remark All the blocks are downloaded from the version of the blob that was opened. Reading a
+   * block fails with a #Azure::Storage::StorageException if the blob has changed since.
+   *
+   * @remark Like the other body streams, the stream must be used from one thread at a time.
+   */
+  class BlobReadStream final : public Azure::Core::IO::BodyStream {
+  public:
+    /**
+     * @brief Destructs the stream. The blocks still being downloaded are dropped once downloaded,
+     * and the blocks to download ahead which haven't started aren't downloaded.
+     *
+     */
+    ~BlobReadStream() override;
+
+    /**
+     * @brief Get the size of the blob.
+     *
+     */
+    int64_t Length() const override { return m_blobSize; }
+
+    /**
+     * @brief Moves back to the beginning of the blob.
+     *
+     */
+    void Rewind() override { Seek(0); }
+
+    /**
+     * @brief Moves to a position in the blob.
+     *
+     * @param offset The position to read from next, from `0` to the size of the blob.
+     */
+    void Seek(int64_t offset);
+
+    /**
+     * @brief Get the position the stream reads from next.
+     *
+     */
+    int64_t Position() const { return m_position; }
+
+    /**
+     * @brief Get the ETag of the version of the blob the stream reads.
+     *
+     */
+    const Azure::ETag& GetETag() const { return m_eTag; }
+
+  private:
+    struct BlockDownload;
+
+    struct CachedBlock
+    {
+      int64_t Index;
+      std::shared_ptr<BlockDownload> Download;
+    };
+
+    std::shared_ptr<const BlobClient> m_blobClient;
+    Azure::ETag m_eTag;
+    int64_t m_blobSize;
+    OpenReadBlobOptions m_options;
+    size_t m_maxCachedBlocks;
+    int64_t m_position = 0;
+    // Where the last read ended. A read starting there is sequential.
+    int64_t m_lastReadEnd = 0;
+    // The most recently read blocks first.
+    std::list<CachedBlock> m_blocks;
+
+    BlobReadStream(
+        std::shared_ptr<const BlobClient> blobClient,
+        Azure::ETag eTag,
+        int64_t blobSize,
+        const OpenReadBlobOptions& options);
+
+    size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const& context) override;
+
+    std::shared_ptr<BlockDownload> CreateBlockDownload(
+        int64_t blockIndex,
+        const Azure::Core::Context& context) const;
+    std::shared_ptr<BlockDownload> PrefetchBlock(
+        int64_t blockIndex,
+        const Azure::Core::Context& context) const;
+    std::list<CachedBlock>::iterator FindBlock(int64_t blockIndex);
+
+    friend class BlobClient;
+  };
+
+}}} // namespace Azure::Storage::Blobs
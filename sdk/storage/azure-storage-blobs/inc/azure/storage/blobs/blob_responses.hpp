@@ -62,6 +62,49 @@ namespace Azure { namespace Storage {
 
       using UploadBlockBlobFromResult = UploadBlockBlobResult;
 
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::BlobContainerClient::UploadDirectory.
+       */
+      struct UploadBlobDirectoryResult final
+      {
+        /**
+         * Number of files uploaded.
+         */
+        int64_t NumberOfFilesUploaded = 0;
+        /**
+         * Number of files skipped because the journal lists them as uploaded already.
+         */
+        int64_t NumberOfFilesSkipped = 0;
+        /**
+         * Number of bytes uploaded.
+         */
+        int64_t BytesUploaded = 0;
+      };
+
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::BlobContainerClient::DownloadDirectory.
+       */
+      struct DownloadBlobDirectoryResult final
+      {
+        /**
+         * Number of blobs downloaded.
+         */
+        int64_t NumberOfBlobsDownloaded = 0;
+        /**
+         * Number of blobs skipped because the journal lists them as downloaded already.
+         */
+        int64_t NumberOfBlobsSkipped = 0;
+        /**
+         * Number of bytes downloaded.
+         */
+        int64_t BytesDownloaded = 0;
+        /**
+         * Names of the blobs that weren't downloaded because they don't map to a file in the
+         * directory, such as the names with an empty, `.` or `..` path segment.
+         */
+        std::vector<std::string> UnsupportedBlobNames;
+      };
+
       /**
        * @brief Response type for #Azure::Storage::Blobs::BlobLeaseClient::Acquire.
        */
@@ -157,6 +157,31 @@ namespace Azure { namespace Storage { namespace Blobs {
         const UploadBlockBlobFromOptions& options = UploadBlockBlobFromOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Creates a new block blob, or updates the content of an existing block blob, from a
+     * stream of unknown length. Updating an existing block blob overwrites any existing metadata on
+     * the blob.
+     *
+     * @details The stream is read once, from its current position to its end, and doesn't need to
+     * be seekable, like the output of a pipe or a compressor. The blocks are staged while the next
+     * ones are read, and at most `TransferOptions.Concurrency` blocks of
+     * `TransferOptions.ChunkSize` bytes are held in memory at the same time.
+     *
+     * @remark Content shorter than `TransferOptions.ChunkSize` is uploaded with a single upload
+     * operation. `TransferOptions.SingleUploadThreshold` isn't used, since the length of the
+     * content isn't known before reading it. `TransferOptions.ChunkSize` defaults to 4 MiB, and a
+     * blob can have up to 50,000 blocks.
+     *
+     * @param content A BodyStream containing the content to upload.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A UploadBlockBlobFromResult describing the state of the updated block blob.
+     */
+    Azure::Response<Models::UploadBlockBlobFromResult> UploadFrom(
+        Azure::Core::IO::BodyStream& content,
+        const UploadBlockBlobFromOptions& options = UploadBlockBlobFromOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Creates a new Block Blob where the contents of the blob are read from a given URL.
      *
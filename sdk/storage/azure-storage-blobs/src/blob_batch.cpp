@@ -567,10 +567,10 @@ namespace Azure { namespace Storage { namespace Blobs {
 
   BlobClient BlobServiceBatch::GetBlobClientForSubrequest(Core::Url url) const
   {
-    auto blobClient = m_blobServiceClient.GetBlobContainerClient("$").GetBlobClient("$");
-    blobClient.m_blobUrl = std::move(url);
-    blobClient.m_pipeline = m_blobServiceClient.m_batchSubrequestPipeline;
-    return blobClient;
+    return BlobClient(
+        std::move(url),
+        m_blobServiceClient.m_batchSubrequestPipeline,
+        m_blobServiceClient.m_clientConfiguration);
   }
 
   DeferredResponse<Models::DeleteBlobResult> BlobServiceBatch::DeleteBlob(
@@ -638,10 +638,10 @@ namespace Azure { namespace Storage { namespace Blobs {
 
   BlobClient BlobContainerBatch::GetBlobClientForSubrequest(Core::Url url) const
   {
-    auto blobClient = m_blobContainerClient.GetBlobClient("$");
-    blobClient.m_blobUrl = std::move(url);
-    blobClient.m_pipeline = m_blobContainerClient.m_batchSubrequestPipeline;
-    return blobClient;
+    return BlobClient(
+        std::move(url),
+        m_blobContainerClient.m_batchSubrequestPipeline,
+        m_blobContainerClient.m_clientConfiguration);
   }
 
   DeferredResponse<Models::DeleteBlobResult> BlobContainerBatch::DeleteBlob(
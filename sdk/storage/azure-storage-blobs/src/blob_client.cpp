@@ -7,6 +7,7 @@
 #include "azure/storage/blobs/block_blob_client.hpp"
 #include "azure/storage/blobs/page_blob_client.hpp"
 #include "private/package_version.hpp"
+#include "private/transfer_checkpoint.hpp"
 
 #include <azure/core/azure_assert.hpp>
 #include <azure/core/http/policies/policy.hpp>
@@ -67,7 +68,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     pipelineOptions.SharedKeyAuthPolicy = std::make_unique<_internal::SharedKeyPolicy>(credential);
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlobClient::BlobClient(
@@ -90,11 +92,12 @@ namespace Azure { namespace Storage { namespace Blobs {
               : _internal::StorageScope);
       pipelineOptions.TokenAuthPolicy
           = std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-              credential, tokenContext, options.EnableTenantDiscovery);
+              credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefreshWindow);
     }
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlobClient::BlobClient(const std::string& blobUrl, const BlobClientOptions& options)
@@ -113,7 +116,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     pipelineOptions.ApiVersion = options.ApiVersion;
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlockBlobClient BlobClient::AsBlockBlobClient() const { return BlockBlobClient(*this); }
@@ -349,6 +353,20 @@ namespace Azure { namespace Storage { namespace Blobs {
     return downloadResponse;
   }
 
+  std::unique_ptr<BlobReadStream> BlobClient::OpenRead(
+      const OpenReadBlobOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    GetBlobPropertiesOptions getPropertiesOptions;
+    getPropertiesOptions.AccessConditions = options.AccessConditions;
+    auto properties = GetProperties(getPropertiesOptions, context);
+    return std::unique_ptr<BlobReadStream>(new BlobReadStream(
+        std::make_shared<BlobClient>(*this),
+        std::move(properties.Value.ETag),
+        properties.Value.BlobSize,
+        options));
+  }
+
   Azure::Response<Models::DownloadBlobToResult> BlobClient::DownloadTo(
       uint8_t* buffer,
       size_t bufferSize,
@@ -482,7 +500,52 @@ namespace Azure { namespace Storage { namespace Blobs {
     }
     firstChunkOptions.ValidationOptions = options.ValidationOptions;
 
-    auto firstChunk = Download(firstChunkOptions, context);
+    // The description of the checkpoint of a download ends with the ETag of the blob, so that a
+    // download only resumes if the blob wasn't modified since. The query of the URL is left out,
+    // so that a SAS token isn't written to the checkpoint.
+    std::unique_ptr<_detail::TransferCheckpoint> checkpoint;
+    std::string checkpointDescription;
+    if (options.CheckpointPath.HasValue())
+    {
+      checkpoint = std::make_unique<_detail::TransferCheckpoint>(options.CheckpointPath.Value());
+      checkpointDescription = "download " + m_blobUrl.GetHost() + "/" + m_blobUrl.GetPath() + " "
+          + std::to_string(firstChunkOffset) + " "
+          + (options.Range.HasValue() && options.Range.Value().Length.HasValue()
+                 ? std::to_string(options.Range.Value().Length.Value())
+                 : std::string("-"))
+          + " " + std::to_string(options.TransferOptions.InitialChunkSize) + " "
+          + std::to_string(options.TransferOptions.ChunkSize) + " " + fileName + " ";
+    }
+
+    auto firstChunk = [&]() {
+      const std::string previousDescription
+          = checkpoint ? checkpoint->GetDescription() : std::string();
+      if (previousDescription.length() > checkpointDescription.length()
+          && previousDescription.compare(0, checkpointDescription.length(), checkpointDescription)
+              == 0)
+      {
+        // A byte of the blob is enough to get its properties when resuming a download.
+        DownloadBlobOptions resumeOptions;
+        resumeOptions.Range = Core::Http::HttpRange();
+        resumeOptions.Range.Value().Offset = firstChunkOffset;
+        resumeOptions.Range.Value().Length = 1;
+        resumeOptions.AccessConditions.IfMatch
+            = Azure::ETag(previousDescription.substr(checkpointDescription.length()));
+        try
+        {
+          return Download(resumeOptions, context);
+        }
+        catch (StorageException& e)
+        {
+          if (e.StatusCode != Azure::Core::Http::HttpStatusCode::PreconditionFailed
+              && e.StatusCode != Azure::Core::Http::HttpStatusCode::RangeNotSatisfiable)
+          {
+            throw;
+          }
+        }
+      }
+      return Download(firstChunkOptions, context);
+    }();
     const Azure::ETag eTag = firstChunk.Value.Details.ETag;
 
     const int64_t blobSize = firstChunk.Value.BlobSize;
@@ -501,10 +564,15 @@ namespace Azure { namespace Storage { namespace Blobs {
     }
     firstChunkLength = (std::min)(firstChunkLength, blobRangeSize);
 
+    // The checkpoint is resumed if the blob still has its ETag. Then the first chunk downloaded
+    // was a single byte.
+    const bool resume = checkpoint && checkpoint->Open(checkpointDescription + eTag.ToString());
+
     auto bodyStreamToFile = [](Azure::Core::IO::BodyStream& stream,
                                _internal::FileWriter& fileWriter,
                                int64_t offset,
                                int64_t length,
+                               Crc64Hash* crc64,
                                const Azure::Core::Context& context) {
       constexpr size_t bufferSize = 4 * 1024 * 1024;
       std::vector<uint8_t> buffer(bufferSize);
@@ -517,13 +585,35 @@ namespace Azure { namespace Storage { namespace Blobs {
           throw Azure::Core::RequestFailedException("Error when reading body stream.");
         }
         fileWriter.Write(buffer.data(), bytesRead, offset);
+        if (crc64 != nullptr)
+        {
+          crc64->Append(buffer.data(), bytesRead);
+        }
         length -= bytesRead;
         offset += bytesRead;
       }
     };
 
-    _internal::FileWriter fileWriter(fileName);
-    bodyStreamToFile(*(firstChunk.Value.BodyStream), fileWriter, 0, firstChunkLength, context);
+    _internal::FileWriter fileWriter(fileName, !resume);
+    if (resume)
+    {
+      // The file can have been written past the range since the download was interrupted.
+      fileWriter.SetSize(blobRangeSize);
+    }
+
+    auto writeChunk = [&](Azure::Core::IO::BodyStream& stream, int64_t offset, int64_t length) {
+      Crc64Hash crc64;
+      bodyStreamToFile(stream, fileWriter, offset, length, checkpoint ? &crc64 : nullptr, context);
+      if (checkpoint)
+      {
+        checkpoint->AddChunk(offset, crc64.Final());
+      }
+    };
+
+    if (!resume)
+    {
+      writeChunk(*(firstChunk.Value.BodyStream), 0, firstChunkLength);
+    }
     firstChunk.Value.BodyStream.reset();
 
     auto returnTypeConverter = [](Azure::Response<Models::DownloadBlobResult>& response) {
@@ -541,6 +631,15 @@ namespace Azure { namespace Storage { namespace Blobs {
     // Keep downloading the remaining in parallel
     auto downloadChunkFunc
         = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
+            // The chunks written by the download resumed are checked against the checkpoint.
+            if (resume
+                && checkpoint->HasChunk(
+                    offset - firstChunkOffset,
+                    _detail::GetFileCrc64(
+                        fileWriter.GetHandle(), offset - firstChunkOffset, length, context)))
+            {
+              return;
+            }
             DownloadBlobOptions chunkOptions;
             chunkOptions.Range = Core::Http::HttpRange();
             chunkOptions.Range.Value().Offset = offset;
@@ -548,12 +647,10 @@ namespace Azure { namespace Storage { namespace Blobs {
             chunkOptions.AccessConditions.IfMatch = eTag;
             chunkOptions.ValidationOptions = options.ValidationOptions;
             auto chunk = Download(chunkOptions, context);
-            bodyStreamToFile(
+            writeChunk(
                 *(chunk.Value.BodyStream),
-                fileWriter,
                 offset - firstChunkOffset,
-                chunkOptions.Range.Value().Length.Value(),
-                context);
+                chunkOptions.Range.Value().Length.Value());
 
             if (chunkId == numChunks - 1)
             {
@@ -562,6 +659,12 @@ namespace Azure { namespace Storage { namespace Blobs {
             }
           };
 
+    if (resume)
+    {
+      ret.Value.TransactionalContentHash.Reset();
+      downloadChunkFunc(firstChunkOffset, firstChunkLength, 0, 1);
+    }
+
     int64_t remainingOffset = firstChunkOffset + firstChunkLength;
     int64_t remainingSize = blobRangeSize - firstChunkLength;
 
@@ -571,6 +674,10 @@ namespace Azure { namespace Storage { namespace Blobs {
         options.TransferOptions.ChunkSize,
         options.TransferOptions.Concurrency,
         downloadChunkFunc);
+    if (checkpoint)
+    {
+      checkpoint->Remove();
+    }
     ret.Value.ContentRange.Offset = firstChunkOffset;
     ret.Value.ContentRange.Length = blobRangeSize;
     return ret;
@@ -1270,7 +1270,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     pipelineOptions.SharedKeyAuthPolicy = std::move(sharedKeyAuthPolicy);
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlobContainerClient::BlobContainerClient(
@@ -1292,7 +1293,7 @@ namespace Azure { namespace Storage { namespace Blobs {
               ? _internal::GetDefaultScopeForAudience(options.Audience.Value().ToString())
               : _internal::StorageScope);
       tokenAuthPolicy = std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-          credential, tokenContext, options.EnableTenantDiscovery);
+          credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefreshWindow);
       perRetryPolicies.emplace_back(tokenAuthPolicy->Clone());
     }
     perOperationPolicies.emplace_back(
@@ -1313,7 +1314,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     pipelineOptions.TokenAuthPolicy = std::move(tokenAuthPolicy);
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlobContainerClient::BlobContainerClient(
@@ -1347,7 +1349,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     pipelineOptions.ApiVersion = options.ApiVersion;
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlobClient BlobContainerClient::GetBlobClient(const std::string& blobName) const
@@ -0,0 +1,597 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/blobs/blob_container_client.hpp"
+
+#include "azure/storage/blobs/block_blob_client.hpp"
+
+#include <azure/core/base64.hpp>
+#include <azure/core/io/body_stream.hpp>
+#include <azure/core/platform.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
+#include <azure/storage/common/transfer_executor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs {
+
+  namespace {
+    // Spreads the bytes transferred by the threads sharing it so that they don't exceed a rate on
+    // average. A transfer can start once the ones before it would be done at that rate.
+    class BandwidthThrottle final {
+    public:
+      explicit BandwidthThrottle(int64_t maxBytesPerSecond)
+          : m_maxBytesPerSecond(maxBytesPerSecond), m_nextStart(std::chrono::steady_clock::now())
+      {
+        if (maxBytesPerSecond <= 0)
+        {
+          throw std::invalid_argument("MaxBytesPerSecond must be positive.");
+        }
+      }
+
+      void Acquire(int64_t length, const Azure::Core::Context& context)
+      {
+        // The bandwidth left unused for up to a second is used by the next transfers.
+        constexpr std::chrono::seconds MaxBurst(1);
+        const std::chrono::duration<double> duration(
+            static_cast<double>(length) / static_cast<double>(m_maxBytesPerSecond));
+        std::chrono::steady_clock::time_point start;
+        {
+          std::lock_guard<std::mutex> guard(m_mutex);
+          start = (std::max)(m_nextStart, std::chrono::steady_clock::now() - MaxBurst);
+          m_nextStart
+              = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration);
+        }
+        while (std::chrono::steady_clock::now() < start)
+        {
+          context.ThrowIfCancelled();
+          std::this_thread::sleep_until(
+              (std::min)(start, std::chrono::steady_clock::now() + std::chrono::milliseconds(100)));
+        }
+      }
+
+    private:
+      const int64_t m_maxBytesPerSecond;
+      std::mutex m_mutex;
+      std::chrono::steady_clock::time_point m_nextStart;
+    };
+
+    // The names of the files or blobs transferred, one per line, appended to a file as they are
+    // transferred. The last line of the journal of an interrupted transfer can be cut, so it's
+    // ignored unless it ends with a newline.
+    class TransferJournal final {
+    public:
+      explicit TransferJournal(const std::string& path)
+      {
+        bool isLastLineCut = false;
+        {
+          std::ifstream file(path, std::ios::binary);
+          std::string name;
+          while (std::getline(file, name))
+          {
+            if (file.eof())
+            {
+              isLastLineCut = true;
+              break;
+            }
+            m_names.insert(std::move(name));
+          }
+        }
+        m_file.open(path, std::ios::binary | std::ios::app);
+        if (!m_file)
+        {
+          throw std::runtime_error("Failed to open journal.");
+        }
+        if (isLastLineCut)
+        {
+          m_file << '\n';
+        }
+      }
+
+      bool Contains(const std::string& name) const { return m_names.count(name) != 0; }
+
+      // The names with a newline are transferred again by the next transfer.
+      void Add(const std::string& name)
+      {
+        if (name.find('\n') != std::string::npos)
+        {
+          return;
+        }
+        std::lock_guard<std::mutex> guard(m_mutex);
+        // Flushed, so that the file isn't transferred again after the process is interrupted.
+        m_file << name << '\n';
+        m_file.flush();
+        if (!m_file)
+        {
+          throw std::runtime_error("Failed to write journal.");
+        }
+      }
+
+    private:
+      std::unordered_set<std::string> m_names;
+      std::mutex m_mutex;
+      std::ofstream m_file;
+    };
+
+    // Runs the transfers of files, blobs or chunks of them on the TransferExecutor, up to a number
+    // at a time, while the calling thread lists the next ones.
+    class DirectoryTransferScheduler final {
+    public:
+      explicit DirectoryTransferScheduler(int32_t concurrency)
+          : m_state(std::make_shared<State>()), m_concurrency((std::max)(concurrency, 1))
+      {
+      }
+
+      // The transfers capture the variables of the calling function.
+      ~DirectoryTransferScheduler()
+      {
+        std::unique_lock<std::mutex> guard(m_state->Mutex);
+        m_state->TransferDone.wait(guard, [this]() { return m_state->RunningTransfers == 0; });
+      }
+
+      // Waits for a transfer to be done if there are too many running, or throws the first
+      // failure once they are all done.
+      void Submit(std::function<void()> transferFunc)
+      {
+        std::unique_lock<std::mutex> guard(m_state->Mutex);
+        m_state->TransferDone.wait(guard, [this]() {
+          return m_state->RunningTransfers < m_concurrency || m_state->Failure != nullptr;
+        });
+        if (m_state->Failure != nullptr)
+        {
+          guard.unlock();
+          Wait();
+          return;
+        }
+        ++m_state->RunningTransfers;
+        guard.unlock();
+
+        auto state = m_state;
+        auto transfer = [state, transferFunc]() {
+          std::exception_ptr failure;
+          try
+          {
+            transferFunc();
+          }
+          catch (...)
+          {
+            failure = std::current_exception();
+          }
+          {
+            std::lock_guard<std::mutex> guard(state->Mutex);
+            if (failure != nullptr && state->Failure == nullptr)
+            {
+              state->Failure = failure;
+            }
+            --state->RunningTransfers;
+          }
+          state->TransferDone.notify_all();
+        };
+        try
+        {
+          GetTransferExecutor()->Execute(transfer);
+        }
+        catch (...)
+        {
+          transfer();
+        }
+      }
+
+      // Waits for all the transfers to be done, and throws the first failure.
+      void Wait()
+      {
+        std::unique_lock<std::mutex> guard(m_state->Mutex);
+        m_state->TransferDone.wait(guard, [this]() { return m_state->RunningTransfers == 0; });
+        if (m_state->Failure != nullptr)
+        {
+          std::rethrow_exception(m_state->Failure);
+        }
+      }
+
+    private:
+      struct State final
+      {
+        std::mutex Mutex;
+        std::condition_variable TransferDone;
+        int32_t RunningTransfers = 0;
+        std::exception_ptr Failure;
+      };
+
+      std::shared_ptr<State> m_state;
+      const int32_t m_concurrency;
+    };
+
+    // The ID of the block of a chunk, like the ones of BlockBlobClient::UploadFrom().
+    std::string GetBlockId(int64_t chunkId)
+    {
+      constexpr size_t BlockIdLength = 64;
+      std::string blockId = std::to_string(chunkId);
+      blockId = std::string(BlockIdLength - blockId.length(), '0') + blockId;
+      return Azure::Core::Convert::Base64Encode(
+          std::vector<uint8_t>(blockId.begin(), blockId.end()));
+    }
+
+    // The chunk size of BlockBlobClient::UploadFrom() for a file.
+    int64_t GetUploadChunkSize(const Azure::Nullable<int64_t>& chunkSize, int64_t fileSize)
+    {
+      constexpr int64_t DefaultStageBlockSize = 4 * 1024 * 1024ULL;
+      constexpr int64_t MaxStageBlockSize = 4000 * 1024 * 1024ULL;
+      constexpr int64_t MaxBlockNumber = 50000;
+      constexpr int64_t BlockGrainSize = 1 * 1024 * 1024;
+
+      int64_t ret;
+      if (chunkSize.HasValue())
+      {
+        ret = chunkSize.Value();
+      }
+      else
+      {
+        int64_t minChunkSize = (fileSize + MaxBlockNumber - 1) / MaxBlockNumber;
+        minChunkSize = (minChunkSize + BlockGrainSize - 1) / BlockGrainSize * BlockGrainSize;
+        ret = (std::max)(DefaultStageBlockSize, minChunkSize);
+      }
+      if (ret > MaxStageBlockSize)
+      {
+        throw Azure::Core::RequestFailedException("Block size is too big.");
+      }
+      return ret;
+    }
+
+    void BodyStreamToFile(
+        Azure::Core::IO::BodyStream& stream,
+        _internal::FileWriter& fileWriter,
+        int64_t offset,
+        int64_t length,
+        const Azure::Core::Context& context)
+    {
+      constexpr size_t BufferSize = 4 * 1024 * 1024;
+      std::vector<uint8_t> buffer(static_cast<size_t>(std::min<int64_t>(BufferSize, length)));
+      while (length > 0)
+      {
+        const size_t readSize = static_cast<size_t>(std::min<int64_t>(BufferSize, length));
+        const size_t bytesRead = stream.ReadToCount(buffer.data(), readSize, context);
+        if (bytesRead != readSize)
+        {
+          throw Azure::Core::RequestFailedException("Error when reading body stream.");
+        }
+        fileWriter.Write(buffer.data(), bytesRead, offset);
+        length -= bytesRead;
+        offset += bytesRead;
+      }
+    }
+
+    // A file or blob transferred in chunks. The transfer of the last chunk closes the file.
+    template <class FileType> struct ChunkedTransfer final
+    {
+      std::unique_ptr<FileType> File;
+      std::atomic<int64_t> ChunksLeft;
+
+      ChunkedTransfer(std::unique_ptr<FileType> file, int64_t numChunks)
+          : File(std::move(file)), ChunksLeft(numChunks)
+      {
+      }
+    };
+
+    std::string GetDirectoryBlobNamePrefix(const std::string& blobNamePrefix)
+    {
+      if (blobNamePrefix.empty() || blobNamePrefix.back() == '/')
+      {
+        return blobNamePrefix;
+      }
+      return blobNamePrefix + "/";
+    }
+
+    // Whether a blob name relative to the prefix is the path of a file in the directory.
+    bool IsValidRelativePath(const std::string& relativePath)
+    {
+#if defined(AZ_PLATFORM_WINDOWS)
+      if (relativePath.find_first_of(std::string("\\:\0", 3)) != std::string::npos)
+#else
+      if (relativePath.find('\0') != std::string::npos)
+#endif
+      {
+        return false;
+      }
+      size_t segmentStart = 0;
+      while (true)
+      {
+        const size_t segmentEnd
+            = (std::min)(relativePath.find('/', segmentStart), relativePath.size());
+        const std::string segment = relativePath.substr(segmentStart, segmentEnd - segmentStart);
+        if (segment.empty() || segment == "." || segment == "..")
+        {
+          return false;
+        }
+        if (segmentEnd == relativePath.size())
+        {
+          return true;
+        }
+        segmentStart = segmentEnd + 1;
+      }
+    }
+  } // namespace
+
+  Models::UploadBlobDirectoryResult BlobContainerClient::UploadDirectory(
+      const std::string& sourceDirectory,
+      const std::string& blobNamePrefix,
+      const UploadBlobDirectoryOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    // Otherwise files would be split in no chunks, and skipped.
+    if (options.TransferOptions.SingleUploadThreshold <= 0)
+    {
+      throw std::invalid_argument("SingleUploadThreshold must be positive.");
+    }
+    if (options.TransferOptions.ChunkSize.HasValue()
+        && options.TransferOptions.ChunkSize.Value() <= 0)
+    {
+      throw std::invalid_argument("ChunkSize must be positive.");
+    }
+    std::unique_ptr<TransferJournal> journal;
+    if (options.JournalPath.HasValue())
+    {
+      journal = std::make_unique<TransferJournal>(options.JournalPath.Value());
+    }
+    std::unique_ptr<BandwidthThrottle> throttle;
+    if (options.TransferOptions.MaxBytesPerSecond.HasValue())
+    {
+      throttle
+          = std::make_unique<BandwidthThrottle>(options.TransferOptions.MaxBytesPerSecond.Value());
+    }
+
+    // Each transfer sends a single request, so that the concurrency bounds the requests of all the
+    // files, and the bandwidth is shared out chunk by chunk. The larger files are staged in chunks
+    // on the scheduler, and the transfer of the last one commits them.
+    UploadBlockBlobFromOptions uploadOptions;
+    uploadOptions.AccessTier = options.AccessTier;
+    uploadOptions.TransferOptions.SingleUploadThreshold
+        = options.TransferOptions.SingleUploadThreshold;
+    uploadOptions.TransferOptions.Concurrency = 1;
+    uploadOptions.ValidationOptions = options.ValidationOptions;
+
+    const std::string prefix = GetDirectoryBlobNamePrefix(blobNamePrefix);
+    std::atomic<int64_t> numberOfFilesUploaded{0};
+    std::atomic<int64_t> bytesUploaded{0};
+    Models::UploadBlobDirectoryResult ret;
+
+    auto onFileUploaded = [&](const std::string& relativePath, int64_t fileSize) {
+      ++numberOfFilesUploaded;
+      bytesUploaded += fileSize;
+      if (journal)
+      {
+        journal->Add(relativePath);
+      }
+    };
+
+    DirectoryTransferScheduler scheduler(options.TransferOptions.Concurrency);
+    _internal::ForEachFile(
+        sourceDirectory, [&](const std::string& relativePath, int64_t fileSize) {
+          context.ThrowIfCancelled();
+          if (journal && journal->Contains(relativePath))
+          {
+            ++ret.NumberOfFilesSkipped;
+            return;
+          }
+          const int64_t chunkSize = GetUploadChunkSize(options.TransferOptions.ChunkSize, fileSize);
+          if (fileSize <= options.TransferOptions.SingleUploadThreshold
+              && (!throttle || fileSize <= chunkSize))
+          {
+            scheduler.Submit([&, relativePath, fileSize]() {
+              if (throttle)
+              {
+                throttle->Acquire(fileSize, context);
+              }
+              GetBlockBlobClient(prefix + relativePath)
+                  .UploadFrom(sourceDirectory + "/" + relativePath, uploadOptions, context);
+              onFileUploaded(relativePath, fileSize);
+            });
+            return;
+          }
+
+          const int64_t numChunks = (fileSize + chunkSize - 1) / chunkSize;
+          auto transfer = std::make_shared<ChunkedTransfer<_internal::FileReader>>(
+              std::make_unique<_internal::FileReader>(sourceDirectory + "/" + relativePath),
+              numChunks);
+          for (int64_t chunkId = 0; chunkId < numChunks; ++chunkId)
+          {
+            scheduler.Submit(
+                [&, transfer, relativePath, fileSize, chunkSize, chunkId, numChunks]() {
+                  const int64_t offset = chunkId * chunkSize;
+                  const int64_t length = (std::min)(chunkSize, fileSize - offset);
+                  if (throttle)
+                  {
+                    throttle->Acquire(length, context);
+                  }
+                  auto blockBlobClient = GetBlockBlobClient(prefix + relativePath);
+                  Azure::Core::IO::_internal::RandomAccessFileBodyStream contentStream(
+                      transfer->File->GetHandle(), offset, length);
+                  StageBlockOptions stageBlockOptions;
+                  stageBlockOptions.ValidationOptions = options.ValidationOptions;
+                  blockBlobClient.StageBlock(
+                      GetBlockId(chunkId), contentStream, stageBlockOptions, context);
+                  if (--transfer->ChunksLeft != 0)
+                  {
+                    return;
+                  }
+                  transfer->File.reset();
+                  std::vector<std::string> blockIds;
+                  for (int64_t i = 0; i < numChunks; ++i)
+                  {
+                    blockIds.push_back(GetBlockId(i));
+                  }
+                  CommitBlockListOptions commitBlockListOptions;
+                  commitBlockListOptions.AccessTier = options.AccessTier;
+                  blockBlobClient.CommitBlockList(blockIds, commitBlockListOptions, context);
+                  onFileUploaded(relativePath, fileSize);
+                });
+          }
+        });
+    scheduler.Wait();
+
+    ret.NumberOfFilesUploaded = numberOfFilesUploaded;
+    ret.BytesUploaded = bytesUploaded;
+    return ret;
+  }
+
+  Models::DownloadBlobDirectoryResult BlobContainerClient::DownloadDirectory(
+      const std::string& blobNamePrefix,
+      const std::string& destinationDirectory,
+      const DownloadBlobDirectoryOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    // Otherwise blobs would be split in no chunks, and skipped.
+    if (options.TransferOptions.InitialChunkSize <= 0)
+    {
+      throw std::invalid_argument("InitialChunkSize must be positive.");
+    }
+    if (options.TransferOptions.ChunkSize <= 0)
+    {
+      throw std::invalid_argument("ChunkSize must be positive.");
+    }
+    std::unique_ptr<TransferJournal> journal;
+    if (options.JournalPath.HasValue())
+    {
+      journal = std::make_unique<TransferJournal>(options.JournalPath.Value());
+    }
+    std::unique_ptr<BandwidthThrottle> throttle;
+    if (options.TransferOptions.MaxBytesPerSecond.HasValue())
+    {
+      throttle
+          = std::make_unique<BandwidthThrottle>(options.TransferOptions.MaxBytesPerSecond.Value());
+    }
+
+    // Each transfer sends a single request, like the ones of UploadDirectory(). The larger blobs
+    // are downloaded in chunks on the scheduler, from the version of the blob listed.
+    DownloadBlobToOptions downloadOptions;
+    downloadOptions.TransferOptions.InitialChunkSize = options.TransferOptions.InitialChunkSize;
+    downloadOptions.TransferOptions.Concurrency = 1;
+    downloadOptions.ValidationOptions = options.ValidationOptions;
+    const int64_t chunkSize = options.TransferOptions.ChunkSize;
+
+    _internal::CreateDirectories(destinationDirectory);
+    // The subdirectories created, so that the directory of each blob isn't created again.
+    std::mutex directoriesMutex;
+    std::unordered_set<std::string> directories;
+    auto createDirectoryOf = [&](const std::string& relativePath) {
+      const auto separator = relativePath.rfind('/');
+      if (separator != std::string::npos)
+      {
+        const std::string directory = relativePath.substr(0, separator);
+        std::lock_guard<std::mutex> guard(directoriesMutex);
+        if (directories.count(directory) == 0)
+        {
+          _internal::CreateDirectories(destinationDirectory + "/" + directory);
+          directories.insert(directory);
+        }
+      }
+    };
+
+    const std::string prefix = GetDirectoryBlobNamePrefix(blobNamePrefix);
+    std::atomic<int64_t> numberOfBlobsDownloaded{0};
+    std::atomic<int64_t> bytesDownloaded{0};
+    Models::DownloadBlobDirectoryResult ret;
+
+    auto onBlobDownloaded = [&](const std::string& relativePath, int64_t blobSize) {
+      ++numberOfBlobsDownloaded;
+      bytesDownloaded += blobSize;
+      if (journal)
+      {
+        journal->Add(relativePath);
+      }
+    };
+
+    ListBlobsOptions listOptions;
+    listOptions.Prefix = prefix;
+    DirectoryTransferScheduler scheduler(options.TransferOptions.Concurrency);
+    for (auto page = ListBlobs(listOptions, context); page.HasPage(); page.MoveToNextPage(context))
+    {
+      for (auto& blob : page.Blobs)
+      {
+        std::string relativePath = blob.Name.substr(prefix.length());
+        if (!relativePath.empty() && relativePath.back() == '/' && blob.BlobSize == 0)
+        {
+          // A placeholder for a directory.
+          continue;
+        }
+        if (!IsValidRelativePath(relativePath))
+        {
+          ret.UnsupportedBlobNames.push_back(std::move(blob.Name));
+          continue;
+        }
+        if (journal && journal->Contains(relativePath))
+        {
+          ++ret.NumberOfBlobsSkipped;
+          continue;
+        }
+
+        const int64_t blobSize = blob.BlobSize;
+        if (blobSize <= options.TransferOptions.InitialChunkSize
+            && (!throttle || blobSize <= chunkSize))
+        {
+          scheduler.Submit([&, blobName = std::move(blob.Name), relativePath, blobSize]() {
+            createDirectoryOf(relativePath);
+            if (throttle)
+            {
+              throttle->Acquire(blobSize, context);
+            }
+            GetBlobClient(blobName).DownloadTo(
+                destinationDirectory + "/" + relativePath, downloadOptions, context);
+            onBlobDownloaded(relativePath, blobSize);
+          });
+          continue;
+        }
+
+        createDirectoryOf(relativePath);
+        const int64_t numChunks = (blobSize + chunkSize - 1) / chunkSize;
+        auto transfer = std::make_shared<ChunkedTransfer<_internal::FileWriter>>(
+            std::make_unique<_internal::FileWriter>(destinationDirectory + "/" + relativePath),
+            numChunks);
+        const Azure::ETag eTag = blob.Details.ETag;
+        for (int64_t chunkId = 0; chunkId < numChunks; ++chunkId)
+        {
+          scheduler.Submit(
+              [&, transfer, blobName = blob.Name, relativePath, blobSize, eTag, chunkId]() {
+                const int64_t offset = chunkId * chunkSize;
+                const int64_t length = (std::min)(chunkSize, blobSize - offset);
+                if (throttle)
+                {
+                  throttle->Acquire(length, context);
+                }
+                DownloadBlobOptions chunkOptions;
+                chunkOptions.Range = Core::Http::HttpRange();
+                chunkOptions.Range.Value().Offset = offset;
+                chunkOptions.Range.Value().Length = length;
+                chunkOptions.AccessConditions.IfMatch = eTag;
+                chunkOptions.ValidationOptions = options.ValidationOptions;
+                auto response = GetBlobClient(blobName).Download(chunkOptions, context);
+                BodyStreamToFile(
+                    *response.Value.BodyStream, *transfer->File, offset, length, context);
+                if (--transfer->ChunksLeft != 0)
+                {
+                  return;
+                }
+                transfer->File.reset();
+                onBlobDownloaded(relativePath, blobSize);
+              });
+        }
+      }
+    }
+    scheduler.Wait();
+
+    ret.NumberOfBlobsDownloaded = numberOfBlobsDownloaded;
+    ret.BytesDownloaded = bytesDownloaded;
+    return ret;
+  }
+
+}}} // namespace Azure::Storage::Blobs
@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/blobs/blob_read_stream.hpp"
+
+#include "azure/storage/blobs/blob_client.hpp"
+
+#include <azure/storage/common/transfer_executor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+
+namespace Azure { namespace Storage { namespace Blobs {
+
+  BlobReadStream::BlobReadStream(
+      std::shared_ptr<const BlobClient> blobClient,
+      Azure::ETag eTag,
+      int64_t blobSize,
+      const OpenReadBlobOptions& options)
+      : m_blobClient(std::move(blobClient)), m_eTag(std::move(eTag)), m_blobSize(blobSize),
+        m_options(options)
+  {
+    if (m_options.TransferOptions.ChunkSize <= 0)
+    {
+      throw Azure::Core::RequestFailedException("Block size must be positive.");
+    }
+    m_options.TransferOptions.Concurrency = (std::max)(m_options.TransferOptions.Concurrency, 0);
+    // The block being read and the blocks downloaded ahead of it are always kept.
+    m_maxCachedBlocks = static_cast<size_t>((std::max)(
+        m_options.TransferOptions.MaxCachedChunks, m_options.TransferOptions.Concurrency + 1));
+  }
+
+  BlobReadStream::~BlobReadStream() = default;
+
+  void BlobReadStream::Seek(int64_t offset)
+  {
+    if (offset < 0 || offset > m_blobSize)
+    {
+      throw std::out_of_range(
+          "Offset " + std::to_string(offset) + " is out of the blob of size "
+          + std::to_string(m_blobSize) + ".");
+    }
+    m_position = offset;
+  }
+
+  struct BlobReadStream::BlockDownload final
+  {
+    std::packaged_task<std::vector<uint8_t>()> Task;
+    std::shared_future<std::vector<uint8_t>> Content;
+    std::atomic<bool> IsStarted{false};
+
+    explicit BlockDownload(std::packaged_task<std::vector<uint8_t>()> task)
+        : Task(std::move(task)), Content(Task.get_future().share())
+    {
+    }
+
+    // Downloads the block, unless another thread already started it.
+    void Run()
+    {
+      if (!IsStarted.exchange(true))
+      {
+        Task();
+      }
+    }
+  };
+
+  std::shared_ptr<BlobReadStream::BlockDownload> BlobReadStream::CreateBlockDownload(
+      int64_t blockIndex,
+      const Azure::Core::Context& context) const
+  {
+    const int64_t offset = blockIndex * m_options.TransferOptions.ChunkSize;
+    const int64_t length = (std::min)(m_options.TransferOptions.ChunkSize, m_blobSize - offset);
+
+    DownloadBlobOptions downloadOptions;
+    downloadOptions.Range = Core::Http::HttpRange();
+    downloadOptions.Range.Value().Offset = offset;
+    downloadOptions.Range.Value().Length = length;
+    downloadOptions.AccessConditions.IfMatch = m_eTag;
+    downloadOptions.AccessConditions.LeaseId = m_options.AccessConditions.LeaseId;
+    downloadOptions.ValidationOptions = m_options.ValidationOptions;
+
+    auto blobClient = m_blobClient;
+    return std::make_shared<BlockDownload>(std::packaged_task<std::vector<uint8_t>()>(
+        [blobClient, downloadOptions, length, context]() {
+          auto response = blobClient->Download(downloadOptions, context);
+          std::vector<uint8_t> content(static_cast<size_t>(length));
+          const auto bytesRead = response.Value.BodyStream->ReadToCount(
+              content.data(), content.size(), context);
+          if (bytesRead != content.size())
+          {
+            throw Azure::Core::RequestFailedException("Error when reading body stream.");
+          }
+          return content;
+        }));
+  }
+
+  std::shared_ptr<BlobReadStream::BlockDownload> BlobReadStream::PrefetchBlock(
+      int64_t blockIndex,
+      const Azure::Core::Context& context) const
+  {
+    auto download = CreateBlockDownload(blockIndex, context);
+    // The task doesn't keep the block: a block dropped before the executor runs the task isn't
+    // downloaded. A block the executor can't take is downloaded by the read needing it.
+    std::weak_ptr<BlockDownload> weakDownload = download;
+    try
+    {
+      GetTransferExecutor()->Execute([weakDownload]() {
+        if (auto lockedDownload = weakDownload.lock())
+        {
+          lockedDownload->Run();
+        }
+      });
+    }
+    catch (...)
+    {
+    }
+    return download;
+  }
+
+  std::list<BlobReadStream::CachedBlock>::iterator BlobReadStream::FindBlock(int64_t blockIndex)
+  {
+    return std::find_if(m_blocks.begin(), m_blocks.end(), [blockIndex](const CachedBlock& block) {
+      return block.Index == blockIndex;
+    });
+  }
+
+  size_t BlobReadStream::OnRead(
+      uint8_t* buffer,
+      size_t count,
+      Azure::Core::Context const& context)
+  {
+    if (count == 0 || m_position >= m_blobSize)
+    {
+      return 0;
+    }
+
+    const int64_t chunkSize = m_options.TransferOptions.ChunkSize;
+    const int64_t blockIndex = m_position / chunkSize;
+    const int64_t numBlocks = (m_blobSize + chunkSize - 1) / chunkSize;
+
+    // Download the blocks after this one ahead of sequential reads. They are moved to the front
+    // before this block, the nearest last, so that the blocks dropped are the ones read before.
+    if (m_position == m_lastReadEnd)
+    {
+      const int64_t lastPrefetchedBlock
+          = (std::min)(blockIndex + m_options.TransferOptions.Concurrency, numBlocks - 1);
+      for (int64_t i = lastPrefetchedBlock; i > blockIndex; --i)
+      {
+        auto block = FindBlock(i);
+        if (block == m_blocks.end())
+        {
+          m_blocks.push_front(CachedBlock{i, PrefetchBlock(i, context)});
+        }
+        else
+        {
+          m_blocks.splice(m_blocks.begin(), m_blocks, block);
+        }
+      }
+    }
+
+    // The block is downloaded on this thread, like the first chunk of a concurrent transfer, so
+    // that the read doesn't wait behind the other transfers of the executor, or for a thread of
+    // the executor it may be running on. A block downloaded ahead and not started yet is
+    // downloaded on this thread too.
+    auto block = FindBlock(blockIndex);
+    const bool isCached = block != m_blocks.end();
+    if (!isCached)
+    {
+      m_blocks.push_front(CachedBlock{blockIndex, CreateBlockDownload(blockIndex, context)});
+    }
+    else
+    {
+      m_blocks.splice(m_blocks.begin(), m_blocks, block);
+    }
+    while (m_blocks.size() > m_maxCachedBlocks)
+    {
+      m_blocks.pop_back();
+    }
+
+    const std::vector<uint8_t>* content = nullptr;
+    try
+    {
+      m_blocks.front().Download->Run();
+      content = &m_blocks.front().Download->Content.get();
+    }
+    catch (...)
+    {
+      if (!isCached)
+      {
+        m_blocks.pop_front();
+        throw;
+      }
+      // A block downloaded ahead can have failed with the context of an earlier read, download it
+      // again with this one.
+      m_blocks.front().Download = CreateBlockDownload(blockIndex, context);
+      try
+      {
+        m_blocks.front().Download->Run();
+        content = &m_blocks.front().Download->Content.get();
+      }
+      catch (...)
+      {
+        m_blocks.pop_front();
+        throw;
+      }
+    }
+
+    const auto blockOffset = static_cast<size_t>(m_position - blockIndex * chunkSize);
+    const size_t bytesRead = (std::min)(count, content->size() - blockOffset);
+    std::memcpy(buffer, content->data() + blockOffset, bytesRead);
+    m_position += static_cast<int64_t>(bytesRead);
+    m_lastReadEnd = m_position;
+    return bytesRead;
+  }
+
+}}} // namespace Azure::Storage::Blobs
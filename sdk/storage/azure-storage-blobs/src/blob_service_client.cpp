@@ -70,7 +70,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     pipelineOptions.SharedKeyAuthPolicy = std::move(sharedKeyPolicy);
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlobServiceClient::BlobServiceClient(
@@ -92,7 +93,7 @@ namespace Azure { namespace Storage { namespace Blobs {
               ? _internal::GetDefaultScopeForAudience(options.Audience.Value().ToString())
               : _internal::StorageScope);
       tokenAuthPolicy = std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-          credential, tokenContext, options.EnableTenantDiscovery);
+          credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefreshWindow);
       perRetryPolicies.emplace_back(tokenAuthPolicy->Clone());
     }
     perOperationPolicies.emplace_back(
@@ -113,7 +114,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     pipelineOptions.TokenAuthPolicy = std::move(tokenAuthPolicy);
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlobServiceClient::BlobServiceClient(
@@ -147,7 +149,8 @@ namespace Azure { namespace Storage { namespace Blobs {
     pipelineOptions.ApiVersion = options.ApiVersion;
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   BlobContainerClient BlobServiceClient::GetBlobContainerClient(
@@ -156,12 +159,12 @@ namespace Azure { namespace Storage { namespace Blobs {
     auto blobContainerUrl = m_serviceUrl;
     blobContainerUrl.AppendPath(_internal::UrlEncodePath(blobContainerName));
 
-    BlobContainerClient blobContainerClient(blobContainerUrl.GetAbsoluteUrl());
-    blobContainerClient.m_pipeline = m_pipeline;
-    blobContainerClient.m_clientConfiguration = m_clientConfiguration;
-    blobContainerClient.m_batchRequestPipeline = m_batchRequestPipeline;
-    blobContainerClient.m_batchSubrequestPipeline = m_batchSubrequestPipeline;
-    return blobContainerClient;
+    return BlobContainerClient(
+        std::move(blobContainerUrl),
+        m_pipeline,
+        m_clientConfiguration,
+        m_batchRequestPipeline,
+        m_batchSubrequestPipeline);
   }
 
   ListBlobContainersPagedResponse BlobServiceClient::ListBlobContainers(
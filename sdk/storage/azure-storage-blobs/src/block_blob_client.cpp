@@ -16,6 +16,7 @@
 #endif
 
 #include "private/avro_parser.hpp"
+#include "private/transfer_checkpoint.hpp"
 
 #include <azure/core/io/body_stream.hpp>
 #include <azure/storage/common/crypt.hpp>
@@ -27,6 +28,8 @@
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
+#include <unordered_map>
+
 namespace Azure { namespace Storage { namespace Blobs {
 
   BlockBlobClient BlockBlobClient::CreateFromConnectionString(
@@ -317,15 +320,43 @@ namespace Azure { namespace Storage { namespace Blobs {
 
     _internal::FileReader fileReader(fileName);
 
+    std::unique_ptr<_detail::TransferCheckpoint> checkpoint;
+    // The sizes of the blocks staged by the upload resumed.
+    std::unordered_map<std::string, int64_t> stagedBlockSizes;
+
     auto uploadBlockFunc = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
+      if (chunkId == numChunks - 1)
+      {
+        blockIds.resize(static_cast<size_t>(numChunks));
+      }
+      const std::string blockId = getBlockId(chunkId);
+      std::vector<uint8_t> crc64;
+      if (checkpoint)
+      {
+        crc64 = _detail::GetFileCrc64(fileReader.GetHandle(), offset, length, context);
+        const auto stagedBlock = stagedBlockSizes.find(blockId);
+        if (stagedBlock != stagedBlockSizes.end() && stagedBlock->second == length
+            && checkpoint->HasChunk(offset, crc64))
+        {
+          return;
+        }
+      }
       Azure::Core::IO::_internal::RandomAccessFileBodyStream contentStream(
           fileReader.GetHandle(), offset, length);
       StageBlockOptions chunkOptions;
       chunkOptions.ValidationOptions = options.ValidationOptions;
-      auto blockInfo = StageBlock(getBlockId(chunkId), contentStream, chunkOptions, context);
-      if (chunkId == numChunks - 1)
+      if (checkpoint && !options.ValidationOptions.HasValue())
       {
-        blockIds.resize(static_cast<size_t>(numChunks));
+        // The service checks that the block has the content of the checkpoint.
+        ContentHash contentHash;
+        contentHash.Algorithm = HashAlgorithm::Crc64;
+        contentHash.Value = crc64;
+        chunkOptions.TransactionalContentHash = std::move(contentHash);
+      }
+      auto blockInfo = StageBlock(blockId, contentStream, chunkOptions, context);
+      if (checkpoint)
+      {
+        checkpoint->AddChunk(offset, crc64);
       }
     };
 
@@ -345,6 +376,35 @@ namespace Azure { namespace Storage { namespace Blobs {
       throw Azure::Core::RequestFailedException("Block size is too big.");
     }
 
+    if (options.CheckpointPath.HasValue())
+    {
+      checkpoint = std::make_unique<_detail::TransferCheckpoint>(options.CheckpointPath.Value());
+      // The query of the URL is left out, so that a SAS token isn't written to the checkpoint.
+      if (checkpoint->Open(
+              "upload " + m_blobUrl.GetHost() + "/" + m_blobUrl.GetPath() + " "
+              + std::to_string(fileReader.GetFileSize()) + " " + std::to_string(chunkSize)))
+      {
+        // The blocks staged are discarded when the blob is committed, or after a week.
+        GetBlockListOptions getBlockListOptions;
+        getBlockListOptions.ListType = Models::BlockListType::Uncommitted;
+        try
+        {
+          auto blockList = GetBlockList(getBlockListOptions, context);
+          for (auto& block : blockList.Value.UncommittedBlocks)
+          {
+            stagedBlockSizes.emplace(std::move(block.Name), block.Size);
+          }
+        }
+        catch (StorageException& e)
+        {
+          if (e.StatusCode != Azure::Core::Http::HttpStatusCode::NotFound)
+          {
+            throw;
+          }
+        }
+      }
+    }
+
     _internal::ConcurrentTransfer(
         0,
         fileReader.GetFileSize(),
@@ -364,6 +424,10 @@ namespace Azure { namespace Storage { namespace Blobs {
     commitBlockListOptions.ImmutabilityPolicy = options.ImmutabilityPolicy;
     commitBlockListOptions.HasLegalHold = options.HasLegalHold;
     auto commitBlockListResponse = CommitBlockList(blockIds, commitBlockListOptions, context);
+    if (checkpoint)
+    {
+      checkpoint->Remove();
+    }
 
     Models::UploadBlockBlobFromResult result;
     result.ETag = commitBlockListResponse.Value.ETag;
@@ -376,6 +440,103 @@ namespace Azure { namespace Storage { namespace Blobs {
         std::move(result), std::move(commitBlockListResponse.RawResponse));
   }
 
+  Azure::Response<Models::UploadBlockBlobFromResult> BlockBlobClient::UploadFrom(
+      Azure::Core::IO::BodyStream& content,
+      const UploadBlockBlobFromOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    constexpr int64_t DefaultStageBlockSize = 4 * 1024 * 1024ULL;
+    constexpr int64_t MaxStageBlockSize = 4000 * 1024 * 1024ULL;
+    constexpr int64_t MaxBlockNumber = 50000;
+
+    const int64_t chunkSize = options.TransferOptions.ChunkSize.HasValue()
+        ? options.TransferOptions.ChunkSize.Value()
+        : DefaultStageBlockSize;
+    if (chunkSize <= 0)
+    {
+      throw Azure::Core::RequestFailedException("Block size must be positive.");
+    }
+    if (chunkSize > MaxStageBlockSize)
+    {
+      throw Azure::Core::RequestFailedException("Block size is too big.");
+    }
+
+    UploadBlockBlobOptions uploadBlockBlobOptions;
+    uploadBlockBlobOptions.HttpHeaders = options.HttpHeaders;
+    uploadBlockBlobOptions.Metadata = options.Metadata;
+    uploadBlockBlobOptions.Tags = options.Tags;
+    uploadBlockBlobOptions.AccessTier = options.AccessTier;
+    uploadBlockBlobOptions.ImmutabilityPolicy = options.ImmutabilityPolicy;
+    uploadBlockBlobOptions.HasLegalHold = options.HasLegalHold;
+    uploadBlockBlobOptions.ValidationOptions = options.ValidationOptions;
+
+    auto getBlockId = [](int64_t id) {
+      constexpr size_t BlockIdLength = 64;
+      std::string blockId = std::to_string(id);
+      blockId = std::string(BlockIdLength - blockId.length(), '0') + blockId;
+      return Azure::Core::Convert::Base64Encode(
+          std::vector<uint8_t>(blockId.begin(), blockId.end()));
+    };
+
+    // A first chunk shorter than the chunk size is the whole content.
+    std::unique_ptr<Azure::Response<Models::UploadBlockBlobResult>> singleUploadResponse;
+    auto uploadBlockFunc = [&](const uint8_t* buffer, size_t length, int64_t chunkId) {
+      if (chunkId == 0 && length < static_cast<size_t>(chunkSize))
+      {
+        Azure::Core::IO::MemoryBodyStream contentStream(buffer, length);
+        singleUploadResponse = std::make_unique<Azure::Response<Models::UploadBlockBlobResult>>(
+            Upload(contentStream, uploadBlockBlobOptions, context));
+        return;
+      }
+      if (chunkId >= MaxBlockNumber)
+      {
+        throw Azure::Core::RequestFailedException(
+            "The content is too big for the block size, use a bigger chunk size.");
+      }
+      Azure::Core::IO::MemoryBodyStream contentStream(buffer, length);
+      StageBlockOptions chunkOptions;
+      chunkOptions.ValidationOptions = options.ValidationOptions;
+      StageBlock(getBlockId(chunkId), contentStream, chunkOptions, context);
+    };
+
+    const int64_t numChunks = _internal::ConcurrentTransferFromStream(
+        content, chunkSize, options.TransferOptions.Concurrency, uploadBlockFunc, context);
+    if (singleUploadResponse)
+    {
+      return std::move(*singleUploadResponse);
+    }
+    if (numChunks == 0)
+    {
+      Azure::Core::IO::MemoryBodyStream contentStream(nullptr, 0);
+      return Upload(contentStream, uploadBlockBlobOptions, context);
+    }
+
+    std::vector<std::string> blockIds;
+    blockIds.reserve(static_cast<size_t>(numChunks));
+    for (int64_t i = 0; i < numChunks; ++i)
+    {
+      blockIds.push_back(getBlockId(i));
+    }
+    CommitBlockListOptions commitBlockListOptions;
+    commitBlockListOptions.HttpHeaders = options.HttpHeaders;
+    commitBlockListOptions.Metadata = options.Metadata;
+    commitBlockListOptions.Tags = options.Tags;
+    commitBlockListOptions.AccessTier = options.AccessTier;
+    commitBlockListOptions.ImmutabilityPolicy = options.ImmutabilityPolicy;
+    commitBlockListOptions.HasLegalHold = options.HasLegalHold;
+    auto commitBlockListResponse = CommitBlockList(blockIds, commitBlockListOptions, context);
+
+    Models::UploadBlockBlobFromResult ret;
+    ret.ETag = std::move(commitBlockListResponse.Value.ETag);
+    ret.LastModified = std::move(commitBlockListResponse.Value.LastModified);
+    ret.VersionId = std::move(commitBlockListResponse.Value.VersionId);
+    ret.IsServerEncrypted = commitBlockListResponse.Value.IsServerEncrypted;
+    ret.EncryptionKeySha256 = std::move(commitBlockListResponse.Value.EncryptionKeySha256);
+    ret.EncryptionScope = std::move(commitBlockListResponse.Value.EncryptionScope);
+    return Azure::Response<Models::UploadBlockBlobFromResult>(
+        std::move(ret), std::move(commitBlockListResponse.RawResponse));
+  }
+
   Azure::Response<Models::UploadBlockBlobFromUriResult> BlockBlobClient::UploadFromUri(
       const std::string& sourceUri,
       const UploadBlockBlobFromUriOptions& options,
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "transfer_checkpoint.hpp"
+
+#include <azure/core/base64.hpp>
+#include <azure/core/io/body_stream.hpp>
+#include <azure/storage/common/crypt.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
+
+  TransferCheckpoint::TransferCheckpoint(std::string path) : m_path(std::move(path))
+  {
+    std::ifstream file(m_path, std::ios::binary);
+    std::string line;
+    while (std::getline(file, line))
+    {
+      if (file.eof())
+      {
+        m_isLastLineCut = true;
+        break;
+      }
+      if (m_description.empty())
+      {
+        m_description = std::move(line);
+        continue;
+      }
+      const auto separator = line.find(' ');
+      if (separator == std::string::npos)
+      {
+        continue;
+      }
+      try
+      {
+        m_chunks[std::stoll(line.substr(0, separator))]
+            = Azure::Core::Convert::Base64Decode(line.substr(separator + 1));
+      }
+      catch (std::exception&)
+      {
+        // The chunks of a line which can't be read are transferred again.
+      }
+    }
+  }
+
+  bool TransferCheckpoint::Open(const std::string& description)
+  {
+    const bool resume = !m_description.empty() && description == m_description;
+    if (!resume)
+    {
+      m_description = description;
+      m_chunks.clear();
+    }
+    m_file.open(m_path, std::ios::binary | (resume ? std::ios::app : std::ios::trunc));
+    if (!m_file)
+    {
+      throw std::runtime_error("Failed to open checkpoint.");
+    }
+    if (!resume)
+    {
+      m_file << description << '\n';
+    }
+    else if (m_isLastLineCut)
+    {
+      m_file << '\n';
+    }
+    m_file.flush();
+    return resume;
+  }
+
+  bool TransferCheckpoint::HasChunk(int64_t offset, const std::vector<uint8_t>& crc64) const
+  {
+    const auto chunk = m_chunks.find(offset);
+    return chunk != m_chunks.end() && chunk->second == crc64;
+  }
+
+  void TransferCheckpoint::AddChunk(int64_t offset, const std::vector<uint8_t>& crc64)
+  {
+    const std::string line
+        = std::to_string(offset) + ' ' + Azure::Core::Convert::Base64Encode(crc64) + '\n';
+    std::lock_guard<std::mutex> guard(m_mutex);
+    // Flushed, so that the chunk isn't transferred again after the process is interrupted.
+    m_file << line;
+    m_file.flush();
+    if (!m_file)
+    {
+      throw std::runtime_error("Failed to write checkpoint.");
+    }
+  }
+
+  void TransferCheckpoint::Remove()
+  {
+    m_file.close();
+    std::remove(m_path.data());
+  }
+
+  std::vector<uint8_t> GetFileCrc64(
+      _internal::FileHandle fileHandle,
+      int64_t offset,
+      int64_t length,
+      const Azure::Core::Context& context)
+  {
+    constexpr int64_t BufferSize = 4 * 1024 * 1024;
+    Azure::Core::IO::_internal::RandomAccessFileBodyStream stream(fileHandle, offset, length);
+    std::vector<uint8_t> buffer(static_cast<size_t>((std::min)(length, BufferSize)));
+    Crc64Hash crc64;
+    while (true)
+    {
+      const size_t bytesRead = stream.Read(buffer.data(), buffer.size(), context);
+      if (bytesRead == 0)
+      {
+        break;
+      }
+      crc64.Append(buffer.data(), bytesRead);
+    }
+    return crc64.Final();
+  }
+
+}}}} // namespace Azure::Storage::Blobs::_detail
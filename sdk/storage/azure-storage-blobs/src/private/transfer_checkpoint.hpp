@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <azure/core/context.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
+
+  // The chunks of a file transferred so far, so that a transfer which failed or was interrupted
+  // can be resumed without transferring them again. The first line of the checkpoint file
+  // describes the transfer, and each of the next lines holds the offset of a chunk in the file
+  // and the CRC64 of its content. The last line of an interrupted transfer can be cut, so it's
+  // ignored unless it ends with a newline.
+  class TransferCheckpoint final {
+  public:
+    // Loads the checkpoint at path, if there is one.
+    explicit TransferCheckpoint(std::string path);
+
+    // The description of the transfer of the checkpoint loaded, or an empty string.
+    const std::string& GetDescription() const { return m_description; }
+
+    // Resumes the checkpoint loaded if it describes the same transfer, or starts a new one.
+    // Returns whether the checkpoint was resumed.
+    bool Open(const std::string& description);
+
+    // Whether the chunk at offset was transferred with this CRC64.
+    bool HasChunk(int64_t offset, const std::vector<uint8_t>& crc64) const;
+
+    // Records that the chunk at offset was transferred. Can be called concurrently.
+    void AddChunk(int64_t offset, const std::vector<uint8_t>& crc64);
+
+    // Deletes the checkpoint once the transfer is done.
+    void Remove();
+
+  private:
+    const std::string m_path;
+    std::string m_description;
+    bool m_isLastLineCut = false;
+    std::unordered_map<int64_t, std::vector<uint8_t>> m_chunks;
+    std::mutex m_mutex;
+    std::ofstream m_file;
+  };
+
+  // Returns the CRC64 of length bytes of a file from offset.
+  std::vector<uint8_t> GetFileCrc64(
+      _internal::FileHandle fileHandle,
+      int64_t offset,
+      int64_t length,
+      const Azure::Core::Context& context);
+
+}}}} // namespace Azure::Storage::Blobs::_detail
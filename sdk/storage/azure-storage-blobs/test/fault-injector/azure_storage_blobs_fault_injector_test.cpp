@@ -21,8 +21,15 @@
 #include "azure/core/http/win_http_transport.hpp"
 #endif
 
+#include <atomic>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 /**
@@ -34,6 +41,15 @@ struct FaultInjectionClientOptions
 {
   Azure::Core::Url m_url;
   std::shared_ptr<Azure::Core::Http::HttpTransport> m_transport;
+
+  /**
+   * @brief The response option of the fault injector for the requests sent after the first
+   * #m_requestsBeforeFault ones, like `na` (no response, then abort the connection) or `pa`
+   * (partial body, then abort the connection). The fault injector asks which response to send
+   * for each request when it's empty.
+   */
+  std::string m_faultResponseOption;
+  int m_requestsBeforeFault = 0;
 };
 
 /**
@@ -43,16 +59,32 @@ struct FaultInjectionClientOptions
 class FaultInjectionClient : public Azure::Core::Http::HttpTransport {
 private:
   FaultInjectionClientOptions m_options;
+  std::atomic<int> m_requestCount{0};
 
 public:
   FaultInjectionClient(FaultInjectionClientOptions options) : m_options(std::move(options)) {}
 
+  /**
+   * @brief The number of requests sent, including the ones which failed.
+   */
+  int GetRequestCount() const { return m_requestCount; }
+
   std::unique_ptr<Azure::Core::Http::RawResponse> Send(
       Azure::Core::Http::Request& request,
       Azure::Core::Context const& context) override
   {
+    // The path, the query and the body of the request are sent to the fault injector.
+    Azure::Core::Url redirectUrl(m_options.m_url.GetAbsoluteUrl());
+    redirectUrl.SetPath(request.GetUrl().GetPath());
+    for (const auto& queryParameter : request.GetUrl().GetQueryParameters())
+    {
+      redirectUrl.AppendQueryParameter(queryParameter.first, queryParameter.second);
+    }
     auto redirectRequest = Azure::Core::Http::Request(
-        request.GetMethod(), Azure::Core::Url(m_options.m_url.GetAbsoluteUrl()));
+        request.GetMethod(),
+        std::move(redirectUrl),
+        request.GetBodyStream(),
+        request.ShouldBufferResponse());
     for (auto& header : request.GetHeaders())
     {
       redirectRequest.SetHeader(header.first, header.second);
@@ -61,14 +93,150 @@ public:
     {
       auto& url = request.GetUrl();
       auto port = url.GetPort();
+      const std::string host = url.GetHost() + (port != 0 ? ":" + std::to_string(port) : "");
+      redirectRequest.SetHeader("Host", host);
+      redirectRequest.SetHeader("x-upstream-base-uri", url.GetScheme() + "://" + host);
+    }
+
+    const int requestCount = m_requestCount++;
+    if (!m_options.m_faultResponseOption.empty())
+    {
       redirectRequest.SetHeader(
-          "Host", url.GetHost() + (port != 0 ? ":" + std::to_string(port) : ""));
+          "x-ms-faultinjector-response-option",
+          requestCount < m_options.m_requestsBeforeFault ? "f"
+                                                          : m_options.m_faultResponseOption);
     }
 
     return m_options.m_transport->Send(redirectRequest, context);
   }
 };
 
+namespace {
+void Check(bool condition, const std::string& message)
+{
+  if (!condition)
+  {
+    throw std::runtime_error(message);
+  }
+}
+
+std::vector<uint8_t> ReadFile(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  return std::vector<uint8_t>(
+      std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Interrupts an upload and a download with checkpoints by faults, and checks that they
+ * resume without transferring the chunks transferred before the faults again.
+ *
+ */
+void ResumeCheckpointedTransfers(
+    const std::string& connectionString,
+    const FaultInjectionClientOptions& options)
+{
+  constexpr int64_t ChunkSize = 1024 * 1024;
+  constexpr int NumChunks = 17;
+  constexpr int ChunksBeforeFault = 5;
+  const std::string fileName = "checkpointed-transfer.bin";
+  const std::string downloadFileName = "checkpointed-transfer-download.bin";
+  const std::string checkpointPath = "checkpointed-transfer.checkpoint";
+
+  std::vector<uint8_t> content(static_cast<size_t>(ChunkSize * NumChunks - 1));
+  std::mt19937_64 random(std::random_device{}());
+  for (auto& byte : content)
+  {
+    byte = static_cast<uint8_t>(random());
+  }
+  std::ofstream(fileName, std::ios::binary)
+      .write(
+          reinterpret_cast<const char*>(content.data()),
+          static_cast<std::streamsize>(content.size()));
+
+  // The faulty transfers fail at the first fault. The transfers resumed don't get any.
+  auto getBlobClient = [&](const std::string& faultResponseOption,
+                           std::shared_ptr<FaultInjectionClient>& client) {
+    FaultInjectionClientOptions clientOptions = options;
+    clientOptions.m_faultResponseOption = faultResponseOption;
+    clientOptions.m_requestsBeforeFault = ChunksBeforeFault;
+    client = std::make_shared<FaultInjectionClient>(clientOptions);
+    Azure::Storage::Blobs::BlobClientOptions blobClientOptions;
+    blobClientOptions.Transport.Transport = client;
+    blobClientOptions.Retry.MaxRetries = 0;
+    return Azure::Storage::Blobs::BlockBlobClient::CreateFromConnectionString(
+        connectionString, "sample", "checkpointed-transfer.bin", blobClientOptions);
+  };
+  std::shared_ptr<FaultInjectionClient> client;
+
+  Azure::Storage::Blobs::UploadBlockBlobFromOptions uploadOptions;
+  uploadOptions.TransferOptions.SingleUploadThreshold = ChunkSize;
+  uploadOptions.TransferOptions.ChunkSize = ChunkSize;
+  uploadOptions.TransferOptions.Concurrency = 1;
+  uploadOptions.CheckpointPath = checkpointPath;
+
+  std::cout << "Uploading with faults..." << std::endl;
+  bool failed = false;
+  try
+  {
+    getBlobClient("na", client).UploadFrom(fileName, uploadOptions);
+  }
+  catch (Azure::Core::RequestFailedException&)
+  {
+    failed = true;
+  }
+  Check(failed, "The upload didn't fail.");
+
+  std::cout << "Resuming the upload..." << std::endl;
+  getBlobClient("f", client).UploadFrom(fileName, uploadOptions);
+  // Get Block List, the blocks not staged, and Put Block List.
+  Check(
+      client->GetRequestCount() == 1 + NumChunks - ChunksBeforeFault + 1,
+      "The upload resumed staged " + std::to_string(client->GetRequestCount() - 2) + " blocks.");
+  Check(!std::ifstream(checkpointPath), "The checkpoint of the upload wasn't deleted.");
+
+  Azure::Storage::Blobs::DownloadBlobToOptions downloadOptions;
+  downloadOptions.TransferOptions.InitialChunkSize = ChunkSize;
+  downloadOptions.TransferOptions.ChunkSize = ChunkSize;
+  downloadOptions.TransferOptions.Concurrency = 1;
+  downloadOptions.CheckpointPath = checkpointPath;
+
+  std::cout << "Downloading with faults..." << std::endl;
+  failed = false;
+  try
+  {
+    getBlobClient("na", client).DownloadTo(downloadFileName, downloadOptions);
+  }
+  catch (Azure::Core::RequestFailedException&)
+  {
+    failed = true;
+  }
+  Check(failed, "The download didn't fail.");
+
+  // A chunk written before the faults which doesn't have the content of the checkpoint anymore
+  // is downloaded again.
+  {
+    std::fstream file(downloadFileName, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(ChunkSize * 2);
+    file.put(static_cast<char>(~content[static_cast<size_t>(ChunkSize * 2)]));
+  }
+
+  std::cout << "Resuming the download..." << std::endl;
+  getBlobClient("f", client).DownloadTo(downloadFileName, downloadOptions);
+  // A byte to check the blob, the chunks not downloaded, and the chunk modified.
+  Check(
+      client->GetRequestCount() == 1 + NumChunks - ChunksBeforeFault + 1,
+      "The download resumed downloaded " + std::to_string(client->GetRequestCount() - 1)
+          + " chunks.");
+  Check(!std::ifstream(checkpointPath), "The checkpoint of the download wasn't deleted.");
+  Check(ReadFile(downloadFileName) == content, "The file downloaded isn't the file uploaded.");
+
+  std::remove(fileName.data());
+  std::remove(downloadFileName.data());
+  std::cout << "Checkpointed transfers resumed." << std::endl;
+}
+} // namespace
+
 int main()
 {
   /* The transport adapter must allow insecure SSL certs.
@@ -106,5 +274,15 @@ int main()
 
   std::cout << "Content: " << std::string(content.begin(), content.end()) << std::endl;
 
+  try
+  {
+    ResumeCheckpointedTransfers(connectionString, options);
+  }
+  catch (std::exception& e)
+  {
+    std::cout << "Failed: " << e.what() << std::endl;
+    return 1;
+  }
+
   return 0;
 }
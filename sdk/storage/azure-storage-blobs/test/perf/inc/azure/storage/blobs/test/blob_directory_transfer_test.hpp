@@ -0,0 +1,233 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of transferring a directory of small files.
+ *
+ */
+
+#pragma once
+
+#include "azure/storage/blobs/test/blob_base_test.hpp"
+
+#include <azure/core/uuid.hpp>
+#include <azure/perf.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief A test to measure uploading a directory to a prefix, or downloading a prefix to a
+   * directory.
+   *
+   * @details `--direction` is `upload` (default) or `download`, and `--method` chooses between:
+   *  - `directory` (default): `BlobContainerClient::UploadDirectory()` or `DownloadDirectory()`.
+   *  - `per-blob`: a loop calling `UploadFrom()` for each file, or `DownloadTo()` for each blob
+   *    listed by `ListBlobs()`.
+   *
+   * The directory holds `--num-files` files of `--size` bytes. To measure the client rather than
+   * the service with many small files, run it against a local emulator such as Azurite, with
+   * `STORAGE_CONNECTION_STRING` set to a connection string with its `BlobEndpoint`.
+   */
+  class BlobDirectoryTransfer : public Azure::Storage::Blobs::Test::BlobsTest {
+  private:
+    std::string m_direction = "upload";
+    std::string m_method = "directory";
+    int m_concurrency = 0;
+    std::string m_sourceDirectory;
+    std::string m_destinationDirectory;
+    const std::string m_prefix = "directory";
+
+    void Upload(Azure::Core::Context const& context)
+    {
+      if (m_method == "per-blob")
+      {
+        _internal::ForEachFile(m_sourceDirectory, [&](const std::string& relativePath, int64_t) {
+          m_containerClient->GetBlockBlobClient(m_prefix + "/" + relativePath)
+              .UploadFrom(m_sourceDirectory + "/" + relativePath, {}, context);
+        });
+        return;
+      }
+      UploadBlobDirectoryOptions options;
+      if (m_concurrency > 0)
+      {
+        options.TransferOptions.Concurrency = m_concurrency;
+      }
+      m_containerClient->UploadDirectory(m_sourceDirectory, m_prefix, options, context);
+    }
+
+    void Download(Azure::Core::Context const& context)
+    {
+      if (m_method == "per-blob")
+      {
+        ListBlobsOptions listOptions;
+        listOptions.Prefix = m_prefix + "/";
+        for (auto page = m_containerClient->ListBlobs(listOptions, context); page.HasPage();
+             page.MoveToNextPage(context))
+        {
+          for (const auto& blob : page.Blobs)
+          {
+            m_containerClient->GetBlobClient(blob.Name).DownloadTo(
+                m_destinationDirectory + "/" + blob.Name.substr(m_prefix.length() + 1),
+                {},
+                context);
+          }
+        }
+        return;
+      }
+      DownloadBlobDirectoryOptions options;
+      if (m_concurrency > 0)
+      {
+        options.TransferOptions.Concurrency = m_concurrency;
+      }
+      m_containerClient->DownloadDirectory(m_prefix, m_destinationDirectory, options, context);
+    }
+
+    static void RemoveDirectory(const std::string& directory)
+    {
+      if (directory.empty())
+      {
+        return;
+      }
+      _internal::ForEachFile(directory, [&directory](const std::string& relativePath, int64_t) {
+        std::remove((directory + "/" + relativePath).data());
+      });
+      std::remove(directory.data());
+    }
+
+  public:
+    /**
+     * @brief Construct a new BlobDirectoryTransfer test.
+     *
+     * @param options The test options.
+     */
+    BlobDirectoryTransfer(Azure::Perf::TestOptions options) : BlobsTest(options) {}
+
+    /**
+     * @brief Create the files of the directory, and upload them for the downloads.
+     *
+     */
+    void Setup() override
+    {
+      // Call base to create blob client
+      BlobsTest::Setup();
+
+      const auto numFiles = m_options.GetOptionOrDefault<int64_t>("NumFiles", 100000);
+      const auto size = m_options.GetOptionOrDefault<int64_t>("Size", 4096);
+      m_direction = m_options.GetOptionOrDefault<std::string>("Direction", "upload");
+      m_method = m_options.GetOptionOrDefault<std::string>("Method", "directory");
+      m_concurrency = m_options.GetOptionOrDefault<int>("Concurrency", 0);
+      if (m_direction != "upload" && m_direction != "download")
+      {
+        throw std::runtime_error(
+            "Invalid --direction '" + m_direction + "'. Expected one of: upload, download.");
+      }
+      if (m_method != "directory" && m_method != "per-blob")
+      {
+        throw std::runtime_error(
+            "Invalid --method '" + m_method + "'. Expected one of: directory, per-blob.");
+      }
+
+      // The files are flat, so that the directory can be removed without removing
+      // subdirectories.
+      m_sourceDirectory = "blob-directory-" + Azure::Core::Uuid::CreateUuid().ToString();
+      _internal::CreateDirectories(m_sourceDirectory);
+      const std::string content(static_cast<size_t>(size), 'x');
+      for (int64_t i = 0; i < numFiles; ++i)
+      {
+        std::ofstream(m_sourceDirectory + "/file" + std::to_string(i), std::ios::binary)
+            << content;
+      }
+
+      if (m_direction == "download")
+      {
+        m_containerClient->UploadDirectory(m_sourceDirectory, m_prefix);
+        RemoveDirectory(m_sourceDirectory);
+        m_sourceDirectory.clear();
+        m_destinationDirectory = "blob-directory-" + Azure::Core::Uuid::CreateUuid().ToString();
+        _internal::CreateDirectories(m_destinationDirectory);
+      }
+    }
+
+    /**
+     * @brief Remove the local directory, and the container.
+     *
+     */
+    void Cleanup() override
+    {
+      RemoveDirectory(m_sourceDirectory);
+      RemoveDirectory(m_destinationDirectory);
+      BlobsTest::Cleanup();
+    }
+
+    /**
+     * @brief Define the test
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      if (m_direction == "download")
+      {
+        Download(context);
+        return;
+      }
+      Upload(context);
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"TokenCredential",
+           {"--token-credential"},
+           "Use a token credential to run the test. By default, a connection string is used.",
+           0},
+          {"NumFiles", {"--num-files"}, "Number of files of the directory. Default: 100000.", 1},
+          {"Size", {"--size"}, "Size of each file (in bytes). Default: 4096.", 1},
+          {"Direction",
+           {"--direction"},
+           "Direction: 'upload' (default, a directory to a prefix) or 'download' (a prefix to a "
+           "directory).",
+           1},
+          {"Method",
+           {"--method"},
+           "Transfer method: 'directory' (default, UploadDirectory or DownloadDirectory) or "
+           "'per-blob' (one UploadFrom or DownloadTo after the other).",
+           1},
+          {"Concurrency",
+           {"--concurrency"},
+           "Files transferred at the same time with the 'directory' method. Default: client "
+           "default.",
+           1}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "BlobDirectoryTransfer",
+          "Upload a directory of small files to a prefix, or download a prefix to a directory.",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Storage::Blobs::Test::BlobDirectoryTransfer>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of the CRC64 used for transactional validation.
+ *
+ */
+
+#pragma once
+
+#include <azure/core.hpp>
+#include <azure/perf.hpp>
+#include <azure/storage/common/crypt.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief Measure the CRC64 throughput.
+   *
+   * @remark Use `--size` to set the size of the data hashed by each operation. With
+   * `--block-size`, the blocks of the data are hashed separately and the hashes concatenated, like
+   * the blocks of a parallel transfer. The throughput is printed at the end of the test.
+   */
+  class Crc64Test : public Azure::Perf::PerfTest {
+    std::vector<uint8_t> m_data;
+    size_t m_blockSize = 0;
+
+    static std::atomic<uint64_t>& BytesHashed()
+    {
+      static std::atomic<uint64_t> bytes{0};
+      return bytes;
+    }
+
+    static std::atomic<int64_t>& HashingTimeNs()
+    {
+      static std::atomic<int64_t> time{0};
+      return time;
+    }
+
+  public:
+    /**
+     * @brief Construct a new Crc64Test test.
+     *
+     * @param options The test options.
+     */
+    Crc64Test(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      m_data.resize(m_options.GetOptionOrDefault<size_t>("Size", 1024 * 1024));
+      for (size_t i = 0; i < m_data.size(); ++i)
+      {
+        m_data[i] = static_cast<uint8_t>(i * 131 + 7);
+      }
+      m_blockSize = m_options.GetOptionOrDefault<size_t>("BlockSize", 0);
+      if (m_blockSize == 0)
+      {
+        m_blockSize = m_data.size();
+      }
+    }
+
+    /**
+     * @brief Hash the data once.
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      auto const start = std::chrono::steady_clock::now();
+      Crc64Hash crc64;
+      for (size_t offset = 0; offset < m_data.size(); offset += m_blockSize)
+      {
+        Crc64Hash block;
+        block.Append(&m_data[offset], (std::min)(m_blockSize, m_data.size() - offset));
+        crc64.Concatenate(block);
+      }
+      crc64.Final();
+      HashingTimeNs() += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+      BytesHashed() += m_data.size();
+    }
+
+    void GlobalCleanup() override
+    {
+      auto const timeNs = HashingTimeNs().load();
+      if (timeNs > 0)
+      {
+        std::cout << "CRC64 throughput: "
+                  << static_cast<double>(BytesHashed().load()) / static_cast<double>(timeNs)
+                  << " GB/s per thread" << std::endl;
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Size", {"--size"}, "Size of the data (in bytes). Default 1 MiB.", 1, false},
+          {"BlockSize",
+           {"--block-size"},
+           "Hash the data in blocks of this size and concatenate the hashes (in bytes). Default 0, "
+           "the data is one block.",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "Crc64",
+          "Measures the CRC64 throughput",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Storage::Blobs::Test::Crc64Test>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
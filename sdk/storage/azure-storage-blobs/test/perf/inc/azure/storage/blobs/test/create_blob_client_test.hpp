@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of creating blob clients.
+ *
+ */
+
+#pragma once
+
+#include <azure/core.hpp>
+#include <azure/perf.hpp>
+#include <azure/storage/blobs.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief Measure creating a blob client from a service client and sending one request with it,
+   * like an application acting on the blobs of a listing.
+   *
+   * @remark The requests are signed with a storage account key and answered without being sent.
+   */
+  class CreateBlobClient : public Azure::Perf::PerfTest {
+    std::unique_ptr<BlobServiceClient> m_serviceClient;
+    int m_blobCount = 0;
+
+  public:
+    /**
+     * @brief Construct a new CreateBlobClient test.
+     *
+     * @param options The test options.
+     */
+    CreateBlobClient(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      BlobClientOptions clientOptions;
+      clientOptions.Transport.Transport = std::make_shared<Azure::Perf::NoNetworkTransport>(
+          true, Azure::Core::Http::HttpStatusCode::Accepted, "Accepted");
+      m_serviceClient = std::make_unique<BlobServiceClient>(
+          "https://account.blob.core.windows.net",
+          std::make_shared<StorageSharedKeyCredential>(
+              "account", Azure::Core::Convert::Base64Encode(std::vector<uint8_t>(64, 0x5a))),
+          clientOptions);
+    }
+
+    /**
+     * @brief Create a container client and a blob client, and delete the blob.
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      auto const blobName = "folder/blob" + std::to_string(++m_blobCount);
+      m_serviceClient->GetBlobContainerClient("container")
+          .GetBlockBlobClient(blobName)
+          .Delete(DeleteBlobOptions(), context);
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "CreateBlobClient",
+          "Create blob clients and send one request with each.",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Storage::Blobs::Test::CreateBlobClient>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
@@ -16,6 +16,8 @@
 #include <azure/core/io/body_stream.hpp>
 #include <azure/perf.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -33,8 +35,22 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
     std::unique_ptr<std::vector<uint8_t>> m_downloadBuffer;
     std::unique_ptr<Azure::Core::Http::CurlTransport> m_curlTransport;
     bool m_bufferResponse = false;
+    size_t m_readSize = 0;
     std::unique_ptr<Azure::Core::Http::Request> m_request;
 
+    // Bytes read and time spent reading by all the parallel instances, used to report the
+    // download throughput.
+    static std::atomic<uint64_t>& BytesRead()
+    {
+      static std::atomic<uint64_t> bytesRead{0};
+      return bytesRead;
+    }
+    static std::atomic<int64_t>& ReadNanoseconds()
+    {
+      static std::atomic<int64_t> readNanoseconds{0};
+      return readNanoseconds;
+    }
+
   public:
     /**
      * @brief Construct a new DownloadBlobWithTransportOnly test.
@@ -54,6 +70,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
 
       long size = m_options.GetMandatoryOption<long>("Size");
       m_bufferResponse = m_options.GetMandatoryOption<bool>("Buffer");
+      m_readSize = m_options.GetOptionOrDefault<size_t>("ReadSize", 0);
 
       m_downloadBuffer = std::make_unique<std::vector<uint8_t>>(size);
 
@@ -63,7 +80,10 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
 
       auto requestUrl = m_blobClient->GetUrl() + GetSasToken();
 
-      m_curlTransport = std::make_unique<Azure::Core::Http::CurlTransport>();
+      Azure::Core::Http::CurlTransportOptions transportOptions;
+      transportOptions.HeaderBufferSize = m_options.GetOptionOrDefault<size_t>(
+          "HeaderBufferSize", transportOptions.HeaderBufferSize);
+      m_curlTransport = std::make_unique<Azure::Core::Http::CurlTransport>(transportOptions);
       m_request = std::make_unique<Azure::Core::Http::Request>(
           Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(requestUrl), m_bufferResponse);
     }
@@ -78,8 +98,46 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
 
       if (m_bufferResponse)
       {
-        // if test request the response stream to be read completely.
-        *m_downloadBuffer = response->ExtractBodyStream()->ReadToEnd();
+        auto const start = std::chrono::steady_clock::now();
+        size_t totalRead = 0;
+        if (m_readSize == 0)
+        {
+          // if test request the response stream to be read completely.
+          *m_downloadBuffer = response->ExtractBodyStream()->ReadToEnd();
+          totalRead = m_downloadBuffer->size();
+        }
+        else
+        {
+          // Read the body straight into the download buffer, `--read-size` bytes at a time.
+          auto bodyStream = response->ExtractBodyStream();
+          while (totalRead < m_downloadBuffer->size())
+          {
+            auto const bytesRead = bodyStream->Read(
+                m_downloadBuffer->data() + totalRead,
+                (std::min)(m_readSize, m_downloadBuffer->size() - totalRead),
+                context);
+            if (bytesRead == 0)
+            {
+              break;
+            }
+            totalRead += bytesRead;
+          }
+        }
+        BytesRead() += totalRead;
+        ReadNanoseconds() += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+      }
+    }
+
+    void GlobalCleanup() override
+    {
+      if (ReadNanoseconds() > 0)
+      {
+        // bytes per nanosecond is GB/s.
+        std::cout << "Body read throughput per parallel instance: "
+                  << static_cast<double>(BytesRead()) / static_cast<double>(ReadNanoseconds())
+                  << " GB/s" << std::endl;
       }
     }
 
@@ -93,7 +151,18 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
       // TODO: Merge with base options
       return {
           {"Size", {"--size"}, "Size of payload (in bytes)", 1, true},
-          {"Buffer", {"--buffer"}, "Whether to buffer the response", 1, true}};
+          {"Buffer", {"--buffer"}, "Whether to buffer the response", 1, true},
+          {"ReadSize",
+           {"--read-size"},
+           "Size of each read from the response body when buffering (in bytes). Default reads the "
+           "whole body with ReadToEnd.",
+           1,
+           false},
+          {"HeaderBufferSize",
+           {"--header-buffer-size"},
+           "Size of the curl transport buffer for the response headers (in bytes). Default 4096.",
+           1,
+           false}};
     }
 
     /**
@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of reading a blob through a seekable blob stream.
+ *
+ */
+
+#pragma once
+
+#include "azure/storage/blobs/test/blob_base_test.hpp"
+
+#include <azure/perf.hpp>
+#include <azure/perf/random_stream.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief A test to measure sequential and random reads of a blob.
+   *
+   * @details `--read-method` chooses between:
+   *  - `open-read` (default): read through the stream of `BlobClient::OpenRead()`, which caches
+   *    blocks and downloads the next ones ahead of sequential reads.
+   *  - `download`: the download path without the stream. Sequential reads drain the body stream
+   *    of one `Download()`, and each random read is a ranged `Download()`.
+   *
+   * Each run reads the whole blob in `--read-size` reads, or makes `--random-reads` reads at
+   * random offsets when it's set. `--block-size` and `--concurrency` are forwarded to
+   * `OpenReadBlobOptions`.
+   */
+  class OpenReadBlob : public Azure::Storage::Blobs::Test::BlobsTest {
+  private:
+    int64_t m_size = 0;
+    std::string m_readMethod = "open-read";
+    size_t m_readSize = 0;
+    int m_randomReads = 0;
+    int64_t m_blockSize = 0;
+    int m_concurrency = 0;
+    std::vector<uint8_t> m_readBuffer;
+    std::mt19937_64 m_random;
+
+    void ReadOpenedBlob(Azure::Core::Context const& context)
+    {
+      OpenReadBlobOptions options;
+      if (m_blockSize > 0)
+      {
+        options.TransferOptions.ChunkSize = m_blockSize;
+      }
+      if (m_concurrency > 0)
+      {
+        options.TransferOptions.Concurrency = m_concurrency;
+      }
+      auto stream = m_blobClient->OpenRead(options, context);
+      if (m_randomReads == 0)
+      {
+        while (stream->ReadToCount(m_readBuffer.data(), m_readBuffer.size(), context) != 0)
+        {
+        }
+        return;
+      }
+      for (int i = 0; i < m_randomReads; ++i)
+      {
+        stream->Seek(RandomOffset());
+        stream->ReadToCount(m_readBuffer.data(), m_readBuffer.size(), context);
+      }
+    }
+
+    void ReadDownloadedBlob(Azure::Core::Context const& context)
+    {
+      if (m_randomReads == 0)
+      {
+        auto response = m_blobClient->Download({}, context);
+        while (response.Value.BodyStream->ReadToCount(
+                   m_readBuffer.data(), m_readBuffer.size(), context)
+               != 0)
+        {
+        }
+        return;
+      }
+      for (int i = 0; i < m_randomReads; ++i)
+      {
+        DownloadBlobOptions options;
+        options.Range = Azure::Core::Http::HttpRange();
+        options.Range.Value().Offset = RandomOffset();
+        options.Range.Value().Length = static_cast<int64_t>(m_readSize);
+        auto response = m_blobClient->Download(options, context);
+        response.Value.BodyStream->ReadToCount(m_readBuffer.data(), m_readBuffer.size(), context);
+      }
+    }
+
+    int64_t RandomOffset()
+    {
+      const auto maxOffset = m_size - static_cast<int64_t>(m_readSize);
+      return static_cast<int64_t>(m_random() % static_cast<uint64_t>(maxOffset + 1));
+    }
+
+  public:
+    /**
+     * @brief Construct a new OpenReadBlob test.
+     *
+     * @param options The test options.
+     */
+    OpenReadBlob(Azure::Perf::TestOptions options) : BlobsTest(options) {}
+
+    /**
+     * @brief Upload the blob to read, of the size given by a mandatory parameter.
+     *
+     */
+    void Setup() override
+    {
+      // Call base to create blob client
+      BlobsTest::Setup();
+
+      m_size = m_options.GetMandatoryOption<int64_t>("Size");
+      m_readMethod = m_options.GetOptionOrDefault<std::string>("ReadMethod", "open-read");
+      m_readSize = static_cast<size_t>(m_options.GetOptionOrDefault<int64_t>("ReadSize", 65536));
+      m_randomReads = m_options.GetOptionOrDefault<int>("RandomReads", 0);
+      m_blockSize = m_options.GetOptionOrDefault<int64_t>("BlockSize", 0);
+      m_concurrency = m_options.GetOptionOrDefault<int>("Concurrency", 0);
+      if (m_readMethod != "open-read" && m_readMethod != "download")
+      {
+        throw std::runtime_error(
+            "Invalid --read-method '" + m_readMethod + "'. Expected one of: open-read, download.");
+      }
+      if (m_size <= 0 || m_readSize == 0 || static_cast<int64_t>(m_readSize) > m_size)
+      {
+        throw std::runtime_error("--read-size must be from 1 to --size.");
+      }
+      m_readBuffer.resize(m_readSize);
+
+      auto content = Azure::Perf::RandomStream::Create(static_cast<size_t>(m_size));
+      m_blobClient->UploadFrom(*content);
+    }
+
+    /**
+     * @brief Define the test
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      if (m_readMethod == "download")
+      {
+        ReadDownloadedBlob(context);
+        return;
+      }
+      ReadOpenedBlob(context);
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"TokenCredential",
+           {"--token-credential"},
+           "Use a token credential to run the test. By default, a connection string is used.",
+           0},
+          {"Size", {"--size"}, "Size of the blob (in bytes)", 1, true},
+          {"ReadMethod",
+           {"--read-method"},
+           "Read method: 'open-read' (default, the stream of OpenRead) or 'download' (Download "
+           "drained, or one ranged Download per random read).",
+           1},
+          {"ReadSize", {"--read-size"}, "Size of each read (in bytes). Default: 65536.", 1},
+          {"RandomReads",
+           {"--random-reads"},
+           "Number of reads at random offsets per run. Default: 0, read the whole blob in order.",
+           1},
+          {"BlockSize",
+           {"--block-size"},
+           "Block size (bytes) for OpenRead. Default: client default.",
+           1},
+          {"Concurrency",
+           {"--concurrency"},
+           "Blocks downloaded ahead of sequential reads for OpenRead. Default: client default.",
+           1}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "OpenReadBlob",
+          "Read a blob sequentially or at random offsets.",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Storage::Blobs::Test::OpenReadBlob>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
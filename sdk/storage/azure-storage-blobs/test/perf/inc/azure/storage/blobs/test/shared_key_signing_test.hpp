@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of signing requests with a storage account key.
+ *
+ */
+
+#pragma once
+
+#include <azure/core.hpp>
+#include <azure/core/internal/http/pipeline.hpp>
+#include <azure/perf.hpp>
+#include <azure/storage/common/internal/shared_key_policy.hpp>
+#include <azure/storage/common/storage_credential.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief Measure signing requests with the shared key policy.
+   *
+   * @remark The requests go through a pipeline with the shared key policy only and are never
+   * sent. Run the test with `--parallel` to sign from many threads with the same credential. With
+   * `--reuse-request 1`, each test instance signs the same request again instead of building a
+   * new one, so the operations only allocate the Authorization header and the empty response.
+   */
+  class SharedKeySigning : public Azure::Perf::PerfTest {
+    std::unique_ptr<Azure::Core::Http::_internal::HttpPipeline> m_pipeline;
+    std::unique_ptr<Azure::Core::Http::Request> m_request;
+    bool m_reuseRequest = false;
+
+    static std::unique_ptr<Azure::Core::Http::Request> CreateRequest()
+    {
+      auto request = std::make_unique<Azure::Core::Http::Request>(
+          Azure::Core::Http::HttpMethod::Put,
+          Azure::Core::Url("https://account.blob.core.windows.net/container/"
+                           "folder/blob.bin?comp=block&blockid=AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"));
+      request->SetHeader("Content-Length", "4194304");
+      request->SetHeader("Content-Type", "application/octet-stream");
+      request->SetHeader("x-ms-client-request-id", "0c8ba5c5-0a4b-4d2e-8d2e-3a6f0e1c9b7d");
+      request->SetHeader("x-ms-date", "Thu, 15 Oct 2026 12:00:00 GMT");
+      request->SetHeader("x-ms-version", "2026-10-06");
+      return request;
+    }
+
+  public:
+    /**
+     * @brief Construct a new SharedKeySigning test.
+     *
+     * @param options The test options.
+     */
+    SharedKeySigning(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      // All the test instances sign with the same credential, like the clients of an application.
+      static auto const credential = std::make_shared<StorageSharedKeyCredential>(
+          "account", Azure::Core::Convert::Base64Encode(std::vector<uint8_t>(64, 0x5a)));
+      std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> policies;
+      policies.emplace_back(
+          std::make_unique<Azure::Storage::_internal::SharedKeyPolicy>(credential));
+      Azure::Core::Http::Policies::TransportOptions transportOptions;
+      transportOptions.Transport = std::make_shared<Azure::Perf::NoNetworkTransport>();
+      policies.emplace_back(
+          std::make_unique<Azure::Core::Http::Policies::_internal::TransportPolicy>(
+              transportOptions));
+      m_pipeline = std::make_unique<Azure::Core::Http::_internal::HttpPipeline>(policies);
+      m_reuseRequest = m_options.GetOptionOrDefault<bool>("ReuseRequest", false);
+      if (m_reuseRequest)
+      {
+        m_request = CreateRequest();
+        // Sign once to add the Authorization header the next signatures replace.
+        m_pipeline->Send(*m_request, Azure::Core::Context{});
+      }
+    }
+
+    /**
+     * @brief Sign one request like a block upload.
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      if (m_reuseRequest)
+      {
+        m_pipeline->Send(*m_request, context);
+      }
+      else
+      {
+        m_pipeline->Send(*CreateRequest(), context);
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"ReuseRequest",
+           {"--reuse-request"},
+           "Sign the same request in each operation instead of a new one.",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "SharedKeySigning",
+          "Sign requests with a storage account key.",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Storage::Blobs::Test::SharedKeySigning>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
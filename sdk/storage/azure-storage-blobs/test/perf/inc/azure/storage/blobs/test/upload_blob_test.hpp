@@ -27,7 +27,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
   /**
    * @brief A test to measure uploading a blob.
    *
-   * @details Supports three upload methods selected via `--upload-method`:
+   * @details Supports four upload methods selected via `--upload-method`:
    *  - `buffer` (default, preserves existing behavior): build a contiguous in-memory
    *    payload and call `BlockBlobClient::UploadFrom(buffer, size)`. Guarded by a
    *    `size * parallel` memory-budget check to avoid OOM kills.
@@ -36,9 +36,12 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
    *  - `single`: same as `buffer` but uses the single-shot `Upload(BodyStream)` for the
    *    in-memory buffer (no chunked staging). Useful to compare buffered vs. chunked
    *    upload paths.
+   *  - `chunked-stream`: stream a circular `RandomStream` into
+   *    `BlockBlobClient::UploadFrom(BodyStream)`, which stages blocks while reading the next
+   *    ones. Memory stays bounded by `concurrency * block size` for any size.
    *
    * `--block-size` and `--concurrency` are forwarded to `UploadBlockBlobFromOptions` for
-   * the `buffer` method.
+   * the `buffer` and `chunked-stream` methods.
    */
   class UploadBlob : public Azure::Storage::Blobs::Test::BlobsTest {
   private:
@@ -82,11 +85,11 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
         m_uploadBuffer = Azure::Perf::RandomStream::Create(static_cast<size_t>(m_size))
                              ->ReadToEnd(Azure::Core::Context{});
       }
-      else if (m_uploadMethod != "stream")
+      else if (m_uploadMethod != "stream" && m_uploadMethod != "chunked-stream")
       {
         throw std::runtime_error(
             "Invalid --upload-method '" + m_uploadMethod
-            + "'. Expected one of: buffer, stream, single.");
+            + "'. Expected one of: buffer, stream, single, chunked-stream.");
       }
     }
 
@@ -108,7 +111,6 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
         m_blobClient->Upload(stream);
         return;
       }
-      // Default: buffer (chunked via UploadFrom).
       Azure::Storage::Blobs::UploadBlockBlobFromOptions opts;
       if (m_blockSize > 0)
       {
@@ -118,6 +120,13 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
       {
         opts.TransferOptions.Concurrency = m_concurrency;
       }
+      if (m_uploadMethod == "chunked-stream")
+      {
+        auto stream = Azure::Perf::RandomStream::Create(static_cast<size_t>(m_size));
+        m_blobClient->UploadFrom(*stream, opts);
+        return;
+      }
+      // Default: buffer (chunked via UploadFrom).
       m_blobClient->UploadFrom(m_uploadBuffer.data(), m_uploadBuffer.size(), opts);
     }
 
@@ -138,16 +147,18 @@ namespace Azure { namespace Storage { namespace Blobs { namespace Test {
           {"UploadMethod",
            {"--upload-method"},
            "Upload method: 'buffer' (default, chunked UploadFrom), 'stream' (Upload "
-           "BodyStream from a circular RandomStream, no contiguous buffer), or 'single' "
-           "(single-shot Upload of an in-memory buffer).",
+           "BodyStream from a circular RandomStream, no contiguous buffer), 'single' "
+           "(single-shot Upload of an in-memory buffer), or 'chunked-stream' (UploadFrom "
+           "BodyStream from a circular RandomStream, staging blocks concurrently).",
            1},
           {"BlockSize",
            {"--block-size"},
-           "Chunk size (bytes) for buffer-mode UploadFrom. Default: client default.",
+           "Chunk size (bytes) for buffer and chunked-stream UploadFrom. Default: client default.",
            1},
           {"Concurrency",
            {"--concurrency"},
-           "Per-operation concurrency for buffer-mode UploadFrom. Default: client default.",
+           "Per-operation concurrency for buffer and chunked-stream UploadFrom. Default: client "
+           "default.",
            1}};
     }
 
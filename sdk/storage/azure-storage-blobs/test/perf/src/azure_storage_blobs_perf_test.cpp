@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 
+#include "azure/storage/blobs/test/blob_directory_transfer_test.hpp"
+#include "azure/storage/blobs/test/crc64_test.hpp"
+#include "azure/storage/blobs/test/create_blob_client_test.hpp"
 #include "azure/storage/blobs/test/download_blob_from_sas.hpp"
 #include "azure/storage/blobs/test/download_blob_pipeline_only.hpp"
 #include "azure/storage/blobs/test/download_blob_test.hpp"
@@ -12,6 +15,8 @@
 #endif
 
 #include "azure/storage/blobs/test/list_blob_test.hpp"
+#include "azure/storage/blobs/test/open_read_blob_test.hpp"
+#include "azure/storage/blobs/test/shared_key_signing_test.hpp"
 #include "azure/storage/blobs/test/upload_blob_test.hpp"
 
 int main(int argc, char** argv)
@@ -25,6 +30,11 @@ int main(int argc, char** argv)
         Azure::Storage::Blobs::Test::UploadBlob::GetTestMetadata(),
         Azure::Storage::Blobs::Test::ListBlob::GetTestMetadata(),
         Azure::Storage::Blobs::Test::DownloadBlobSas::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::Crc64Test::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::SharedKeySigning::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::CreateBlobClient::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::OpenReadBlob::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::BlobDirectoryTransfer::GetTestMetadata(),
 #if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
         Azure::Storage::Blobs::Test::DownloadBlobWithTransportOnly::GetTestMetadata(),
 #endif
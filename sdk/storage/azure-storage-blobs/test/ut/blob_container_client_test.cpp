@@ -7,8 +7,10 @@
 #include <azure/storage/blobs/blob_lease_client.hpp>
 #include <azure/storage/blobs/blob_sas_builder.hpp>
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
 
 #include <chrono>
+#include <cstdio>
 #include <thread>
 
 namespace Azure { namespace Storage { namespace Blobs { namespace Models {
@@ -1853,4 +1855,68 @@ namespace Azure { namespace Storage { namespace Test {
     }
   }
 
+  TEST_F(BlobContainerClientTest, UploadDownloadDirectory_LIVEONLY_)
+  {
+    auto containerClient = *m_blobContainerClient;
+
+    const std::string sourceDirectory = "dir" + RandomString();
+    const std::string destinationDirectory = "dir" + RandomString();
+    const std::string journalPath = "journal" + RandomString();
+    const std::string prefix = "prefix" + RandomString();
+    const std::vector<std::string> relativePaths = {"a", "b", "sub/c", "sub/d", "sub/sub/e"};
+    std::vector<std::vector<uint8_t>> contents;
+    _internal::CreateDirectories(sourceDirectory + "/sub/sub");
+    for (size_t i = 0; i < relativePaths.size(); ++i)
+    {
+      contents.push_back(RandomBuffer(i == 0 ? 0 : i * 1024));
+      WriteFile(sourceDirectory + "/" + relativePaths[i], contents[i]);
+    }
+
+    // The files and blobs larger than 2 KiB are transferred in chunks.
+    Blobs::UploadBlobDirectoryOptions uploadOptions;
+    uploadOptions.TransferOptions.SingleUploadThreshold = 2048;
+    uploadOptions.TransferOptions.ChunkSize = 1000;
+    uploadOptions.TransferOptions.Concurrency = 2;
+    auto uploadResult = containerClient.UploadDirectory(sourceDirectory, prefix, uploadOptions);
+    EXPECT_EQ(uploadResult.NumberOfFilesUploaded, static_cast<int64_t>(relativePaths.size()));
+    EXPECT_EQ(uploadResult.NumberOfFilesSkipped, 0);
+    EXPECT_EQ(uploadResult.BytesUploaded, 10 * 1024);
+
+    // A placeholder of a directory isn't downloaded.
+    containerClient.GetBlockBlobClient(prefix + "/sub/").UploadFrom(nullptr, 0);
+
+    Blobs::DownloadBlobDirectoryOptions downloadOptions;
+    downloadOptions.TransferOptions.InitialChunkSize = 2048;
+    downloadOptions.TransferOptions.ChunkSize = 1000;
+    downloadOptions.JournalPath = journalPath;
+    auto downloadResult
+        = containerClient.DownloadDirectory(prefix, destinationDirectory, downloadOptions);
+    EXPECT_EQ(downloadResult.NumberOfBlobsDownloaded, static_cast<int64_t>(relativePaths.size()));
+    EXPECT_EQ(downloadResult.BytesDownloaded, 10 * 1024);
+    EXPECT_TRUE(downloadResult.UnsupportedBlobNames.empty());
+    for (size_t i = 0; i < relativePaths.size(); ++i)
+    {
+      EXPECT_EQ(ReadFile(destinationDirectory + "/" + relativePaths[i]), contents[i]);
+    }
+
+    // The blobs in the journal are skipped.
+    downloadResult
+        = containerClient.DownloadDirectory(prefix, destinationDirectory, downloadOptions);
+    EXPECT_EQ(downloadResult.NumberOfBlobsDownloaded, 0);
+    EXPECT_EQ(downloadResult.NumberOfBlobsSkipped, static_cast<int64_t>(relativePaths.size()));
+
+    for (const auto& directory : {sourceDirectory, destinationDirectory})
+    {
+      for (const auto& relativePath : relativePaths)
+      {
+        DeleteFile(directory + "/" + relativePath);
+      }
+      for (const auto& subdirectory : {"/sub/sub", "/sub", ""})
+      {
+        std::remove((directory + subdirectory).data());
+      }
+    }
+    DeleteFile(journalPath);
+  }
+
 }}} // namespace Azure::Storage::Test
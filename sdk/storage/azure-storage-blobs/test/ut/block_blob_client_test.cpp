@@ -1708,6 +1708,50 @@ namespace Azure { namespace Storage { namespace Test {
     DeleteFile(emptyFilename);
   }
 
+  TEST_F(BlockBlobClientTest, OpenRead_LIVEONLY_)
+  {
+    auto blobClient = m_blobContainerClient->GetBlockBlobClient(RandomString());
+    const auto blobContent = RandomBuffer(static_cast<size_t>(1_MB + 123));
+    blobClient.UploadFrom(blobContent.data(), blobContent.size());
+
+    Blobs::OpenReadBlobOptions options;
+    options.TransferOptions.ChunkSize = 64_KB;
+    options.TransferOptions.Concurrency = 4;
+    options.TransferOptions.MaxCachedChunks = 6;
+    auto stream = blobClient.OpenRead(options);
+    EXPECT_EQ(stream->Length(), static_cast<int64_t>(blobContent.size()));
+    EXPECT_EQ(stream->ReadToEnd(), blobContent);
+
+    for (int i = 0; i < 16; ++i)
+    {
+      const auto offset = static_cast<size_t>(RandomInt(0, 1_MB));
+      const auto length = static_cast<size_t>(RandomInt(1, 200_KB));
+      stream->Seek(static_cast<int64_t>(offset));
+      std::vector<uint8_t> buffer(length);
+      buffer.resize(stream->ReadToCount(buffer.data(), buffer.size()));
+      EXPECT_EQ(stream->Position(), static_cast<int64_t>(offset + buffer.size()));
+      EXPECT_EQ(
+          buffer,
+          std::vector<uint8_t>(
+              blobContent.begin() + offset,
+              blobContent.begin() + (std::min)(offset + length, blobContent.size())));
+    }
+    EXPECT_THROW(stream->Seek(stream->Length() + 1), std::out_of_range);
+
+    // The stream keeps reading the version of the blob it opened.
+    auto reopenedStream = blobClient.OpenRead(options);
+    blobClient.UploadFrom(blobContent.data(), blobContent.size());
+    try
+    {
+      reopenedStream->ReadToEnd();
+      FAIL();
+    }
+    catch (const StorageException& e)
+    {
+      EXPECT_EQ(e.StatusCode, Azure::Core::Http::HttpStatusCode::PreconditionFailed);
+    }
+  }
+
   TEST_F(BlockBlobClientTest, ConcurrentDownloadEmptyBlob)
   {
     auto blockBlobClient = GetBlockBlobClientForTest(RandomString());
@@ -2079,6 +2123,47 @@ namespace Azure { namespace Storage { namespace Test {
     }
   }
 
+  TEST_F(BlockBlobClientTest, ConcurrentUploadFromStream_LIVEONLY_)
+  {
+    const auto blobContent = RandomBuffer(static_cast<size_t>(1_MB));
+
+    auto testUploadFromStream
+        = [&](int concurrency, int64_t contentSize, Azure::Nullable<int64_t> chunkSize = {}) {
+            Blobs::UploadBlockBlobFromOptions options;
+            options.TransferOptions.Concurrency = concurrency;
+            if (chunkSize.HasValue())
+            {
+              options.TransferOptions.ChunkSize = chunkSize.Value();
+            }
+
+            auto blobClient = m_blobContainerClient->GetBlockBlobClient(RandomString());
+            Azure::Core::IO::MemoryBodyStream contentStream(
+                blobContent.data(), static_cast<size_t>(contentSize));
+            EXPECT_NO_THROW(blobClient.UploadFrom(contentStream, options));
+            std::vector<uint8_t> downloadBuffer(static_cast<size_t>(contentSize), '\x00');
+            blobClient.DownloadTo(downloadBuffer.data(), downloadBuffer.size());
+            std::vector<uint8_t> expectedData(
+                blobContent.begin(), blobContent.begin() + static_cast<size_t>(contentSize));
+            EXPECT_EQ(downloadBuffer, expectedData);
+            return blobClient.GetBlockList().Value.CommittedBlocks.size();
+          };
+
+    // Content shorter than a chunk is uploaded in one request, without blocks.
+    EXPECT_EQ(testUploadFromStream(4, 0, 64_KB), 0U);
+    EXPECT_EQ(testUploadFromStream(4, 1_KB, 64_KB), 0U);
+    EXPECT_EQ(testUploadFromStream(4, 64_KB, 64_KB), 1U);
+    EXPECT_EQ(testUploadFromStream(4, 64_KB + 1, 64_KB), 2U);
+    for (int c : {1, 2, 4})
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        int64_t contentSize = RandomInt(1, 1_MB);
+        testUploadFromStream(c, contentSize, 47_KB);
+      }
+    }
+    testUploadFromStream(4, 1_MB);
+  }
+
   TEST_F(BlockBlobClientTest, MaxUploadBlockSize)
   {
 #ifdef _WIN64
@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/transfer_checkpoint.hpp"
+
+#include <azure/core/base64.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  namespace {
+    const std::vector<uint8_t> Crc64A = {1, 2, 3, 4, 5, 6, 7, 8};
+    const std::vector<uint8_t> Crc64B = {8, 7, 6, 5, 4, 3, 2, 1};
+
+    // A checkpoint file named after the test, deleted after it.
+    class CheckpointFile final {
+    public:
+      CheckpointFile()
+          : Path(
+              std::string(::testing::UnitTest::GetInstance()->current_test_info()->name())
+              + ".checkpoint")
+      {
+        std::remove(Path.data());
+      }
+      ~CheckpointFile() { std::remove(Path.data()); }
+
+      void Write(const std::string& content) const
+      {
+        std::ofstream(Path, std::ios::binary) << content;
+      }
+
+      std::string Read() const
+      {
+        std::ifstream file(Path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+      }
+
+      const std::string Path;
+    };
+
+    std::string ChunkLine(int64_t offset, const std::vector<uint8_t>& crc64)
+    {
+      return std::to_string(offset) + " " + Core::Convert::Base64Encode(crc64) + "\n";
+    }
+  } // namespace
+
+  TEST(TransferCheckpointTest, CutLastLine)
+  {
+    CheckpointFile file;
+    const std::string cutLine = ChunkLine(4096, Crc64B).substr(0, 10);
+    file.Write("upload a\n" + ChunkLine(0, Crc64A) + cutLine);
+
+    {
+      Blobs::_detail::TransferCheckpoint checkpoint(file.Path);
+      EXPECT_EQ(checkpoint.GetDescription(), "upload a");
+      EXPECT_TRUE(checkpoint.Open("upload a"));
+      EXPECT_TRUE(checkpoint.HasChunk(0, Crc64A));
+      EXPECT_FALSE(checkpoint.HasChunk(4096, Crc64B));
+      checkpoint.AddChunk(8192, Crc64B);
+    }
+
+    // The cut line is ended before the next chunk, so that it doesn't corrupt it.
+    EXPECT_EQ(
+        file.Read(),
+        "upload a\n" + ChunkLine(0, Crc64A) + cutLine + "\n" + ChunkLine(8192, Crc64B));
+    Blobs::_detail::TransferCheckpoint checkpoint(file.Path);
+    EXPECT_TRUE(checkpoint.Open("upload a"));
+    EXPECT_TRUE(checkpoint.HasChunk(0, Crc64A));
+    EXPECT_FALSE(checkpoint.HasChunk(4096, Crc64B));
+    EXPECT_TRUE(checkpoint.HasChunk(8192, Crc64B));
+  }
+
+  TEST(TransferCheckpointTest, DescriptionMismatch)
+  {
+    CheckpointFile file;
+    file.Write("upload a\n" + ChunkLine(0, Crc64A));
+
+    {
+      Blobs::_detail::TransferCheckpoint checkpoint(file.Path);
+      EXPECT_EQ(checkpoint.GetDescription(), "upload a");
+      EXPECT_FALSE(checkpoint.Open("upload b"));
+      EXPECT_EQ(checkpoint.GetDescription(), "upload b");
+      EXPECT_FALSE(checkpoint.HasChunk(0, Crc64A));
+      checkpoint.AddChunk(4096, Crc64B);
+    }
+
+    EXPECT_EQ(file.Read(), "upload b\n" + ChunkLine(4096, Crc64B));
+    Blobs::_detail::TransferCheckpoint checkpoint(file.Path);
+    EXPECT_TRUE(checkpoint.Open("upload b"));
+    EXPECT_FALSE(checkpoint.HasChunk(0, Crc64A));
+    EXPECT_TRUE(checkpoint.HasChunk(4096, Crc64B));
+  }
+
+  TEST(TransferCheckpointTest, HasChunk)
+  {
+    CheckpointFile file;
+    file.Write("upload a\n" + ChunkLine(0, Crc64A) + "4096 not base64\n");
+
+    Blobs::_detail::TransferCheckpoint checkpoint(file.Path);
+    EXPECT_TRUE(checkpoint.Open("upload a"));
+    EXPECT_TRUE(checkpoint.HasChunk(0, Crc64A));
+    // The chunk was transferred with another content.
+    EXPECT_FALSE(checkpoint.HasChunk(0, Crc64B));
+    EXPECT_FALSE(checkpoint.HasChunk(0, {}));
+    EXPECT_FALSE(checkpoint.HasChunk(1024, Crc64A));
+    EXPECT_FALSE(checkpoint.HasChunk(4096, Crc64A));
+
+    checkpoint.Remove();
+    EXPECT_FALSE(std::ifstream(file.Path).good());
+  }
+
+}}} // namespace Azure::Storage::Test
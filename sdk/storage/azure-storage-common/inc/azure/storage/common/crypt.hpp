@@ -7,6 +7,7 @@
 #include <azure/core/cryptography/hash.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,50 @@ namespace Azure { namespace Storage {
   };
 
   namespace _internal {
+    /**
+     * @brief An HMAC-SHA256 key to sign many messages with. The padded key is hashed once, when
+     * the key is created, instead of for each message.
+     */
+    class HmacSha256Key final {
+    public:
+      /**
+       * @brief Initializes a new instance of the HmacSha256Key.
+       *
+       * @param key The secret key.
+       */
+      explicit HmacSha256Key(const std::vector<uint8_t>& key);
+
+      ~HmacSha256Key();
+
+      /**
+       * @brief Computes the HMAC-SHA256 of the data. Can be called from many threads at once.
+       *
+       * @param data The data to sign.
+       * @param length The size of the data.
+       * @return The HMAC-SHA256 of the data.
+       */
+      std::vector<uint8_t> Sign(const uint8_t* data, size_t length) const;
+
+      /**
+       * @brief Computes the HMAC-SHA256 of the data into a buffer. Can be called from many threads
+       * at once.
+       *
+       * @param data The data to sign.
+       * @param length The size of the data.
+       * @param hash The buffer the HMAC-SHA256 is written to, of #HashSize bytes.
+       */
+      void Sign(const uint8_t* data, size_t length, uint8_t* hash) const;
+
+      /**
+       * @brief The size of an HMAC-SHA256.
+       */
+      static constexpr size_t HashSize = 32;
+
+    private:
+      struct State;
+      std::unique_ptr<State> m_state;
+    };
+
     std::vector<uint8_t> HmacSha256(
         const std::vector<uint8_t>& data,
         const std::vector<uint8_t>& key);
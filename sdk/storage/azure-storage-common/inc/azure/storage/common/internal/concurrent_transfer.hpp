@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <azure/core/context.hpp>
+#include <azure/core/io/body_stream.hpp>
+
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <future>
@@ -15,56 +19,51 @@ namespace Azure { namespace Storage { namespace _internal {
 
   int GetHardwareConcurrency();
 
-  inline void ConcurrentTransfer(
+  /**
+   * @brief Transfers a range in chunks, up to \p concurrency chunks at a time.
+   *
+   * @details The calling thread transfers chunks, and up to `concurrency - 1` tasks of the
+   * #Azure::Storage::TransferExecutor transfer the others. Each task transfers one chunk and then
+   * submits the next one, so that the transfers sharing the executor take turns.
+   *
+   * @param offset The offset of the range.
+   * @param length The length of the range.
+   * @param chunkSize The size of the chunks.
+   * @param concurrency The maximum number of chunks transferred at the same time.
+   * @param transferFunc Transfers a chunk, given its offset, its length, its ID and the number of
+   * chunks.
+   */
+  void ConcurrentTransfer(
       int64_t offset,
       int64_t length,
       int64_t chunkSize,
       int concurrency,
       // offset, length, chunk ID, number of chunks
-      std::function<void(int64_t, int64_t, int64_t, int64_t)> transferFunc)
-  {
-    std::atomic<int> numWorkingThreads{concurrency};
-    std::atomic<int> nextChunkId{0};
-    std::atomic<bool> failed{false};
-
-    const auto numChunks = (length + chunkSize - 1) / chunkSize;
-
-    auto threadFunc = [&]() {
-      while (true)
-      {
-        int chunkId = nextChunkId.fetch_add(1);
-        if (chunkId >= numChunks || failed)
-        {
-          break;
-        }
-        int64_t chunkOffset = offset + chunkSize * chunkId;
-        int64_t chunkLength = (std::min)(length - chunkSize * chunkId, chunkSize);
-        try
-        {
-          transferFunc(chunkOffset, chunkLength, chunkId, numChunks);
-        }
-        catch (const std::exception&)
-        {
-          if (failed.exchange(true) == false)
-          {
-            numWorkingThreads.fetch_sub(1);
-            throw;
-          }
-        }
-      }
-      numWorkingThreads.fetch_sub(1);
-    };
+      std::function<void(int64_t, int64_t, int64_t, int64_t)> transferFunc);
 
-    std::vector<std::future<void>> threadHandles;
-    for (int i = 0; i < std::min<int64_t>(concurrency, numChunks) - 1; ++i)
-    {
-      threadHandles.emplace_back(std::async(std::launch::async, threadFunc));
-    }
-    threadFunc();
-    for (auto& handle : threadHandles)
-    {
-      handle.get();
-    }
-  }
+  /**
+   * @brief Reads a stream of unknown length in chunks and transfers up to \p concurrency chunks at
+   * a time while reading the next ones.
+   *
+   * @details The stream is read on the calling thread into a pool of at most \p concurrency
+   * buffers of \p chunkSize bytes, allocated as they are needed, and each chunk is transferred by
+   * a task of the #Azure::Storage::TransferExecutor. When no buffer is free, the calling thread
+   * transfers the oldest chunk not started yet instead of waiting for the executor. Every chunk
+   * but the last one is \p chunkSize bytes long.
+   *
+   * @param stream The stream to read. It doesn't need to be seekable.
+   * @param chunkSize The size of the chunks.
+   * @param concurrency The maximum number of chunks transferred at the same time.
+   * @param transferFunc Transfers a chunk, given its content, its length and its ID.
+   * @param context The context of the reads.
+   * @return The number of chunks transferred, 0 for an empty stream.
+   */
+  int64_t ConcurrentTransferFromStream(
+      Azure::Core::IO::BodyStream& stream,
+      int64_t chunkSize,
+      int concurrency,
+      // chunk content, chunk length, chunk ID
+      std::function<void(const uint8_t*, size_t, int64_t)> transferFunc,
+      const Azure::Core::Context& context);
 
 }}} // namespace Azure::Storage::_internal
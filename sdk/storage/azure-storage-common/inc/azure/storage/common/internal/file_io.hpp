@@ -6,6 +6,7 @@
 #include <azure/core/platform.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <string>
 
 namespace Azure { namespace Storage { namespace _internal {
@@ -33,7 +34,8 @@ namespace Azure { namespace Storage { namespace _internal {
 
   class FileWriter final {
   public:
-    FileWriter(const std::string& filename);
+    // Truncates the file, unless truncate is false. Then the file can be read from the handle too.
+    FileWriter(const std::string& filename, bool truncate = true);
 
     ~FileWriter();
 
@@ -41,8 +43,21 @@ namespace Azure { namespace Storage { namespace _internal {
 
     void Write(const uint8_t* buffer, size_t length, int64_t offset);
 
+    // Sets the size of the file, cutting the bytes past it or extending it with zeros.
+    void SetSize(int64_t size);
+
   private:
     FileHandle m_handle;
   };
 
+  // Calls onFile with the path relative to directory, separated with '/', and the size of each
+  // regular file in directory and its subdirectories. Symbolic links to directories aren't
+  // followed.
+  void ForEachFile(
+      const std::string& directory,
+      const std::function<void(const std::string& relativePath, int64_t fileSize)>& onFile);
+
+  // Creates a directory and its missing parents.
+  void CreateDirectories(const std::string& path);
+
 }}} // namespace Azure::Storage::_internal
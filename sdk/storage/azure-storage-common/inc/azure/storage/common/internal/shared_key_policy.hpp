@@ -31,13 +31,12 @@ namespace Azure { namespace Storage { namespace _internal {
         Core::Http::Policies::NextHttpPolicy nextPolicy,
         Core::Context const& context) const override
     {
-      request.SetHeader(
-          "Authorization", "SharedKey " + m_credential->AccountName + ":" + GetSignature(request));
+      request.SetHeader("Authorization", GetAuthorizationHeader(request));
       return nextPolicy.Send(request, context);
     }
 
   private:
-    std::string GetSignature(const Core::Http::Request& request) const;
+    std::string GetAuthorizationHeader(const Core::Http::Request& request) const;
 
     std::shared_ptr<StorageSharedKeyCredential> m_credential;
   };
@@ -19,12 +19,18 @@ namespace Azure { namespace Storage { namespace _internal {
      * @param credential An #Azure::Core::TokenCredential to use with this policy.
      * @param tokenRequestContext A context to get the token in.
      * @param enableTenantDiscovery Enables tenant discovery through the authorization challenge.
+     * @param tokenRefreshWindow A token expiring within this window is refreshed in the
+     * background while requests keep using it.
      */
     explicit StorageBearerTokenAuthenticationPolicy(
         std::shared_ptr<const Azure::Core::Credentials::TokenCredential> credential,
         Azure::Core::Credentials::TokenRequestContext tokenRequestContext,
-        bool enableTenantDiscovery)
-        : BearerTokenAuthenticationPolicy(std::move(credential), tokenRequestContext),
+        bool enableTenantDiscovery,
+        DateTime::duration tokenRefreshWindow = DateTime::duration::zero())
+        : BearerTokenAuthenticationPolicy(
+            std::move(credential),
+            tokenRequestContext,
+            tokenRefreshWindow),
           m_scopes(tokenRequestContext.Scopes), m_safeTenantId(tokenRequestContext.TenantId),
           m_enableTenantDiscovery(enableTenantDiscovery)
     {
@@ -21,7 +21,8 @@ namespace Azure { namespace Storage {
 
   namespace _internal {
     class SharedKeyPolicy;
-  }
+    class HmacSha256Key;
+  } // namespace _internal
 
   /**
    * @brief A StorageSharedKeyCredential is a credential backed by a storage account's name and
@@ -51,6 +52,7 @@ namespace Azure { namespace Storage {
     {
       std::lock_guard<std::mutex> guard(m_mutex);
       m_accountKey = std::move(accountKey);
+      m_signingKey.reset();
     }
 
     /**
@@ -71,8 +73,12 @@ namespace Azure { namespace Storage {
       return m_accountKey;
     }
 
+    // The account key ready to sign requests, created on first use and after each update.
+    std::shared_ptr<const _internal::HmacSha256Key> GetSigningKey() const;
+
     mutable std::mutex m_mutex;
     std::string m_accountKey;
+    mutable std::shared_ptr<const _internal::HmacSha256Key> m_signingKey;
   };
 
   namespace _internal {
@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Storage {
+
+  namespace _internal {
+    int GetHardwareConcurrency();
+  } // namespace _internal
+
+  /**
+   * @brief Runs the chunk transfers of the parallel uploads and downloads of the storage clients.
+   *
+   * @details Implement it to run the transfers on an executor of the application, and set it
+   * with #Azure::Storage::SetTransferExecutor.
+   */
+  class TransferExecutor {
+  public:
+    /**
+     * @brief Destructs the executor.
+     *
+     */
+    virtual ~TransferExecutor() = default;
+
+    /**
+     * @brief Runs a task on another thread.
+     *
+     * @remark The task must not be run on the calling thread, since tasks submit other tasks. The
+     * tasks don't throw, and each one transfers at most one chunk before submitting the next task
+     * of its operation, so that the operations sharing the executor take turns.
+     *
+     * @param task The task to run.
+     */
+    virtual void Execute(std::function<void()> task) = 0;
+
+  protected:
+    TransferExecutor() = default;
+    TransferExecutor(const TransferExecutor&) = default;
+    TransferExecutor& operator=(const TransferExecutor&) = default;
+  };
+
+  /**
+   * @brief The options of a #Azure::Storage::TransferThreadPool.
+   *
+   */
+  struct TransferThreadPoolOptions final
+  {
+    /**
+     * @brief The maximum number of threads of the pool.
+     */
+    int32_t MaxThreads = (std::max)(32, 4 * _internal::GetHardwareConcurrency());
+  };
+
+  /**
+   * @brief A pool of threads running the tasks in the order they are submitted.
+   *
+   * @details The threads are started as the tasks need them, up to `MaxThreads`, and then
+   * reused. The storage clients share one pool by default, which bounds the number of threads
+   * transferring chunks in the process whatever the number and the concurrency of the transfers.
+   */
+  class TransferThreadPool final : public TransferExecutor {
+  public:
+    /**
+     * @brief Constructs a pool with no threads.
+     *
+     * @param options The options of the pool.
+     */
+    explicit TransferThreadPool(
+        const TransferThreadPoolOptions& options = TransferThreadPoolOptions());
+
+    /**
+     * @brief Destructs the pool, after running the tasks submitted.
+     *
+     */
+    ~TransferThreadPool() override;
+
+    void Execute(std::function<void()> task) override;
+
+    /**
+     * @brief Get the number of threads started by the pool.
+     *
+     */
+    int32_t GetThreadCount() const;
+
+  private:
+    const size_t m_maxThreads;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    std::deque<std::function<void()>> m_tasks;
+    std::vector<std::thread> m_threads;
+    size_t m_idleThreads = 0;
+    bool m_stopping = false;
+
+    TransferThreadPool(const TransferThreadPool&) = delete;
+    TransferThreadPool& operator=(const TransferThreadPool&) = delete;
+
+    void Run();
+  };
+
+  /**
+   * @brief Sets the executor of the chunk transfers of all the storage clients of the process.
+   *
+   * @remark The transfers in progress keep the executor they started with.
+   *
+   * @param executor The executor, or `nullptr` to use the default
+   * #Azure::Storage::TransferThreadPool again.
+   */
+  void SetTransferExecutor(std::shared_ptr<TransferExecutor> executor);
+
+  /**
+   * @brief Get the executor of the chunk transfers of the storage clients.
+   *
+   */
+  std::shared_ptr<TransferExecutor> GetTransferExecutor();
+
+}} // namespace Azure::Storage
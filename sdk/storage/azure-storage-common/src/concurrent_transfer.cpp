@@ -3,14 +3,304 @@
 
 #include "azure/storage/common/internal/concurrent_transfer.hpp"
 
+#include "azure/storage/common/transfer_executor.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 namespace Azure { namespace Storage { namespace _internal {
 
+  namespace {
+    // The state of a transfer, shared with its tasks, which can run after the transfer returned.
+    struct TransferState final
+    {
+      int64_t Offset;
+      int64_t Length;
+      int64_t ChunkSize;
+      int64_t NumChunks;
+      const std::function<void(int64_t, int64_t, int64_t, int64_t)>* TransferFunc;
+      TransferExecutor* Executor;
+
+      std::mutex Mutex;
+      std::condition_variable ChunkDone;
+      int64_t NextChunkId = 0;
+      int64_t RunningChunks = 0;
+      std::exception_ptr Failure;
+    };
+
+    // Transfers the next chunk, or returns false once all the chunks are claimed or a chunk
+    // failed. The transfer waits for the chunks claimed, so TransferFunc and Executor are only
+    // used before it returns, and the tasks don't keep the executor alive.
+    bool TransferNextChunk(const std::shared_ptr<TransferState>& state, bool submitNext)
+    {
+      int64_t chunkId;
+      {
+        std::lock_guard<std::mutex> guard(state->Mutex);
+        if (state->NextChunkId >= state->NumChunks || state->Failure != nullptr)
+        {
+          return false;
+        }
+        chunkId = state->NextChunkId++;
+        ++state->RunningChunks;
+      }
+
+      std::exception_ptr failure;
+      try
+      {
+        (*state->TransferFunc)(
+            state->Offset + state->ChunkSize * chunkId,
+            (std::min)(state->Length - state->ChunkSize * chunkId, state->ChunkSize),
+            chunkId,
+            state->NumChunks);
+      }
+      catch (...)
+      {
+        failure = std::current_exception();
+      }
+
+      // The next chunk of this task is queued after the chunks of the other transfers. It's
+      // submitted while this chunk still counts as running, so that the transfer hasn't returned.
+      if (submitNext && failure == nullptr)
+      {
+        try
+        {
+          state->Executor->Execute([state]() { TransferNextChunk(state, true); });
+        }
+        catch (...)
+        {
+          // The other tasks and the thread waiting for the transfer transfer the remaining chunks.
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> guard(state->Mutex);
+        if (failure != nullptr && state->Failure == nullptr)
+        {
+          state->Failure = failure;
+        }
+        --state->RunningChunks;
+      }
+      state->ChunkDone.notify_all();
+      return true;
+    }
+  } // namespace
+
   int GetHardwareConcurrency()
   {
     static int c = static_cast<int>(std::thread::hardware_concurrency());
     return c;
   }
 
+  void ConcurrentTransfer(
+      int64_t offset,
+      int64_t length,
+      int64_t chunkSize,
+      int concurrency,
+      std::function<void(int64_t, int64_t, int64_t, int64_t)> transferFunc)
+  {
+    const auto executor = GetTransferExecutor();
+    auto state = std::make_shared<TransferState>();
+    state->Offset = offset;
+    state->Length = length;
+    state->ChunkSize = chunkSize;
+    state->NumChunks = (length + chunkSize - 1) / chunkSize;
+    state->TransferFunc = &transferFunc;
+    state->Executor = executor.get();
+
+    for (int64_t i = 0; i < (std::min<int64_t>)(concurrency, state->NumChunks) - 1; ++i)
+    {
+      try
+      {
+        executor->Execute([state]() { TransferNextChunk(state, true); });
+      }
+      catch (...)
+      {
+        // This thread transfers the chunks alone.
+        break;
+      }
+    }
+    while (TransferNextChunk(state, false))
+    {
+    }
+
+    std::unique_lock<std::mutex> guard(state->Mutex);
+    state->ChunkDone.wait(guard, [&state]() { return state->RunningChunks == 0; });
+    if (state->Failure != nullptr)
+    {
+      std::rethrow_exception(state->Failure);
+    }
+  }
+
+  int64_t ConcurrentTransferFromStream(
+      Azure::Core::IO::BodyStream& stream,
+      int64_t chunkSize,
+      int concurrency,
+      std::function<void(const uint8_t*, size_t, int64_t)> transferFunc,
+      const Azure::Core::Context& context)
+  {
+    struct StreamTransferState final
+    {
+      std::mutex Mutex;
+      std::condition_variable ChunkDone;
+      std::vector<uint8_t*> FreeBuffers;
+      // The chunks read but not transferred yet, oldest first. Each has a task submitted to the
+      // executor, which transfers the oldest one, unless this thread did it already.
+      std::deque<std::function<void()>> PendingChunks;
+      int64_t RunningChunks = 0;
+      std::exception_ptr Failure;
+    };
+
+    // Transfers the oldest pending chunk, or returns false if there's none.
+    auto transferPendingChunk = [](const std::shared_ptr<StreamTransferState>& state) {
+      std::function<void()> transferChunk;
+      {
+        std::lock_guard<std::mutex> guard(state->Mutex);
+        if (state->PendingChunks.empty())
+        {
+          return false;
+        }
+        transferChunk = std::move(state->PendingChunks.front());
+        state->PendingChunks.pop_front();
+      }
+      transferChunk();
+      return true;
+    };
+
+    const auto bufferSize = static_cast<size_t>(chunkSize);
+    const auto maxBuffers = static_cast<size_t>((std::max)(concurrency, 1));
+    auto state = std::make_shared<StreamTransferState>();
+    const auto* transferFuncPtr = &transferFunc;
+
+    // Only this thread allocates the buffers. They and transferFunc are used by the tasks until
+    // the last running chunk is done, which this transfer waits for.
+    std::vector<std::unique_ptr<uint8_t[]>> buffers;
+    const auto executor = GetTransferExecutor();
+    int64_t numChunks = 0;
+    try
+    {
+      while (true)
+      {
+        uint8_t* buffer = nullptr;
+        {
+          std::unique_lock<std::mutex> guard(state->Mutex);
+          if (buffers.size() == maxBuffers)
+          {
+            // When the executor is busy, this thread transfers the oldest pending chunk instead of
+            // waiting for it, so the transfer doesn't stall behind the other work of the executor.
+            state->ChunkDone.wait(guard, [&state]() {
+              return !state->FreeBuffers.empty() || !state->PendingChunks.empty()
+                  || state->Failure;
+            });
+          }
+          if (state->Failure != nullptr)
+          {
+            break;
+          }
+          if (!state->FreeBuffers.empty())
+          {
+            buffer = state->FreeBuffers.back();
+            state->FreeBuffers.pop_back();
+          }
+          else if (buffers.size() == maxBuffers)
+          {
+            guard.unlock();
+            transferPendingChunk(state);
+            continue;
+          }
+        }
+        if (buffer == nullptr)
+        {
+          buffers.emplace_back(new uint8_t[bufferSize]);
+          buffer = buffers.back().get();
+        }
+
+        const size_t length = stream.ReadToCount(buffer, bufferSize, context);
+        if (length == 0)
+        {
+          break;
+        }
+
+        const int64_t chunkId = numChunks++;
+        {
+          std::lock_guard<std::mutex> guard(state->Mutex);
+          ++state->RunningChunks;
+        }
+        auto transferChunk = [state, transferFuncPtr, buffer, length, chunkId]() {
+          std::exception_ptr failure;
+          try
+          {
+            bool failed;
+            {
+              std::lock_guard<std::mutex> guard(state->Mutex);
+              failed = state->Failure != nullptr;
+            }
+            if (!failed)
+            {
+              (*transferFuncPtr)(buffer, length, chunkId);
+            }
+          }
+          catch (...)
+          {
+            failure = std::current_exception();
+          }
+
+          {
+            std::lock_guard<std::mutex> guard(state->Mutex);
+            if (failure != nullptr && state->Failure == nullptr)
+            {
+              state->Failure = failure;
+            }
+            state->FreeBuffers.push_back(buffer);
+            --state->RunningChunks;
+          }
+          state->ChunkDone.notify_all();
+        };
+        {
+          std::lock_guard<std::mutex> guard(state->Mutex);
+          state->PendingChunks.push_back(std::move(transferChunk));
+        }
+        try
+        {
+          executor->Execute([state, transferPendingChunk]() { transferPendingChunk(state); });
+        }
+        catch (...)
+        {
+          transferPendingChunk(state);
+        }
+
+        if (length < bufferSize)
+        {
+          break;
+        }
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> guard(state->Mutex);
+      if (state->Failure == nullptr)
+      {
+        state->Failure = std::current_exception();
+      }
+    }
+
+    // The chunks still pending are transferred here rather than waited for. The tasks submitted
+    // for them find no chunk left, and don't use the buffers or transferFunc.
+    while (transferPendingChunk(state))
+    {
+    }
+
+    std::unique_lock<std::mutex> guard(state->Mutex);
+    state->ChunkDone.wait(guard, [&state]() { return state->RunningChunks == 0; });
+    if (state->Failure != nullptr)
+    {
+      std::rethrow_exception(state->Failure);
+    }
+    return numChunks;
+  }
+
 }}} // namespace Azure::Storage::_internal
@@ -36,6 +36,20 @@
 #include <stdexcept>
 #include <vector>
 
+#if defined(__x86_64__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+#define _azure_CRC64_X64_KERNELS
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define _azure_CRC64_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#else
+#define _azure_CRC64_TARGET(instructionSet)
+#endif
+#endif
+
 namespace Azure { namespace Storage {
 
   namespace _internal {
@@ -155,82 +169,204 @@ namespace Azure { namespace Storage {
       ~AlgorithmProviderInstance() { BCryptCloseAlgorithmProvider(Handle, 0); }
     };
 
-    std::vector<uint8_t> HmacSha256(
-        const std::vector<uint8_t>& data,
-        const std::vector<uint8_t>& key)
+    static AlgorithmProviderInstance& GetHmacSha256AlgorithmProvider()
     {
-      AZURE_ASSERT_MSG(data.size() <= (std::numeric_limits<ULONG>::max)(), "Data size is too big.");
-
       static AlgorithmProviderInstance AlgorithmProvider(AlgorithmType::HmacSha256);
+      return AlgorithmProvider;
+    }
 
-      std::string context;
-      context.resize(AlgorithmProvider.ContextSize);
+    // A hash object created with the key, which each signature duplicates.
+    struct HmacSha256Key::State final
+    {
+      std::string HashObject;
+      BCRYPT_HASH_HANDLE HashHandle = nullptr;
 
-      BCRYPT_HASH_HANDLE hashHandle;
+      ~State()
+      {
+        if (HashHandle != nullptr)
+        {
+          BCryptDestroyHash(HashHandle);
+        }
+      }
+    };
+
+    HmacSha256Key::HmacSha256Key(const std::vector<uint8_t>& key)
+        : m_state(std::make_unique<State>())
+    {
+      auto& algorithmProvider = GetHmacSha256AlgorithmProvider();
+      m_state->HashObject.resize(algorithmProvider.ContextSize);
       NTSTATUS status = BCryptCreateHash(
-          AlgorithmProvider.Handle,
+          algorithmProvider.Handle,
+          &m_state->HashHandle,
+          reinterpret_cast<PUCHAR>(&m_state->HashObject[0]),
+          static_cast<ULONG>(m_state->HashObject.size()),
+          reinterpret_cast<PUCHAR>(const_cast<uint8_t*>(key.data())),
+          static_cast<ULONG>(key.size()),
+          0);
+      if (!BCRYPT_SUCCESS(status))
+      {
+        m_state->HashHandle = nullptr;
+        throw std::runtime_error("BCryptCreateHash failed.");
+      }
+    }
+
+    void HmacSha256Key::Sign(const uint8_t* data, size_t length, uint8_t* hash) const
+    {
+      AZURE_ASSERT_MSG(length <= (std::numeric_limits<ULONG>::max)(), "Data size is too big.");
+
+      auto& algorithmProvider = GetHmacSha256AlgorithmProvider();
+
+      // Each thread duplicates the hash object into its own buffer, which is kept from one
+      // signature to the next.
+      thread_local std::string context;
+      context.resize(algorithmProvider.ContextSize);
+
+      BCRYPT_HASH_HANDLE hashHandle;
+      NTSTATUS status = BCryptDuplicateHash(
+          m_state->HashHandle,
           &hashHandle,
           reinterpret_cast<PUCHAR>(&context[0]),
           static_cast<ULONG>(context.size()),
-          reinterpret_cast<PUCHAR>(const_cast<uint8_t*>(&key[0])),
-          static_cast<ULONG>(key.size()),
           0);
       if (!BCRYPT_SUCCESS(status))
       {
-        throw std::runtime_error("BCryptCreateHash failed.");
+        throw std::runtime_error("BCryptDuplicateHash failed.");
       }
 
       status = BCryptHashData(
           hashHandle,
-          reinterpret_cast<PBYTE>(const_cast<uint8_t*>(data.data())),
-          static_cast<ULONG>(data.size()),
+          reinterpret_cast<PBYTE>(const_cast<uint8_t*>(data)),
+          static_cast<ULONG>(length),
           0);
       if (!BCRYPT_SUCCESS(status))
       {
+        BCryptDestroyHash(hashHandle);
         throw std::runtime_error("BCryptHashData failed.");
       }
 
-      std::vector<uint8_t> hash;
-      hash.resize(AlgorithmProvider.HashLength);
+      AZURE_ASSERT(algorithmProvider.HashLength == HashSize);
       status = BCryptFinishHash(
-          hashHandle, reinterpret_cast<PUCHAR>(&hash[0]), static_cast<ULONG>(hash.size()), 0);
+          hashHandle, reinterpret_cast<PUCHAR>(hash), static_cast<ULONG>(HashSize), 0);
+      BCryptDestroyHash(hashHandle);
       if (!BCRYPT_SUCCESS(status))
       {
         throw std::runtime_error("BCryptFinishHash failed.");
       }
+    }
+  } // namespace _internal
 
-      BCryptDestroyHash(hashHandle);
+#elif defined(AZ_PLATFORM_POSIX)
 
-      return hash;
+  namespace _internal {
+
+    // The inner and outer hashes of HMAC (RFC 2104) after the padded key, which each signature
+    // copies.
+    struct HmacSha256Key::State final
+    {
+      EVP_MD_CTX* Inner = EVP_MD_CTX_new();
+      EVP_MD_CTX* Outer = EVP_MD_CTX_new();
+
+      ~State()
+      {
+        EVP_MD_CTX_free(Inner);
+        EVP_MD_CTX_free(Outer);
+      }
+    };
+
+    HmacSha256Key::HmacSha256Key(const std::vector<uint8_t>& key)
+        : m_state(std::make_unique<State>())
+    {
+      constexpr size_t BlockSize = 64;
+      if (m_state->Inner == nullptr || m_state->Outer == nullptr)
+      {
+        throw std::runtime_error("Crypto error while creating EVP context.");
+      }
+
+      // A key longer than a block is replaced by its hash.
+      uint8_t paddedKey[BlockSize] = {};
+      if (key.size() > BlockSize)
+      {
+        unsigned int hashLength = 0;
+        if (1 != EVP_Digest(key.data(), key.size(), paddedKey, &hashLength, EVP_sha256(), nullptr))
+        {
+          throw std::runtime_error("Crypto error while hashing the HMAC key.");
+        }
+      }
+      else
+      {
+        std::copy(key.begin(), key.end(), paddedKey);
+      }
+
+      uint8_t innerPad[BlockSize];
+      uint8_t outerPad[BlockSize];
+      for (size_t i = 0; i < BlockSize; ++i)
+      {
+        innerPad[i] = static_cast<uint8_t>(paddedKey[i] ^ 0x36);
+        outerPad[i] = static_cast<uint8_t>(paddedKey[i] ^ 0x5c);
+      }
+      if (1 != EVP_DigestInit_ex(m_state->Inner, EVP_sha256(), nullptr)
+          || 1 != EVP_DigestUpdate(m_state->Inner, innerPad, BlockSize)
+          || 1 != EVP_DigestInit_ex(m_state->Outer, EVP_sha256(), nullptr)
+          || 1 != EVP_DigestUpdate(m_state->Outer, outerPad, BlockSize))
+      {
+        throw std::runtime_error("Crypto error while initializing the HMAC key.");
+      }
+    }
+
+    void HmacSha256Key::Sign(const uint8_t* data, size_t length, uint8_t* hash) const
+    {
+      // Each thread signs with its own context, which keeps its allocations from one signature to
+      // the next.
+      struct SigningContext final
+      {
+        EVP_MD_CTX* Context = EVP_MD_CTX_new();
+        ~SigningContext() { EVP_MD_CTX_free(Context); }
+      };
+      thread_local SigningContext signingContext;
+      auto const context = signingContext.Context;
+      if (context == nullptr)
+      {
+        throw std::runtime_error("Crypto error while creating EVP context.");
+      }
+
+      unsigned char innerHash[EVP_MAX_MD_SIZE];
+      unsigned int hashLength = 0;
+      if (1 != EVP_MD_CTX_copy_ex(context, m_state->Inner)
+          || 1 != EVP_DigestUpdate(context, data, length)
+          || 1 != EVP_DigestFinal_ex(context, innerHash, &hashLength)
+          || 1 != EVP_MD_CTX_copy_ex(context, m_state->Outer)
+          || 1 != EVP_DigestUpdate(context, innerHash, hashLength)
+          || 1 != EVP_DigestFinal_ex(context, hash, &hashLength))
+      {
+        throw std::runtime_error("Crypto error while computing HMAC-SHA256.");
+      }
+      AZURE_ASSERT(hashLength == HashSize);
     }
+
   } // namespace _internal
 
-#elif defined(AZ_PLATFORM_POSIX)
+#endif
 
   namespace _internal {
 
+    HmacSha256Key::~HmacSha256Key() = default;
+
+    std::vector<uint8_t> HmacSha256Key::Sign(const uint8_t* data, size_t length) const
+    {
+      std::vector<uint8_t> hash(HashSize);
+      Sign(data, length, hash.data());
+      return hash;
+    }
+
     std::vector<uint8_t> HmacSha256(
         const std::vector<uint8_t>& data,
         const std::vector<uint8_t>& key)
     {
-      uint8_t hash[EVP_MAX_MD_SIZE];
-      unsigned int hashLength = 0;
-      HMAC(
-          EVP_sha256(),
-          key.data(),
-          static_cast<int>(key.size()),
-          reinterpret_cast<const unsigned char*>(data.data()),
-          data.size(),
-          reinterpret_cast<unsigned char*>(&hash[0]),
-          &hashLength);
-
-      return std::vector<uint8_t>(std::begin(hash), std::begin(hash) + hashLength);
+      return HmacSha256Key(key).Sign(data.data(), data.size());
     }
 
   } // namespace _internal
 
-#endif
-
   static constexpr uint64_t Crc64Poly = 0x9A6C9329AC4BC9B5ULL;
   static constexpr uint64_t Crc64MU1[] = {
       0x0000000000000000ULL, 0x7f6ef0c830358979ULL, 0xfedde190606b12f2ULL, 0x81b31158505e9b8bULL,
@@ -840,8 +976,238 @@ namespace Azure { namespace Storage {
       0x8ee4ce0c2e2bd662UL, 0x4000000000000000UL, 0x2000000000000000UL, 0x0800000000000000UL,
   };
 
+#if defined(_azure_CRC64_X64_KERNELS)
+  // The x64 kernels fold the data into a 128 bit state with carry-less multiplications, as in
+  // "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" by Intel. Like the
+  // tables, they work in the reflected domain, where bit i of a 64 bit value is the coefficient
+  // of x^(63-i), and the constants below are x^n mod P.
+  static constexpr uint64_t Crc64X127 = 0x21e9761e252621acULL;
+  static constexpr uint64_t Crc64X191 = 0xeadc41fd2ba3d420ULL;
+  static constexpr uint64_t Crc64X511 = 0x62242240ace5045aULL;
+  static constexpr uint64_t Crc64X575 = 0x0c32cdb31e18a84aULL;
+  static constexpr uint64_t Crc64X2047 = 0xa043808c0f782663ULL;
+  static constexpr uint64_t Crc64X2111 = 0x37ccd3e14069cabcULL;
+  // floor(x^128 / P) without its x^64 term, for the Barrett reduction.
+  static constexpr uint64_t Crc64BarrettMu = 0x13f67d194d77cfbbULL;
+
+  enum class Crc64Kernels
+  {
+    Table,
+    Pclmulqdq,
+    Vpclmulqdq,
+  };
+
+#if defined(_MSC_VER)
+  static Crc64Kernels DetectCrc64Kernels()
+  {
+    int info[4];
+    __cpuid(info, 0);
+    auto const maxLeaf = info[0];
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 1)) == 0)
+    {
+      return Crc64Kernels::Table;
+    }
+    // AVX-512 also needs the OS to save the YMM and ZMM registers.
+    bool const osSavesZmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0xe6) == 0xe6;
+    if (osSavesZmm && maxLeaf >= 7)
+    {
+      __cpuidex(info, 7, 0);
+      if ((info[1] & (1 << 16)) != 0 && (info[2] & (1 << 10)) != 0)
+      {
+        return Crc64Kernels::Vpclmulqdq;
+      }
+    }
+    return Crc64Kernels::Pclmulqdq;
+  }
+#else
+  static Crc64Kernels DetectCrc64Kernels()
+  {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("vpclmulqdq"))
+    {
+      return Crc64Kernels::Vpclmulqdq;
+    }
+    if (__builtin_cpu_supports("pclmul"))
+    {
+      return Crc64Kernels::Pclmulqdq;
+    }
+    return Crc64Kernels::Table;
+  }
+#endif
+
+  static Crc64Kernels GetCrc64Kernels()
+  {
+    static Crc64Kernels const kernels = DetectCrc64Kernels();
+    return kernels;
+  }
+
+  static inline __m128i Crc64ToVector(uint64_t value)
+  {
+    return _mm_cvtsi64_si128(static_cast<long long>(value));
+  }
+
+  static inline __m128i Crc64ToVector(uint64_t low, uint64_t high)
+  {
+    return _mm_set_epi64x(static_cast<long long>(high), static_cast<long long>(low));
+  }
+
+  static inline uint64_t Crc64LowHalf(__m128i const value)
+  {
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(value));
+  }
+
+  static inline uint64_t Crc64HighHalf(__m128i const value)
+  {
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(value, value)));
+  }
+
+  // Returns (high * x^64 + low) mod P.
+  _azure_CRC64_TARGET("pclmul") static uint64_t Crc64ReducePclmulqdq(uint64_t high, uint64_t low)
+  {
+    // Barrett reduction: q = floor(high * x^64 / P) = high + floor(high * Mu / x^64), and
+    // high * x^64 mod P is q * P mod x^64. The product of two reflected values is shifted by one
+    // bit, its bit k is the coefficient of x^(126-k).
+    __m128i const t
+        = _mm_clmulepi64_si128(Crc64ToVector(high), Crc64ToVector(Crc64BarrettMu), 0x00);
+    uint64_t const q = high ^ (Crc64LowHalf(t) << 1);
+    __m128i const r = _mm_clmulepi64_si128(Crc64ToVector(q), Crc64ToVector(Crc64Poly), 0x00);
+    return ((Crc64LowHalf(r) >> 63) | (Crc64HighHalf(r) << 1)) ^ low;
+  }
+
+  // Returns a * b mod P, like Crc64MulPoly.
+  _azure_CRC64_TARGET("pclmul") static uint64_t Crc64MulPolyPclmulqdq(uint64_t a, uint64_t b)
+  {
+    __m128i const product = _mm_clmulepi64_si128(Crc64ToVector(a), Crc64ToVector(b), 0x00);
+    uint64_t const low = Crc64LowHalf(product);
+    return Crc64ReducePclmulqdq(low << 1, (low >> 63) | (Crc64HighHalf(product) << 1));
+  }
+
+  // Moves the state forward by the distance of the constants and adds the data at the new
+  // position. The low half of the constants is x^(d+63) mod P and the high half x^(d-1) mod P,
+  // for a distance of d bits.
+  _azure_CRC64_TARGET("pclmul") static inline __m128i
+      Crc64FoldPclmulqdq(__m128i const state, __m128i const constants, __m128i const data)
+  {
+    return _mm_xor_si128(
+        _mm_xor_si128(
+            _mm_clmulepi64_si128(state, constants, 0x00),
+            _mm_clmulepi64_si128(state, constants, 0x11)),
+        data);
+  }
+
+  // Folds the 16 byte blocks of data from offset into the state and returns the CRC register,
+  // state * x^64 mod P. Sets offset to the end of the last block.
+  _azure_CRC64_TARGET("pclmul") static uint64_t
+      Crc64FinishPclmulqdq(__m128i state, uint8_t const* data, size_t& offset, size_t length)
+  {
+    __m128i const fold128 = Crc64ToVector(Crc64X191, Crc64X127);
+    for (; offset + 16 <= length; offset += 16)
+    {
+      state = Crc64FoldPclmulqdq(
+          state, fold128, _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + offset)));
+    }
+    // The low half of the state is the first half of the data, so the register is
+    // (low * x^128 + high * x^64) mod P.
+    __m128i const t = _mm_clmulepi64_si128(state, Crc64ToVector(Crc64X127), 0x00);
+    return Crc64ReducePclmulqdq(Crc64LowHalf(t) ^ Crc64HighHalf(state), Crc64HighHalf(t));
+  }
+
+  // Updates the CRC register with the whole 16 byte blocks of data, at least one. Returns the
+  // number of bytes used.
+  _azure_CRC64_TARGET("pclmul") static size_t
+      Crc64Pclmulqdq(uint8_t const* data, size_t length, uint64_t& crc)
+  {
+    auto const blocks = reinterpret_cast<__m128i const*>(data);
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(blocks), Crc64ToVector(crc));
+    size_t offset = 16;
+    if (length >= 64)
+    {
+      __m128i const fold128 = Crc64ToVector(Crc64X191, Crc64X127);
+      __m128i const fold512 = Crc64ToVector(Crc64X575, Crc64X511);
+      __m128i x1 = _mm_loadu_si128(blocks + 1);
+      __m128i x2 = _mm_loadu_si128(blocks + 2);
+      __m128i x3 = _mm_loadu_si128(blocks + 3);
+      for (offset = 64; offset + 64 <= length; offset += 64)
+      {
+        auto const next = reinterpret_cast<__m128i const*>(data + offset);
+        x0 = Crc64FoldPclmulqdq(x0, fold512, _mm_loadu_si128(next));
+        x1 = Crc64FoldPclmulqdq(x1, fold512, _mm_loadu_si128(next + 1));
+        x2 = Crc64FoldPclmulqdq(x2, fold512, _mm_loadu_si128(next + 2));
+        x3 = Crc64FoldPclmulqdq(x3, fold512, _mm_loadu_si128(next + 3));
+      }
+      x0 = Crc64FoldPclmulqdq(x0, fold128, x1);
+      x0 = Crc64FoldPclmulqdq(x0, fold128, x2);
+      x0 = Crc64FoldPclmulqdq(x0, fold128, x3);
+    }
+    crc = Crc64FinishPclmulqdq(x0, data, offset, length);
+    return offset;
+  }
+
+  // The same low and high halves in the four 128 bit lanes.
+  _azure_CRC64_TARGET("avx512f") static inline __m512i
+      Crc64ToVector512(uint64_t low, uint64_t high)
+  {
+    auto const l = static_cast<long long>(low);
+    auto const h = static_cast<long long>(high);
+    return _mm512_set_epi64(h, l, h, l, h, l, h, l);
+  }
+
+  _azure_CRC64_TARGET("avx512f,vpclmulqdq,pclmul") static inline __m512i
+      Crc64FoldVpclmulqdq(__m512i const state, __m512i const constants, __m512i const data)
+  {
+    // 0x96 is the truth table of a ^ b ^ c.
+    return _mm512_ternarylogic_epi64(
+        _mm512_clmulepi64_epi128(state, constants, 0x00),
+        _mm512_clmulepi64_epi128(state, constants, 0x11),
+        data,
+        0x96);
+  }
+
+  // Same as Crc64Pclmulqdq with four 64 byte states, for at least 256 bytes of data.
+  _azure_CRC64_TARGET("avx512f,vpclmulqdq,pclmul") static size_t
+      Crc64Vpclmulqdq(uint8_t const* data, size_t length, uint64_t& crc)
+  {
+    __m512i x0 = _mm512_xor_si512(
+        _mm512_loadu_si512(data),
+        _mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, static_cast<long long>(crc)));
+    __m512i x1 = _mm512_loadu_si512(data + 64);
+    __m512i x2 = _mm512_loadu_si512(data + 128);
+    __m512i x3 = _mm512_loadu_si512(data + 192);
+    __m512i const fold2048 = Crc64ToVector512(Crc64X2111, Crc64X2047);
+    size_t offset = 256;
+    for (; offset + 256 <= length; offset += 256)
+    {
+      x0 = Crc64FoldVpclmulqdq(x0, fold2048, _mm512_loadu_si512(data + offset));
+      x1 = Crc64FoldVpclmulqdq(x1, fold2048, _mm512_loadu_si512(data + offset + 64));
+      x2 = Crc64FoldVpclmulqdq(x2, fold2048, _mm512_loadu_si512(data + offset + 128));
+      x3 = Crc64FoldVpclmulqdq(x3, fold2048, _mm512_loadu_si512(data + offset + 192));
+    }
+    __m512i const fold512 = Crc64ToVector512(Crc64X575, Crc64X511);
+    x0 = Crc64FoldVpclmulqdq(x0, fold512, x1);
+    x0 = Crc64FoldVpclmulqdq(x0, fold512, x2);
+    x0 = Crc64FoldVpclmulqdq(x0, fold512, x3);
+
+    __m128i lanes[4];
+    _mm512_storeu_si512(lanes, x0);
+    __m128i const fold128 = Crc64ToVector(Crc64X191, Crc64X127);
+    __m128i state = lanes[0];
+    state = Crc64FoldPclmulqdq(state, fold128, lanes[1]);
+    state = Crc64FoldPclmulqdq(state, fold128, lanes[2]);
+    state = Crc64FoldPclmulqdq(state, fold128, lanes[3]);
+    crc = Crc64FinishPclmulqdq(state, data, offset, length);
+    return offset;
+  }
+#endif
+
   static uint64_t Crc64MulPoly(uint64_t a, uint64_t b)
   {
+#if defined(_azure_CRC64_X64_KERNELS)
+    if (GetCrc64Kernels() != Crc64Kernels::Table)
+    {
+      return Crc64MulPolyPclmulqdq(a, b);
+    }
+#endif
     constexpr uint64_t p = Crc64Poly;
     constexpr uint64_t p2 = (p >> 1) ^ (p * (p & 1));
     constexpr uint64_t bw = sizeof(p) * 8;
@@ -868,6 +1234,28 @@ namespace Azure { namespace Storage {
 
     uint64_t uCrc = m_context ^ ~0ULL;
 
+#if defined(_azure_CRC64_X64_KERNELS)
+    // The kernels use the whole 16 byte blocks, the tables the rest.
+    if (length >= 16)
+    {
+      size_t used = 0;
+      switch (GetCrc64Kernels())
+      {
+        case Crc64Kernels::Vpclmulqdq:
+          used = length >= 256 ? Crc64Vpclmulqdq(data, length, uCrc)
+                               : Crc64Pclmulqdq(data, length, uCrc);
+          break;
+        case Crc64Kernels::Pclmulqdq:
+          used = Crc64Pclmulqdq(data, length, uCrc);
+          break;
+        case Crc64Kernels::Table:
+          break;
+      }
+      data += used;
+      length -= used;
+    }
+#endif
+
     uint64_t pData = 0;
 
     size_t uStop = length - (length % 32);
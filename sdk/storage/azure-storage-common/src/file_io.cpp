@@ -6,6 +6,7 @@
 #include <azure/core/platform.hpp>
 
 #if defined(AZ_PLATFORM_POSIX)
+#include <dirent.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -23,11 +24,31 @@
 #include <windows.h>
 #endif
 
+#include <cerrno>
 #include <limits>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace _internal {
 
+  namespace {
+    std::string JoinPath(const std::string& directory, const std::string& relativePath)
+    {
+      if (relativePath.empty())
+      {
+        return directory;
+      }
+      const char last = directory.empty() ? '/' : directory.back();
+#if defined(AZ_PLATFORM_WINDOWS)
+      const bool endsWithSeparator = last == '/' || last == '\\';
+#else
+      const bool endsWithSeparator = last == '/';
+#endif
+      return endsWithSeparator ? directory + relativePath : directory + "/" + relativePath;
+    }
+  } // namespace
+
 #if defined(AZ_PLATFORM_WINDOWS)
   FileReader::FileReader(const std::string& filename)
   {
@@ -88,7 +109,7 @@ namespace Azure { namespace Storage { namespace _internal {
 
   FileReader::~FileReader() { CloseHandle(static_cast<HANDLE>(m_handle)); }
 
-  FileWriter::FileWriter(const std::string& filename)
+  FileWriter::FileWriter(const std::string& filename, bool truncate)
   {
     int sizeNeeded = MultiByteToWideChar(
         CP_UTF8,
@@ -115,20 +136,26 @@ namespace Azure { namespace Storage { namespace _internal {
     }
 
     HANDLE fileHandle;
+    const DWORD desiredAccess = truncate ? GENERIC_WRITE : GENERIC_READ | GENERIC_WRITE;
+    const DWORD creationDisposition = truncate ? CREATE_ALWAYS : OPEN_ALWAYS;
 
 #if !defined(WINAPI_PARTITION_DESKTOP) \
     || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
     fileHandle = CreateFileW(
         filenameW.data(),
-        GENERIC_WRITE,
+        desiredAccess,
         FILE_SHARE_READ | FILE_SHARE_WRITE,
         nullptr,
-        CREATE_ALWAYS,
+        creationDisposition,
         FILE_ATTRIBUTE_NORMAL,
         NULL);
 #else
     fileHandle = CreateFile2(
-        filenameW.data(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, CREATE_ALWAYS, NULL);
+        filenameW.data(),
+        desiredAccess,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        creationDisposition,
+        NULL);
 #endif
     if (fileHandle == INVALID_HANDLE_VALUE)
     {
@@ -163,6 +190,173 @@ namespace Azure { namespace Storage { namespace _internal {
       throw std::runtime_error("Failed to write file.");
     }
   }
+
+  void FileWriter::SetSize(int64_t size)
+  {
+    FILE_END_OF_FILE_INFO endOfFile;
+    endOfFile.EndOfFile.QuadPart = size;
+    if (!SetFileInformationByHandle(
+            static_cast<HANDLE>(m_handle), FileEndOfFileInfo, &endOfFile, sizeof(endOfFile)))
+    {
+      throw std::runtime_error("Failed to set size of file.");
+    }
+  }
+
+  namespace {
+    std::wstring ToWideString(const std::string& path)
+    {
+      if (path.empty())
+      {
+        return std::wstring();
+      }
+      int sizeNeeded = MultiByteToWideChar(
+          CP_UTF8, MB_ERR_INVALID_CHARS, path.data(), static_cast<int>(path.length()), nullptr, 0);
+      if (sizeNeeded == 0)
+      {
+        throw std::runtime_error("Invalid filename.");
+      }
+      std::wstring pathW(sizeNeeded, L'\0');
+      if (MultiByteToWideChar(
+              CP_UTF8,
+              MB_ERR_INVALID_CHARS,
+              path.data(),
+              static_cast<int>(path.length()),
+              &pathW[0],
+              sizeNeeded)
+          == 0)
+      {
+        throw std::runtime_error("Invalid filename.");
+      }
+      return pathW;
+    }
+
+    std::string ToUtf8String(const std::wstring& pathW)
+    {
+      if (pathW.empty())
+      {
+        return std::string();
+      }
+      int sizeNeeded = WideCharToMultiByte(
+          CP_UTF8,
+          WC_ERR_INVALID_CHARS,
+          pathW.data(),
+          static_cast<int>(pathW.length()),
+          nullptr,
+          0,
+          nullptr,
+          nullptr);
+      if (sizeNeeded == 0)
+      {
+        throw std::runtime_error("Invalid filename.");
+      }
+      std::string path(sizeNeeded, '\0');
+      if (WideCharToMultiByte(
+              CP_UTF8,
+              WC_ERR_INVALID_CHARS,
+              pathW.data(),
+              static_cast<int>(pathW.length()),
+              &path[0],
+              sizeNeeded,
+              nullptr,
+              nullptr)
+          == 0)
+      {
+        throw std::runtime_error("Invalid filename.");
+      }
+      return path;
+    }
+  } // namespace
+
+  void ForEachFile(
+      const std::string& directory,
+      const std::function<void(const std::string& relativePath, int64_t fileSize)>& onFile)
+  {
+    std::vector<std::string> directories{std::string()};
+    while (!directories.empty())
+    {
+      const std::string relativeDirectory = std::move(directories.back());
+      directories.pop_back();
+
+      // The files are listed before they are passed to onFile, so that the directory isn't kept
+      // open while they are.
+      std::vector<std::pair<std::string, int64_t>> files;
+      WIN32_FIND_DATAW findData;
+      HANDLE findHandle = FindFirstFileExW(
+          ToWideString(JoinPath(JoinPath(directory, relativeDirectory), "*")).data(),
+          FindExInfoBasic,
+          &findData,
+          FindExSearchNameMatch,
+          nullptr,
+          FIND_FIRST_EX_LARGE_FETCH);
+      if (findHandle == INVALID_HANDLE_VALUE)
+      {
+        throw std::runtime_error("Failed to open directory.");
+      }
+      do
+      {
+        const std::wstring nameW = findData.cFileName;
+        if (nameW == L"." || nameW == L"..")
+        {
+          continue;
+        }
+        std::string relativePath;
+        try
+        {
+          relativePath = JoinPath(relativeDirectory, ToUtf8String(nameW));
+        }
+        catch (...)
+        {
+          FindClose(findHandle);
+          throw;
+        }
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+          if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+          {
+            directories.push_back(std::move(relativePath));
+          }
+        }
+        else
+        {
+          files.emplace_back(
+              std::move(relativePath),
+              static_cast<int64_t>(
+                  (static_cast<uint64_t>(findData.nFileSizeHigh) << 32)
+                  | findData.nFileSizeLow));
+        }
+      } while (FindNextFileW(findHandle, &findData));
+      FindClose(findHandle);
+
+      for (const auto& file : files)
+      {
+        onFile(file.first, file.second);
+      }
+    }
+  }
+
+  void CreateDirectories(const std::string& path)
+  {
+    if (CreateDirectoryW(ToWideString(path).data(), nullptr))
+    {
+      return;
+    }
+    const DWORD error = GetLastError();
+    if (error == ERROR_ALREADY_EXISTS)
+    {
+      return;
+    }
+    const auto separator = path.find_last_of("/\\", path.length() - 2);
+    if (error != ERROR_PATH_NOT_FOUND || separator == std::string::npos || separator == 0)
+    {
+      throw std::runtime_error("Failed to create directory.");
+    }
+    CreateDirectories(path.substr(0, separator));
+    if (!CreateDirectoryW(ToWideString(path).data(), nullptr)
+        && GetLastError() != ERROR_ALREADY_EXISTS)
+    {
+      throw std::runtime_error("Failed to create directory.");
+    }
+  }
 #elif defined(AZ_PLATFORM_POSIX)
   FileReader::FileReader(const std::string& filename)
   {
@@ -181,10 +375,12 @@ namespace Azure { namespace Storage { namespace _internal {
 
   FileReader::~FileReader() { close(m_handle); }
 
-  FileWriter::FileWriter(const std::string& filename)
+  FileWriter::FileWriter(const std::string& filename, bool truncate)
   {
     m_handle = open(
-        filename.data(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        filename.data(),
+        truncate ? O_WRONLY | O_CREAT | O_TRUNC : O_RDWR | O_CREAT,
+        S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
     if (m_handle == -1)
     {
       throw std::runtime_error("Failed to open file.");
@@ -205,6 +401,98 @@ namespace Azure { namespace Storage { namespace _internal {
       throw std::runtime_error("Failed to write file.");
     }
   }
+
+  void FileWriter::SetSize(int64_t size)
+  {
+    if (size > static_cast<int64_t>((std::numeric_limits<off_t>::max)())
+        || ftruncate(m_handle, static_cast<off_t>(size)) != 0)
+    {
+      throw std::runtime_error("Failed to set size of file.");
+    }
+  }
+
+  void ForEachFile(
+      const std::string& directory,
+      const std::function<void(const std::string& relativePath, int64_t fileSize)>& onFile)
+  {
+    std::vector<std::string> directories{std::string()};
+    while (!directories.empty())
+    {
+      const std::string relativeDirectory = std::move(directories.back());
+      directories.pop_back();
+
+      // The files are listed before they are passed to onFile, so that the directory isn't kept
+      // open while they are.
+      std::vector<std::pair<std::string, int64_t>> files;
+      DIR* dir = opendir(JoinPath(directory, relativeDirectory).data());
+      if (dir == nullptr)
+      {
+        throw std::runtime_error("Failed to open directory.");
+      }
+      while (const dirent* entry = readdir(dir))
+      {
+        const std::string name = entry->d_name;
+        if (name == "." || name == "..")
+        {
+          continue;
+        }
+        struct stat fileStatus;
+        if (fstatat(dirfd(dir), entry->d_name, &fileStatus, AT_SYMLINK_NOFOLLOW) != 0)
+        {
+          if (errno == ENOENT)
+          {
+            // Deleted since it was listed.
+            continue;
+          }
+          closedir(dir);
+          throw std::runtime_error("Failed to get status of file.");
+        }
+        const bool isLink = S_ISLNK(fileStatus.st_mode);
+        if (isLink && fstatat(dirfd(dir), entry->d_name, &fileStatus, 0) != 0)
+        {
+          // A broken link.
+          continue;
+        }
+        if (S_ISDIR(fileStatus.st_mode))
+        {
+          if (!isLink)
+          {
+            directories.push_back(JoinPath(relativeDirectory, name));
+          }
+        }
+        else if (S_ISREG(fileStatus.st_mode))
+        {
+          files.emplace_back(
+              JoinPath(relativeDirectory, name), static_cast<int64_t>(fileStatus.st_size));
+        }
+      }
+      closedir(dir);
+
+      for (const auto& file : files)
+      {
+        onFile(file.first, file.second);
+      }
+    }
+  }
+
+  void CreateDirectories(const std::string& path)
+  {
+    if (mkdir(path.data(), 0777) == 0 || errno == EEXIST)
+    {
+      return;
+    }
+    const int error = errno;
+    const auto separator = path.find_last_of('/', path.length() - 2);
+    if (error != ENOENT || separator == std::string::npos || separator == 0)
+    {
+      throw std::runtime_error("Failed to create directory.");
+    }
+    CreateDirectories(path.substr(0, separator));
+    if (mkdir(path.data(), 0777) != 0 && errno != EEXIST)
+    {
+      throw std::runtime_error("Failed to create directory.");
+    }
+  }
 #endif
 
 }}} // namespace Azure::Storage::_internal
@@ -5,10 +5,15 @@
 
 #include "azure/storage/common/crypt.hpp"
 
+#include <azure/core/base64.hpp>
 #include <azure/core/http/http.hpp>
 #include <azure/core/internal/strings.hpp>
+#include <azure/core/url.hpp>
 
 #include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace {
 /*
@@ -88,82 +93,257 @@ bool comparator(const std::string& lhs, const std::string& rhs)
   }
   return false;
 }
+
+// Orders two header names made of lowercase ASCII letters, digits and '-' like comparator. For
+// these names, the first level of comparator compares the characters other than '-' by their code.
+// Returns 0 when the names only differ by their '-', which the next levels of comparator order.
+int CompareSimpleHeaderNames(const std::string& lhs, const std::string& rhs)
+{
+  size_t i = 0;
+  size_t j = 0;
+  while (true)
+  {
+    while (i < lhs.size() && lhs[i] == '-')
+    {
+      ++i;
+    }
+    while (j < rhs.size() && rhs[j] == '-')
+    {
+      ++j;
+    }
+    if (i == lhs.size() || j == rhs.size())
+    {
+      return (i == lhs.size() ? 0 : 1) - (j == rhs.size() ? 0 : 1);
+    }
+    if (lhs[i] != rhs[j])
+    {
+      return lhs[i] < rhs[j] ? -1 : 1;
+    }
+    ++i;
+    ++j;
+  }
+}
+
+bool IsSimpleHeaderName(const std::string& name)
+{
+  return std::all_of(name.begin(), name.end(), [](char c) {
+    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-';
+  });
+}
+
+struct CanonicalizedHeader final
+{
+  const std::string* Name;
+  const std::string* Value;
+  bool IsSimple;
+};
+
+// A query parameter decoded into StringToSignBuffers::DecodedQueryParameters.
+struct CanonicalizedQueryParameter final
+{
+  size_t KeyOffset;
+  size_t KeyLength;
+  size_t ValueOffset;
+  size_t ValueLength;
+};
+
+// The buffers of the requests signed on a thread. They keep their capacity from one request to the
+// next, so signing stops allocating once they have grown to the size of the requests.
+struct StringToSignBuffers final
+{
+  std::string StringToSign;
+  std::vector<CanonicalizedHeader> Headers;
+  std::string DecodedQueryParameters;
+  std::vector<CanonicalizedQueryParameter> QueryParameters;
+};
+
+void AppendCanonicalizedHeaders(
+    std::vector<CanonicalizedHeader>& canonicalizedHeaders,
+    const Azure::Core::Http::HttpHeaders& headers)
+{
+  static const std::string prefix = "x-ms-";
+  for (auto ite = headers.lower_bound(prefix);
+       ite != headers.end() && ite->first.compare(0, prefix.length(), prefix) == 0;
+       ++ite)
+  {
+    canonicalizedHeaders.push_back({&ite->first, &ite->second, IsSimpleHeaderName(ite->first)});
+  }
+}
+
+// Appends value lowercased if toLower is set, then decoded like Azure::Core::Url::Decode does.
+void AppendDecoded(std::string& output, const std::string& value, bool toLower)
+{
+  using Azure::Core::_internal::StringExtensions;
+  const auto hexValue = [](char c) {
+    return StringExtensions::IsDigit(c) ? c - '0' : StringExtensions::ToLower(c) - 'a' + 10;
+  };
+  for (size_t i = 0; i < value.size(); ++i)
+  {
+    const char c = value[i];
+    if (c == '%')
+    {
+      if (value.size() - i < 3 || !StringExtensions::IsHexDigit(value[i + 1])
+          || !StringExtensions::IsHexDigit(value[i + 2]))
+      {
+        throw std::runtime_error("failed when decoding URL component");
+      }
+      output += static_cast<char>(hexValue(value[i + 1]) * 16 + hexValue(value[i + 2]));
+      i += 2;
+    }
+    else if (c == '+')
+    {
+      output += ' ';
+    }
+    else
+    {
+      output += toLower ? StringExtensions::ToLower(c) : c;
+    }
+  }
+}
+
+int CompareDecoded(
+    const std::string& decoded,
+    size_t lhsOffset,
+    size_t lhsLength,
+    size_t rhsOffset,
+    size_t rhsLength)
+{
+  const int result = std::char_traits<char>::compare(
+      decoded.data() + lhsOffset, decoded.data() + rhsOffset, (std::min)(lhsLength, rhsLength));
+  if (result != 0)
+  {
+    return result;
+  }
+  return lhsLength < rhsLength ? -1 : (lhsLength > rhsLength ? 1 : 0);
+}
 } // namespace
 
 namespace Azure { namespace Storage { namespace _internal {
 
-  std::string SharedKeyPolicy::GetSignature(const Core::Http::Request& request) const
+  std::string SharedKeyPolicy::GetAuthorizationHeader(const Core::Http::Request& request) const
   {
-    std::string string_to_sign;
-    string_to_sign += request.GetMethod().ToString() + "\n";
+    static const std::string standardHeaders[] = {
+        "content-encoding",
+        "content-language",
+        "content-length",
+        "content-md5",
+        "content-type",
+        "date",
+        "if-modified-since",
+        "if-match",
+        "if-none-match",
+        "if-unmodified-since",
+        "range"};
+    static const std::string& contentLength = standardHeaders[2];
+
+    thread_local StringToSignBuffers buffers;
+    std::string& string_to_sign = buffers.StringToSign;
+    string_to_sign.clear();
+    string_to_sign += request.GetMethod().ToString();
+    string_to_sign += '\n';
 
     const auto& headers = request.GetHeaders();
-    for (std::string headerName :
-         {"Content-Encoding",
-          "Content-Language",
-          "Content-Length",
-          "Content-MD5",
-          "Content-Type",
-          "Date",
-          "If-Modified-Since",
-          "If-Match",
-          "If-None-Match",
-          "If-Unmodified-Since",
-          "Range"})
-    {
-      auto ite = headers.find(headerName);
-      if (ite != headers.end())
+    for (const auto& headerName : standardHeaders)
+    {
+      const auto header = headers.find(headerName);
+      if (header != headers.end() && !(&headerName == &contentLength && header->second == "0"))
       {
-        if (headerName == "Content-Length" && ite->second == "0")
-        {
-          // do nothing
-        }
-        else
-        {
-          string_to_sign += ite->second;
-        }
+        string_to_sign += header->second;
       }
-      string_to_sign += "\n";
+      string_to_sign += '\n';
     }
 
     // canonicalized headers
-    const std::string prefix = "x-ms-";
-    std::vector<std::pair<std::string, std::string>> ordered_kv;
-    for (auto ite = headers.lower_bound(prefix);
-         ite != headers.end() && ite->first.substr(0, prefix.length()) == prefix;
-         ++ite)
+    auto& canonicalizedHeaders = buffers.Headers;
+    canonicalizedHeaders.clear();
+    // The header names are lowercase.
+    AppendCanonicalizedHeaders(canonicalizedHeaders, headers);
+    std::sort(
+        canonicalizedHeaders.begin(),
+        canonicalizedHeaders.end(),
+        [](const CanonicalizedHeader& lhs, const CanonicalizedHeader& rhs) {
+          if (lhs.IsSimple && rhs.IsSimple)
+          {
+            const int result = CompareSimpleHeaderNames(*lhs.Name, *rhs.Name);
+            if (result != 0)
+            {
+              return result < 0;
+            }
+          }
+          return comparator(*lhs.Name, *rhs.Name);
+        });
+    for (const auto& header : canonicalizedHeaders)
     {
-      std::string key = Azure::Core::_internal::StringExtensions::ToLower(ite->first);
-      ordered_kv.emplace_back(std::make_pair(std::move(key), ite->second));
+      string_to_sign += *header.Name;
+      string_to_sign += ':';
+      string_to_sign += *header.Value;
+      string_to_sign += '\n';
     }
-    std::sort(ordered_kv.begin(), ordered_kv.end(), [](const auto& lhs, const auto& rhs) {
-      return comparator(lhs.first, rhs.first);
-    });
-    for (const auto& p : ordered_kv)
-    {
-      string_to_sign += p.first + ":" + p.second + "\n";
-    }
-    ordered_kv.clear();
 
     // canonicalized resource
-    string_to_sign += "/" + m_credential->AccountName + "/" + request.GetUrl().GetPath() + "\n";
-    for (const auto& query : request.GetUrl().GetQueryParameters())
+    string_to_sign += '/';
+    string_to_sign += m_credential->AccountName;
+    string_to_sign += '/';
+    string_to_sign += request.GetUrl().GetPath();
+    string_to_sign += '\n';
+
+    auto& decoded = buffers.DecodedQueryParameters;
+    auto& queryParameters = buffers.QueryParameters;
+    decoded.clear();
+    queryParameters.clear();
+    const auto& encodedQueryParameters
+        = Core::_internal::UrlHelpers::GetEncodedQueryParameters(request.GetUrl());
+    for (const auto& query : encodedQueryParameters)
     {
-      std::string key = Azure::Core::_internal::StringExtensions::ToLower(query.first);
-      ordered_kv.emplace_back(
-          std::make_pair(Azure::Core::Url::Decode(key), Azure::Core::Url::Decode(query.second)));
+      CanonicalizedQueryParameter parameter;
+      parameter.KeyOffset = decoded.size();
+      AppendDecoded(decoded, query.first, true);
+      parameter.KeyLength = decoded.size() - parameter.KeyOffset;
+      parameter.ValueOffset = decoded.size();
+      AppendDecoded(decoded, query.second, false);
+      parameter.ValueLength = decoded.size() - parameter.ValueOffset;
+      queryParameters.push_back(parameter);
     }
-    std::sort(ordered_kv.begin(), ordered_kv.end());
-    for (const auto& p : ordered_kv)
+    std::sort(
+        queryParameters.begin(),
+        queryParameters.end(),
+        [&decoded](const CanonicalizedQueryParameter& lhs, const CanonicalizedQueryParameter& rhs) {
+          const int result = CompareDecoded(
+              decoded, lhs.KeyOffset, lhs.KeyLength, rhs.KeyOffset, rhs.KeyLength);
+          if (result != 0)
+          {
+            return result < 0;
+          }
+          return CompareDecoded(
+                     decoded, lhs.ValueOffset, lhs.ValueLength, rhs.ValueOffset, rhs.ValueLength)
+              < 0;
+        });
+    for (const auto& parameter : queryParameters)
     {
-      string_to_sign += p.first + ":" + p.second + "\n";
+      string_to_sign.append(decoded, parameter.KeyOffset, parameter.KeyLength);
+      string_to_sign += ':';
+      string_to_sign.append(decoded, parameter.ValueOffset, parameter.ValueLength);
+      string_to_sign += '\n';
     }
 
     // remove last linebreak
     string_to_sign.pop_back();
 
-    return Azure::Core::Convert::Base64Encode(_internal::HmacSha256(
-        std::vector<uint8_t>(string_to_sign.begin(), string_to_sign.end()),
-        Azure::Core::Convert::Base64Decode(m_credential->GetAccountKey())));
+    uint8_t signature[HmacSha256Key::HashSize];
+    m_credential->GetSigningKey()->Sign(
+        reinterpret_cast<const uint8_t*>(string_to_sign.data()), string_to_sign.size(), signature);
+
+    static const std::string scheme = "SharedKey ";
+    const size_t signatureOffset = scheme.size() + m_credential->AccountName.size() + 1;
+    const size_t signatureSize = Core::Convert::GetBase64EncodedSize(sizeof(signature));
+    std::string authorizationHeader;
+    authorizationHeader.reserve(signatureOffset + signatureSize);
+    authorizationHeader += scheme;
+    authorizationHeader += m_credential->AccountName;
+    authorizationHeader += ':';
+    authorizationHeader.resize(signatureOffset + signatureSize);
+    Core::Convert::Base64Encode(
+        signature, sizeof(signature), &authorizationHeader[signatureOffset], signatureSize);
+    return authorizationHeader;
   }
 }}} // namespace Azure::Storage::_internal
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/common/transfer_executor.hpp"
+
+#include <system_error>
+#include <utility>
+
+namespace Azure { namespace Storage {
+
+  namespace {
+    std::mutex g_transferExecutorMutex;
+    std::shared_ptr<TransferExecutor> g_transferExecutor;
+
+    std::shared_ptr<TransferExecutor> GetDefaultTransferExecutor()
+    {
+      // Never destroyed, so that its threads aren't joined while the process exits.
+      static TransferThreadPool* defaultPool = new TransferThreadPool();
+      return std::shared_ptr<TransferExecutor>(std::shared_ptr<TransferExecutor>(), defaultPool);
+    }
+  } // namespace
+
+  TransferThreadPool::TransferThreadPool(const TransferThreadPoolOptions& options)
+      : m_maxThreads(static_cast<size_t>((std::max)(options.MaxThreads, 1)))
+  {
+  }
+
+  TransferThreadPool::~TransferThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_stopping = true;
+    }
+    m_taskAdded.notify_all();
+    for (auto& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  void TransferThreadPool::Execute(std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_tasks.push_back(std::move(task));
+      if (m_tasks.size() > m_idleThreads && m_threads.size() < m_maxThreads)
+      {
+        try
+        {
+          m_threads.emplace_back(&TransferThreadPool::Run, this);
+          return;
+        }
+        catch (const std::system_error&)
+        {
+          // The threads already started run the task later.
+          if (m_threads.empty())
+          {
+            m_tasks.pop_back();
+            throw;
+          }
+        }
+      }
+    }
+    m_taskAdded.notify_one();
+  }
+
+  int32_t TransferThreadPool::GetThreadCount() const
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return static_cast<int32_t>(m_threads.size());
+  }
+
+  void TransferThreadPool::Run()
+  {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    while (true)
+    {
+      if (m_tasks.empty())
+      {
+        if (m_stopping)
+        {
+          return;
+        }
+        ++m_idleThreads;
+        m_taskAdded.wait(guard, [this]() { return !m_tasks.empty() || m_stopping; });
+        --m_idleThreads;
+        continue;
+      }
+
+      auto task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+      guard.unlock();
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        // The tasks report their errors to the transfers that submitted them.
+      }
+      guard.lock();
+    }
+  }
+
+  void SetTransferExecutor(std::shared_ptr<TransferExecutor> executor)
+  {
+    std::lock_guard<std::mutex> guard(g_transferExecutorMutex);
+    g_transferExecutor = std::move(executor);
+  }
+
+  std::shared_ptr<TransferExecutor> GetTransferExecutor()
+  {
+    {
+      std::lock_guard<std::mutex> guard(g_transferExecutorMutex);
+      if (g_transferExecutor)
+      {
+        return g_transferExecutor;
+      }
+    }
+    return GetDefaultTransferExecutor();
+  }
+
+}} // namespace Azure::Storage
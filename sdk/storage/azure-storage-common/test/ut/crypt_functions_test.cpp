@@ -6,6 +6,7 @@
 #include <azure/storage/common/crypt.hpp>
 
 #include <cstring>
+#include <thread>
 
 namespace Azure { namespace Storage { namespace Test {
 
@@ -31,6 +32,39 @@ namespace Azure { namespace Storage { namespace Test {
         "+SBESxQVhI53mSEdZJcCBpdBkaqwzfPaVYZMAf5LP3c=");
   }
 
+  TEST_F(CryptFunctionsTest, HmacSha256Key)
+  {
+    // Test cases 2 and 6 of RFC 4231, the second one with a key longer than a block.
+    _internal::HmacSha256Key shortKey(ToBinaryVector("Jefe"));
+    auto const shortKeyMessage = ToBinaryVector("what do ya want for nothing?");
+    _internal::HmacSha256Key longKey(std::vector<uint8_t>(131, 0xaa));
+    auto const longKeyMessage
+        = ToBinaryVector("Test Using Larger Than Block-Size Key - Hash Key First");
+
+    // The key signs any number of messages, from many threads at once.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([&]() {
+        for (int i = 0; i < 100; ++i)
+        {
+          EXPECT_EQ(
+              Azure::Core::Convert::Base64Encode(
+                  shortKey.Sign(shortKeyMessage.data(), shortKeyMessage.size())),
+              "W9zBRr9gdU5qBCQmCJV1x1oAPwidJzmDnexYuWTsOEM=");
+          EXPECT_EQ(
+              Azure::Core::Convert::Base64Encode(
+                  longKey.Sign(longKeyMessage.data(), longKeyMessage.size())),
+              "YOQxWR7gtn8Niiaqy/W3f44LxiE3KMUUBUYEDw7jf1Q=");
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
   static std::vector<uint8_t> ComputeHash(const std::string& data)
   {
     const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data.data());
@@ -114,6 +148,59 @@ namespace Azure { namespace Storage { namespace Test {
         crc64Single.Final(reinterpret_cast<const uint8_t*>(allData.data()), allData.size()));
   }
 
+  TEST_F(CryptFunctionsTest, Crc64Hash_MatchesTable)
+  {
+    // Data appended in pieces shorter than 16 bytes only goes through the tables, so this
+    // compares the hardware accelerated kernels, when the CPU has them, with the tables for every
+    // way the data can be split into blocks.
+    auto data = RandomBuffer(static_cast<size_t>(8_KB));
+    std::vector<size_t> lengths;
+    for (size_t length = 0; length <= 1040; ++length)
+    {
+      lengths.push_back(length);
+    }
+    lengths.push_back(static_cast<size_t>(4_KB - 1));
+    lengths.push_back(static_cast<size_t>(4_KB));
+    lengths.push_back(static_cast<size_t>(4_KB + 17));
+    lengths.push_back(static_cast<size_t>(8_KB - 15));
+
+    for (size_t length : lengths)
+    {
+      for (size_t offset = 0; offset < 16 && offset + length <= data.size(); offset += 5)
+      {
+        Crc64Hash accelerated;
+        accelerated.Append(&data[offset], length);
+
+        Crc64Hash table;
+        for (size_t i = 0; i < length; i += 15)
+        {
+          table.Append(&data[offset + i], (std::min)(length - i, static_cast<size_t>(15)));
+        }
+        ASSERT_EQ(accelerated.Final(), table.Final())
+            << "length " << length << " offset " << offset;
+      }
+    }
+  }
+
+  TEST_F(CryptFunctionsTest, Crc64Hash_ConcatenateMatchesAppend)
+  {
+    auto data = RandomBuffer(static_cast<size_t>(64_KB));
+    std::vector<size_t> const splits
+        = {0, 1, 15, 16, 255, static_cast<size_t>(4_KB), data.size() - 300, data.size()};
+    for (size_t split : splits)
+    {
+      Crc64Hash first;
+      first.Append(data.data(), split);
+      Crc64Hash second;
+      second.Append(data.data() + split, data.size() - split);
+      first.Concatenate(second);
+
+      Crc64Hash whole;
+      whole.Append(data.data(), data.size());
+      EXPECT_EQ(first.Final(), whole.Final()) << "split " << split;
+    }
+  }
+
   TEST_F(CryptFunctionsTest, Crc64Hash_CtorDtor)
   {
     {
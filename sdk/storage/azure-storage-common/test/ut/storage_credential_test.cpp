@@ -3,8 +3,18 @@
 
 #include "test_base.hpp"
 
+#include <azure/core/http/policies/policy_latency_recorder.hpp>
+#include <azure/core/internal/http/pipeline.hpp>
+#include <azure/storage/blobs.hpp>
+#include <azure/storage/common/internal/shared_key_policy.hpp>
 #include <azure/storage/common/storage_credential.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace Azure { namespace Storage { namespace Test {
 
   TEST(StorageCredentialTest, DefaultHostCorrect)
@@ -23,4 +33,181 @@ namespace Azure { namespace Storage { namespace Test {
         "testaccount.blob.core.windows.net");
   }
 
+  namespace {
+    class AuthorizationHeaderPolicy final : public Core::Http::Policies::HttpPolicy {
+    public:
+      explicit AuthorizationHeaderPolicy(std::string& authorizationHeader)
+          : m_authorizationHeader(authorizationHeader)
+      {
+      }
+
+      std::unique_ptr<Core::Http::RawResponse> Send(
+          Core::Http::Request& request,
+          Core::Http::Policies::NextHttpPolicy,
+          Core::Context const&) const override
+      {
+        m_authorizationHeader = request.GetHeader("Authorization").Value();
+        return std::make_unique<Core::Http::RawResponse>(
+            1, 1, Core::Http::HttpStatusCode::Ok, "OK");
+      }
+
+      std::unique_ptr<HttpPolicy> Clone() const override
+      {
+        return std::make_unique<AuthorizationHeaderPolicy>(*this);
+      }
+
+    private:
+      std::string& m_authorizationHeader;
+    };
+
+    class SetHeaderPolicy final : public Core::Http::Policies::HttpPolicy {
+    public:
+      SetHeaderPolicy(std::string name, std::string value)
+          : m_name(std::move(name)), m_value(std::move(value))
+      {
+      }
+
+      std::unique_ptr<Core::Http::RawResponse> Send(
+          Core::Http::Request& request,
+          Core::Http::Policies::NextHttpPolicy nextPolicy,
+          Core::Context const& context) const override
+      {
+        request.SetHeader(m_name, m_value);
+        return nextPolicy.Send(request, context);
+      }
+
+      std::unique_ptr<HttpPolicy> Clone() const override
+      {
+        return std::make_unique<SetHeaderPolicy>(*this);
+      }
+
+    private:
+      std::string m_name;
+      std::string m_value;
+    };
+
+    // Signs the request like a client sending it does, with the headers set by perRetryHeaders
+    // set during the try.
+    std::string GetAuthorizationHeader(
+        Core::Http::Request& request,
+        const std::vector<std::pair<std::string, std::string>>& perRetryHeaders = {})
+    {
+      static const auto credential = std::make_shared<StorageSharedKeyCredential>(
+          "account", Core::Convert::Base64Encode(std::vector<uint8_t>(64, 0x5a)));
+      std::string authorizationHeader;
+      std::vector<std::unique_ptr<Core::Http::Policies::HttpPolicy>> policies;
+      policies.emplace_back(std::make_unique<Core::Http::Policies::_internal::RetryPolicy>(
+          Core::Http::Policies::RetryOptions()));
+      for (const auto& header : perRetryHeaders)
+      {
+        policies.emplace_back(std::make_unique<SetHeaderPolicy>(header.first, header.second));
+      }
+      policies.emplace_back(std::make_unique<_internal::SharedKeyPolicy>(credential));
+      policies.emplace_back(std::make_unique<AuthorizationHeaderPolicy>(authorizationHeader));
+      Core::Http::_internal::HttpPipeline(policies).Send(request, Core::Context());
+      return authorizationHeader;
+    }
+
+    class AcceptedTransport final : public Core::Http::HttpTransport {
+    public:
+      std::unique_ptr<Core::Http::RawResponse> Send(
+          Core::Http::Request&,
+          Core::Context const&) override
+      {
+        auto response = std::make_unique<Core::Http::RawResponse>(
+            1, 1, Core::Http::HttpStatusCode::Accepted, "Accepted");
+        response->SetBodyStream(std::make_unique<Core::IO::MemoryBodyStream>(nullptr, 0));
+        return response;
+      }
+    };
+  } // namespace
+
+  TEST(StorageCredentialTest, SharedKeySignature)
+  {
+    {
+      Core::Http::Request request(
+          Core::Http::HttpMethod::Put,
+          Core::Url("https://account.blob.core.windows.net/container/folder/"
+                    "blob.bin?comp=block&blockid=AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"));
+      request.SetHeader("Content-Length", "4194304");
+      request.SetHeader("Content-Type", "application/octet-stream");
+      request.SetHeader("x-ms-client-request-id", "0c8ba5c5-0a4b-4d2e-8d2e-3a6f0e1c9b7d");
+      request.SetHeader("x-ms-date", "Thu, 15 Oct 2026 12:00:00 GMT");
+      request.SetHeader("x-ms-version", "2026-10-06");
+      EXPECT_EQ(
+          GetAuthorizationHeader(request),
+          "SharedKey account:KGMbMukniUvOB/wfvZ5jDOQpIJ34rFj6Zeb8m8k+UDY=");
+    }
+    {
+      // The x-ms- headers are ordered like .NET orders strings, which ignores '-' first, and the
+      // query parameters are decoded, with lowercase names.
+      Core::Http::Request request(
+          Core::Http::HttpMethod::Get,
+          Core::Url("https://account.blob.core.windows.net/container/"
+                    "a%2Fb?Restype=container&comp=list&prefix=a+b%2Fc&Marker=%C3%A9"));
+      request.SetHeader("Content-Length", "0");
+      request.SetHeader("Range", "bytes=0-1023");
+      request.SetHeader("x-ms-meta-a-c", "1");
+      request.SetHeader("x-ms-meta-ab", "2");
+      request.SetHeader("x-ms-meta-a_b", "3");
+      request.SetHeader("x-ms-meta-a", "4");
+      request.SetHeader("x-ms-meta-Ab-", "5");
+      request.SetHeader("x-ms-meta-a9", "6");
+      request.SetHeader("x-ms-meta-a.b", "7");
+      request.SetHeader("x-ms-date", "Thu, 15 Oct 2026 12:00:00 GMT");
+      request.SetHeader("x-ms-version", "2026-10-06");
+      EXPECT_EQ(
+          GetAuthorizationHeader(request),
+          "SharedKey account:fWXdZ5/mdq3N7JyJNJ7g6ZbP/cjX3JoCs5MOFdzy6cI=");
+    }
+    {
+      // The headers set during the try replace the ones set before.
+      Core::Http::Request request(
+          Core::Http::HttpMethod::Delete,
+          Core::Url("https://account.blob.core.windows.net/container/blob"));
+      request.SetHeader("If-Match", "\"0x8D\"");
+      request.SetHeader("x-ms-date", "Thu, 15 Oct 2026 12:00:00 GMT");
+      request.SetHeader("x-ms-version", "2026-10-06");
+      EXPECT_EQ(
+          GetAuthorizationHeader(
+              request,
+              {{"x-ms-date", "Thu, 15 Oct 2026 12:00:05 GMT"},
+               {"x-ms-client-request-id", "id"},
+               {"If-Match", "\"0x8E\""}}),
+          "SharedKey account:DWzy60lLp3bhIOe8/pqcuwu+W9Ot9/c0bF2qti6KSb4=");
+    }
+  }
+
+  TEST(StorageCredentialTest, SharedKeyPolicyLatency)
+  {
+    // The clients pass the latency recorder of their options to the pipeline they build.
+    auto const recorder = std::make_shared<Core::Http::Policies::PolicyLatencyRecorder>();
+    Blobs::BlobClientOptions options;
+    options.Transport.Transport = std::make_shared<AcceptedTransport>();
+    options.Telemetry.LatencyRecorder = recorder;
+    Blobs::BlobServiceClient serviceClient(
+        "https://account.blob.core.windows.net",
+        std::make_shared<StorageSharedKeyCredential>(
+            "account", Core::Convert::Base64Encode(std::vector<uint8_t>(64, 0x5a))),
+        options);
+    serviceClient.GetBlobContainerClient("container").GetBlobClient("blob").Delete();
+
+    auto const histograms = recorder->GetHistograms();
+    ASSERT_FALSE(histograms.empty());
+    for (auto const& histogram : histograms)
+    {
+      EXPECT_EQ(histogram.Count, 1);
+    }
+#if defined(AZ_CORE_RTTI)
+    EXPECT_NE(
+        std::find_if(
+            histograms.begin(),
+            histograms.end(),
+            [](Core::Http::Policies::PolicyLatencyHistogram const& histogram) {
+              return histogram.PolicyName.find("SharedKeyPolicy") != std::string::npos;
+            }),
+        histograms.end());
+#endif
+  }
+
 }}} // namespace Azure::Storage::Test
@@ -0,0 +1,428 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "test_base.hpp"
+
+#include <azure/storage/common/internal/concurrent_transfer.hpp>
+#include <azure/storage/common/transfer_executor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  namespace {
+    // Sets the executor of the transfers of a test, and restores the default one after it.
+    class ScopedTransferExecutor final {
+    public:
+      explicit ScopedTransferExecutor(std::shared_ptr<TransferExecutor> executor)
+      {
+        SetTransferExecutor(std::move(executor));
+      }
+      ~ScopedTransferExecutor() { SetTransferExecutor(nullptr); }
+    };
+
+    // Runs each task on a thread of its own, and counts them.
+    class ThreadPerTaskExecutor final : public TransferExecutor {
+    public:
+      ~ThreadPerTaskExecutor() override
+      {
+        // The tasks submitted by the tasks being joined are started before they are joined.
+        for (size_t i = 0;; ++i)
+        {
+          std::thread thread;
+          {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (i == m_threads.size())
+            {
+              break;
+            }
+            thread = std::move(m_threads[i]);
+          }
+          thread.join();
+        }
+      }
+
+      void Execute(std::function<void()> task) override
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_threads.emplace_back(std::move(task));
+        ++NumTasks;
+      }
+
+      std::atomic<int> NumTasks{0};
+
+    private:
+      std::mutex m_mutex;
+      std::vector<std::thread> m_threads;
+    };
+
+    class FailingExecutor final : public TransferExecutor {
+    public:
+      void Execute(std::function<void()>) override
+      {
+        throw std::system_error(std::make_error_code(std::errc::resource_unavailable_try_again));
+      }
+    };
+
+    // A stream of unknown length which can't be rewound, returning at most 7 bytes per read, like
+    // a network stream. It can fail the read after a number of bytes.
+    class NonSeekableStream final : public Azure::Core::IO::BodyStream {
+    public:
+      explicit NonSeekableStream(
+          std::vector<uint8_t> content,
+          size_t failAfter = (std::numeric_limits<size_t>::max)())
+          : m_content(std::move(content)), m_failAfter(failAfter)
+      {
+      }
+
+      int64_t Length() const override { return -1; }
+
+      std::atomic<size_t> BytesRead{0};
+
+    private:
+      size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const&) override
+      {
+        if (BytesRead >= m_failAfter)
+        {
+          throw std::runtime_error("Read failed.");
+        }
+        const size_t length = (std::min)({count, size_t(7), m_content.size() - BytesRead});
+        std::copy(
+            m_content.begin() + static_cast<std::ptrdiff_t>(BytesRead.load()),
+            m_content.begin() + static_cast<std::ptrdiff_t>(BytesRead + length),
+            buffer);
+        BytesRead += length;
+        return length;
+      }
+
+      std::vector<uint8_t> m_content;
+      size_t m_failAfter;
+    };
+
+    std::vector<uint8_t> CreateContent(size_t length)
+    {
+      std::vector<uint8_t> content(length);
+      for (size_t i = 0; i < length; ++i)
+      {
+        content[i] = static_cast<uint8_t>(i % 251);
+      }
+      return content;
+    }
+  } // namespace
+
+  TEST(TransferExecutorTest, ThreadPoolRunsTasks)
+  {
+    std::atomic<int> numTasksRun{0};
+    {
+      TransferThreadPoolOptions options;
+      options.MaxThreads = 2;
+      TransferThreadPool pool(options);
+      for (int i = 0; i < 100; ++i)
+      {
+        pool.Execute([&numTasksRun]() {
+          ++numTasksRun;
+          throw std::runtime_error("Task failed.");
+        });
+      }
+      EXPECT_LE(pool.GetThreadCount(), 2);
+    }
+    EXPECT_EQ(numTasksRun, 100);
+  }
+
+  TEST(TransferExecutorTest, ConcurrentTransfersShareThreads)
+  {
+    constexpr int MaxThreads = 4;
+    constexpr int NumTransfers = 16;
+    constexpr int64_t NumChunks = 64;
+
+    TransferThreadPoolOptions options;
+    options.MaxThreads = MaxThreads;
+    auto pool = std::make_shared<TransferThreadPool>(options);
+    ScopedTransferExecutor scopedExecutor(pool);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+    std::vector<std::vector<int>> chunksTransferred(
+        NumTransfers, std::vector<int>(static_cast<size_t>(NumChunks)));
+
+    std::vector<std::thread> transfers;
+    for (int t = 0; t < NumTransfers; ++t)
+    {
+      transfers.emplace_back([&, t]() {
+        _internal::ConcurrentTransfer(
+            0,
+            NumChunks * 10,
+            10,
+            8,
+            [&, t](int64_t offset, int64_t length, int64_t chunkId, int64_t) {
+              EXPECT_EQ(offset, chunkId * 10);
+              EXPECT_EQ(length, 10);
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+              std::lock_guard<std::mutex> guard(mutex);
+              threadIds.insert(std::this_thread::get_id());
+              ++chunksTransferred[t][static_cast<size_t>(chunkId)];
+            });
+      });
+    }
+    for (auto& transfer : transfers)
+    {
+      transfer.join();
+    }
+
+    for (const auto& chunks : chunksTransferred)
+    {
+      for (auto numTransfers : chunks)
+      {
+        EXPECT_EQ(numTransfers, 1);
+      }
+    }
+    EXPECT_LE(pool->GetThreadCount(), MaxThreads);
+    EXPECT_LE(threadIds.size(), static_cast<size_t>(MaxThreads + NumTransfers));
+  }
+
+  TEST(TransferExecutorTest, CustomExecutor)
+  {
+    auto executor = std::make_shared<ThreadPerTaskExecutor>();
+    ScopedTransferExecutor scopedExecutor(executor);
+
+    std::atomic<int64_t> numBytes{0};
+    _internal::ConcurrentTransfer(
+        0, 1000, 10, 4, [&numBytes](int64_t, int64_t length, int64_t, int64_t) {
+          numBytes += length;
+        });
+    EXPECT_EQ(numBytes, 1000);
+    EXPECT_GT(executor->NumTasks, 0);
+  }
+
+  TEST(TransferExecutorTest, ExecutorFailure)
+  {
+    ScopedTransferExecutor scopedExecutor(std::make_shared<FailingExecutor>());
+
+    std::atomic<int64_t> numBytes{0};
+    _internal::ConcurrentTransfer(
+        0, 1000, 10, 4, [&numBytes](int64_t, int64_t length, int64_t, int64_t) {
+          numBytes += length;
+        });
+    EXPECT_EQ(numBytes, 1000);
+
+    std::vector<uint8_t> content(95);
+    Azure::Core::IO::MemoryBodyStream stream(content);
+    numBytes = 0;
+    EXPECT_EQ(
+        _internal::ConcurrentTransferFromStream(
+            stream,
+            10,
+            4,
+            [&numBytes](const uint8_t*, size_t length, int64_t) {
+              numBytes += static_cast<int64_t>(length);
+            },
+            Azure::Core::Context()),
+        10);
+    EXPECT_EQ(numBytes, 95);
+  }
+
+  TEST(TransferExecutorTest, ChunkFailure)
+  {
+    std::atomic<int> numChunks{0};
+    EXPECT_THROW(
+        _internal::ConcurrentTransfer(
+            0,
+            1000,
+            10,
+            4,
+            [&numChunks](int64_t, int64_t, int64_t chunkId, int64_t) {
+              ++numChunks;
+              if (chunkId == 3)
+              {
+                throw std::runtime_error("Chunk failed.");
+              }
+            }),
+        std::runtime_error);
+    EXPECT_LT(numChunks, 100);
+  }
+
+  TEST(ConcurrentTransferFromStreamTest, ChunksInOrder)
+  {
+    ScopedTransferExecutor scopedExecutor(std::make_shared<ThreadPerTaskExecutor>());
+
+    const auto content = CreateContent(1000);
+    NonSeekableStream stream(content);
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>> chunks(16);
+    EXPECT_EQ(
+        _internal::ConcurrentTransferFromStream(
+            stream,
+            64,
+            4,
+            [&](const uint8_t* chunk, size_t length, int64_t chunkId) {
+              std::lock_guard<std::mutex> guard(mutex);
+              ASSERT_LT(chunkId, 16);
+              EXPECT_TRUE(chunks[static_cast<size_t>(chunkId)].empty());
+              chunks[static_cast<size_t>(chunkId)].assign(chunk, chunk + length);
+            },
+            Azure::Core::Context()),
+        16);
+
+    // Each chunk has the content at its ID, and only the last one is shorter.
+    std::vector<uint8_t> transferred;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+      EXPECT_EQ(chunks[i].size(), i + 1 < chunks.size() ? 64 : 1000 - 15 * 64);
+      transferred.insert(transferred.end(), chunks[i].begin(), chunks[i].end());
+    }
+    EXPECT_EQ(transferred, content);
+
+    // An empty stream has no chunk.
+    NonSeekableStream emptyStream({});
+    EXPECT_EQ(
+        _internal::ConcurrentTransferFromStream(
+            emptyStream,
+            64,
+            4,
+            [](const uint8_t*, size_t, int64_t) { FAIL(); },
+            Azure::Core::Context()),
+        0);
+  }
+
+  TEST(ConcurrentTransferFromStreamTest, MemoryBound)
+  {
+    ScopedTransferExecutor scopedExecutor(std::make_shared<ThreadPerTaskExecutor>());
+
+    constexpr int Concurrency = 3;
+    constexpr int64_t ChunkSize = 16;
+    NonSeekableStream stream(CreateContent(100 * ChunkSize));
+    std::mutex mutex;
+    std::set<const uint8_t*> buffers;
+    std::atomic<int> runningChunks{0};
+    std::atomic<int> maxRunningChunks{0};
+    std::atomic<size_t> bytesTransferred{0};
+    std::atomic<size_t> maxBytesInMemory{0};
+    _internal::ConcurrentTransferFromStream(
+        stream,
+        ChunkSize,
+        Concurrency,
+        [&](const uint8_t* chunk, size_t length, int64_t) {
+          const int running = ++runningChunks;
+          {
+            std::lock_guard<std::mutex> guard(mutex);
+            buffers.insert(chunk);
+            maxRunningChunks = (std::max)(maxRunningChunks.load(), running);
+            // The bytes read and not transferred yet are all in the buffers. Reading the bytes
+            // transferred last can only make the difference smaller.
+            const size_t bytesRead = stream.BytesRead;
+            maxBytesInMemory = (std::max)(maxBytesInMemory.load(), bytesRead - bytesTransferred);
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          bytesTransferred += length;
+          --runningChunks;
+        },
+        Azure::Core::Context());
+
+    EXPECT_EQ(bytesTransferred, 100 * ChunkSize);
+    EXPECT_LE(buffers.size(), static_cast<size_t>(Concurrency));
+    EXPECT_LE(maxRunningChunks, Concurrency);
+    EXPECT_LE(maxBytesInMemory, static_cast<size_t>(Concurrency * ChunkSize));
+  }
+
+  TEST(ConcurrentTransferFromStreamTest, BusyExecutor)
+  {
+    TransferThreadPoolOptions options;
+    options.MaxThreads = 1;
+    auto pool = std::make_shared<TransferThreadPool>(options);
+    ScopedTransferExecutor scopedExecutor(pool);
+
+    // The only thread of the executor is busy until the transfer is done.
+    std::promise<void> transferDone;
+    auto transferDoneFuture = transferDone.get_future().share();
+    pool->Execute([transferDoneFuture]() { transferDoneFuture.wait(); });
+
+    NonSeekableStream stream(CreateContent(1000));
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+    auto transfer = std::async(std::launch::async, [&]() {
+      return _internal::ConcurrentTransferFromStream(
+          stream,
+          10,
+          2,
+          [&](const uint8_t*, size_t, int64_t) {
+            std::lock_guard<std::mutex> guard(mutex);
+            threadIds.insert(std::this_thread::get_id());
+          },
+          Azure::Core::Context());
+    });
+
+    // The calling thread transfers the chunks instead of waiting for the executor.
+    const bool isDone
+        = transfer.wait_for(std::chrono::seconds(30)) == std::future_status::ready;
+    transferDone.set_value();
+    ASSERT_TRUE(isDone);
+    EXPECT_EQ(transfer.get(), 100);
+    EXPECT_EQ(threadIds.size(), 1U);
+  }
+
+  TEST(ConcurrentTransferFromStreamTest, ChunkFailure)
+  {
+    ScopedTransferExecutor scopedExecutor(std::make_shared<ThreadPerTaskExecutor>());
+
+    NonSeekableStream stream(CreateContent(1000 * 10));
+    std::atomic<int> numChunks{0};
+    std::atomic<int> runningChunks{0};
+    EXPECT_THROW(
+        _internal::ConcurrentTransferFromStream(
+            stream,
+            10,
+            4,
+            [&](const uint8_t*, size_t, int64_t chunkId) {
+              ++runningChunks;
+              ++numChunks;
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+              --runningChunks;
+              if (chunkId == 3)
+              {
+                throw std::runtime_error("Chunk failed.");
+              }
+            },
+            Azure::Core::Context()),
+        std::runtime_error);
+    // The transfer stops reading the stream and waits for the running chunks.
+    EXPECT_LT(numChunks, 1000);
+    EXPECT_LT(stream.BytesRead, size_t(1000 * 10));
+    EXPECT_EQ(runningChunks, 0);
+  }
+
+  TEST(ConcurrentTransferFromStreamTest, ReadFailure)
+  {
+    ScopedTransferExecutor scopedExecutor(std::make_shared<ThreadPerTaskExecutor>());
+
+    NonSeekableStream stream(CreateContent(1000), 95);
+    std::atomic<int> runningChunks{0};
+    std::atomic<int> numChunks{0};
+    EXPECT_THROW(
+        _internal::ConcurrentTransferFromStream(
+            stream,
+            10,
+            4,
+            [&](const uint8_t*, size_t, int64_t) {
+              ++runningChunks;
+              ++numChunks;
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+              --runningChunks;
+            },
+            Azure::Core::Context()),
+        std::runtime_error);
+    // The chunks read before the failure are transferred before it is thrown.
+    EXPECT_EQ(runningChunks, 0);
+    EXPECT_LE(numChunks, 9);
+  }
+
+}}} // namespace Azure::Storage::Test
@@ -207,6 +207,14 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
      */
     bool EnableTenantDiscovery = false;
 
+    /**
+     * When set, a token expiring within this window is refreshed in the background while the
+     * requests keep using it, when the client is configured to use a TokenCredential. Only the
+     * requests finding a token about to expire wait for a new one. By default, the token is
+     * refreshed by the request which finds it expiring.
+     */
+    Azure::DateTime::duration TokenRefreshWindow = Azure::DateTime::duration::zero();
+
     /**
      * The Audience to use for authentication with Azure Active Directory (AAD).
      * #Azure::Storage::Files::DataLake::DataLakeAudience::DefaultAudience will be assumed
@@ -1049,6 +1057,14 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
      * @brief Optional. Configures whether to do content validation for file uploads.
      */
     Azure::Nullable<TransferValidationOptions> ValidationOptions;
+
+    /**
+     * @brief The path of a checkpoint of the chunks uploaded, when uploading a local file in
+     * chunks. An upload of the same local file which failed or was interrupted resumes from its
+     * checkpoint: the chunks still uploaded with the same content aren't uploaded again. The
+     * checkpoint is deleted once the upload is done.
+     */
+    Azure::Nullable<std::string> CheckpointPath;
   };
 
   using AcquireLeaseOptions = Blobs::AcquireLeaseOptions;
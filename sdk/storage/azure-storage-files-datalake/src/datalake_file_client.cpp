@@ -301,6 +301,7 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
       validationOptions.Algorithm = options.ValidationOptions.Value().Algorithm;
       blobOptions.ValidationOptions = std::move(validationOptions);
     }
+    blobOptions.CheckpointPath = options.CheckpointPath;
     return m_blobClient.AsBlockBlobClient().UploadFrom(fileName, blobOptions, context);
   }
 
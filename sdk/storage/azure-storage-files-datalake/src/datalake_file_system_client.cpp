@@ -67,7 +67,8 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     pipelineOptions.SharedKeyAuthPolicy = std::make_unique<_internal::SharedKeyPolicy>(credential);
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   DataLakeFileSystemClient::DataLakeFileSystemClient(
@@ -100,11 +101,12 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
               : _internal::StorageScope);
       pipelineOptions.TokenAuthPolicy
           = std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-              credential, tokenContext, options.EnableTenantDiscovery);
+              credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefreshWindow);
     }
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   DataLakeFileSystemClient::DataLakeFileSystemClient(
@@ -128,7 +130,8 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     pipelineOptions.ApiVersion = options.ApiVersion;
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   DataLakeFileClient DataLakeFileSystemClient::GetFileClient(const std::string& fileName) const
@@ -65,7 +65,8 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     pipelineOptions.SharedKeyAuthPolicy = std::make_unique<_internal::SharedKeyPolicy>(credential);
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   DataLakePathClient::DataLakePathClient(
@@ -98,11 +99,12 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
               : _internal::StorageScope);
       pipelineOptions.TokenAuthPolicy
           = std::make_unique<_internal::StorageBearerTokenAuthenticationPolicy>(
-              credential, tokenContext, options.EnableTenantDiscovery);
+              credential, tokenContext, options.EnableTenantDiscovery, options.TokenRefreshWindow);
     }
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   DataLakePathClient::DataLakePathClient(
@@ -125,7 +127,8 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
     pipelineOptions.ApiVersion = options.ApiVersion;
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   Azure::Response<Models::SetPathAccessControlListResult> DataLakePathClient::SetAccessControlList(
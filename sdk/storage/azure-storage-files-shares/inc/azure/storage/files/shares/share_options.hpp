@@ -343,6 +343,14 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
      */
     Azure::Nullable<ShareAudience> Audience;
 
+    /**
+     * When set, a token expiring within this window is refreshed in the background while the
+     * requests keep using it, when the client is configured to use a TokenCredential. Only the
+     * requests finding a token about to expire wait for a new one. By default, the token is
+     * refreshed by the request which finds it expiring.
+     */
+    Azure::DateTime::duration TokenRefreshWindow = Azure::DateTime::duration::zero();
+
     /**
      * @brief Optional. Configures whether to do content validation for file uploads.
      */
@@ -57,7 +57,8 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     pipelineOptions.SharedKeyAuthPolicy = std::make_unique<_internal::SharedKeyPolicy>(credential);
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   ShareClient::ShareClient(
@@ -85,11 +86,12 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
               : _internal::StorageScope);
       pipelineOptions.TokenAuthPolicy = std::make_unique<
           Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy>(
-          credential, tokenContext);
+          credential, tokenContext, options.TokenRefreshWindow);
     }
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   ShareClient::ShareClient(const std::string& shareUrl, const ShareClientOptions& options)
@@ -108,7 +110,8 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     pipelineOptions.ApiVersion = options.ApiVersion;
 
     m_pipeline = std::make_shared<Azure::Core::Http::_internal::HttpPipeline>(
-        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)));
+        _internal::BuildHttpPipelinePolicies(options, std::move(pipelineOptions)),
+        options.Telemetry.LatencyRecorder);
   }
 
   ShareDirectoryClient ShareClient::GetRootDirectoryClient() const
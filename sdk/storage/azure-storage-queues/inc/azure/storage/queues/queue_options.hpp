@@ -137,6 +137,14 @@ namespace Azure { namespace Storage { namespace Queues {
      */
     bool EnableTenantDiscovery = false;
 
+    /**
+     * When set, a token expiring within this window is refreshed in the background while the
+     * requests keep using it, when the client is configured to use a TokenCredential. Only the
+     * requests finding a token about to expire wait for a new one. By default, the token is
+     * refreshed by the request which finds it expiring.
+     */
+    Azure::DateTime::duration TokenRefreshWindow = Azure::DateTime::duration::zero();
+
     /**
      * The Audience to use for authentication with Azure Active Directory (AAD).
      * #Azure::Storage::Queues::QueueAudience::DefaultAudience will be assumed if